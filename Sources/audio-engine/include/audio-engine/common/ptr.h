@@ -8,6 +8,8 @@
 
 namespace yas::audio {
 class pcm_buffer;
+class pcm_buffer_allocator;
+class pcm_buffer_pool;
 class time;
 class file;
 class io_kernel;
@@ -37,6 +39,11 @@ class graph_input_tap;
 class graph_io;
 class graph_avf_au;
 class graph_avf_au_mixer;
+class graph_mixer;
+class graph_resampler;
+class graph_oscillator_bank;
+class worker_pool;
+class rendering_worker_pool;
 
 class manageable_graph_au;
 class graph_node_removable;
@@ -49,6 +56,8 @@ class manageable_graph_avf_au;
 class renderable_graph_connection;
 
 using pcm_buffer_ptr = std::shared_ptr<pcm_buffer>;
+using pcm_buffer_allocator_ptr = std::shared_ptr<pcm_buffer_allocator>;
+using pcm_buffer_pool_ptr = std::shared_ptr<pcm_buffer_pool>;
 using time_ptr = std::shared_ptr<time>;
 using file_ptr = std::shared_ptr<file>;
 using io_kernel_ptr = std::shared_ptr<io_kernel>;
@@ -79,6 +88,11 @@ using graph_input_tap_ptr = std::shared_ptr<graph_input_tap>;
 using graph_io_ptr = std::shared_ptr<graph_io>;
 using graph_avf_au_ptr = std::shared_ptr<graph_avf_au>;
 using graph_avf_au_mixer_ptr = std::shared_ptr<graph_avf_au_mixer>;
+using graph_mixer_ptr = std::shared_ptr<graph_mixer>;
+using graph_resampler_ptr = std::shared_ptr<graph_resampler>;
+using graph_oscillator_bank_ptr = std::shared_ptr<graph_oscillator_bank>;
+using worker_pool_ptr = std::shared_ptr<worker_pool>;
+using rendering_worker_pool_ptr = std::shared_ptr<rendering_worker_pool>;
 
 using manageable_graph_au_ptr = std::shared_ptr<manageable_graph_au>;
 using graph_node_removable_ptr = std::shared_ptr<graph_node_removable>;
@@ -42,7 +42,7 @@ enum class continuation {
 
 using bus_result_t = std::optional<uint32_t>;
 using abl_uptr = std::unique_ptr<AudioBufferList, std::function<void(AudioBufferList *)>>;
-using abl_data_uptr = std::unique_ptr<std::vector<std::vector<uint8_t>>>;
+using abl_data_uptr = std::unique_ptr<uint8_t, std::function<void(uint8_t *)>>;
 using channel_map_t = std::vector<uint32_t>;
 }  // namespace yas::audio
 
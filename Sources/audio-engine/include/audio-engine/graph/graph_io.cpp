@@ -48,6 +48,14 @@ io_ptr const &graph_io::raw_io() {
     return this->_raw_io;
 }
 
+void graph_io::set_rendering_worker_pool(rendering_worker_pool_ptr const &worker_pool) {
+    this->_rendering_worker_pool = worker_pool;
+}
+
+rendering_worker_pool_ptr const &graph_io::rendering_worker_pool() const {
+    return this->_rendering_worker_pool;
+}
+
 bool graph_io::_validate_connections() {
     auto const &raw_io = this->_raw_io;
 
@@ -118,7 +126,8 @@ void graph_io::update_rendering() {
         return;
     }
 
-    auto graph = std::make_shared<rendering_graph>(this->output_node, this->input_node);
+    auto graph = std::make_shared<rendering_graph>(this->output_node, this->input_node,
+                                                   raw_io->maximum_frames_per_slice(), this->_rendering_worker_pool);
 
     auto render_handler = [input_context = this->_input_context, graph](io_render_args args) {
         input_context->input_buffer = args.input_buffer;
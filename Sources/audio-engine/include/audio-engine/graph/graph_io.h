@@ -20,11 +20,17 @@ struct graph_io : manageable_graph_io {
 
     [[nodiscard]] audio::io_ptr const &raw_io() override;
 
+    /// 設定すると、独立した接続元を持つノードの入力をrendering_worker_poolで並列に描画する
+    /// 次にレンダリングが更新されたときから反映される
+    void set_rendering_worker_pool(rendering_worker_pool_ptr const &);
+    [[nodiscard]] rendering_worker_pool_ptr const &rendering_worker_pool() const;
+
     [[nodiscard]] static graph_io_ptr make_shared(audio::io_ptr const &);
 
    private:
     audio::io_ptr const _raw_io;
     std::shared_ptr<graph_input_context> _input_context = nullptr;
+    rendering_worker_pool_ptr _rendering_worker_pool = nullptr;
 
     graph_io(audio::io_ptr const &);
 
@@ -0,0 +1,253 @@
+//
+//  graph_mixer.cpp
+//
+
+#include "graph_mixer.h"
+
+#include <audio-engine/rendering/rendering_connection.h>
+#include <audio-engine/utils/mix_kernels.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace yas;
+using namespace yas::audio;
+
+namespace yas::audio::graph_mixer_utils {
+/// 2チャンネルのときだけパンを反映する。中央では両方とも1になる
+static float pan_gain(float const pan, uint32_t const ch_idx, uint32_t const ch_count) {
+    if (ch_count != 2) {
+        return 1.0f;
+    }
+
+    auto const clamped = std::clamp(pan, -1.0f, 1.0f);
+    return ch_idx == 0 ? std::min(1.0f, 1.0f - clamped) : std::min(1.0f, 1.0f + clamped);
+}
+
+static bool is_supported(audio::format const &format) {
+    auto const pcm_format = format.pcm_format();
+    return (pcm_format == pcm_format::float32 || pcm_format == pcm_format::float64) && !format.is_interleaved();
+}
+}  // namespace yas::audio::graph_mixer_utils
+
+#pragma mark - render_context
+
+class graph_mixer::render_context {
+   public:
+    struct input {
+        uint32_t const bus_idx;
+        std::optional<audio::format> const format;
+        std::shared_ptr<bus_parameters const> const parameters;
+        // 前回描画したときのチャンネルごとの音量。最初の描画までは空
+        std::vector<double> gains;
+    };
+
+    /// 入力を受けるバッファは出力と同じフォーマットの入力があるときだけ、frame_capacityの長さで確保する
+    render_context(std::vector<input> &&inputs, std::shared_ptr<bus_parameters const> const &output_parameters,
+                   std::optional<audio::format> const &output_format, uint32_t const frame_capacity)
+        : _inputs(std::move(inputs)), _output_parameters(output_parameters) {
+        if (output_format.has_value() && graph_mixer_utils::is_supported(*output_format) &&
+            std::any_of(this->_inputs.begin(), this->_inputs.end(),
+                        [&output_format](input const &input) { return input.format == *output_format; })) {
+            this->_input_buffer = std::make_unique<pcm_buffer>(*output_format, std::max(frame_capacity, uint32_t(1)));
+        }
+
+        for (auto &input : this->_inputs) {
+            input.gains.reserve(output_format.has_value() ? output_format->channel_count() : 0);
+        }
+    }
+
+    void render(node_render_args const &args) {
+        auto *const buffer = args.buffer;
+        auto const &format = buffer->format();
+
+        buffer->clear();
+
+        if (!graph_mixer_utils::is_supported(format)) {
+            return;
+        }
+
+        if (format.pcm_format() == pcm_format::float32) {
+            this->_render<float>(args);
+        } else {
+            this->_render<double>(args);
+        }
+    }
+
+   private:
+    std::vector<input> _inputs;
+    std::shared_ptr<bus_parameters const> const _output_parameters;
+    std::unique_ptr<pcm_buffer> _input_buffer = nullptr;
+
+    template <typename T>
+    void _render(node_render_args const &args) {
+        auto *const buffer = args.buffer;
+        auto const &format = buffer->format();
+        auto const frame_length = buffer->frame_length();
+        auto const ch_count = format.channel_count();
+
+        // 描画スレッドでは確保し直さず、準備したバッファに収まらなければ無音にする
+        if (!this->_input_buffer || this->_input_buffer->format() != format ||
+            this->_input_buffer->frame_capacity() < frame_length) {
+            return;
+        }
+
+        auto &input_buffer = *this->_input_buffer;
+
+        float const output_volume = this->_output_parameters->volume.load();
+        float const output_pan = this->_output_parameters->pan.load();
+
+        for (auto &input : this->_inputs) {
+            auto const iterator = args.source_connections.find(input.bus_idx);
+            if (iterator == args.source_connections.end()) {
+                continue;
+            }
+
+            auto const &connection = iterator->second;
+            if (connection.format != format) {
+                continue;
+            }
+
+            auto const &parameters = *input.parameters;
+            float const volume = parameters.enabled.load() ? parameters.volume.load() : 0.0f;
+            float const pan = parameters.pan.load();
+
+            auto target_gain = [&](uint32_t const ch_idx) {
+                return static_cast<double>(volume * graph_mixer_utils::pan_gain(pan, ch_idx, ch_count) *
+                                           output_volume * graph_mixer_utils::pan_gain(output_pan, ch_idx, ch_count));
+            };
+
+            if (input.gains.size() != ch_count) {
+                input.gains.resize(ch_count);
+                for (uint32_t ch_idx = 0; ch_idx < ch_count; ++ch_idx) {
+                    input.gains[ch_idx] = target_gain(ch_idx);
+                }
+            }
+
+            bool is_silent = true;
+            for (uint32_t ch_idx = 0; ch_idx < ch_count; ++ch_idx) {
+                if (input.gains[ch_idx] != 0.0 || target_gain(ch_idx) != 0.0) {
+                    is_silent = false;
+                    break;
+                }
+            }
+
+            // 無効なバスや音量が0のままのバスは描画しない
+            if (is_silent) {
+                continue;
+            }
+
+            input_buffer.set_frame_length(frame_length);
+
+            if (!connection.render(&input_buffer, args.time)) {
+                continue;
+            }
+
+            for (uint32_t ch_idx = 0; ch_idx < ch_count; ++ch_idx) {
+                auto const target = target_gain(ch_idx);
+                mix::add_ramped<T>(buffer->data_ptr_at_index<T>(ch_idx), input_buffer.data_ptr_at_index<T>(ch_idx),
+                                   frame_length, static_cast<T>(input.gains[ch_idx]), static_cast<T>(target));
+                input.gains[ch_idx] = target;
+            }
+        }
+    }
+};
+
+#pragma mark - graph_mixer
+
+graph_mixer::graph_mixer()
+    : node(graph_node::make_shared(
+          {.input_bus_count = std::numeric_limits<uint32_t>::max(), .output_bus_count = 1})),
+      _output_parameters(std::make_shared<bus_parameters>()) {
+    auto const manageable_node = manageable_graph_node::cast(this->node);
+
+    manageable_node->set_prepare_rendering_handler([this] {
+        std::vector<render_context::input> inputs;
+
+        for (auto const &pair : this->node->input_connections()) {
+            if (pair.second.expired()) {
+                continue;
+            }
+
+            inputs.emplace_back(render_context::input{.bus_idx = pair.first,
+                                                      .format = this->node->input_format(pair.first),
+                                                      .parameters = this->_input_parameters_at(pair.first)});
+        }
+
+        auto const context =
+            std::make_shared<render_context>(std::move(inputs), this->_output_parameters, this->node->output_format(0),
+                                             this->node->maximum_frames_per_slice());
+
+        this->node->set_render_handler([context](node_render_args const &args) { context->render(args); });
+    });
+}
+
+void graph_mixer::set_output_volume(float const volume, uint32_t const bus_idx) {
+    this->_output_parameters_at(bus_idx).volume = volume;
+}
+
+float graph_mixer::output_volume(uint32_t const bus_idx) const {
+    return this->_output_parameters_at(bus_idx).volume;
+}
+
+void graph_mixer::set_output_pan(float const pan, uint32_t const bus_idx) {
+    this->_output_parameters_at(bus_idx).pan = pan;
+}
+
+float graph_mixer::output_pan(uint32_t const bus_idx) const {
+    return this->_output_parameters_at(bus_idx).pan;
+}
+
+void graph_mixer::set_input_volume(float const volume, uint32_t const bus_idx) {
+    this->_input_parameters_at(bus_idx)->volume = volume;
+}
+
+float graph_mixer::input_volume(uint32_t const bus_idx) const {
+    auto const *parameters = this->_input_parameters_if_exists(bus_idx);
+    return parameters ? parameters->volume.load() : 1.0f;
+}
+
+void graph_mixer::set_input_pan(float const pan, uint32_t const bus_idx) {
+    this->_input_parameters_at(bus_idx)->pan = pan;
+}
+
+float graph_mixer::input_pan(uint32_t const bus_idx) const {
+    auto const *parameters = this->_input_parameters_if_exists(bus_idx);
+    return parameters ? parameters->pan.load() : 0.0f;
+}
+
+void graph_mixer::set_input_enabled(bool const enabled, uint32_t const bus_idx) {
+    this->_input_parameters_at(bus_idx)->enabled = enabled;
+}
+
+bool graph_mixer::input_enabled(uint32_t const bus_idx) const {
+    auto const *parameters = this->_input_parameters_if_exists(bus_idx);
+    return parameters ? parameters->enabled.load() : true;
+}
+
+std::shared_ptr<graph_mixer::bus_parameters> const &graph_mixer::_input_parameters_at(uint32_t const bus_idx) {
+    auto iterator = this->_input_parameters.find(bus_idx);
+    if (iterator == this->_input_parameters.end()) {
+        iterator = this->_input_parameters.emplace(bus_idx, std::make_shared<bus_parameters>()).first;
+    }
+    return iterator->second;
+}
+
+graph_mixer::bus_parameters const *graph_mixer::_input_parameters_if_exists(uint32_t const bus_idx) const {
+    auto const iterator = this->_input_parameters.find(bus_idx);
+    return iterator != this->_input_parameters.end() ? iterator->second.get() : nullptr;
+}
+
+graph_mixer::bus_parameters &graph_mixer::_output_parameters_at(uint32_t const bus_idx) const {
+    if (bus_idx != 0) {
+        throw std::out_of_range(std::string(__PRETTY_FUNCTION__) + " : out of range. bus_idx(" +
+                                std::to_string(bus_idx) + ")");
+    }
+    return *this->_output_parameters;
+}
+
+graph_mixer_ptr graph_mixer::make_shared() {
+    return graph_mixer_ptr(new graph_mixer{});
+}
@@ -0,0 +1,59 @@
+//
+//  graph_mixer.h
+//
+
+#pragma once
+
+#include <audio-engine/graph/graph_node.h>
+
+#include <atomic>
+#include <map>
+
+namespace yas::audio {
+/// AudioUnitを使わずに入力のバスを足し合わせるミキサー
+/// float32とfloat64のインターリーブされていないフォーマットで、入力と出力のフォーマットが同じものを扱う
+/// 音量とパンを変更すると、次に描画するスライスの間で直線的に変化させる
+struct graph_mixer final {
+    /// 出力のバスは0だけ
+    void set_output_volume(float const volume, uint32_t const bus_idx);
+    [[nodiscard]] float output_volume(uint32_t const bus_idx) const;
+    void set_output_pan(float const pan, uint32_t const bus_idx);
+    [[nodiscard]] float output_pan(uint32_t const bus_idx) const;
+
+    void set_input_volume(float const volume, uint32_t const bus_idx);
+    [[nodiscard]] float input_volume(uint32_t const bus_idx) const;
+    void set_input_pan(float const pan, uint32_t const bus_idx);
+    [[nodiscard]] float input_pan(uint32_t const bus_idx) const;
+
+    void set_input_enabled(bool const enabled, uint32_t const bus_idx);
+    [[nodiscard]] bool input_enabled(uint32_t const bus_idx) const;
+
+    graph_node_ptr const node;
+
+    [[nodiscard]] static graph_mixer_ptr make_shared();
+
+   private:
+    struct bus_parameters {
+        std::atomic<float> volume{1.0f};
+        std::atomic<float> pan{0.0f};
+        std::atomic<bool> enabled{true};
+    };
+
+    class render_context;
+
+    // レンダリングスレッドからも参照するのでバスごとにshared_ptrで持つ
+    std::map<uint32_t, std::shared_ptr<bus_parameters>> _input_parameters;
+    std::shared_ptr<bus_parameters> const _output_parameters;
+
+    graph_mixer();
+
+    std::shared_ptr<bus_parameters> const &_input_parameters_at(uint32_t const bus_idx);
+    bus_parameters const *_input_parameters_if_exists(uint32_t const bus_idx) const;
+    bus_parameters &_output_parameters_at(uint32_t const bus_idx) const;
+
+    graph_mixer(graph_mixer const &) = delete;
+    graph_mixer(graph_mixer &&) = delete;
+    graph_mixer &operator=(graph_mixer const &) = delete;
+    graph_mixer &operator=(graph_mixer &&) = delete;
+};
+}  // namespace yas::audio
@@ -199,7 +199,13 @@ graph_node_f const &graph_node::teardown_handler() const {
     return this->_teardown_handler;
 }
 
-void graph_node::prepare_rendering() {
+uint32_t graph_node::maximum_frames_per_slice() const {
+    return this->_maximum_frames_per_slice;
+}
+
+void graph_node::prepare_rendering(uint32_t const maximum_frames) {
+    this->_maximum_frames_per_slice = maximum_frames;
+
     if (this->_prepare_rendering_handler) {
         this->_prepare_rendering_handler();
     }
@@ -45,6 +45,9 @@ struct graph_node : connectable_graph_node, manageable_graph_node, renderable_gr
     void set_render_handler(node_render_f);
     [[nodiscard]] node_render_f const render_handler() const override;
 
+    /// 最後のprepare_renderingで渡された、1回の描画で来る最大のフレーム数
+    [[nodiscard]] uint32_t maximum_frames_per_slice() const;
+
     static graph_node_ptr make_shared(graph_node_args);
 
    private:
@@ -53,6 +56,7 @@ struct graph_node : connectable_graph_node, manageable_graph_node, renderable_gr
     uint32_t _output_bus_count = 0;
     bool _is_input_renderable = false;
     std::optional<uint32_t> _override_output_bus_idx = std::nullopt;
+    uint32_t _maximum_frames_per_slice = 0;
     audio::graph_connection_wmap _input_connections;
     audio::graph_connection_wmap _output_connections;
     graph_node_f _setup_handler;
@@ -76,7 +80,7 @@ struct graph_node : connectable_graph_node, manageable_graph_node, renderable_gr
     void set_will_reset_handler(graph_node_f &&) override;
     graph_node_f const &setup_handler() const override;
     graph_node_f const &teardown_handler() const override;
-    void prepare_rendering() override;
+    void prepare_rendering(uint32_t const maximum_frames) override;
     void update_rendering() override;
 
     graph_node(graph_node &&) = delete;
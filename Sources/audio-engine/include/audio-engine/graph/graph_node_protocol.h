@@ -56,7 +56,7 @@ struct manageable_graph_node {
 };
 
 struct renderable_graph_node {
-    virtual void prepare_rendering() = 0;
+    virtual void prepare_rendering(uint32_t const maximum_frames) = 0;
     virtual void update_rendering() = 0;
     virtual graph_connection_wmap const &input_connections() const = 0;
     virtual graph_connection_wmap const &output_connections() const = 0;
@@ -0,0 +1,123 @@
+//
+//  graph_oscillator_bank.cpp
+//
+
+#include "graph_oscillator_bank.h"
+
+#include <audio-engine/rendering/rendering_connection.h>
+
+using namespace yas;
+using namespace yas::audio;
+
+namespace yas::audio::graph_oscillator_bank_utils {
+static bool is_supported(audio::format const &format) {
+    auto const pcm_format = format.pcm_format();
+    return (pcm_format == pcm_format::float32 || pcm_format == pcm_format::float64) && !format.is_interleaved() &&
+           format.sample_rate() > 0.0;
+}
+
+template <typename T>
+struct kernel {
+    audio::oscillator_bank<T> bank;
+    std::vector<T *> output_ptrs;
+
+    kernel(audio::format const &format, std::vector<oscillator_voice> const &voices, std::vector<double> const &table)
+        : bank(format.sample_rate(), format.channel_count()), output_ptrs(format.channel_count(), nullptr) {
+        for (auto const &voice : voices) {
+            if (voice.channel < format.channel_count()) {
+                this->bank.add_voice(voice);
+            }
+        }
+
+        this->bank.set_table(std::vector<T>(table.begin(), table.end()));
+    }
+};
+}  // namespace yas::audio::graph_oscillator_bank_utils
+
+#pragma mark - render_context
+
+class graph_oscillator_bank::render_context {
+   public:
+    render_context(std::optional<audio::format> const &output_format, std::vector<oscillator_voice> const &voices,
+                   std::vector<double> const &table) {
+        if (!output_format.has_value() || !graph_oscillator_bank_utils::is_supported(*output_format)) {
+            return;
+        }
+
+        this->_output_format = *output_format;
+
+        if (output_format->pcm_format() == pcm_format::float32) {
+            this->_float32_kernel =
+                std::make_unique<graph_oscillator_bank_utils::kernel<float>>(*output_format, voices, table);
+        } else {
+            this->_float64_kernel =
+                std::make_unique<graph_oscillator_bank_utils::kernel<double>>(*output_format, voices, table);
+        }
+    }
+
+    void render(node_render_args const &args) {
+        auto *const buffer = args.buffer;
+
+        if (!this->_output_format.has_value() || buffer->format() != *this->_output_format) {
+            buffer->clear();
+        } else if (this->_float32_kernel) {
+            this->_render(*this->_float32_kernel, buffer);
+        } else if (this->_float64_kernel) {
+            this->_render(*this->_float64_kernel, buffer);
+        } else {
+            buffer->clear();
+        }
+    }
+
+   private:
+    std::optional<audio::format> _output_format = std::nullopt;
+    std::unique_ptr<graph_oscillator_bank_utils::kernel<float>> _float32_kernel = nullptr;
+    std::unique_ptr<graph_oscillator_bank_utils::kernel<double>> _float64_kernel = nullptr;
+
+    template <typename T>
+    void _render(graph_oscillator_bank_utils::kernel<T> &kernel, pcm_buffer *const buffer) {
+        for (uint32_t ch_idx = 0; ch_idx < kernel.bank.channel_count(); ++ch_idx) {
+            kernel.output_ptrs[ch_idx] = buffer->data_ptr_at_index<T>(ch_idx);
+        }
+
+        kernel.bank.render(kernel.output_ptrs.data(), buffer->frame_length());
+    }
+};
+
+#pragma mark - graph_oscillator_bank
+
+graph_oscillator_bank::graph_oscillator_bank()
+    : node(graph_node::make_shared({.input_bus_count = 0, .output_bus_count = 1})) {
+    auto const manageable_node = manageable_graph_node::cast(this->node);
+
+    manageable_node->set_prepare_rendering_handler([this] {
+        auto const context =
+            std::make_shared<render_context>(this->node->output_format(0), this->_voices, this->_table);
+
+        this->node->set_render_handler([context](node_render_args const &args) { context->render(args); });
+    });
+}
+
+void graph_oscillator_bank::set_voices(std::vector<oscillator_voice> voices) {
+    this->_voices = std::move(voices);
+
+    renderable_graph_node::cast(this->node)->update_rendering();
+}
+
+std::vector<oscillator_voice> const &graph_oscillator_bank::voices() const {
+    return this->_voices;
+}
+
+void graph_oscillator_bank::set_table(std::vector<double> table) {
+    this->_table = std::move(table);
+
+    renderable_graph_node::cast(this->node)->update_rendering();
+}
+
+std::vector<double> const &graph_oscillator_bank::table() const {
+    return this->_table;
+}
+
+graph_oscillator_bank_ptr graph_oscillator_bank::make_shared() {
+    return graph_oscillator_bank_ptr(new graph_oscillator_bank{});
+}
@@ -0,0 +1,40 @@
+//
+//  graph_oscillator_bank.h
+//
+
+#pragma once
+
+#include <audio-engine/graph/graph_node.h>
+#include <audio-engine/utils/oscillator_bank.h>
+
+namespace yas::audio {
+/// oscillator_bankで発振器の和を出力するノード
+/// 出力はfloat32とfloat64のインターリーブされていないフォーマットを扱い、それ以外は0で埋める
+struct graph_oscillator_bank final {
+    /// 次に描画の準備をしたときから反映され、位置はvoiceのphaseに戻る
+    /// 出力のチャンネル数を超えるchannelの発振器は使わない
+    void set_voices(std::vector<oscillator_voice>);
+    [[nodiscard]] std::vector<oscillator_voice> const &voices() const;
+
+    /// tableの発振器が読む1周期分の波形。次に描画の準備をしたときから反映される
+    void set_table(std::vector<double>);
+    [[nodiscard]] std::vector<double> const &table() const;
+
+    graph_node_ptr const node;
+
+    [[nodiscard]] static graph_oscillator_bank_ptr make_shared();
+
+   private:
+    class render_context;
+
+    std::vector<oscillator_voice> _voices;
+    std::vector<double> _table;
+
+    graph_oscillator_bank();
+
+    graph_oscillator_bank(graph_oscillator_bank const &) = delete;
+    graph_oscillator_bank(graph_oscillator_bank &&) = delete;
+    graph_oscillator_bank &operator=(graph_oscillator_bank const &) = delete;
+    graph_oscillator_bank &operator=(graph_oscillator_bank &&) = delete;
+};
+}  // namespace yas::audio
@@ -0,0 +1,234 @@
+//
+//  graph_resampler.cpp
+//
+
+#include "graph_resampler.h"
+
+#include <audio-engine/common/time.h>
+#include <audio-engine/rendering/rendering_connection.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace yas;
+using namespace yas::audio;
+
+namespace yas::audio::graph_resampler_utils {
+static bool is_supported(audio::format const &input_format, audio::format const &output_format) {
+    auto const pcm_format = input_format.pcm_format();
+    return (pcm_format == pcm_format::float32 || pcm_format == pcm_format::float64) &&
+           pcm_format == output_format.pcm_format() && !input_format.is_interleaved() &&
+           !output_format.is_interleaved() && input_format.channel_count() == output_format.channel_count() &&
+           input_format.sample_rate() > 0.0 && output_format.sample_rate() > 0.0;
+}
+
+template <typename T>
+struct kernel {
+    audio::resampler<T> resampler;
+    std::vector<T const *> input_ptrs;
+    std::vector<T *> output_ptrs;
+
+    kernel(audio::format const &input_format, audio::format const &output_format, resampler_quality const quality,
+           uint32_t const maximum_frames)
+        : resampler(input_format.sample_rate(), output_format.sample_rate(), input_format.channel_count(), quality,
+                    maximum_frames),
+          input_ptrs(input_format.channel_count(), nullptr),
+          output_ptrs(input_format.channel_count(), nullptr) {
+    }
+};
+}  // namespace yas::audio::graph_resampler_utils
+
+#pragma mark - render_context
+
+class graph_resampler::render_context {
+   public:
+    /// maximum_framesを出力するときに必要な最大の入力の長さで、入力を受けるバッファを確保しておく
+    render_context(std::optional<audio::format> const &input_format,
+                   std::optional<audio::format> const &output_format, resampler_quality const quality,
+                   uint32_t const maximum_frames) {
+        if (!input_format.has_value() || !output_format.has_value() ||
+            !graph_resampler_utils::is_supported(*input_format, *output_format)) {
+            return;
+        }
+
+        this->_output_format = *output_format;
+
+        if (input_format->sample_rate() == output_format->sample_rate()) {
+            this->_is_bypassed = true;
+            return;
+        }
+
+        auto const frame_capacity = std::max(maximum_frames, uint32_t(1));
+        std::size_t input_capacity = 0;
+
+        if (input_format->pcm_format() == pcm_format::float32) {
+            this->_float32_kernel = std::make_unique<graph_resampler_utils::kernel<float>>(
+                *input_format, *output_format, quality, frame_capacity);
+            input_capacity = this->_float32_kernel->resampler.maximum_input_length();
+        } else {
+            this->_float64_kernel = std::make_unique<graph_resampler_utils::kernel<double>>(
+                *input_format, *output_format, quality, frame_capacity);
+            input_capacity = this->_float64_kernel->resampler.maximum_input_length();
+        }
+
+        this->_input_buffer = std::make_unique<pcm_buffer>(*input_format, static_cast<uint32_t>(input_capacity));
+    }
+
+    void render(node_render_args const &args) {
+        auto *const buffer = args.buffer;
+
+        auto const iterator = args.source_connections.find(0);
+        if (!this->_output_format.has_value() || buffer->format() != *this->_output_format ||
+            iterator == args.source_connections.end()) {
+            buffer->clear();
+            return;
+        }
+
+        auto const &connection = iterator->second;
+
+        if (this->_is_bypassed) {
+            if (!connection.render(buffer, args.time)) {
+                buffer->clear();
+            }
+        } else if (this->_float32_kernel) {
+            this->_render(*this->_float32_kernel, args, connection);
+        } else if (this->_float64_kernel) {
+            this->_render(*this->_float64_kernel, args, connection);
+        } else {
+            buffer->clear();
+        }
+    }
+
+   private:
+    std::optional<audio::format> _output_format = std::nullopt;
+    bool _is_bypassed = false;
+    std::unique_ptr<pcm_buffer> _input_buffer = nullptr;
+    std::unique_ptr<graph_resampler_utils::kernel<float>> _float32_kernel = nullptr;
+    std::unique_ptr<graph_resampler_utils::kernel<double>> _float64_kernel = nullptr;
+
+    // 前回の描画から続いている出力の時間。途切れたら変換の途中の状態を捨てる
+    std::optional<int64_t> _next_output_sample_time = std::nullopt;
+    int64_t _input_sample_time = 0;
+
+    template <typename T>
+    void _render(graph_resampler_utils::kernel<T> &kernel, node_render_args const &args,
+                 rendering_connection const &connection) {
+        auto *const buffer = args.buffer;
+        auto &resampler = kernel.resampler;
+        auto const out_length = buffer->frame_length();
+
+        // 描画スレッドでは確保し直さず、準備した長さを超える描画は無音にする
+        if (resampler.maximum_frames() < out_length) {
+            buffer->clear();
+            return;
+        }
+
+        auto const input_time = this->_input_time(args.time, out_length, resampler);
+        auto const in_length = static_cast<uint32_t>(resampler.input_length_for_output(out_length));
+
+        if (this->_input_buffer->frame_capacity() < in_length) {
+            buffer->clear();
+            return;
+        }
+
+        auto &input_buffer = *this->_input_buffer;
+        input_buffer.set_frame_length(in_length);
+
+        if (in_length > 0 && !connection.render(&input_buffer, input_time)) {
+            input_buffer.clear();
+        }
+
+        for (uint32_t ch_idx = 0; ch_idx < resampler.channel_count(); ++ch_idx) {
+            kernel.input_ptrs[ch_idx] = input_buffer.data_ptr_at_index<T>(ch_idx);
+            kernel.output_ptrs[ch_idx] = buffer->data_ptr_at_index<T>(ch_idx);
+        }
+
+        resampler.process(kernel.input_ptrs.data(), in_length, kernel.output_ptrs.data(), out_length);
+
+        this->_input_sample_time += in_length;
+    }
+
+    template <typename T>
+    audio::time _input_time(audio::time const &output_time, uint32_t const out_length,
+                            audio::resampler<T> &resampler) {
+        if (!output_time.is_sample_time_valid()) {
+            return output_time;
+        }
+
+        auto const output_sample_time = output_time.sample_time();
+
+        if (this->_next_output_sample_time != output_sample_time) {
+            if (this->_next_output_sample_time.has_value()) {
+                resampler.reset();
+            }
+            this->_input_sample_time = std::llround(static_cast<double>(output_sample_time) *
+                                                    resampler.input_sample_rate() / resampler.output_sample_rate());
+        }
+
+        this->_next_output_sample_time = output_sample_time + out_length;
+
+        if (output_time.is_host_time_valid()) {
+            return audio::time{output_time.host_time(), this->_input_sample_time, resampler.input_sample_rate()};
+        } else {
+            return audio::time{this->_input_sample_time, resampler.input_sample_rate()};
+        }
+    }
+};
+
+#pragma mark - graph_resampler
+
+graph_resampler::graph_resampler(resampler_quality const quality)
+    : node(graph_node::make_shared({.input_bus_count = 1, .output_bus_count = 1})), _quality(quality) {
+    auto const manageable_node = manageable_graph_node::cast(this->node);
+
+    manageable_node->set_prepare_rendering_handler([this] {
+        auto const context =
+            std::make_shared<render_context>(this->node->input_format(0), this->node->output_format(0), this->_quality,
+                                             this->node->maximum_frames_per_slice());
+
+        this->node->set_render_handler([context](node_render_args const &args) { context->render(args); });
+    });
+}
+
+void graph_resampler::set_quality(resampler_quality const quality) {
+    if (this->_quality == quality) {
+        return;
+    }
+
+    this->_quality = quality;
+
+    renderable_graph_node::cast(this->node)->update_rendering();
+}
+
+resampler_quality graph_resampler::quality() const {
+    return this->_quality;
+}
+
+double graph_resampler::latency_frames() const {
+    auto const input_format = this->node->input_format(0);
+    auto const output_format = this->node->output_format(0);
+
+    if (!input_format.has_value() || !output_format.has_value() ||
+        !graph_resampler_utils::is_supported(*input_format, *output_format) ||
+        input_format->sample_rate() == output_format->sample_rate()) {
+        return 0.0;
+    }
+
+    return resampler_latency_frames(input_format->sample_rate(), output_format->sample_rate(), this->_quality);
+}
+
+double graph_resampler::latency_seconds() const {
+    if (auto const output_format = this->node->output_format(0)) {
+        return this->latency_frames() / output_format->sample_rate();
+    }
+    return 0.0;
+}
+
+graph_resampler_ptr graph_resampler::make_shared() {
+    return make_shared(resampler_quality::high);
+}
+
+graph_resampler_ptr graph_resampler::make_shared(resampler_quality const quality) {
+    return graph_resampler_ptr(new graph_resampler{quality});
+}
@@ -0,0 +1,40 @@
+//
+//  graph_resampler.h
+//
+
+#pragma once
+
+#include <audio-engine/graph/graph_node.h>
+#include <audio-engine/utils/resampler.h>
+
+namespace yas::audio {
+/// AudioUnitを使わずにサンプルレートを変換するノード
+/// 入力と出力はサンプルレートだけが異なる、float32とfloat64のインターリーブされていないフォーマットを扱う
+/// サンプルレートが同じなら変換せずにそのまま渡す
+struct graph_resampler final {
+    /// 次に描画の準備をしたときから反映される
+    void set_quality(resampler_quality const);
+    [[nodiscard]] resampler_quality quality() const;
+
+    /// 接続されているフォーマットでの遅れを出力のフレーム数で返す。変換しなければ0
+    [[nodiscard]] double latency_frames() const;
+    [[nodiscard]] double latency_seconds() const;
+
+    graph_node_ptr const node;
+
+    [[nodiscard]] static graph_resampler_ptr make_shared();
+    [[nodiscard]] static graph_resampler_ptr make_shared(resampler_quality const);
+
+   private:
+    class render_context;
+
+    resampler_quality _quality;
+
+    explicit graph_resampler(resampler_quality const);
+
+    graph_resampler(graph_resampler const &) = delete;
+    graph_resampler(graph_resampler &&) = delete;
+    graph_resampler &operator=(graph_resampler const &) = delete;
+    graph_resampler &operator=(graph_resampler &&) = delete;
+};
+}  // namespace yas::audio
@@ -6,12 +6,147 @@
 
 #include <audio-engine/graph/graph_node.h>
 #include <audio-engine/rendering/rendering_connection.h>
-#include <cpp-utils/result.h>
 #include <cpp-utils/stl_utils.h>
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
 using namespace yas;
 using namespace yas::audio;
 
+namespace yas::audio::graph_route_utils {
+static uint32_t constexpr unmapped_channel = static_cast<uint32_t>(-1);
+
+static bool is_supported(audio::format const &format) {
+    return !format.is_interleaved();
+}
+
+static audio::time offset_time(audio::time const &time, uint32_t const frames) {
+    if (!time.is_sample_time_valid()) {
+        return time;
+    }
+
+    int64_t const sample_time = time.sample_time() + frames;
+
+    if (time.is_host_time_valid()) {
+        return audio::time{time.host_time(), sample_time, time.sample_rate()};
+    } else {
+        return audio::time{sample_time, time.sample_rate()};
+    }
+}
+}  // namespace yas::audio::graph_route_utils
+
+#pragma mark - render_context
+
+/// ルートから求めたチャンネルマップと、出力のバッファを入力側から見るためのバッファをあらかじめ作っておく
+class graph_route::render_context {
+   public:
+    struct path {
+        uint32_t src_bus_idx;
+        uint32_t dst_bus_idx;
+        audio::format src_format;
+        audio::format dst_format;
+        channel_map_t channel_map;
+
+        abl_uptr abl = nullptr;
+        std::unique_ptr<pcm_buffer> view = nullptr;
+    };
+
+    render_context(std::vector<path> &&paths, uint32_t const frame_capacity) : _paths(std::move(paths)) {
+        // 描画時に出力のバスで探せるように並べておく
+        std::sort(this->_paths.begin(), this->_paths.end(), [](path const &lhs, path const &rhs) {
+            return std::tie(lhs.dst_bus_idx, lhs.src_bus_idx) < std::tie(rhs.dst_bus_idx, rhs.src_bus_idx);
+        });
+
+        this->_reserve(std::max(frame_capacity, uint32_t(1)));
+    }
+
+    void render(node_render_args const &args) {
+        auto *const dst_buffer = args.buffer;
+        auto const frame_length = dst_buffer->frame_length();
+
+        auto const dst_bus_idx = args.bus_idx;
+        auto const begin = std::lower_bound(this->_paths.begin(), this->_paths.end(), dst_bus_idx,
+                                            [](path const &path, uint32_t const bus_idx) {
+                                                return path.dst_bus_idx < bus_idx;
+                                            });
+
+        AudioBufferList const *const dst_abl = dst_buffer->audio_buffer_list();
+
+        for (auto iterator = begin; iterator != this->_paths.end() && iterator->dst_bus_idx == dst_bus_idx;
+             ++iterator) {
+            auto &path = *iterator;
+
+            if (dst_buffer->format() != path.dst_format) {
+                continue;
+            }
+
+            auto const connection_iterator = args.source_connections.find(path.src_bus_idx);
+            if (connection_iterator == args.source_connections.end()) {
+                continue;
+            }
+
+            auto const &src_connection = connection_iterator->second;
+            if (!src_connection.source_node) {
+                continue;
+            }
+
+            AudioBufferList *const src_abl = path.abl.get();
+            uint32_t const bytes_per_frame = path.dst_format.stream_description().mBytesPerFrame;
+
+            // 描画スレッドでは確保し直さず、確保した長さを超えるスライスは分けて描画する
+            for (uint32_t frm_idx = 0; frm_idx < frame_length; frm_idx += this->_frame_capacity) {
+                uint32_t const length = std::min(frame_length - frm_idx, this->_frame_capacity);
+                uint32_t src_ch_idx = 0;
+
+                for (auto const &dst_ch_idx : path.channel_map) {
+                    src_abl->mBuffers[src_ch_idx].mData =
+                        (dst_ch_idx == graph_route_utils::unmapped_channel) ?
+                            this->_unmapped_data.data() :
+                            static_cast<uint8_t *>(dst_abl->mBuffers[dst_ch_idx].mData) + frm_idx * bytes_per_frame;
+                    ++src_ch_idx;
+                }
+
+                path.view->set_frame_length(length);
+
+                src_connection.render(path.view.get(), graph_route_utils::offset_time(args.time, frm_idx));
+            }
+        }
+    }
+
+   private:
+    std::vector<path> _paths;
+    // 出力先のないチャンネルの書き込み先。すべてのpathで共有する
+    std::vector<uint8_t> _unmapped_data;
+    uint32_t _frame_capacity = 0;
+
+    void _reserve(uint32_t const frame_capacity) {
+        uint32_t max_bytes_per_frame = 0;
+        for (auto const &path : this->_paths) {
+            max_bytes_per_frame = std::max(max_bytes_per_frame, path.src_format.stream_description().mBytesPerFrame);
+        }
+
+        this->_frame_capacity = frame_capacity;
+        this->_unmapped_data.resize(static_cast<std::size_t>(frame_capacity) * max_bytes_per_frame);
+
+        for (auto &path : this->_paths) {
+            uint32_t const byte_size = frame_capacity * path.src_format.stream_description().mBytesPerFrame;
+
+            path.abl = allocate_audio_buffer_list(path.src_format.buffer_count(), path.src_format.stride(), 0).first;
+
+            for (uint32_t buf_idx = 0; buf_idx < path.abl->mNumberBuffers; ++buf_idx) {
+                path.abl->mBuffers[buf_idx].mData = this->_unmapped_data.data();
+                path.abl->mBuffers[buf_idx].mDataByteSize = byte_size;
+            }
+
+            path.view = std::make_unique<pcm_buffer>(path.src_format, path.abl.get());
+        }
+    }
+};
+
 #pragma mark - main
 
 graph_route::graph_route()
@@ -20,26 +155,56 @@ graph_route::graph_route()
     auto const manageable_node = manageable_graph_node::cast(this->node);
 
     manageable_node->set_prepare_rendering_handler([this] {
-        this->node->set_render_handler([routes = this->_routes](node_render_args const &args) {
-            auto &dst_buffer = args.buffer;
-            auto const dst_bus_idx = args.bus_idx;
-            uint32_t const dst_ch_count = dst_buffer->format().channel_count();
-
-            for (auto const &pair : args.source_connections) {
-                auto const &src_connection = pair.second;
-                if (auto const *node = src_connection.source_node) {
-                    auto const &src_format = src_connection.format;
-                    auto const &src_bus_idx = pair.first;
-                    uint32_t const src_ch_count = src_format.channel_count();
-                    if (auto const result =
-                            channel_map_from_routes(routes, src_bus_idx, src_ch_count, dst_bus_idx, dst_ch_count)) {
-                        pcm_buffer src_buffer(src_format, *dst_buffer, result.value());
-
-                        src_connection.render(&src_buffer, args.time);
-                    }
-                }
+        // ルートを一度だけ走査して、つながっている入出力のバスの組み合わせごとにチャンネルマップを作る
+        std::map<std::pair<uint32_t, uint32_t>, channel_map_t> channel_maps;
+
+        for (auto const &route : this->_routes) {
+            auto const src_format = this->node->input_format(route.source.bus);
+            auto const dst_format = this->node->output_format(route.destination.bus);
+
+            if (!src_format.has_value() || !dst_format.has_value()) {
+                continue;
             }
-        });
+
+            if (route.source.channel >= src_format->channel_count() ||
+                route.destination.channel >= dst_format->channel_count()) {
+                continue;
+            }
+
+            auto iterator = channel_maps.find({route.source.bus, route.destination.bus});
+            if (iterator == channel_maps.end()) {
+                iterator = channel_maps
+                               .emplace(std::make_pair(route.source.bus, route.destination.bus),
+                                        channel_map_t(src_format->channel_count(), graph_route_utils::unmapped_channel))
+                               .first;
+            }
+
+            iterator->second.at(route.source.channel) = route.destination.channel;
+        }
+
+        std::vector<render_context::path> paths;
+        paths.reserve(channel_maps.size());
+
+        for (auto &pair : channel_maps) {
+            auto const &[src_bus_idx, dst_bus_idx] = pair.first;
+            auto const src_format = *this->node->input_format(src_bus_idx);
+            auto const dst_format = *this->node->output_format(dst_bus_idx);
+
+            if (!graph_route_utils::is_supported(src_format) || !graph_route_utils::is_supported(dst_format) ||
+                src_format.pcm_format() != dst_format.pcm_format()) {
+                continue;
+            }
+
+            paths.emplace_back(render_context::path{.src_bus_idx = src_bus_idx,
+                                                    .dst_bus_idx = dst_bus_idx,
+                                                    .src_format = src_format,
+                                                    .dst_format = dst_format,
+                                                    .channel_map = std::move(pair.second)});
+        }
+
+        auto const context = std::make_shared<render_context>(std::move(paths), this->node->maximum_frames_per_slice());
+
+        this->node->set_render_handler([context](node_render_args const &args) { context->render(args); });
     });
 
     manageable_node->set_will_reset_handler([this] { this->_will_reset(); });
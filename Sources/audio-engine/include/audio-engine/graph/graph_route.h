@@ -24,6 +24,8 @@ struct graph_route final {
     [[nodiscard]] static graph_route_ptr make_shared();
 
    private:
+    class render_context;
+
     route_set_t _routes;
 
     graph_route();
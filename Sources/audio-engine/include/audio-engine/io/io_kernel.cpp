@@ -4,14 +4,28 @@
 
 #include "io_kernel.h"
 
+#include <audio-engine/pcm_buffer/pcm_buffer_allocator.h>
+
 using namespace yas;
 using namespace yas::audio;
 
+namespace yas::audio::io_kernel_utils {
+static pcm_buffer_ptr make_buffer(std::optional<format> const &format, uint32_t const frame_capacity) {
+    if (!format.has_value()) {
+        return nullptr;
+    }
+
+    // デバイスの変更で作り直されることがあるので、解放した領域を使い回す
+    return std::make_shared<pcm_buffer>(*format, frame_capacity,
+                                        pcm_buffer::allocation_options{.allocator = pcm_buffer_pool::shared()});
+}
+}  // namespace yas::audio::io_kernel_utils
+
 io_kernel::io_kernel(io_render_f const &render_handler, std::optional<format> const &input_format,
                      std::optional<format> const &output_format, uint32_t const frame_capacity)
     : render_handler(render_handler),
-      input_buffer(input_format ? std::make_shared<pcm_buffer>(*input_format, frame_capacity) : nullptr),
-      output_buffer(output_format ? std::make_shared<pcm_buffer>(*output_format, frame_capacity) : nullptr) {
+      input_buffer(io_kernel_utils::make_buffer(input_format, frame_capacity)),
+      output_buffer(io_kernel_utils::make_buffer(output_format, frame_capacity)) {
 }
 
 void io_kernel::reset_buffers() {
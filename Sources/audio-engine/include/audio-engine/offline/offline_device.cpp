@@ -9,8 +9,16 @@
 using namespace yas;
 using namespace yas::audio;
 
-offline_device::offline_device(format const &output_format, offline_render_f &&render_handler)
-    : _output_format(output_format), _render_handler(std::move(render_handler)) {
+double offline_render_stats::frames_per_second() const {
+    if (this->elapsed_seconds <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(this->consumed_frames) / this->elapsed_seconds;
+}
+
+offline_device::offline_device(format const &output_format, offline_render_f &&render_handler,
+                               std::optional<offline_pipeline_args> &&pipeline)
+    : _output_format(output_format), _render_handler(std::move(render_handler)), _pipeline(std::move(pipeline)) {
 }
 
 std::optional<format> offline_device::input_format() const {
@@ -42,6 +50,10 @@ std::optional<offline_completion_f> offline_device::completion_handler() const {
     return this->_completion_handler;
 }
 
+std::optional<offline_pipeline_args> const &offline_device::pipeline() const {
+    return this->_pipeline;
+}
+
 void offline_device::_prepare(offline_device_ptr const &device, offline_completion_f &&completion_handler) {
     this->_weak_device = device;
 
@@ -61,7 +73,16 @@ void offline_device::_prepare(offline_device_ptr const &device, offline_completi
 
 offline_device_ptr offline_device::make_shared(format const &output_format, offline_render_f &&render_handler,
                                                offline_completion_f &&completion_handler) {
-    auto shared = offline_device_ptr{new offline_device{output_format, std::move(render_handler)}};
+    auto shared = offline_device_ptr{new offline_device{output_format, std::move(render_handler), std::nullopt}};
+    shared->_prepare(shared, std::move(completion_handler));
+    return shared;
+}
+
+offline_device_ptr offline_device::make_shared(format const &output_format, offline_render_f &&render_handler,
+                                               offline_completion_f &&completion_handler,
+                                               offline_pipeline_args &&pipeline) {
+    auto shared =
+        offline_device_ptr{new offline_device{output_format, std::move(render_handler), std::move(pipeline)}};
     shared->_prepare(shared, std::move(completion_handler));
     return shared;
 }
@@ -15,6 +15,35 @@ struct offline_render_args {
 using offline_render_f = std::function<continuation(offline_render_args)>;
 using offline_completion_f = std::function<void(bool const cancelled)>;
 
+struct offline_render_stats {
+    /// キューに描画したフレーム数
+    uint64_t rendered_frames = 0;
+    /// render_handlerに渡したフレーム数
+    uint64_t consumed_frames = 0;
+    /// 開始してから終わるまでの時間
+    double elapsed_seconds = 0.0;
+    /// グラフの描画にかかった時間の合計
+    double rendering_seconds = 0.0;
+    /// render_handlerにかかった時間の合計
+    double consuming_seconds = 0.0;
+    /// キューが埋まっていて描画を待った回数
+    uint64_t render_wait_count = 0;
+    /// キューが空でrender_handlerの呼び出しを待った回数
+    uint64_t consume_wait_count = 0;
+
+    [[nodiscard]] double frames_per_second() const;
+};
+
+using offline_stats_f = std::function<void(offline_render_stats const &)>;
+
+/// 描画とrender_handlerの呼び出しを別のスレッドで行う場合の設定
+struct offline_pipeline_args {
+    /// 描画済みのバッファを溜めておける数。埋まったら描画を待つ
+    uint32_t buffer_count = 4;
+    /// 終了時にcompletionの前にメインスレッドで呼ばれる
+    std::optional<offline_stats_f> stats_handler = std::nullopt;
+};
+
 struct offline_device : io_device {
     [[nodiscard]] std::optional<audio::format> input_format() const override;
     [[nodiscard]] std::optional<audio::format> output_format() const override;
@@ -27,19 +56,24 @@ struct offline_device : io_device {
 
     [[nodiscard]] offline_render_f render_handler() const;
     [[nodiscard]] std::optional<offline_completion_f> completion_handler() const;
+    [[nodiscard]] std::optional<offline_pipeline_args> const &pipeline() const;
 
     static offline_device_ptr make_shared(audio::format const &output_format, offline_render_f &&,
                                           offline_completion_f &&);
+    /// 描画したバッファをキューに溜め、render_handlerは別のスレッドから呼ぶ
+    static offline_device_ptr make_shared(audio::format const &output_format, offline_render_f &&,
+                                          offline_completion_f &&, offline_pipeline_args &&);
 
    private:
     std::weak_ptr<offline_device> _weak_device;
     audio::format const _output_format;
     offline_render_f _render_handler;
     std::optional<offline_completion_f> _completion_handler;
+    std::optional<offline_pipeline_args> const _pipeline;
 
     observing::notifier_ptr<io_device::method> const _notifier = observing::notifier<io_device::method>::make_shared();
 
-    offline_device(audio::format const &output_format, offline_render_f &&);
+    offline_device(audio::format const &output_format, offline_render_f &&, std::optional<offline_pipeline_args> &&);
 
     void _prepare(offline_device_ptr const &, offline_completion_f &&);
 };
@@ -7,6 +7,8 @@
 #include <audio-engine/io/io_core.h>
 
 namespace yas::audio {
+struct offline_pipeline_args;
+
 struct offline_io_core : io_core {
     ~offline_io_core();
 
@@ -30,5 +32,6 @@ struct offline_io_core : io_core {
     offline_io_core(offline_device_ptr const &);
 
     io_kernel_ptr _make_kernel() const;
+    void _start_pipeline(io_kernel_ptr &&, offline_pipeline_args const &);
 };
 }  // namespace yas::audio
@@ -6,16 +6,114 @@
 
 #include <audio-engine/offline/offline_device.h>
 #include <cpp-utils/thread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <future>
+#include <mutex>
+#include <vector>
 
 using namespace yas;
 using namespace yas::audio;
 
+namespace yas::audio::offline_io_core_utils {
+static double seconds_since(std::chrono::steady_clock::time_point const &begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/// 描画するスレッドとrender_handlerを呼ぶスレッドの間でバッファを受け渡す固定長のリングバッファ
+/// バッファは最初に確保しておき、描画する側と読み出す側で使い回す
+struct buffer_queue {
+    struct element {
+        pcm_buffer_ptr const buffer;
+        int64_t sample_time = 0;
+    };
+
+    buffer_queue(audio::format const &format, uint32_t const frame_capacity, uint32_t const count) {
+        this->_elements.reserve(count);
+
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            this->_elements.emplace_back(element{.buffer = std::make_shared<pcm_buffer>(format, frame_capacity)});
+        }
+    }
+
+    /// 空きができるまで待ち、次に描画するバッファを返す。止められた場合はnullptrを返す
+    element *wait_for_writable(uint64_t &wait_count) {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        if (!this->_is_cancelled && this->_count == this->_elements.size()) {
+            ++wait_count;
+            this->_condition.wait(lock, [this] { return this->_is_cancelled || this->_count < this->_elements.size(); });
+        }
+
+        if (this->_is_cancelled) {
+            return nullptr;
+        }
+
+        return &this->_elements.at((this->_head + this->_count) % this->_elements.size());
+    }
+
+    void push() {
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            ++this->_count;
+        }
+        this->_condition.notify_all();
+    }
+
+    /// 描画済みのバッファができるまで待って返す。止められた場合はnullptrを返す
+    element const *wait_for_readable(uint64_t &wait_count) {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        if (!this->_is_cancelled && this->_count == 0) {
+            ++wait_count;
+            this->_condition.wait(lock, [this] { return this->_is_cancelled || this->_count > 0; });
+        }
+
+        if (this->_is_cancelled) {
+            return nullptr;
+        }
+
+        return &this->_elements.at(this->_head);
+    }
+
+    void pop() {
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_head = (this->_head + 1) % this->_elements.size();
+            --this->_count;
+        }
+        this->_condition.notify_all();
+    }
+
+    void cancel() {
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_is_cancelled = true;
+        }
+        this->_condition.notify_all();
+    }
+
+   private:
+    std::vector<element> _elements;
+    std::size_t _head = 0;
+    std::size_t _count = 0;
+    bool _is_cancelled = false;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+};
+}  // namespace yas::audio::offline_io_core_utils
+
 struct offline_io_core::render_context {
     std::optional<std::promise<void>> promise = std::promise<void>();
     std::atomic<bool> is_cancelled = false;
+    std::shared_ptr<offline_io_core_utils::buffer_queue> queue = nullptr;
+    // 描画のスレッドで書き込み、promiseが終わってからメインスレッドで読む
+    offline_render_stats stats;
 
-    render_context(std::optional<offline_completion_f> completion) : _completion(std::move(completion)) {
+    render_context(std::optional<offline_completion_f> completion, std::optional<offline_stats_f> stats_handler)
+        : _completion(std::move(completion)), _stats_handler(std::move(stats_handler)) {
     }
 
     void stop() {
@@ -24,14 +122,15 @@ struct offline_io_core::render_context {
         if (this->promise.has_value()) {
             this->is_cancelled = true;
 
+            if (auto const &queue = this->queue) {
+                queue->cancel();
+            }
+
             this->promise.value().get_future().get();
 
             this->promise = std::nullopt;
 
-            if (auto const &completion = this->_completion) {
-                completion.value()(this->is_cancelled);
-                this->_completion = std::nullopt;
-            }
+            this->_call_handlers();
         }
     }
 
@@ -40,14 +139,24 @@ struct offline_io_core::render_context {
 
         this->promise = std::nullopt;
 
+        this->_call_handlers();
+    }
+
+   private:
+    std::optional<offline_completion_f> _completion;
+    std::optional<offline_stats_f> _stats_handler;
+
+    void _call_handlers() {
+        if (auto const &stats_handler = this->_stats_handler) {
+            stats_handler.value()(this->stats);
+            this->_stats_handler = std::nullopt;
+        }
+
         if (auto const &completion = this->_completion) {
             completion.value()(this->is_cancelled);
             this->_completion = std::nullopt;
         }
     }
-
-   private:
-    std::optional<offline_completion_f> _completion;
 };
 
 offline_io_core::offline_io_core(offline_device_ptr const &device) : _device(device) {
@@ -76,7 +185,12 @@ bool offline_io_core::start() {
         return false;
     }
 
-    this->_render_context = std::make_shared<render_context>(this->_device->completion_handler());
+    if (auto const &pipeline = this->_device->pipeline()) {
+        this->_start_pipeline(std::move(kernel), pipeline.value());
+        return true;
+    }
+
+    this->_render_context = std::make_shared<render_context>(this->_device->completion_handler(), std::nullopt);
 
     std::thread thread{[kernel = std::move(kernel), render_context = this->_render_context,
                         device_render_handler = this->_device->render_handler()]() mutable {
@@ -119,6 +233,92 @@ bool offline_io_core::start() {
     return true;
 }
 
+void offline_io_core::_start_pipeline(io_kernel_ptr &&kernel, offline_pipeline_args const &pipeline) {
+    auto const &format = kernel->output_buffer->format();
+    uint32_t const frame_capacity = kernel->output_buffer->frame_capacity();
+
+    this->_render_context =
+        std::make_shared<render_context>(this->_device->completion_handler(), pipeline.stats_handler);
+    this->_render_context->queue = std::make_shared<offline_io_core_utils::buffer_queue>(
+        format, frame_capacity, std::max(pipeline.buffer_count, uint32_t(1)));
+
+    // このスレッドでrender_handlerを呼び、グラフの描画は別のスレッドで先行させる
+    std::thread thread{[kernel = std::move(kernel), render_context = this->_render_context,
+                        device_render_handler = this->_device->render_handler()]() mutable {
+        using namespace offline_io_core_utils;
+
+        auto const &queue = render_context->queue;
+        auto &stats = render_context->stats;
+        double const sample_rate = kernel->output_buffer->format().sample_rate();
+        auto const begin = std::chrono::steady_clock::now();
+
+        std::thread render_thread{[&kernel, &queue, &stats, &render_context, sample_rate]() {
+            int64_t current_sample_time = 0;
+
+            while (!render_context->is_cancelled) {
+                auto *const element = queue->wait_for_writable(stats.render_wait_count);
+                if (!element) {
+                    break;
+                }
+
+                auto const &render_buffer = element->buffer;
+                render_buffer->reset_buffer();
+
+                time const time(current_sample_time, sample_rate);
+
+                auto const render_begin = std::chrono::steady_clock::now();
+
+                kernel->render_handler({.output_buffer = render_buffer.get(),
+                                        .output_time = time,
+                                        .input_buffer = nullptr,
+                                        .input_time = null_time_opt});
+
+                stats.rendering_seconds += seconds_since(render_begin);
+                stats.rendered_frames += render_buffer->frame_length();
+
+                element->sample_time = current_sample_time;
+                current_sample_time += render_buffer->frame_capacity();
+
+                queue->push();
+            }
+        }};
+
+        while (!render_context->is_cancelled) {
+            auto const *const element = queue->wait_for_readable(stats.consume_wait_count);
+            if (!element) {
+                break;
+            }
+
+            time const time(element->sample_time, sample_rate);
+
+            auto const consume_begin = std::chrono::steady_clock::now();
+
+            auto const result = device_render_handler({.output_buffer = element->buffer, .output_time = time});
+
+            stats.consuming_seconds += seconds_since(consume_begin);
+            stats.consumed_frames += element->buffer->frame_length();
+
+            queue->pop();
+
+            if (result == continuation::abort) {
+                break;
+            }
+        }
+
+        // 先行して描画しているスレッドを止める
+        queue->cancel();
+        render_thread.join();
+
+        stats.elapsed_seconds = seconds_since(begin);
+
+        render_context->promise->set_value();
+
+        thread::perform_async_on_main([render_context]() { render_context->complete(); });
+    }};
+
+    thread.detach();
+}
+
 void offline_io_core::stop() {
     if (this->_render_context) {
         this->_render_context->stop();
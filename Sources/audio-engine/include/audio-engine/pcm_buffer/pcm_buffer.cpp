@@ -4,6 +4,8 @@
 
 #include "pcm_buffer.h"
 
+#include <audio-engine/pcm_buffer/pcm_buffer_allocator.h>
+
 static_assert(ACCELERATE_NEW_LAPACK, "");
 static_assert(ACCELERATE_LAPACK_ILP64, "");
 
@@ -23,31 +25,43 @@ using namespace yas::audio;
 
 namespace yas::audio::pcm_buffer_utils {
 static std::vector<uint8_t> _dummy_data(4096 * 4);
+
+// インターリーブを変換するときに、読み書きする範囲がキャッシュに収まるように区切るフレーム数
+static uint32_t constexpr convert_block_length = 256;
 }
 
-std::pair<audio::abl_uptr, audio::abl_data_uptr> audio::allocate_audio_buffer_list(uint32_t const buffer_count,
-                                                                                   uint32_t const channel_count,
-                                                                                   uint32_t const size) {
+std::pair<audio::abl_uptr, audio::abl_data_uptr> audio::allocate_audio_buffer_list(
+    uint32_t const buffer_count, uint32_t const channel_count, uint32_t const size,
+    pcm_buffer::allocation_options const &options) {
     abl_uptr abl_ptr((AudioBufferList *)calloc(1, sizeof(AudioBufferList) + buffer_count * sizeof(AudioBuffer)),
                      [](AudioBufferList *abl) { free(abl); });
 
     abl_ptr->mNumberBuffers = buffer_count;
-    auto data_ptr = std::make_unique<std::vector<std::vector<uint8_t>>>();
-    if (size > 0) {
-        data_ptr->reserve(buffer_count);
-    } else {
-        data_ptr = nullptr;
+
+    // 全てのバッファを1つの領域に並べ、それぞれの先頭をpcm_buffer_alignmentに揃える
+    std::size_t const stride = (size + pcm_buffer_alignment - 1) / pcm_buffer_alignment * pcm_buffer_alignment;
+    std::size_t const total_size = stride * buffer_count;
+
+    abl_data_uptr data_ptr = nullptr;
+
+    if (total_size > 0) {
+        pcm_buffer_allocator_ptr const allocator =
+            options.allocator ? options.allocator : pcm_buffer_allocator::default_allocator();
+        auto *const bytes = static_cast<uint8_t *>(allocator->allocate(total_size, pcm_buffer_alignment));
+
+        if (options.zero_filled) {
+            memset(bytes, 0, total_size);
+        }
+
+        data_ptr = abl_data_uptr(bytes, [allocator, total_size](uint8_t *ptr) {
+            allocator->deallocate(ptr, total_size, pcm_buffer_alignment);
+        });
     }
 
     for (uint32_t i = 0; i < buffer_count; ++i) {
         abl_ptr->mBuffers[i].mNumberChannels = channel_count;
         abl_ptr->mBuffers[i].mDataByteSize = size;
-        if (size > 0) {
-            data_ptr->push_back(std::vector<uint8_t>(size));
-            abl_ptr->mBuffers[i].mData = data_ptr->at(i).data();
-        } else {
-            abl_ptr->mBuffers[i].mData = nullptr;
-        }
+        abl_ptr->mBuffers[i].mData = data_ptr ? &data_ptr.get()[stride * i] : nullptr;
     }
 
     return std::make_pair(std::move(abl_ptr), std::move(data_ptr));
@@ -215,9 +229,13 @@ pcm_buffer::pcm_buffer(audio::format const &format, AudioBufferList *abl)
 }
 
 pcm_buffer::pcm_buffer(audio::format const &format, uint32_t const frame_capacity)
+    : pcm_buffer(format, frame_capacity, allocation_options{}) {
+}
+
+pcm_buffer::pcm_buffer(audio::format const &format, uint32_t const frame_capacity, allocation_options const &options)
     : pcm_buffer(format,
                  allocate_audio_buffer_list(format.buffer_count(), format.stride(),
-                                            frame_capacity * format.stream_description().mBytesPerFrame),
+                                            frame_capacity * format.stream_description().mBytesPerFrame, options),
                  frame_capacity) {
     if (frame_capacity == 0) {
         throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + " : argument is null.");
@@ -514,6 +532,72 @@ pcm_buffer::copy_result pcm_buffer::copy_channel_from(pcm_buffer const &from_buf
     return copy_result{args.length};
 }
 
+pcm_buffer::copy_result pcm_buffer::convert_from(pcm_buffer const &from_buffer) {
+    return this->convert_from(from_buffer, convert_options{});
+}
+
+pcm_buffer::copy_result pcm_buffer::convert_from(pcm_buffer const &from_buffer, convert_options args) {
+    audio::format const &from_format = from_buffer.format();
+    audio::format const &to_format = this->format();
+
+    if (!convert::is_convertible(from_format.pcm_format()) || !convert::is_convertible(to_format.pcm_format()) ||
+        from_format.channel_count() != to_format.channel_count()) {
+        return copy_result(copy_error_t::invalid_format);
+    }
+
+    get_abl_info_result_t const from_result =
+        get_abl_info(from_buffer.audio_buffer_list(), from_format.sample_byte_count());
+    if (!from_result) {
+        return copy_result(from_result.error());
+    }
+
+    get_abl_info_result_t const to_result = get_abl_info(this->audio_buffer_list(), to_format.sample_byte_count());
+    if (!to_result) {
+        return copy_result(to_result.error());
+    }
+
+    abl_info const &from_info = from_result.value();
+    abl_info const &to_info = to_result.value();
+
+    if (args.from_begin_frame > from_info.frame_length) {
+        return copy_result(copy_error_t::out_of_range_frame);
+    }
+
+    uint32_t const copy_length = args.length ?: (from_info.frame_length - args.from_begin_frame);
+
+    if ((args.from_begin_frame + copy_length) > from_info.frame_length ||
+        (args.to_begin_frame + copy_length) > to_info.frame_length) {
+        return copy_result(copy_error_t::out_of_range_frame);
+    }
+
+    bool const is_interleaved = from_format.stride() > 1 || to_format.stride() > 1;
+    uint32_t const block_length = is_interleaved ? pcm_buffer_utils::convert_block_length : copy_length;
+    uint32_t const from_sample_byte_count = from_format.sample_byte_count();
+    uint32_t const to_sample_byte_count = to_format.sample_byte_count();
+
+    for (uint32_t offset = 0; offset < copy_length; offset += block_length) {
+        uint32_t const length = std::min(block_length, copy_length - offset);
+
+        for (uint32_t ch_idx = 0; ch_idx < from_info.channel_count; ++ch_idx) {
+            uint32_t const from_stride = from_info.strides[ch_idx];
+            uint32_t const to_stride = to_info.strides[ch_idx];
+            uint32_t const from_frame = args.from_begin_frame + offset;
+            uint32_t const to_frame = args.to_begin_frame + offset;
+
+            convert::samples(&from_info.datas[ch_idx][from_frame * from_sample_byte_count * from_stride],
+                             from_format.pcm_format(), from_stride,
+                             &to_info.datas[ch_idx][to_frame * to_sample_byte_count * to_stride],
+                             to_format.pcm_format(), to_stride, length, args.dither);
+        }
+    }
+
+    if (args.from_begin_frame == 0 && args.to_begin_frame == 0 && args.length == 0) {
+        this->set_frame_length(copy_length);
+    }
+
+    return copy_result(copy_length);
+}
+
 pcm_buffer::copy_result pcm_buffer::copy_from(AudioBufferList const *const from_abl, uint32_t const from_begin_frame,
                                               uint32_t const to_begin_frame, uint32_t const length) {
     this->set_frame_length(0);
@@ -652,6 +736,9 @@ void audio::copy(void const *const from_data, uint32_t const from_stride, void *
             double const *const from_float64_data = static_cast<double const *>(from_data);
             double *const to_float64_data = static_cast<double *>(to_data);
             cblas_dcopy(copy_length, from_float64_data, from_stride, to_float64_data, to_stride);
+        } else if (sample_byte_count == sizeof(int16_t)) {
+            convert::samples(static_cast<int16_t const *>(from_data), from_stride, static_cast<int16_t *>(to_data),
+                             to_stride, copy_length);
         } else {
             for (uint32_t frame = 0; frame < copy_length; ++frame) {
                 uint32_t const sample_frame = frame * sample_byte_count;
@@ -7,6 +7,7 @@
 #include <audio-engine/common/ptr.h>
 #include <audio-engine/common/types.h>
 #include <audio-engine/format/format.h>
+#include <audio-engine/utils/convert_kernels.h>
 #include <cpp-utils/result.h>
 
 #include <ostream>
@@ -17,7 +18,17 @@ class result;
 }
 
 namespace yas::audio {
+/// チャンネルごとのデータの先頭を揃えるバイト数。各チャンネルの領域はこの倍数に切り上げて1つの領域に並べる
+static std::size_t constexpr pcm_buffer_alignment = 64;
+
 struct pcm_buffer final {
+    struct allocation_options {
+        /// falseなら確保した領域を0で埋めない。全て書き込んでから読む場合に使う
+        bool const zero_filled = true;
+        /// nullならpcm_buffer_allocator::default_allocatorを使う
+        pcm_buffer_allocator_ptr const allocator = nullptr;
+    };
+
     struct copy_options {
         uint32_t const from_begin_frame = 0;
         uint32_t const to_begin_frame = 0;
@@ -32,6 +43,13 @@ struct pcm_buffer final {
         uint32_t const length = 0;
     };
 
+    struct convert_options {
+        uint32_t const from_begin_frame = 0;
+        uint32_t const to_begin_frame = 0;
+        uint32_t const length = 0;
+        dither_type const dither = dither_type::none;
+    };
+
     enum class copy_error_t {
         invalid_argument,
         invalid_abl,
@@ -44,6 +62,7 @@ struct pcm_buffer final {
 
     pcm_buffer(audio::format const &format, AudioBufferList *abl);
     pcm_buffer(audio::format const &format, uint32_t const frame_capacity);
+    pcm_buffer(audio::format const &format, uint32_t const frame_capacity, allocation_options const &);
     pcm_buffer(audio::format const &format, pcm_buffer const &from_buffer, channel_map_t const &channel_map);
 
     pcm_buffer(pcm_buffer &&);
@@ -75,6 +94,10 @@ struct pcm_buffer final {
     pcm_buffer::copy_result copy_from(pcm_buffer const &, copy_options);
     pcm_buffer::copy_result copy_channel_from(pcm_buffer const &);
     pcm_buffer::copy_result copy_channel_from(pcm_buffer const &, copy_channel_options);
+    /// pcm_formatとインターリーブの違うバッファから、変換しながら1回の走査でコピーする
+    /// float32、float64、int16、fixed824の間で変換でき、チャンネル数は同じでなければならない
+    pcm_buffer::copy_result convert_from(pcm_buffer const &);
+    pcm_buffer::copy_result convert_from(pcm_buffer const &, convert_options);
     pcm_buffer::copy_result copy_from(AudioBufferList const *const from_abl, uint32_t const from_begin_frame = 0,
                                       uint32_t const to_begin_frame = 0, uint32_t const length = 0);
     pcm_buffer::copy_result copy_to(AudioBufferList *const to_abl, uint32_t const from_begin_frame = 0,
@@ -130,7 +153,8 @@ pcm_buffer::copy_result copy(AudioBufferList const *const from_abl, AudioBufferL
 uint32_t frame_length(AudioBufferList const *const abl, uint32_t const sample_byte_count);
 
 std::pair<abl_uptr, abl_data_uptr> allocate_audio_buffer_list(uint32_t const buffer_count, uint32_t const channel_count,
-                                                              uint32_t const size = 0);
+                                                              uint32_t const size = 0,
+                                                              pcm_buffer::allocation_options const & = {});
 bool is_equal_structure(AudioBufferList const &abl1, AudioBufferList const &abl2);
 }  // namespace yas::audio
 
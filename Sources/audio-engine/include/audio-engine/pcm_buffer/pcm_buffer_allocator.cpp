@@ -0,0 +1,113 @@
+//
+//  pcm_buffer_allocator.cpp
+//
+
+#include "pcm_buffer_allocator.h"
+
+#include <new>
+
+using namespace yas;
+using namespace yas::audio;
+
+namespace yas::audio::pcm_buffer_allocator_utils {
+static std::size_t constexpr shared_max_pooled_byte_size = 64 * 1024 * 1024;
+
+static void *allocate(std::size_t const byte_size, std::size_t const alignment) {
+    return ::operator new(byte_size, std::align_val_t{alignment});
+}
+
+static void deallocate(void *const ptr, std::size_t const alignment) {
+    ::operator delete(ptr, std::align_val_t{alignment});
+}
+
+struct default_allocator final : pcm_buffer_allocator {
+    void *allocate(std::size_t const byte_size, std::size_t const alignment) override {
+        return pcm_buffer_allocator_utils::allocate(byte_size, alignment);
+    }
+
+    void deallocate(void *const ptr, std::size_t const, std::size_t const alignment) override {
+        pcm_buffer_allocator_utils::deallocate(ptr, alignment);
+    }
+};
+}  // namespace yas::audio::pcm_buffer_allocator_utils
+
+pcm_buffer_allocator_ptr const &pcm_buffer_allocator::default_allocator() {
+    static pcm_buffer_allocator_ptr const allocator =
+        std::make_shared<pcm_buffer_allocator_utils::default_allocator>();
+    return allocator;
+}
+
+#pragma mark - pcm_buffer_pool
+
+pcm_buffer_pool::pcm_buffer_pool(std::size_t const max_pooled_byte_size)
+    : _max_pooled_byte_size(max_pooled_byte_size) {
+}
+
+pcm_buffer_pool::~pcm_buffer_pool() {
+    this->purge();
+}
+
+void *pcm_buffer_pool::allocate(std::size_t const byte_size, std::size_t const alignment) {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        auto const iterator = this->_blocks.find({byte_size, alignment});
+        if (iterator != this->_blocks.end() && !iterator->second.empty()) {
+            void *const ptr = iterator->second.back();
+            iterator->second.pop_back();
+            this->_pooled_byte_size -= byte_size;
+            return ptr;
+        }
+    }
+
+    return pcm_buffer_allocator_utils::allocate(byte_size, alignment);
+}
+
+void pcm_buffer_pool::deallocate(void *const ptr, std::size_t const byte_size, std::size_t const alignment) {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        if (this->_pooled_byte_size + byte_size <= this->_max_pooled_byte_size) {
+            this->_blocks[{byte_size, alignment}].push_back(ptr);
+            this->_pooled_byte_size += byte_size;
+            return;
+        }
+    }
+
+    pcm_buffer_allocator_utils::deallocate(ptr, alignment);
+}
+
+std::size_t pcm_buffer_pool::max_pooled_byte_size() const {
+    return this->_max_pooled_byte_size;
+}
+
+std::size_t pcm_buffer_pool::pooled_byte_size() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_pooled_byte_size;
+}
+
+void pcm_buffer_pool::purge() {
+    std::map<key_t, std::vector<void *>> blocks;
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        blocks.swap(this->_blocks);
+        this->_pooled_byte_size = 0;
+    }
+
+    for (auto const &pair : blocks) {
+        for (void *const ptr : pair.second) {
+            pcm_buffer_allocator_utils::deallocate(ptr, pair.first.second);
+        }
+    }
+}
+
+pcm_buffer_pool_ptr pcm_buffer_pool::make_shared(std::size_t const max_pooled_byte_size) {
+    return pcm_buffer_pool_ptr(new pcm_buffer_pool{max_pooled_byte_size});
+}
+
+pcm_buffer_pool_ptr const &pcm_buffer_pool::shared() {
+    static pcm_buffer_pool_ptr const pool =
+        pcm_buffer_pool::make_shared(pcm_buffer_allocator_utils::shared_max_pooled_byte_size);
+    return pool;
+}
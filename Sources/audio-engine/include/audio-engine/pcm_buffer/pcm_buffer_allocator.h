@@ -0,0 +1,60 @@
+//
+//  pcm_buffer_allocator.h
+//
+
+#pragma once
+
+#include <audio-engine/common/ptr.h>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace yas::audio {
+/// pcm_bufferのデータの領域を確保する
+/// 確保と解放は別のスレッドから呼ばれることがあるので、スレッドセーフに実装する
+struct pcm_buffer_allocator {
+    virtual ~pcm_buffer_allocator() = default;
+
+    /// alignmentに先頭を揃えたbyte_sizeの領域を返す。中身は初期化しなくて良い
+    [[nodiscard]] virtual void *allocate(std::size_t const byte_size, std::size_t const alignment) = 0;
+    /// allocateと同じbyte_sizeとalignmentで呼ばれる
+    virtual void deallocate(void *const, std::size_t const byte_size, std::size_t const alignment) = 0;
+
+    /// 都度newとdeleteをする
+    [[nodiscard]] static pcm_buffer_allocator_ptr const &default_allocator();
+};
+
+/// 解放された領域をサイズごとに取っておき、同じサイズの確保で使い回す
+/// 取っておく合計がmax_pooled_byte_sizeを超える分はそのまま解放する
+struct pcm_buffer_pool final : pcm_buffer_allocator {
+    ~pcm_buffer_pool();
+
+    [[nodiscard]] void *allocate(std::size_t const byte_size, std::size_t const alignment) override;
+    void deallocate(void *const, std::size_t const byte_size, std::size_t const alignment) override;
+
+    [[nodiscard]] std::size_t max_pooled_byte_size() const;
+    [[nodiscard]] std::size_t pooled_byte_size() const;
+    /// 取っておいた領域を全て解放する
+    void purge();
+
+    [[nodiscard]] static pcm_buffer_pool_ptr make_shared(std::size_t const max_pooled_byte_size);
+    /// io_kernelとbuffering_elementが共有するプール
+    [[nodiscard]] static pcm_buffer_pool_ptr const &shared();
+
+   private:
+    using key_t = std::pair<std::size_t, std::size_t>;
+
+    std::size_t const _max_pooled_byte_size;
+    std::map<key_t, std::vector<void *>> _blocks;
+    std::size_t _pooled_byte_size = 0;
+    mutable std::mutex _mutex;
+
+    explicit pcm_buffer_pool(std::size_t const max_pooled_byte_size);
+
+    pcm_buffer_pool(pcm_buffer_pool const &) = delete;
+    pcm_buffer_pool(pcm_buffer_pool &&) = delete;
+    pcm_buffer_pool &operator=(pcm_buffer_pool const &) = delete;
+    pcm_buffer_pool &operator=(pcm_buffer_pool &&) = delete;
+};
+}  // namespace yas::audio
@@ -25,10 +25,7 @@ bool rendering_connection::render(pcm_buffer *const buffer, time const &time) co
 
     assert(this->source_node->render_handler);
 
-    this->source_node->render_handler({.buffer = buffer,
-                                       .bus_idx = this->source_bus_idx,
-                                       .time = time,
-                                       .source_connections = this->source_node->source_connections});
+    this->source_node->render(buffer, this->source_bus_idx, time);
 
     return true;
 }
@@ -6,22 +6,38 @@
 
 #include <audio-engine/graph/graph_connection.h>
 #include <audio-engine/graph/graph_node.h>
-#include <cpp-utils/stl_utils.h>
+
+#include <algorithm>
 
 using namespace yas;
 using namespace yas::audio;
 
 namespace yas::audio {
 
-std::vector<std::unique_ptr<rendering_node>> make_rendering_nodes(renderable_graph_node_ptr const &node) {
-    node->prepare_rendering();
+struct rendering_nodes_context {
+    uint32_t maximum_frames;
+    std::map<renderable_graph_node const *, rendering_node const *> made_nodes;
+    // 接続元が先に並ぶ
+    std::vector<std::unique_ptr<rendering_node>> sorted_nodes;
+};
+
+// 複数の接続先を持つノードも一つだけ作る
+rendering_node const *make_rendering_node(renderable_graph_node_ptr const &node, rendering_nodes_context &context) {
+    if (auto const iterator = context.made_nodes.find(node.get()); iterator != context.made_nodes.end()) {
+        return iterator->second;
+    }
+
+    node->prepare_rendering(context.maximum_frames);
 
     assert(node->render_handler());
 
-    std::vector<std::unique_ptr<rendering_node>> sub_nodes;
     rendering_connection_map connections;
 
-    for (auto const &pair : node->input_connections()) {
+    // 最後に逆順にしたときにバスの順で並ぶよう、後ろのバスから辿る
+    auto const &input_connections = node->input_connections();
+    for (auto iterator = input_connections.rbegin(); iterator != input_connections.rend(); ++iterator) {
+        auto const &pair = *iterator;
+
         if (pair.second.expired()) {
             continue;
         }
@@ -30,26 +46,36 @@ std::vector<std::unique_ptr<rendering_node>> make_rendering_nodes(renderable_gra
         renderable_graph_connection_ptr const connection = pair.second.lock();
         renderable_graph_node_ptr const src_node = connection->source_node();
 
-        std::vector<std::unique_ptr<rendering_node>> src_rendering_nodes = make_rendering_nodes(src_node);
-
-        connections.emplace(dst_bus_idx, rendering_connection{connection->source_bus(), src_rendering_nodes.at(0).get(),
-                                                              connection->format()});
+        rendering_node const *const src_rendering_node = make_rendering_node(src_node, context);
 
-        yas::move_back_insert(sub_nodes, std::move(src_rendering_nodes));
+        connections.emplace(dst_bus_idx,
+                            rendering_connection{connection->source_bus(), src_rendering_node, connection->format()});
     }
 
-    std::vector<std::unique_ptr<rendering_node>> result;
+    auto rendering_node = std::make_unique<audio::rendering_node>(node->render_handler(), std::move(connections));
+    auto const *const rendering_node_ptr = rendering_node.get();
 
-    result.emplace_back(std::make_unique<rendering_node>(node->render_handler(), std::move(connections)));
+    context.made_nodes.emplace(node.get(), rendering_node_ptr);
+    context.sorted_nodes.emplace_back(std::move(rendering_node));
 
-    if (!sub_nodes.empty()) {
-        yas::move_back_insert(result, std::move(sub_nodes));
-    }
+    return rendering_node_ptr;
+}
+
+/// nodeから辿れるノードを、接続先が接続元より前になるように並べて返す。先頭はnodeになる
+std::vector<std::unique_ptr<rendering_node>> make_rendering_nodes(renderable_graph_node_ptr const &node,
+                                                                  uint32_t const maximum_frames) {
+    rendering_nodes_context context{.maximum_frames = maximum_frames};
+
+    make_rendering_node(node, context);
 
-    return result;
+    std::reverse(context.sorted_nodes.begin(), context.sorted_nodes.end());
+
+    return std::move(context.sorted_nodes);
 }
 
-std::unique_ptr<rendering_output_node> make_rendering_output_node(renderable_graph_node_ptr const &output_node) {
+std::unique_ptr<rendering_output_node> make_rendering_output_node(renderable_graph_node_ptr const &output_node,
+                                                                  uint32_t const maximum_frames,
+                                                                  rendering_worker_pool_ptr const &worker_pool) {
     if (output_node->input_connections().empty()) {
         return nullptr;
     }
@@ -63,17 +89,21 @@ std::unique_ptr<rendering_output_node> make_rendering_output_node(renderable_gra
     renderable_graph_connection_ptr const connection = pair.second.lock();
     renderable_graph_node_ptr const src_node = connection->source_node();
 
-    auto nodes = make_rendering_nodes(src_node);
+    auto nodes = make_rendering_nodes(src_node, maximum_frames);
 
     if (nodes.empty()) {
         return nullptr;
     }
 
+    auto *const first_node = nodes.at(0).get();
+
     return std::make_unique<rendering_output_node>(
-        std::move(nodes), rendering_connection{connection->source_bus(), nodes.at(0).get(), connection->format()});
+        std::move(nodes), rendering_connection{connection->source_bus(), first_node, connection->format()},
+        maximum_frames, worker_pool);
 }
 
-std::unique_ptr<rendering_input_node> make_rendering_input_node(renderable_graph_node_ptr const &input_node) {
+std::unique_ptr<rendering_input_node> make_rendering_input_node(renderable_graph_node_ptr const &input_node,
+                                                                uint32_t const maximum_frames) {
     if (input_node->output_connections().empty()) {
         return nullptr;
     }
@@ -88,7 +118,7 @@ std::unique_ptr<rendering_input_node> make_rendering_input_node(renderable_graph
     renderable_graph_node_ptr const dst_node = connection->destination_node();
 
     if (dst_node->is_input_renderable()) {
-        dst_node->prepare_rendering();
+        dst_node->prepare_rendering(maximum_frames);
         return std::make_unique<rendering_input_node>(connection->format(), dst_node->render_handler());
     } else {
         return nullptr;
@@ -98,7 +128,19 @@ std::unique_ptr<rendering_input_node> make_rendering_input_node(renderable_graph
 
 rendering_graph::rendering_graph(renderable_graph_node_ptr const &output_node,
                                  renderable_graph_node_ptr const &input_node)
-    : _output_node(make_rendering_output_node(output_node)), _input_node(make_rendering_input_node(input_node)) {
+    : rendering_graph(output_node, input_node, rendering_graph::default_maximum_frames) {
+}
+
+rendering_graph::rendering_graph(renderable_graph_node_ptr const &output_node,
+                                 renderable_graph_node_ptr const &input_node, uint32_t const maximum_frames)
+    : rendering_graph(output_node, input_node, maximum_frames, nullptr) {
+}
+
+rendering_graph::rendering_graph(renderable_graph_node_ptr const &output_node,
+                                 renderable_graph_node_ptr const &input_node, uint32_t const maximum_frames,
+                                 rendering_worker_pool_ptr const &worker_pool)
+    : _output_node(make_rendering_output_node(output_node, maximum_frames, worker_pool)),
+      _input_node(make_rendering_input_node(input_node, maximum_frames)) {
 }
 
 rendering_output_node const *rendering_graph::output_node() const {
@@ -11,7 +11,16 @@
 
 namespace yas::audio {
 struct rendering_graph {
+    static uint32_t constexpr default_maximum_frames = 4096;
+
     rendering_graph(renderable_graph_node_ptr const &output_node, renderable_graph_node_ptr const &input_node);
+    /// 複数の接続先を持つノードの出力はmaximum_framesまでのバッファに一度だけ描画して共有する
+    /// 各ノードにはprepare_renderingでmaximum_framesを渡し、描画で使うバッファをその長さで確保させる
+    rendering_graph(renderable_graph_node_ptr const &output_node, renderable_graph_node_ptr const &input_node,
+                    uint32_t const maximum_frames);
+    /// rendering_worker_poolを渡すと、独立した接続元を持つノードの入力を並列に描画する
+    rendering_graph(renderable_graph_node_ptr const &output_node, renderable_graph_node_ptr const &input_node,
+                    uint32_t const maximum_frames, rendering_worker_pool_ptr const &);
 
     [[nodiscard]] rendering_output_node const *output_node() const;
     [[nodiscard]] rendering_input_node const *input_node() const;
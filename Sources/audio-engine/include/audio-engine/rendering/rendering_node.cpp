@@ -5,6 +5,9 @@
 #include "rendering_node.h"
 
 #include <audio-engine/rendering/rendering_connection.h>
+#include <audio-engine/utils/rendering_worker_pool.h>
+
+#include <set>
 
 using namespace yas;
 using namespace yas::audio;
@@ -41,14 +44,202 @@ bool rendering_node::input_render(pcm_buffer *const buffer, time const &time) co
     return true;
 }
 
+void rendering_node::render(pcm_buffer *const buffer, uint32_t const bus_idx, time const &time) const {
+    if (auto *const shared = this->_shared_output(bus_idx, *buffer)) {
+        auto const frame_length = buffer->frame_length();
+        this->_render_shared_output(*shared, bus_idx, frame_length, time);
+        buffer->copy_from(shared->buffer, {.length = frame_length});
+    } else {
+        this->_call_render_handler(buffer, bus_idx, time);
+    }
+}
+
+void rendering_node::share_output(uint32_t const bus_idx, audio::format const &format, uint32_t const frame_capacity,
+                                  uint64_t const *const cycle) {
+    this->_shared_outputs.insert_or_assign(
+        bus_idx, std::unique_ptr<shared_output>(new shared_output{.buffer = pcm_buffer{format, frame_capacity},
+                                                                  .cycle = cycle,
+                                                                  .rendered_cycle = 0,
+                                                                  .rendered_sample_time = 0}));
+}
+
+bool rendering_node::is_output_shared(uint32_t const bus_idx) const {
+    return this->_shared_outputs.count(bus_idx) > 0;
+}
+
+void rendering_node::set_parallel_sources(std::vector<rendering_connection const *> &&connections,
+                                          rendering_worker_pool_ptr const &worker_pool) {
+    this->_parallel_sources = std::move(connections);
+    this->_worker_pool = worker_pool;
+}
+
+std::vector<rendering_connection const *> const &rendering_node::parallel_sources() const {
+    return this->_parallel_sources;
+}
+
+rendering_node::shared_output *rendering_node::_shared_output(uint32_t const bus_idx, pcm_buffer const &buffer) const {
+    if (auto const iterator = this->_shared_outputs.find(bus_idx); iterator != this->_shared_outputs.end()) {
+        auto *const shared = iterator->second.get();
+        if (buffer.frame_length() <= shared->buffer.frame_capacity() && buffer.format() == shared->buffer.format()) {
+            return shared;
+        }
+    }
+    return nullptr;
+}
+
+void rendering_node::_render_shared_output(shared_output &shared, uint32_t const bus_idx, uint32_t const frame_length,
+                                           time const &time) const {
+    // 同じ周期でも、違う位置を描画しようとしていたら描画し直す
+    if (shared.rendered_cycle == *shared.cycle && shared.buffer.frame_length() == frame_length &&
+        shared.rendered_sample_time == time.sample_time()) {
+        return;
+    }
+
+    shared.buffer.set_frame_length(frame_length);
+    shared.buffer.clear();
+
+    this->_call_render_handler(&shared.buffer, bus_idx, time);
+
+    shared.rendered_cycle = *shared.cycle;
+    shared.rendered_sample_time = time.sample_time();
+}
+
+void rendering_node::_prerender(rendering_connection const &connection, uint32_t const frame_length,
+                                time const &time) const {
+    auto const iterator = this->_shared_outputs.find(connection.source_bus_idx);
+    if (iterator == this->_shared_outputs.end()) {
+        return;
+    }
+
+    auto &shared = *iterator->second;
+    if (frame_length <= shared.buffer.frame_capacity() && connection.format == shared.buffer.format()) {
+        this->_render_shared_output(shared, connection.source_bus_idx, frame_length, time);
+    }
+}
+
+void rendering_node::_call_render_handler(pcm_buffer *const buffer, uint32_t const bus_idx, time const &time) const {
+    if (this->_worker_pool && this->_parallel_sources.size() > 1) {
+        auto const frame_length = buffer->frame_length();
+
+        // 描画した結果は接続元ごとのバッファに入るので、render_handlerでまとめる順番は変わらない
+        this->_worker_pool->parallel_for(
+            this->_parallel_sources.size(), [this, frame_length, &time](std::size_t const idx) {
+                auto const &connection = *this->_parallel_sources.at(idx);
+                connection.source_node->_prerender(connection, frame_length, time);
+            });
+    }
+
+    this->render_handler(
+        {.buffer = buffer, .bus_idx = bus_idx, .time = time, .source_connections = this->source_connections});
+}
+
 #pragma mark - rendering_output_node
 
+namespace yas::audio::rendering_utils {
+using output_key_t = std::pair<rendering_node const *, uint32_t>;
+using node_set_t = std::set<rendering_node const *>;
+
+static node_set_t const &upstream_nodes(rendering_node const *const node,
+                                        std::map<rendering_node const *, node_set_t> &cache) {
+    if (auto const iterator = cache.find(node); iterator != cache.end()) {
+        return iterator->second;
+    }
+
+    node_set_t nodes{node};
+
+    for (auto const &pair : node->source_connections) {
+        auto const &source_nodes = upstream_nodes(pair.second.source_node, cache);
+        nodes.insert(source_nodes.begin(), source_nodes.end());
+    }
+
+    return cache.emplace(node, std::move(nodes)).first->second;
+}
+
+// 接続元どうしが同じノードを含まなければ並列に描画できる
+static bool is_independent_sources(rendering_node const *const node,
+                                   std::map<rendering_node const *, node_set_t> &cache) {
+    if (node->source_connections.size() < 2) {
+        return false;
+    }
+
+    node_set_t visited;
+
+    for (auto const &pair : node->source_connections) {
+        for (auto const *const upstream_node : upstream_nodes(pair.second.source_node, cache)) {
+            if (!visited.insert(upstream_node).second) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+}  // namespace yas::audio::rendering_utils
+
 rendering_output_node::rendering_output_node(std::vector<std::unique_ptr<rendering_node>> &&nodes,
-                                             rendering_connection &&connection)
+                                             rendering_connection &&connection, uint32_t const maximum_frames,
+                                             rendering_worker_pool_ptr const &worker_pool)
     : source_nodes(std::move(nodes)), source_connection(std::move(connection)) {
+    using namespace rendering_utils;
+
+    // 並列に描画する接続元の出力は、接続先が1つでも共有して描画結果を受け渡す
+    std::set<output_key_t> parallel_outputs;
+
+    if (worker_pool) {
+        std::map<rendering_node const *, node_set_t> upstream_cache;
+
+        for (auto const &node : this->source_nodes) {
+            if (!is_independent_sources(node.get(), upstream_cache)) {
+                continue;
+            }
+
+            std::vector<rendering_connection const *> connections;
+
+            for (auto const &pair : node->source_connections) {
+                connections.emplace_back(&pair.second);
+                parallel_outputs.emplace(pair.second.source_node, pair.second.source_bus_idx);
+            }
+
+            node->set_parallel_sources(std::move(connections), worker_pool);
+        }
+    }
+
+    // 1回のrenderで各ノードの出力が描画される回数を、接続先から順に数える
+    std::map<output_key_t, uint64_t> pull_counts;
+    std::map<output_key_t, audio::format> formats;
+
+    auto add_pull = [&pull_counts, &formats](rendering_connection const &connection, uint64_t const count) {
+        output_key_t const key{connection.source_node, connection.source_bus_idx};
+        pull_counts[key] += count;
+        formats.emplace(key, connection.format);
+    };
+
+    add_pull(this->source_connection, 1);
+
+    for (auto const &node : this->source_nodes) {
+        uint64_t render_count = 0;
+
+        for (auto const &[key, pull_count] : pull_counts) {
+            if (key.first != node.get()) {
+                continue;
+            }
+
+            if (pull_count > 1 || parallel_outputs.count(key) > 0) {
+                node->share_output(key.second, formats.at(key), maximum_frames, &this->_cycle);
+                render_count += 1;
+            } else {
+                render_count += pull_count;
+            }
+        }
+
+        for (auto const &pair : node->source_connections) {
+            add_pull(pair.second, render_count);
+        }
+    }
 }
 
 bool rendering_output_node::render(pcm_buffer *const buffer, time const &time) const {
+    ++this->_cycle;
     return this->source_connection.render(buffer, time);
 }
 
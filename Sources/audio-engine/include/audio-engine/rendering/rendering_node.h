@@ -4,10 +4,14 @@
 
 #pragma once
 
+#include <audio-engine/common/ptr.h>
 #include <audio-engine/rendering/rendering_connection.h>
 
 #include "rendering_types.h"
 
+#include <memory>
+#include <vector>
+
 namespace yas::audio {
 struct rendering_node {
     rendering_node(node_render_f const &, rendering_connection_map &&);
@@ -18,7 +22,37 @@ struct rendering_node {
     bool output_render(pcm_buffer *const, audio::time const &) const;
     bool input_render(pcm_buffer *const, audio::time const &) const;
 
+    /// busの出力をbufferに描画する。共有する出力ならレンダリングの周期ごとに一度だけ描画してコピーする
+    void render(pcm_buffer *const, uint32_t const bus_idx, audio::time const &) const;
+
+    /// busの出力を複数の接続先で使うので、frame_capacityまでのバッファを確保して共有する
+    void share_output(uint32_t const bus_idx, audio::format const &, uint32_t const frame_capacity,
+                      uint64_t const *const cycle);
+    [[nodiscard]] bool is_output_shared(uint32_t const bus_idx) const;
+
+    /// render_handlerを呼ぶ前に、接続元の共有している出力をrendering_worker_poolで並列に描画しておく
+    /// 接続元どうしは同じノードを含まない独立したものでなければならない
+    void set_parallel_sources(std::vector<rendering_connection const *> &&, rendering_worker_pool_ptr const &);
+    [[nodiscard]] std::vector<rendering_connection const *> const &parallel_sources() const;
+
    private:
+    struct shared_output {
+        pcm_buffer buffer;
+        uint64_t const *const cycle;
+        uint64_t rendered_cycle = 0;
+        int64_t rendered_sample_time = 0;
+    };
+
+    std::map<uint32_t, std::unique_ptr<shared_output>> _shared_outputs;
+    std::vector<rendering_connection const *> _parallel_sources;
+    rendering_worker_pool_ptr _worker_pool = nullptr;
+
+    shared_output *_shared_output(uint32_t const bus_idx, pcm_buffer const &) const;
+    void _render_shared_output(shared_output &, uint32_t const bus_idx, uint32_t const frame_length,
+                               audio::time const &) const;
+    void _prerender(rendering_connection const &, uint32_t const frame_length, audio::time const &) const;
+    void _call_render_handler(pcm_buffer *const, uint32_t const bus_idx, audio::time const &) const;
+
     rendering_node(rendering_node const &) = delete;
     rendering_node(rendering_node &&) = delete;
     rendering_node &operator=(rendering_node const &) = delete;
@@ -26,7 +60,11 @@ struct rendering_node {
 };
 
 struct rendering_output_node {
-    explicit rendering_output_node(std::vector<std::unique_ptr<rendering_node>> &&, rendering_connection &&);
+    /// source_nodesは接続先から順に並んでいて、同じノードは一つだけ含まれる
+    /// 複数の接続先から使われる出力はmaximum_framesまでのバッファで共有する
+    /// rendering_worker_poolがあれば、接続元が独立しているノードの入力を並列に描画する
+    explicit rendering_output_node(std::vector<std::unique_ptr<rendering_node>> &&, rendering_connection &&,
+                                   uint32_t const maximum_frames, rendering_worker_pool_ptr const & = nullptr);
 
     std::vector<std::unique_ptr<rendering_node>> const source_nodes;
     rendering_connection const source_connection;
@@ -34,6 +72,9 @@ struct rendering_output_node {
     bool render(pcm_buffer *const, audio::time const &) const;
 
    private:
+    // renderが呼ばれるたびに進めて、共有している出力の描画済みを判断する
+    mutable uint64_t _cycle = 0;
+
     rendering_output_node(rendering_output_node const &) = delete;
     rendering_output_node(rendering_output_node &&) = delete;
     rendering_output_node &operator=(rendering_output_node const &) = delete;
@@ -13,10 +13,18 @@
 #include <audio-engine/io/renewable_device.h>
 #include <audio-engine/offline/offline_device.h>
 #include <audio-engine/pcm_buffer/pcm_buffer.h>
+#include <audio-engine/pcm_buffer/pcm_buffer_allocator.h>
+#include <audio-engine/utils/convert_kernels.h>
 #include <audio-engine/utils/debug.h>
 #include <audio-engine/utils/each_data.h>
 #include <audio-engine/utils/exception.h>
 #include <audio-engine/utils/math.h>
+#include <audio-engine/utils/mix_kernels.h>
+#include <audio-engine/utils/oscillator_bank.h>
+#include <audio-engine/utils/oscillator_kernels.h>
+#include <audio-engine/utils/resampler.h>
+#include <audio-engine/utils/rendering_worker_pool.h>
+#include <audio-engine/utils/worker_pool.h>
 #include <cpp-utils/cf_utils.h>
 #include <cpp-utils/exception.h>
 #include <cpp-utils/result.h>
@@ -42,7 +50,10 @@
 #include <audio-engine/graph/graph_avf_au_mixer.h>
 #include <audio-engine/graph/graph_connection.h>
 #include <audio-engine/graph/graph_io.h>
+#include <audio-engine/graph/graph_mixer.h>
 #include <audio-engine/graph/graph_node.h>
+#include <audio-engine/graph/graph_oscillator_bank.h>
+#include <audio-engine/graph/graph_resampler.h>
 #include <audio-engine/graph/graph_route.h>
 #include <audio-engine/graph/graph_tap.h>
 #include <audio-engine/rendering/rendering_graph.h>
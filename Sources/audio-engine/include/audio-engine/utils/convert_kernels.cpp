@@ -0,0 +1,301 @@
+//
+//  convert_kernels.cpp
+//
+
+#include "convert_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+using namespace yas;
+using namespace yas::audio;
+
+// mix_kernelsと同じく、特定の命令セットに依存せずコンパイラがベクトル化できるように分岐のない単純なループにしている
+
+namespace yas::audio::convert_kernels_utils {
+static std::size_t constexpr dither_block_length = 256;
+
+template <typename T>
+struct sample_traits {
+    static bool constexpr is_integer = false;
+    static int constexpr bit_depth = 64;
+    static double constexpr scale = 1.0;
+};
+
+template <>
+struct sample_traits<int16_t> {
+    static bool constexpr is_integer = true;
+    static int constexpr bit_depth = 16;
+    static double constexpr scale = 32768.0;
+    static double constexpr min = -32768.0;
+    static double constexpr max = 32767.0;
+};
+
+template <>
+struct sample_traits<int32_t> {
+    static bool constexpr is_integer = true;
+    static int constexpr bit_depth = 32;
+    static double constexpr scale = 16777216.0;
+    static double constexpr min = -2147483648.0;
+    static double constexpr max = 2147483647.0;
+};
+
+// floatとint16の間だけfloatで計算する。int32の固定小数点はfloatでは範囲の端を表せない
+template <typename From, typename To>
+using compute_t = std::conditional_t<std::is_same_v<From, double> || std::is_same_v<To, double> ||
+                                         std::is_same_v<From, int32_t> || std::is_same_v<To, int32_t>,
+                                     double, float>;
+
+template <typename From, typename To>
+static bool constexpr is_ditherable =
+    sample_traits<To>::is_integer && sample_traits<From>::bit_depth > sample_traits<To>::bit_depth;
+
+// ディザの乱数はスレッドごとに続けて数え、呼び出しごとに同じノイズにならないようにする
+static thread_local uint32_t dither_counter = 0;
+
+// 前の値に依存しない整数のハッシュで一様な乱数を作り、ノイズを作るループもベクトル化させる
+static uint32_t dither_hash(uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7feb352dU;
+    value ^= value >> 15;
+    value *= 0x846ca68bU;
+    value ^= value >> 16;
+    return value;
+}
+
+template <typename T>
+static T dither_uniform(uint32_t const counter) {
+    // 上位24bitを使い、floatでも1にならないようにする
+    return static_cast<T>(static_cast<int32_t>(dither_hash(counter) >> 8)) * static_cast<T>(1.0 / 16777216.0);
+}
+
+template <typename T>
+static void fill_dither(T *const noise, std::size_t const length, dither_type const dither) {
+    T *__restrict const noise_ptr = noise;
+    uint32_t const counter = dither_counter;
+    auto const count = static_cast<int32_t>(length);
+
+    switch (dither) {
+        case dither_type::rectangular:
+            for (int32_t idx = 0; idx < count; ++idx) {
+                noise_ptr[idx] = dither_uniform<T>(counter + idx) - static_cast<T>(0.5);
+            }
+            dither_counter = counter + count;
+            break;
+        case dither_type::triangular:
+            for (int32_t idx = 0; idx < count; ++idx) {
+                noise_ptr[idx] = dither_uniform<T>(counter + idx * 2) - dither_uniform<T>(counter + idx * 2 + 1);
+            }
+            dither_counter = counter + count * 2;
+            break;
+        case dither_type::none:
+            std::fill_n(noise_ptr, length, T(0));
+            break;
+    }
+}
+
+template <typename From, typename To, bool IsDithered>
+static void convert(From const *const from, int32_t const from_stride, To *const to, int32_t const to_stride,
+                    int32_t const length, compute_t<From, To> const *const noise) {
+    using T = compute_t<From, To>;
+
+    From const *__restrict const from_ptr = from;
+    To *__restrict const to_ptr = to;
+    T const *__restrict const noise_ptr = noise;
+
+    if constexpr (std::is_same_v<From, To>) {
+        for (int32_t idx = 0; idx < length; ++idx) {
+            to_ptr[idx * to_stride] = from_ptr[idx * from_stride];
+        }
+    } else if constexpr (sample_traits<To>::is_integer) {
+        using integer_t = std::conditional_t<std::is_same_v<To, int16_t>, int32_t, int64_t>;
+
+        T const gain = static_cast<T>(sample_traits<To>::scale / sample_traits<From>::scale);
+        T const min = static_cast<T>(sample_traits<To>::min);
+        T const max = static_cast<T>(sample_traits<To>::max);
+        // floorはベクトル化されにくいので、範囲に収めてから負にならないようにずらして切り捨てで四捨五入する
+        T const offset = static_cast<T>(0.5) - min;
+        auto const integer_min = static_cast<integer_t>(sample_traits<To>::min);
+
+        for (int32_t idx = 0; idx < length; ++idx) {
+            T value = static_cast<T>(from_ptr[idx * from_stride]) * gain;
+            if constexpr (IsDithered) {
+                value += noise_ptr[idx];
+            }
+            value = std::min(std::max(value, min), max) + offset;
+            to_ptr[idx * to_stride] = static_cast<To>(static_cast<integer_t>(value) + integer_min);
+        }
+    } else {
+        T const gain = static_cast<T>(sample_traits<To>::scale / sample_traits<From>::scale);
+
+        for (int32_t idx = 0; idx < length; ++idx) {
+            to_ptr[idx * to_stride] = static_cast<To>(static_cast<T>(from_ptr[idx * from_stride]) * gain);
+        }
+    }
+}
+
+template <typename From, typename To, bool IsDithered>
+static void convert_strided(From const *const from, uint32_t const from_stride, To *const to,
+                            uint32_t const to_stride, std::size_t const length,
+                            compute_t<From, To> const *const noise) {
+    auto const count = static_cast<int32_t>(length);
+
+    // 連続していれば間隔を定数にしてベクトル化させる
+    if (from_stride == 1 && to_stride == 1) {
+        if constexpr (std::is_same_v<From, To>) {
+            std::memcpy(to, from, length * sizeof(From));
+        } else {
+            convert<From, To, IsDithered>(from, 1, to, 1, count, noise);
+        }
+    } else {
+        convert<From, To, IsDithered>(from, static_cast<int32_t>(from_stride), to, static_cast<int32_t>(to_stride),
+                                      count, noise);
+    }
+}
+
+template <typename From>
+static bool samples_from(From const *const from, uint32_t const from_stride, void *const to,
+                         pcm_format const to_format, uint32_t const to_stride, std::size_t const length,
+                         dither_type const dither) {
+    switch (to_format) {
+        case pcm_format::float32:
+            convert::samples(from, from_stride, static_cast<float *>(to), to_stride, length, dither);
+            return true;
+        case pcm_format::float64:
+            convert::samples(from, from_stride, static_cast<double *>(to), to_stride, length, dither);
+            return true;
+        case pcm_format::int16:
+            convert::samples(from, from_stride, static_cast<int16_t *>(to), to_stride, length, dither);
+            return true;
+        case pcm_format::fixed824:
+            convert::samples(from, from_stride, static_cast<int32_t *>(to), to_stride, length, dither);
+            return true;
+        case pcm_format::other:
+            return false;
+    }
+
+    return false;
+}
+}  // namespace yas::audio::convert_kernels_utils
+
+template <typename From, typename To>
+void convert::samples(From const *const from, uint32_t const from_stride, To *const to, uint32_t const to_stride,
+                      std::size_t const length, dither_type const dither) {
+    using namespace convert_kernels_utils;
+
+    if (length == 0) {
+        return;
+    }
+
+    if constexpr (is_ditherable<From, To>) {
+        if (dither != dither_type::none) {
+            compute_t<From, To> noise[dither_block_length];
+
+            // ノイズを作るループと変換するループを分けて、変換の方をベクトル化させる
+            for (std::size_t offset = 0; offset < length; offset += dither_block_length) {
+                auto const block_length = std::min(dither_block_length, length - offset);
+                fill_dither(noise, block_length, dither);
+                convert_strided<From, To, true>(&from[offset * from_stride], from_stride, &to[offset * to_stride],
+                                                to_stride, block_length, noise);
+            }
+            return;
+        }
+    }
+
+    convert_strided<From, To, false>(from, from_stride, to, to_stride, length, nullptr);
+}
+
+bool convert::samples(void const *const from, pcm_format const from_format, uint32_t const from_stride,
+                      void *const to, pcm_format const to_format, uint32_t const to_stride, std::size_t const length,
+                      dither_type const dither) {
+    using namespace convert_kernels_utils;
+
+    if (!is_convertible(from_format) || !is_convertible(to_format)) {
+        return false;
+    }
+
+    switch (from_format) {
+        case pcm_format::float32:
+            return samples_from(static_cast<float const *>(from), from_stride, to, to_format, to_stride, length,
+                                dither);
+        case pcm_format::float64:
+            return samples_from(static_cast<double const *>(from), from_stride, to, to_format, to_stride, length,
+                                dither);
+        case pcm_format::int16:
+            return samples_from(static_cast<int16_t const *>(from), from_stride, to, to_format, to_stride, length,
+                                dither);
+        case pcm_format::fixed824:
+            return samples_from(static_cast<int32_t const *>(from), from_stride, to, to_format, to_stride, length,
+                                dither);
+        case pcm_format::other:
+            return false;
+    }
+
+    return false;
+}
+
+bool convert::is_convertible(pcm_format const pcm_format) {
+    switch (pcm_format) {
+        case pcm_format::float32:
+        case pcm_format::float64:
+        case pcm_format::int16:
+        case pcm_format::fixed824:
+            return true;
+        case pcm_format::other:
+            return false;
+    }
+
+    return false;
+}
+
+template void convert::samples(float const *const, uint32_t const, float *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(float const *const, uint32_t const, double *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(float const *const, uint32_t const, int16_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(float const *const, uint32_t const, int32_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(double const *const, uint32_t const, float *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(double const *const, uint32_t const, double *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(double const *const, uint32_t const, int16_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(double const *const, uint32_t const, int32_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int16_t const *const, uint32_t const, float *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int16_t const *const, uint32_t const, double *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int16_t const *const, uint32_t const, int16_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int16_t const *const, uint32_t const, int32_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int32_t const *const, uint32_t const, float *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int32_t const *const, uint32_t const, double *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int32_t const *const, uint32_t const, int16_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+template void convert::samples(int32_t const *const, uint32_t const, int32_t *const, uint32_t const,
+                               std::size_t const, dither_type const);
+
+std::string yas::to_string(dither_type const &dither) {
+    switch (dither) {
+        case dither_type::none:
+            return "none";
+        case dither_type::rectangular:
+            return "rectangular";
+        case dither_type::triangular:
+            return "triangular";
+    }
+
+    throw "dither not found.";
+}
+
+std::ostream &operator<<(std::ostream &os, yas::audio::dither_type const &value) {
+    os << to_string(value);
+    return os;
+}
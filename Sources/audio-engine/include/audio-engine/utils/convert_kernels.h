@@ -0,0 +1,43 @@
+//
+//  convert_kernels.h
+//
+
+#pragma once
+
+#include <audio-engine/common/types.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yas::audio {
+/// 整数へ丸めるときに足すノイズ
+enum class dither_type {
+    none,
+    /// ±0.5LSBの一様分布
+    rectangular,
+    /// ±1LSBの三角分布
+    triangular,
+};
+}  // namespace yas::audio
+
+namespace yas::audio::convert {
+/// fromのfrom_strideおきのサンプルを、型を変換しながらtoのto_strideおきへlength個書き込む
+/// int16_tは16bit整数、int32_tは固定小数点8.24として扱い、整数へは四捨五入して範囲に収める
+/// ditherは精度の下がる整数への変換でだけ使う
+template <typename From, typename To>
+void samples(From const *const from, uint32_t const from_stride, To *const to, uint32_t const to_stride,
+             std::size_t const length, dither_type const dither = dither_type::none);
+
+/// pcm_formatで型を指定する。float32、float64、int16、fixed824以外ならfalseを返して何もしない
+bool samples(void const *const from, pcm_format const from_format, uint32_t const from_stride, void *const to,
+             pcm_format const to_format, uint32_t const to_stride, std::size_t const length,
+             dither_type const dither = dither_type::none);
+
+[[nodiscard]] bool is_convertible(pcm_format const);
+}  // namespace yas::audio::convert
+
+namespace yas {
+std::string to_string(audio::dither_type const &);
+}
+
+std::ostream &operator<<(std::ostream &, yas::audio::dither_type const &);
@@ -2,8 +2,8 @@
 //  math.cpp
 //
 
-#include <Accelerate/Accelerate.h>
 #include <audio-engine/utils/math.h>
+#include <audio-engine/utils/oscillator_kernels.h>
 
 using namespace yas;
 using namespace yas::audio;
@@ -53,17 +53,19 @@ float math::fill_sine(float *const out_data, uint32_t const length, double const
         return start_phase;
     }
 
-    double phase = start_phase;
+    float *__restrict const out_ptr = out_data;
+    // 1周期を1とした位置にして、負にならないように先に0以上1未満へ収めておく
+    double const start = start_phase / two_pi - std::floor(start_phase / two_pi);
+    double const step = phase_per_frame / two_pi - std::floor(phase_per_frame / two_pi);
+    auto const count = static_cast<int32_t>(length);
 
-    for (uint32_t i = 0; i < length; ++i) {
-        out_data[i] = phase;
-        phase = fmod(phase + phase_per_frame, two_pi);
+    // 位置をフレームごとに足していかずに求めて、ループをベクトル化させる
+    for (int32_t idx = 0; idx < count; ++idx) {
+        double const phase = start + step * static_cast<double>(idx);
+        out_ptr[idx] = oscillator::sine(static_cast<float>(phase - static_cast<double>(static_cast<int64_t>(phase))));
     }
 
-    int const len = length;
-    vvsinf(out_data, out_data, &len);
-
-    return phase;
+    return fmod(start_phase + phase_per_frame * static_cast<double>(length), two_pi);
 }
 
 #pragma mark - level
@@ -0,0 +1,58 @@
+//
+//  mix_kernels.cpp
+//
+
+#include "mix_kernels.h"
+
+#include <cstdint>
+
+using namespace yas;
+using namespace yas::audio;
+
+// 特定の命令セットに依存せず、コンパイラがベクトル化できるように分岐のない単純なループにしている
+
+template <typename T>
+void mix::add_scaled(T *const out, T const *const in, std::size_t const length, T const gain) {
+    T *__restrict const out_ptr = out;
+    T const *__restrict const in_ptr = in;
+
+    if (gain == T(1)) {
+        for (std::size_t idx = 0; idx < length; ++idx) {
+            out_ptr[idx] += in_ptr[idx];
+        }
+    } else {
+        for (std::size_t idx = 0; idx < length; ++idx) {
+            out_ptr[idx] += in_ptr[idx] * gain;
+        }
+    }
+}
+
+template <typename T>
+void mix::add_ramped(T *const out, T const *const in, std::size_t const length, T const begin_gain,
+                     T const end_gain) {
+    if (length == 0) {
+        return;
+    }
+
+    if (begin_gain == end_gain) {
+        add_scaled(out, in, length, end_gain);
+        return;
+    }
+
+    T *__restrict const out_ptr = out;
+    T const *__restrict const in_ptr = in;
+
+    // 最後のフレームでend_gainになるようにする
+    T const step = (end_gain - begin_gain) / static_cast<T>(length);
+
+    // 符号なし64bitからの変換はベクトル化されにくいので、32bitの符号付き整数で数える
+    auto const count = static_cast<int32_t>(length);
+    for (int32_t idx = 0; idx < count; ++idx) {
+        out_ptr[idx] += in_ptr[idx] * (begin_gain + step * static_cast<T>(idx + 1));
+    }
+}
+
+template void mix::add_scaled(float *const, float const *const, std::size_t const, float const);
+template void mix::add_scaled(double *const, double const *const, std::size_t const, double const);
+template void mix::add_ramped(float *const, float const *const, std::size_t const, float const, float const);
+template void mix::add_ramped(double *const, double const *const, std::size_t const, double const, double const);
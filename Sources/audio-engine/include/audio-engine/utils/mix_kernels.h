@@ -0,0 +1,17 @@
+//
+//  mix_kernels.h
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace yas::audio::mix {
+/// outにinをgain倍して足す
+template <typename T>
+void add_scaled(T *const out, T const *const in, std::size_t const length, T const gain);
+
+/// outにinを足す。gainはbegin_gainからend_gainへ直線的に変化させる
+template <typename T>
+void add_ramped(T *const out, T const *const in, std::size_t const length, T const begin_gain, T const end_gain);
+}  // namespace yas::audio::mix
@@ -0,0 +1,293 @@
+//
+//  oscillator_bank.cpp
+//
+
+#include "oscillator_bank.h"
+
+#include <audio-engine/utils/oscillator_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+using namespace yas;
+using namespace yas::audio;
+
+namespace yas::audio::oscillator_bank_utils {
+// 同じチャンネルと波形の発振器をこの数ずつまとめて計算する。足りない分は音の出ない発振器で埋める
+static std::size_t constexpr lane_count = 8;
+
+template <typename T>
+static T wrapped_phase(double const phase) {
+    return static_cast<T>(phase - std::floor(phase));
+}
+
+template <typename T>
+static T table_value(T const *const table, int32_t const table_size, T const phase) {
+    T const position = phase * static_cast<T>(table_size);
+    int32_t const idx = std::min(static_cast<int32_t>(position), table_size - 1);
+    T const fraction = position - static_cast<T>(idx);
+    T const value = table[idx];
+    return value + (table[idx + 1] - value) * fraction;
+}
+
+// 足す順番を固定してベクトルのまま足せるようにする
+template <typename T>
+static T sum_lanes(T const *const values) {
+    return ((values[0] + values[1]) + (values[2] + values[3])) + ((values[4] + values[5]) + (values[6] + values[7]));
+}
+}  // namespace yas::audio::oscillator_bank_utils
+
+template <typename T>
+oscillator_bank<T>::oscillator_bank(double const sample_rate, uint32_t const channel_count)
+    : _sample_rate(sample_rate), _channel_count(channel_count) {
+    if (sample_rate <= 0.0) {
+        throw std::invalid_argument("oscillator_bank - sample_rate is not positive.");
+    }
+}
+
+template <typename T>
+double oscillator_bank<T>::sample_rate() const {
+    return this->_sample_rate;
+}
+
+template <typename T>
+uint32_t oscillator_bank<T>::channel_count() const {
+    return this->_channel_count;
+}
+
+template <typename T>
+std::size_t oscillator_bank<T>::voice_count() const {
+    return this->_voices.size();
+}
+
+template <typename T>
+std::size_t oscillator_bank<T>::add_voice(oscillator_voice const &voice) {
+    if (voice.channel >= this->_channel_count) {
+        throw std::out_of_range("oscillator_bank::add_voice - channel is out of range.");
+    }
+
+    // 並べ直す前に、描画で進んだ位置を引き継ぐ
+    for (std::size_t idx = 0; idx < this->_voices.size(); ++idx) {
+        this->_voices.at(idx).phase = this->_phases.at(this->_slots.at(idx));
+    }
+
+    this->_voices.push_back(voice);
+    this->_update_layout();
+
+    return this->_voices.size() - 1;
+}
+
+template <typename T>
+void oscillator_bank<T>::remove_all_voices() {
+    this->_voices.clear();
+    this->_update_layout();
+}
+
+template <typename T>
+void oscillator_bank<T>::set_frequency(std::size_t const voice_idx, double const frequency) {
+    this->_voices.at(voice_idx).frequency = frequency;
+    this->_update_increment(voice_idx);
+}
+
+template <typename T>
+void oscillator_bank<T>::set_phase(std::size_t const voice_idx, double const phase) {
+    this->_voices.at(voice_idx).phase = phase;
+    this->_phases.at(this->_slots.at(voice_idx)) = oscillator_bank_utils::wrapped_phase<T>(phase);
+}
+
+template <typename T>
+void oscillator_bank<T>::set_gain(std::size_t const voice_idx, double const gain) {
+    this->_voices.at(voice_idx).gain = gain;
+    this->_gains.at(this->_slots.at(voice_idx)) = static_cast<T>(gain);
+}
+
+template <typename T>
+double oscillator_bank<T>::frequency(std::size_t const voice_idx) const {
+    return this->_voices.at(voice_idx).frequency;
+}
+
+template <typename T>
+double oscillator_bank<T>::phase(std::size_t const voice_idx) const {
+    return this->_phases.at(this->_slots.at(voice_idx));
+}
+
+template <typename T>
+double oscillator_bank<T>::gain(std::size_t const voice_idx) const {
+    return this->_voices.at(voice_idx).gain;
+}
+
+template <typename T>
+void oscillator_bank<T>::set_table(std::vector<T> table) {
+    if (!table.empty()) {
+        table.push_back(table.front());
+    }
+    this->_table = std::move(table);
+}
+
+template <typename T>
+void oscillator_bank<T>::render(T *const *const outs, uint32_t const length) {
+    for (uint32_t ch_idx = 0; ch_idx < this->_channel_count; ++ch_idx) {
+        std::fill_n(outs[ch_idx], length, T(0));
+    }
+
+    for (auto const &group : this->_groups) {
+        switch (group.waveform) {
+            case oscillator_waveform::sine:
+                this->_render_group<oscillator_waveform::sine>(group, outs[group.channel], length);
+                break;
+            case oscillator_waveform::saw:
+                this->_render_group<oscillator_waveform::saw>(group, outs[group.channel], length);
+                break;
+            case oscillator_waveform::table:
+                this->_render_group<oscillator_waveform::table>(group, outs[group.channel], length);
+                break;
+        }
+    }
+}
+
+template <typename T>
+void oscillator_bank<T>::_update_layout() {
+    using namespace oscillator_bank_utils;
+
+    auto const voice_count = this->_voices.size();
+
+    std::vector<std::size_t> order(voice_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t const lhs, std::size_t const rhs) {
+        auto const &lhs_voice = this->_voices.at(lhs);
+        auto const &rhs_voice = this->_voices.at(rhs);
+        return std::make_pair(lhs_voice.channel, lhs_voice.waveform) <
+               std::make_pair(rhs_voice.channel, rhs_voice.waveform);
+    });
+
+    this->_slots.resize(voice_count);
+    this->_groups.clear();
+    this->_phases.clear();
+    this->_increments.clear();
+    this->_inverse_increments.clear();
+    this->_gains.clear();
+
+    auto const pad = [this] {
+        while (this->_phases.size() % lane_count != 0) {
+            this->_phases.push_back(0);
+            this->_increments.push_back(0);
+            this->_inverse_increments.push_back(0);
+            this->_gains.push_back(0);
+        }
+    };
+
+    for (auto const &voice_idx : order) {
+        auto const &voice = this->_voices.at(voice_idx);
+
+        if (this->_groups.empty() || this->_groups.back().channel != voice.channel ||
+            this->_groups.back().waveform != voice.waveform) {
+            pad();
+            if (!this->_groups.empty()) {
+                this->_groups.back().end = this->_phases.size();
+            }
+            this->_groups.push_back(
+                {.channel = voice.channel, .waveform = voice.waveform, .begin = this->_phases.size(), .end = 0});
+        }
+
+        this->_slots.at(voice_idx) = this->_phases.size();
+        this->_phases.push_back(wrapped_phase<T>(voice.phase));
+        this->_increments.push_back(0);
+        this->_inverse_increments.push_back(0);
+        this->_gains.push_back(static_cast<T>(voice.gain));
+    }
+
+    pad();
+    if (!this->_groups.empty()) {
+        this->_groups.back().end = this->_phases.size();
+    }
+
+    for (std::size_t voice_idx = 0; voice_idx < voice_count; ++voice_idx) {
+        this->_update_increment(voice_idx);
+    }
+}
+
+template <typename T>
+void oscillator_bank<T>::_update_increment(std::size_t const voice_idx) {
+    auto const slot = this->_slots.at(voice_idx);
+    // 1フレームで半周期より進むと位置の折り返しが1回で済まなくなる
+    double const increment = std::clamp(this->_voices.at(voice_idx).frequency / this->_sample_rate, 0.0, 0.5);
+
+    this->_increments.at(slot) = static_cast<T>(increment);
+    this->_inverse_increments.at(slot) = increment > 0.0 ? static_cast<T>(1.0 / increment) : T(0);
+}
+
+template <typename T>
+template <oscillator_waveform Waveform>
+void oscillator_bank<T>::_render_group(group const &group, T *const out, uint32_t const length) {
+    using namespace oscillator_bank_utils;
+
+    if constexpr (Waveform == oscillator_waveform::table) {
+        if (this->_table.empty()) {
+            for (std::size_t idx = group.begin; idx < group.end; ++idx) {
+                T const phase = this->_phases[idx] + static_cast<T>(length) * this->_increments[idx];
+                this->_phases[idx] = wrapped_phase<T>(phase);
+            }
+            return;
+        }
+    }
+
+    T *__restrict const out_ptr = out;
+    T *__restrict const phases = &this->_phases[group.begin];
+    T const *__restrict const increments = &this->_increments[group.begin];
+    T const *__restrict const inverse_increments = &this->_inverse_increments[group.begin];
+    T const *__restrict const gains = &this->_gains[group.begin];
+    T const *__restrict const table = this->_table.data();
+    auto const table_size = static_cast<int32_t>(this->_table.size()) - 1;
+    auto const voice_count = static_cast<int32_t>(group.end - group.begin);
+    auto const frame_count = static_cast<int32_t>(length);
+
+    // resamplerのdotと同じく、発振器をlane_count個ずつ別々の和に足し込んでベクトル化させる
+    for (int32_t frm_idx = 0; frm_idx < frame_count; ++frm_idx) {
+        T sums[lane_count] = {};
+
+        for (int32_t top_idx = 0; top_idx < voice_count; top_idx += lane_count) {
+            for (int32_t lane = 0; lane < static_cast<int32_t>(lane_count); ++lane) {
+                auto const idx = top_idx + lane;
+                T const phase = phases[idx];
+                T const increment = increments[idx];
+
+                if constexpr (Waveform == oscillator_waveform::sine) {
+                    sums[lane] += oscillator::sine(phase) * gains[idx];
+                } else if constexpr (Waveform == oscillator_waveform::saw) {
+                    sums[lane] += oscillator::saw(phase, inverse_increments[idx]) * gains[idx];
+                } else {
+                    sums[lane] += table_value(table, table_size, phase) * gains[idx];
+                }
+
+                // 比較で選ぶとベクトル化されにくいので、2未満で負にならない位置を切り捨てて折り返す
+                T const next = phase + increment;
+                phases[idx] = next - static_cast<T>(static_cast<int32_t>(next));
+            }
+        }
+
+        out_ptr[frm_idx] += sum_lanes(sums);
+    }
+}
+
+template struct yas::audio::oscillator_bank<float>;
+template struct yas::audio::oscillator_bank<double>;
+
+std::string yas::to_string(oscillator_waveform const &waveform) {
+    switch (waveform) {
+        case oscillator_waveform::sine:
+            return "sine";
+        case oscillator_waveform::saw:
+            return "saw";
+        case oscillator_waveform::table:
+            return "table";
+    }
+
+    throw "waveform not found.";
+}
+
+std::ostream &operator<<(std::ostream &os, yas::audio::oscillator_waveform const &value) {
+    os << to_string(value);
+    return os;
+}
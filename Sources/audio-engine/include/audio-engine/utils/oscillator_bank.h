@@ -0,0 +1,95 @@
+//
+//  oscillator_bank.h
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace yas::audio {
+enum class oscillator_waveform {
+    sine,
+    /// PolyBLEPで帯域を制限したノコギリ波
+    saw,
+    /// set_tableで渡した1周期分の波形を線形補間して読む
+    table,
+};
+
+struct oscillator_voice {
+    oscillator_waveform waveform = oscillator_waveform::sine;
+    uint32_t channel = 0;
+    /// 0以上でナイキスト周波数を超える分は収める
+    double frequency = 0.0;
+    /// 1周期を1とした開始位置
+    double phase = 0.0;
+    double gain = 1.0;
+};
+
+/// 多数の発振器をまとめて、インターリーブされていないチャンネルごとのデータへ書き込む
+/// 同じチャンネルと波形の発振器を並べて持ち、発振器をまたいでベクトル化する
+template <typename T>
+struct oscillator_bank final {
+    oscillator_bank(double const sample_rate, uint32_t const channel_count);
+
+    [[nodiscard]] double sample_rate() const;
+    [[nodiscard]] uint32_t channel_count() const;
+    [[nodiscard]] std::size_t voice_count() const;
+
+    /// 追加した順のインデックスを返す
+    std::size_t add_voice(oscillator_voice const &);
+    void remove_all_voices();
+
+    void set_frequency(std::size_t const voice_idx, double const frequency);
+    void set_phase(std::size_t const voice_idx, double const phase);
+    void set_gain(std::size_t const voice_idx, double const gain);
+
+    [[nodiscard]] double frequency(std::size_t const voice_idx) const;
+    [[nodiscard]] double phase(std::size_t const voice_idx) const;
+    [[nodiscard]] double gain(std::size_t const voice_idx) const;
+
+    /// tableの発振器すべてで共有する。空なら0を出す
+    void set_table(std::vector<T> table);
+
+    /// outsのチャンネルごとにlengthフレームを上書きし、発振器の位置を進める
+    void render(T *const *const outs, uint32_t const length);
+
+   private:
+    struct group {
+        uint32_t channel;
+        oscillator_waveform waveform;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    double const _sample_rate;
+    uint32_t const _channel_count;
+
+    std::vector<oscillator_voice> _voices;
+    std::vector<std::size_t> _slots;
+    std::vector<group> _groups;
+
+    // 描画に使う値を発振器ごとではなく値ごとに並べる
+    std::vector<T> _phases;
+    std::vector<T> _increments;
+    std::vector<T> _inverse_increments;
+    std::vector<T> _gains;
+
+    // 線形補間で末尾から先頭へつなぐために、先頭の値を最後に足しておく
+    std::vector<T> _table;
+
+    void _update_layout();
+    void _update_increment(std::size_t const voice_idx);
+    template <oscillator_waveform Waveform>
+    void _render_group(group const &, T *const out, uint32_t const length);
+};
+}  // namespace yas::audio
+
+namespace yas {
+std::string to_string(audio::oscillator_waveform const &);
+}
+
+std::ostream &operator<<(std::ostream &, yas::audio::oscillator_waveform const &);
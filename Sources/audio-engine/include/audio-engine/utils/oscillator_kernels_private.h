@@ -0,0 +1,69 @@
+//
+//  oscillator_kernels_private.h
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace yas::audio::oscillator_kernels_utils {
+// sin(2πu) ≒ u * P(u²)を-0.25≦u≦0.25で最大誤差が最小になるように合わせた係数
+template <typename T>
+struct sine_coefficients;
+
+template <>
+struct sine_coefficients<float> {
+    static float constexpr c1 = 6.283185160089479f;
+    static float constexpr c3 = -41.34165503141651f;
+    static float constexpr c5 = 81.60100407327357f;
+    static float constexpr c7 = -76.54978229382905f;
+    static float constexpr c9 = 39.53670606730218f;
+};
+
+template <>
+struct sine_coefficients<double> {
+    static double constexpr c1 = 6.283185306487505;
+    static double constexpr c3 = -41.341701929772505;
+    static double constexpr c5 = 81.60520943106748;
+    static double constexpr c7 = -76.70366782731983;
+    static double constexpr c9 = 41.99998982350621;
+    static double constexpr c11 = -14.33702467670608;
+};
+}  // namespace yas::audio::oscillator_kernels_utils
+
+namespace yas::audio::oscillator {
+// 分岐せずに計算して、発振器をまたいだループをベクトル化できるようにしている
+template <typename T>
+T sine(T const phase) {
+    using coefs = oscillator_kernels_utils::sine_coefficients<T>;
+
+    // sin(2πp) = -sin(2π(p - 0.5))で半周期ずらしてから、±0.25の範囲へ折り返す
+    T const shifted = phase - static_cast<T>(0.5);
+    T const abs = std::abs(shifted);
+    T const u = std::copysign(std::min(abs, static_cast<T>(0.5) - abs), shifted);
+    T const u2 = u * u;
+
+    if constexpr (std::is_same_v<T, float>) {
+        return -u * (coefs::c1 + u2 * (coefs::c3 + u2 * (coefs::c5 + u2 * (coefs::c7 + u2 * coefs::c9))));
+    } else {
+        return -u * (coefs::c1 +
+                     u2 * (coefs::c3 + u2 * (coefs::c5 + u2 * (coefs::c7 + u2 * (coefs::c9 + u2 * coefs::c11)))));
+    }
+}
+
+template <typename T>
+T saw(T const phase, T const inverse_increment) {
+    T const one = static_cast<T>(1);
+    T const half = static_cast<T>(0.5);
+    // 不連続な点の直後は-(1 - p / inc)²、直前は(1 + (p - 1) / inc)²を引く
+    T const head = one - phase * inverse_increment;
+    T const tail = one + (phase - one) * inverse_increment;
+    // 比較で選ぶとベクトル化されにくいので、絶対値を足して負の範囲を0にする
+    T const clamped_head = (head + std::abs(head)) * half;
+    T const clamped_tail = (tail + std::abs(tail)) * half;
+
+    return phase + phase - one + clamped_head * clamped_head - clamped_tail * clamped_tail;
+}
+}  // namespace yas::audio::oscillator
@@ -0,0 +1,132 @@
+//
+//  rendering_worker_pool.cpp
+//
+
+#include "rendering_worker_pool.h"
+
+using namespace yas;
+using namespace yas::audio;
+
+// 空いたスレッドから次のインデックスを取っていく
+bool rendering_worker_pool::job::run() {
+    bool is_ran = false;
+
+    while (true) {
+        auto const idx = this->next_idx.fetch_add(1);
+        if (idx >= this->count) {
+            return is_ran;
+        }
+
+        this->task(this->context, idx);
+        this->finished_count.fetch_add(1);
+        is_ran = true;
+    }
+}
+
+rendering_worker_pool::rendering_worker_pool(std::size_t const thread_count) {
+    this->_threads.reserve(thread_count);
+
+    for (std::size_t idx = 0; idx < thread_count; ++idx) {
+        this->_threads.emplace_back([this] { this->_run_worker(); });
+    }
+}
+
+rendering_worker_pool::~rendering_worker_pool() {
+    this->_is_stopped = true;
+    this->_generation.fetch_add(1);
+    this->_generation.notify_all();
+
+    for (auto &thread : this->_threads) {
+        thread.join();
+    }
+}
+
+std::size_t rendering_worker_pool::thread_count() const {
+    return this->_threads.size();
+}
+
+void rendering_worker_pool::_parallel_for(std::size_t const count, void const *const context, task_f const task) {
+    if (count == 0) {
+        return;
+    }
+
+    job *job = nullptr;
+
+    if (!this->_threads.empty() && count > 1) {
+        for (auto &candidate : this->_jobs) {
+            auto expected = job_state::idle;
+            if (candidate.state.compare_exchange_strong(expected, job_state::preparing)) {
+                job = &candidate;
+                break;
+            }
+        }
+    }
+
+    if (!job) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            task(context, idx);
+        }
+        return;
+    }
+
+    // 前の処理を見ていたワーカーが枠から抜けるのを待ってから書き込む
+    while (job->user_count.load() > 0) {
+        std::this_thread::yield();
+    }
+
+    job->task = task;
+    job->context = context;
+    job->count = count;
+    job->next_idx = 0;
+    job->finished_count = 0;
+    job->state = job_state::active;
+
+    this->_generation.fetch_add(1);
+    this->_generation.notify_all();
+
+    job->run();
+
+    // ワーカーが取ったインデックスの処理が終わるのを待つ
+    while (job->finished_count.load() < count) {
+        std::this_thread::yield();
+    }
+
+    job->state = job_state::idle;
+}
+
+void rendering_worker_pool::_run_worker() {
+    while (true) {
+        auto const generation = this->_generation.load();
+
+        if (this->_is_stopped) {
+            return;
+        }
+
+        bool is_ran = false;
+
+        for (auto &job : this->_jobs) {
+            job.user_count.fetch_add(1);
+
+            if (job.state.load() == job_state::active) {
+                is_ran = job.run() || is_ran;
+            }
+
+            job.user_count.fetch_sub(1);
+        }
+
+        // 処理するものがなければ、次の処理が入るまで眠る
+        if (!is_ran) {
+            this->_generation.wait(generation);
+        }
+    }
+}
+
+rendering_worker_pool_ptr rendering_worker_pool::make_shared() {
+    auto const concurrency = std::thread::hardware_concurrency();
+    // 呼び出したスレッドも処理に加わるので1つ減らす
+    return make_shared(concurrency > 1 ? concurrency - 1 : 0);
+}
+
+rendering_worker_pool_ptr rendering_worker_pool::make_shared(std::size_t const thread_count) {
+    return rendering_worker_pool_ptr(new rendering_worker_pool{thread_count});
+}
@@ -0,0 +1,74 @@
+//
+//  rendering_worker_pool.h
+//
+
+#pragma once
+
+#include <audio-engine/common/ptr.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace yas::audio {
+/// 描画スレッドから呼べるように、確保やロック、ブロックする待機をせずに処理を複数のスレッドで分担する
+/// 処理は決まった数だけ用意した枠に入れて渡し、空いた枠がなければ呼び出したスレッドだけで順番に処理する
+struct rendering_worker_pool final {
+    static std::size_t constexpr job_capacity = 8;
+
+    ~rendering_worker_pool();
+
+    [[nodiscard]] std::size_t thread_count() const;
+
+    /// 0からcount未満のインデックスでtaskを呼ぶ。呼び出したスレッドも処理に加わり、すべて終わるまでスピンして待つ
+    /// taskの中から呼ばれた場合は別の枠を使う。taskは例外を投げてはならない
+    template <typename Task>
+    void parallel_for(std::size_t const count, Task const &task) {
+        this->_parallel_for(count, &task, [](void const *const context, std::size_t const idx) {
+            (*static_cast<Task const *>(context))(idx);
+        });
+    }
+
+    [[nodiscard]] static rendering_worker_pool_ptr make_shared();
+    [[nodiscard]] static rendering_worker_pool_ptr make_shared(std::size_t const thread_count);
+
+   private:
+    using task_f = void (*)(void const *const, std::size_t const);
+
+    enum class job_state : uint32_t {
+        idle,
+        preparing,
+        active,
+    };
+
+    struct job {
+        std::atomic<job_state> state{job_state::idle};
+        // 枠を見ているワーカーの数。0になるまで次の処理を書き込まない
+        std::atomic<std::size_t> user_count{0};
+        std::atomic<std::size_t> next_idx{0};
+        std::atomic<std::size_t> finished_count{0};
+
+        task_f task = nullptr;
+        void const *context = nullptr;
+        std::size_t count = 0;
+
+        bool run();
+    };
+
+    std::array<job, job_capacity> _jobs;
+    std::vector<std::thread> _threads;
+    std::atomic<uint32_t> _generation{0};
+    std::atomic<bool> _is_stopped{false};
+
+    explicit rendering_worker_pool(std::size_t const thread_count);
+
+    void _parallel_for(std::size_t const count, void const *const context, task_f const);
+    void _run_worker();
+
+    rendering_worker_pool(rendering_worker_pool const &) = delete;
+    rendering_worker_pool(rendering_worker_pool &&) = delete;
+    rendering_worker_pool &operator=(rendering_worker_pool const &) = delete;
+    rendering_worker_pool &operator=(rendering_worker_pool &&) = delete;
+};
+}  // namespace yas::audio
@@ -0,0 +1,355 @@
+//
+//  resampler.cpp
+//
+
+#include "resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+using namespace yas;
+using namespace yas::audio;
+
+namespace yas::audio::resampler_utils {
+struct tier {
+    uint32_t tap_count;
+    double kaiser_beta;
+    double rolloff;
+};
+
+static tier tier_for(resampler_quality const quality) {
+    switch (quality) {
+        case resampler_quality::low:
+            return {.tap_count = 16, .kaiser_beta = 6.0, .rolloff = 0.85};
+        case resampler_quality::medium:
+            return {.tap_count = 32, .kaiser_beta = 8.6, .rolloff = 0.91};
+        case resampler_quality::high:
+            return {.tap_count = 64, .kaiser_beta = 10.0, .rolloff = 0.945};
+    }
+}
+
+// 比を約分した出力側の値がこれを超えたら、決まった数のフェーズの間を補間する
+static uint64_t constexpr max_exact_phase_count = 1024;
+static uint32_t constexpr interpolated_phase_count = 512;
+static uint32_t constexpr max_tap_count = 512;
+static uint32_t constexpr tap_alignment = 8;
+
+static double ratio(double const input_sample_rate, double const output_sample_rate) {
+    return std::min(1.0, output_sample_rate / input_sample_rate);
+}
+
+// 間引くときは入力から見た遷移帯域の幅を保つためにタップを増やす
+static uint32_t tap_count(double const ratio, resampler_quality const quality) {
+    auto const count = static_cast<uint32_t>(std::ceil(static_cast<double>(tier_for(quality).tap_count) / ratio));
+    return std::min(max_tap_count, (count + tap_alignment - 1) / tap_alignment * tap_alignment);
+}
+
+static double bessel_i0(double const x) {
+    double const half = x * 0.5;
+    double sum = 1.0;
+    double term = 1.0;
+
+    for (uint32_t k = 1; k < 64; ++k) {
+        double const factor = half / static_cast<double>(k);
+        term *= factor * factor;
+        sum += term;
+        if (term < sum * 1.0e-15) {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+// 特定の命令セットに依存せず、コンパイラがベクトル化できるように、タップ数を揃えて別々の和に足し込んでいく
+template <typename T>
+static T dot(T const *const lhs, T const *const rhs, uint32_t const length) {
+    T const *__restrict const lhs_ptr = lhs;
+    T const *__restrict const rhs_ptr = rhs;
+
+    T sums[tap_alignment] = {};
+
+    for (uint32_t idx = 0; idx < length; idx += tap_alignment) {
+        for (uint32_t lane = 0; lane < tap_alignment; ++lane) {
+            sums[lane] += lhs_ptr[idx + lane] * rhs_ptr[idx + lane];
+        }
+    }
+
+    T result = 0;
+    for (uint32_t lane = 0; lane < tap_alignment; ++lane) {
+        result += sums[lane];
+    }
+    return result;
+}
+}  // namespace yas::audio::resampler_utils
+
+double audio::resampler_latency_frames(double const input_sample_rate, double const output_sample_rate,
+                                      resampler_quality const quality) {
+    if (input_sample_rate <= 0.0 || output_sample_rate <= 0.0) {
+        return 0.0;
+    }
+
+    auto const ratio = resampler_utils::ratio(input_sample_rate, output_sample_rate);
+    auto const tap_count = resampler_utils::tap_count(ratio, quality);
+    return static_cast<double>(tap_count / 2) * output_sample_rate / input_sample_rate;
+}
+
+template <typename T>
+resampler<T>::resampler(double const input_sample_rate, double const output_sample_rate,
+                        uint32_t const channel_count, resampler_quality const quality,
+                        std::size_t const maximum_frames)
+    : _input_sample_rate(input_sample_rate),
+      _output_sample_rate(output_sample_rate),
+      _quality(quality),
+      _maximum_frames(std::max(maximum_frames, std::size_t(1))) {
+    auto const input_rate = input_sample_rate > 0.0 ? static_cast<uint64_t>(std::llround(input_sample_rate)) : 0;
+    auto const output_rate = output_sample_rate > 0.0 ? static_cast<uint64_t>(std::llround(output_sample_rate)) : 0;
+
+    if (input_rate == 0 || output_rate == 0 || channel_count == 0) {
+        throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + " : invalid argument. input_sample_rate(" +
+                                    std::to_string(input_sample_rate) + ") output_sample_rate(" +
+                                    std::to_string(output_sample_rate) + ") channel_count(" +
+                                    std::to_string(channel_count) + ")");
+    }
+
+    auto const gcd = std::gcd(input_rate, output_rate);
+    this->_step_numerator = input_rate / gcd;
+    this->_step_denominator = output_rate / gcd;
+
+    this->_is_interpolated = this->_step_denominator > resampler_utils::max_exact_phase_count;
+    this->_phase_count = this->_is_interpolated ? resampler_utils::interpolated_phase_count :
+                                                  static_cast<uint32_t>(this->_step_denominator);
+
+    auto const tier = resampler_utils::tier_for(quality);
+    bool const is_same_rate = this->_step_numerator == this->_step_denominator;
+    double const ratio = resampler_utils::ratio(input_sample_rate, output_sample_rate);
+
+    this->_tap_count = resampler_utils::tap_count(ratio, quality);
+
+    // 入力の周期を1とした遮断周波数。同じレートなら遅延させるだけにする
+    double const cutoff = 0.5 * ratio * (is_same_rate ? 1.0 : tier.rolloff);
+    double const half = static_cast<double>(this->_tap_count / 2);
+    double const window_scale = 1.0 / resampler_utils::bessel_i0(tier.kaiser_beta);
+
+    // 補間するときは次のフェーズを参照できるように1つ多く作る
+    uint32_t const row_count = this->_phase_count + (this->_is_interpolated ? 1 : 0);
+    this->_coefficients.resize(static_cast<std::size_t>(row_count) * this->_tap_count);
+
+    std::vector<double> values(this->_tap_count);
+
+    for (uint32_t row = 0; row < row_count; ++row) {
+        double const fraction = static_cast<double>(row) / static_cast<double>(this->_phase_count);
+        double sum = 0.0;
+
+        for (uint32_t tap = 0; tap < this->_tap_count; ++tap) {
+            double const distance = fraction + half - 1.0 - static_cast<double>(tap);
+            double const position = distance / half;
+            double const window =
+                std::abs(position) <= 1.0 ?
+                    resampler_utils::bessel_i0(tier.kaiser_beta * std::sqrt(1.0 - position * position)) * window_scale :
+                    0.0;
+            double const x = M_PI * 2.0 * cutoff * distance;
+            double const sinc = distance == 0.0 ? 1.0 : std::sin(x) / x;
+
+            values.at(tap) = sinc * window;
+            sum += values.at(tap);
+        }
+
+        // フェーズごとに直流のゲインを1に揃える
+        auto *const row_ptr = &this->_coefficients[static_cast<std::size_t>(row) * this->_tap_count];
+        for (uint32_t tap = 0; tap < this->_tap_count; ++tap) {
+            row_ptr[tap] = static_cast<T>(values.at(tap) / sum);
+        }
+    }
+
+    // 前回から残っている窓と読み飛ばす分に、maximum_framesを出力する入力と持ち越せる入力を足した長さを確保する
+    this->_buffer_capacity = static_cast<std::size_t>(this->_tap_count) * 2 + this->maximum_input_length() +
+                             this->_maximum_frames;
+    this->_channel_buffers.assign(channel_count, std::vector<T>(this->_buffer_capacity, T(0)));
+
+    this->reset();
+}
+
+template <typename T>
+double resampler<T>::input_sample_rate() const {
+    return this->_input_sample_rate;
+}
+
+template <typename T>
+double resampler<T>::output_sample_rate() const {
+    return this->_output_sample_rate;
+}
+
+template <typename T>
+uint32_t resampler<T>::channel_count() const {
+    return static_cast<uint32_t>(this->_channel_buffers.size());
+}
+
+template <typename T>
+resampler_quality resampler<T>::quality() const {
+    return this->_quality;
+}
+
+template <typename T>
+std::size_t resampler<T>::maximum_frames() const {
+    return this->_maximum_frames;
+}
+
+template <typename T>
+uint32_t resampler<T>::tap_count() const {
+    return this->_tap_count;
+}
+
+template <typename T>
+uint32_t resampler<T>::phase_count() const {
+    return this->_phase_count;
+}
+
+template <typename T>
+double resampler<T>::latency_frames() const {
+    return resampler_latency_frames(this->_input_sample_rate, this->_output_sample_rate, this->_quality);
+}
+
+template <typename T>
+double resampler<T>::latency_seconds() const {
+    return this->latency_frames() / this->_output_sample_rate;
+}
+
+template <typename T>
+std::size_t resampler<T>::input_length_for_output(std::size_t const out_length) const {
+    if (out_length == 0) {
+        return 0;
+    }
+
+    auto const last_read_idx =
+        this->_read_idx + static_cast<std::size_t>((this->_phase_numerator + (out_length - 1) * this->_step_numerator) /
+                                                   this->_step_denominator);
+    auto const required_length = last_read_idx + this->_tap_count;
+
+    return required_length > this->_buffered_length ? required_length - this->_buffered_length : 0;
+}
+
+template <typename T>
+std::size_t resampler<T>::maximum_input_length() const {
+    // 読む位置の端数と前回の出力で進んだ分を合わせても2フレームを超えない
+    return static_cast<std::size_t>((this->_maximum_frames * this->_step_numerator + this->_step_denominator - 1) /
+                                    this->_step_denominator) +
+           2;
+}
+
+template <typename T>
+void resampler<T>::process(T const *const *const in, std::size_t const in_length, T *const *const out,
+                           std::size_t const out_length) {
+    std::size_t in_offset = 0;
+    std::size_t out_offset = 0;
+
+    // 確保したバッファに収まるように出力をmaximum_framesずつに分け、最後以外には必要な分だけ入力を渡す
+    do {
+        auto const length = std::min(out_length - out_offset, this->_maximum_frames);
+        auto const is_last = out_offset + length == out_length;
+        auto const remaining_length = in_length - in_offset;
+        auto const chunk_length =
+            is_last ? remaining_length : std::min(remaining_length, this->input_length_for_output(length));
+
+        this->_process(in, in_offset, chunk_length, out, out_offset, length);
+
+        in_offset += chunk_length;
+        out_offset += length;
+    } while (out_offset < out_length);
+}
+
+template <typename T>
+void resampler<T>::reset() {
+    // 最初の出力の窓が0から始まるように、タップ数より1つ少ない無音を置いておく
+    this->_buffered_length = this->_tap_count - 1;
+    this->_read_idx = 0;
+    this->_phase_numerator = 0;
+
+    for (auto &buffer : this->_channel_buffers) {
+        std::fill_n(buffer.begin(), this->_buffered_length, T(0));
+    }
+}
+
+template <typename T>
+void resampler<T>::_process(T const *const *const in, std::size_t const in_offset, std::size_t const in_length,
+                            T *const *const out, std::size_t const out_offset, std::size_t const out_length) {
+    auto const append_length = std::min(std::max(in_length, this->input_length_for_output(out_length)),
+                                        this->_buffer_capacity - this->_buffered_length);
+    auto const copy_length = std::min(in_length, append_length);
+    auto const total_length = this->_buffered_length + append_length;
+
+    for (std::size_t ch_idx = 0; ch_idx < this->_channel_buffers.size(); ++ch_idx) {
+        auto *const buffer_ptr = this->_channel_buffers[ch_idx].data();
+        auto *const append_ptr = &buffer_ptr[this->_buffered_length];
+
+        if (in && in[ch_idx] && copy_length > 0) {
+            std::memcpy(append_ptr, &in[ch_idx][in_offset], copy_length * sizeof(T));
+            std::fill(&append_ptr[copy_length], &buffer_ptr[total_length], T(0));
+        } else {
+            std::fill(append_ptr, &buffer_ptr[total_length], T(0));
+        }
+    }
+
+    this->_buffered_length = total_length;
+
+    uint32_t const tap_count = this->_tap_count;
+    uint64_t const step_denominator = this->_step_denominator;
+    auto const step_integer = static_cast<std::size_t>(this->_step_numerator / step_denominator);
+    uint64_t const step_remainder = this->_step_numerator % step_denominator;
+
+    std::size_t read_idx = this->_read_idx;
+    uint64_t phase_numerator = this->_phase_numerator;
+
+    for (std::size_t ch_idx = 0; ch_idx < this->_channel_buffers.size(); ++ch_idx) {
+        auto const *const buffer_ptr = this->_channel_buffers[ch_idx].data();
+        auto const *const coefficients_ptr = this->_coefficients.data();
+        auto *const out_ptr = &out[ch_idx][out_offset];
+
+        read_idx = this->_read_idx;
+        phase_numerator = this->_phase_numerator;
+
+        for (std::size_t frame = 0; frame < out_length; ++frame) {
+            auto const *const input_ptr = &buffer_ptr[read_idx];
+
+            if (this->_is_interpolated) {
+                uint64_t const scaled = phase_numerator * this->_phase_count;
+                auto const row = static_cast<std::size_t>(scaled / step_denominator);
+                T const fraction = static_cast<T>(scaled % step_denominator) / static_cast<T>(step_denominator);
+                T const current = resampler_utils::dot(input_ptr, &coefficients_ptr[row * tap_count], tap_count);
+                T const next = resampler_utils::dot(input_ptr, &coefficients_ptr[(row + 1) * tap_count], tap_count);
+                out_ptr[frame] = current + (next - current) * fraction;
+            } else {
+                out_ptr[frame] =
+                    resampler_utils::dot(input_ptr, &coefficients_ptr[phase_numerator * tap_count], tap_count);
+            }
+
+            read_idx += step_integer;
+            phase_numerator += step_remainder;
+            if (phase_numerator >= step_denominator) {
+                phase_numerator -= step_denominator;
+                ++read_idx;
+            }
+        }
+    }
+
+    // 使い終わった入力を詰める。読む位置が入力の先まで進んでいれば、その分を次の入力から読み飛ばす
+    auto const consumed_length = std::min(read_idx, this->_buffered_length);
+    auto const remaining_length = this->_buffered_length - consumed_length;
+
+    if (consumed_length > 0) {
+        for (auto &buffer : this->_channel_buffers) {
+            std::memmove(buffer.data(), &buffer[consumed_length], remaining_length * sizeof(T));
+        }
+    }
+
+    this->_buffered_length = remaining_length;
+    this->_read_idx = read_idx - consumed_length;
+    this->_phase_numerator = phase_numerator;
+}
+
+template struct yas::audio::resampler<float>;
+template struct yas::audio::resampler<double>;
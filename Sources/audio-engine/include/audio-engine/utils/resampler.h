@@ -0,0 +1,82 @@
+//
+//  resampler.h
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace yas::audio {
+/// 品質が高いほどタップ数が増え、遅延と処理量も増える
+enum class resampler_quality {
+    low,
+    medium,
+    high,
+};
+
+/// 入力に対する出力の遅れを出力のフレーム数で返す。resamplerを作らずに求められる
+[[nodiscard]] double resampler_latency_frames(double const input_sample_rate, double const output_sample_rate,
+                                              resampler_quality const);
+
+/// ポリフェーズFIRでサンプルレートを変換する
+/// インターリーブされていないデータをチャンネルごとに扱い、処理の途中で止めても続きから変換できる
+/// 作るときにmaximum_framesの出力に必要なバッファを確保し、processでは確保し直さない
+template <typename T>
+struct resampler final {
+    static std::size_t constexpr default_maximum_frames = 4096;
+
+    resampler(double const input_sample_rate, double const output_sample_rate, uint32_t const channel_count,
+              resampler_quality const, std::size_t const maximum_frames = default_maximum_frames);
+
+    [[nodiscard]] double input_sample_rate() const;
+    [[nodiscard]] double output_sample_rate() const;
+    [[nodiscard]] uint32_t channel_count() const;
+    [[nodiscard]] resampler_quality quality() const;
+    [[nodiscard]] std::size_t maximum_frames() const;
+
+    [[nodiscard]] uint32_t tap_count() const;
+    [[nodiscard]] uint32_t phase_count() const;
+
+    /// 入力に対する出力の遅れを出力のフレーム数で返す
+    [[nodiscard]] double latency_frames() const;
+    [[nodiscard]] double latency_seconds() const;
+
+    /// out_lengthフレームを出力するために追加で必要な入力のフレーム数を返す
+    [[nodiscard]] std::size_t input_length_for_output(std::size_t const out_length) const;
+    /// maximum_framesを出力するときに追加で必要になる入力の最大のフレーム数を返す
+    [[nodiscard]] std::size_t maximum_input_length() const;
+
+    /// inのin_lengthフレームを受け取り、outへout_lengthフレームを書き込む
+    /// 入力が足りなければ0が続くものとして扱い、余った入力は次の呼び出しに持ち越す
+    /// maximum_framesより長い出力は分けて処理する。持ち越す入力が確保した長さを超えたら、その分は捨てる
+    void process(T const *const *const in, std::size_t const in_length, T *const *const out,
+                 std::size_t const out_length);
+
+    void reset();
+
+   private:
+    double const _input_sample_rate;
+    double const _output_sample_rate;
+    resampler_quality const _quality;
+    std::size_t const _maximum_frames;
+
+    // 出力1フレームごとに入力をstep_numerator / step_denominatorフレーム進める
+    uint64_t _step_numerator;
+    uint64_t _step_denominator;
+    uint32_t _tap_count;
+    uint32_t _phase_count;
+    bool _is_interpolated;
+    std::vector<T> _coefficients;
+
+    std::vector<std::vector<T>> _channel_buffers;
+    std::size_t _buffer_capacity;
+    std::size_t _buffered_length;
+    std::size_t _read_idx;
+    uint64_t _phase_numerator;
+
+    void _process(T const *const *const in, std::size_t const in_offset, std::size_t const in_length,
+                  T *const *const out, std::size_t const out_offset, std::size_t const out_length);
+};
+}  // namespace yas::audio
@@ -0,0 +1,155 @@
+//
+//  worker_pool.cpp
+//
+
+#include "worker_pool.h"
+
+#include <exception>
+
+using namespace yas;
+using namespace yas::audio;
+
+struct worker_pool::job {
+    task_f const &task;
+    std::size_t const count;
+    std::atomic<std::size_t> next_idx{0};
+    std::atomic<std::size_t> finished_count{0};
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool is_finished = false;
+    std::exception_ptr exception = nullptr;
+
+    job(task_f const &task, std::size_t const count) : task(task), count(count) {
+    }
+
+    // 空いたスレッドから次のインデックスを取っていく
+    void run() {
+        while (true) {
+            auto const idx = this->next_idx.fetch_add(1);
+            if (idx >= this->count) {
+                return;
+            }
+
+            try {
+                this->task(idx);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!this->exception) {
+                    this->exception = std::current_exception();
+                }
+            }
+
+            if (this->finished_count.fetch_add(1) + 1 == this->count) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->is_finished = true;
+                this->condition.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->condition.wait(lock, [this] { return this->is_finished; });
+    }
+};
+
+worker_pool::worker_pool(std::size_t const thread_count) {
+    this->_threads.reserve(thread_count);
+
+    for (std::size_t idx = 0; idx < thread_count; ++idx) {
+        this->_threads.emplace_back([this] { this->_run_worker(); });
+    }
+}
+
+worker_pool::~worker_pool() {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_is_stopped = true;
+    }
+
+    this->_condition.notify_all();
+
+    for (auto &thread : this->_threads) {
+        thread.join();
+    }
+}
+
+std::size_t worker_pool::thread_count() const {
+    return this->_threads.size();
+}
+
+void worker_pool::parallel_for(std::size_t const count, task_f const &task) {
+    if (count == 0) {
+        return;
+    }
+
+    bool is_running = false;
+
+    if (this->_threads.empty() || count == 1 || !this->_is_running.compare_exchange_strong(is_running, true)) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            task(idx);
+        }
+        return;
+    }
+
+    auto const job = std::make_shared<worker_pool::job>(task, count);
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_job = job;
+        ++this->_generation;
+    }
+
+    this->_condition.notify_all();
+
+    job->run();
+    job->wait();
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_job = nullptr;
+    }
+
+    this->_is_running = false;
+
+    if (job->exception) {
+        std::rethrow_exception(job->exception);
+    }
+}
+
+void worker_pool::_run_worker() {
+    uint64_t generation = 0;
+
+    while (true) {
+        std::shared_ptr<worker_pool::job> job = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_condition.wait(lock, [this, &generation] {
+                return this->_is_stopped || this->_generation != generation;
+            });
+
+            if (this->_is_stopped) {
+                return;
+            }
+
+            generation = this->_generation;
+            job = this->_job;
+        }
+
+        if (job) {
+            job->run();
+        }
+    }
+}
+
+worker_pool_ptr worker_pool::make_shared() {
+    auto const concurrency = std::thread::hardware_concurrency();
+    // 呼び出したスレッドも処理に加わるので1つ減らす
+    return make_shared(concurrency > 1 ? concurrency - 1 : 0);
+}
+
+worker_pool_ptr worker_pool::make_shared(std::size_t const thread_count) {
+    return worker_pool_ptr(new worker_pool{thread_count});
+}
@@ -0,0 +1,53 @@
+//
+//  worker_pool.h
+//
+
+#pragma once
+
+#include <audio-engine/common/ptr.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yas::audio {
+/// 同じ処理をインデックスごとに複数のスレッドで分担する
+struct worker_pool final {
+    using task_f = std::function<void(std::size_t const)>;
+
+    ~worker_pool();
+
+    [[nodiscard]] std::size_t thread_count() const;
+
+    /// 0からcount未満のインデックスでtaskを呼ぶ。呼び出したスレッドも処理に加わり、すべて終わるまで戻らない
+    /// 他のparallel_forの実行中に呼ばれた場合は呼び出したスレッドだけで順番に処理する
+    /// taskで投げられた例外は呼び出したスレッドで投げ直す
+    void parallel_for(std::size_t const count, task_f const &);
+
+    [[nodiscard]] static worker_pool_ptr make_shared();
+    [[nodiscard]] static worker_pool_ptr make_shared(std::size_t const thread_count);
+
+   private:
+    struct job;
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::shared_ptr<job> _job = nullptr;
+    uint64_t _generation = 0;
+    bool _is_stopped = false;
+    std::atomic<bool> _is_running{false};
+
+    explicit worker_pool(std::size_t const thread_count);
+
+    void _run_worker();
+
+    worker_pool(worker_pool const &) = delete;
+    worker_pool(worker_pool &&) = delete;
+    worker_pool &operator=(worker_pool const &) = delete;
+    worker_pool &operator=(worker_pool &&) = delete;
+};
+}  // namespace yas::audio
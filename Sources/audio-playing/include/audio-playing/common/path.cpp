@@ -56,6 +56,20 @@ bool fragment::operator!=(fragment const &rhs) const {
     return !(*this == rhs);
 }
 
+#pragma mark - path::packed_fragment
+
+std::filesystem::path packed_fragment::value() const {
+    return this->channel_path.value().append(packed_fragment_name(this->fragment_index));
+}
+
+bool packed_fragment::operator==(packed_fragment const &rhs) const {
+    return this->channel_path == rhs.channel_path && this->fragment_index == rhs.fragment_index;
+}
+
+bool packed_fragment::operator!=(packed_fragment const &rhs) const {
+    return !(*this == rhs);
+}
+
 #pragma mark - path::signal_event
 
 std::filesystem::path signal_event::value() const {
@@ -97,3 +111,7 @@ std::string path::channel_name(channel_index_t const ch_idx) {
 std::string path::fragment_name(fragment_index_t const frag_idx) {
     return std::to_string(frag_idx);
 }
+
+std::string path::packed_fragment_name(fragment_index_t const frag_idx) {
+    return fragment_name(frag_idx) + ".packed";
+}
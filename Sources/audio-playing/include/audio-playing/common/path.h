@@ -42,6 +42,17 @@ struct [[nodiscard]] fragment final {
     bool operator!=(fragment const &rhs) const;
 };
 
+/// 1チャンネル1フラグメント分のイベントをまとめたファイル
+struct [[nodiscard]] packed_fragment final {
+    channel channel_path;
+    fragment_index_t fragment_index;
+
+    [[nodiscard]] std::filesystem::path value() const;
+
+    bool operator==(packed_fragment const &rhs) const;
+    bool operator!=(packed_fragment const &rhs) const;
+};
+
 struct [[nodiscard]] signal_event final {
     fragment fragment_path;
     proc::time::range range;
@@ -65,4 +76,5 @@ struct [[nodiscard]] number_events final {
 [[nodiscard]] std::string timeline_name(std::string const &identifier, sample_rate_t const);
 [[nodiscard]] std::string channel_name(channel_index_t const ch_idx);
 [[nodiscard]] std::string fragment_name(fragment_index_t const frag_idx);
+[[nodiscard]] std::string packed_fragment_name(fragment_index_t const frag_idx);
 }  // namespace yas::playing::path
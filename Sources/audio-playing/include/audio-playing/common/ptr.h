@@ -18,15 +18,14 @@ class player;
 class buffering_resource;
 class buffering_channel;
 class buffering_element;
-class reading_resource;
 class player_resource;
+class signal_file_cache;
 
 class player_for_coordinator;
 class renderer_for_coordinator;
 class buffering_element_for_buffering_channel;
 class buffering_channel_for_buffering_resource;
 class buffering_resource_for_player_resource;
-class reading_resource_for_player_resource;
 class player_resource_for_player;
 class exporter_for_coordinator;
 
@@ -41,6 +40,6 @@ using cancel_id_ptr = std::shared_ptr<cancel_id>;
 using buffering_resource_ptr = std::shared_ptr<buffering_resource>;
 using buffering_channel_ptr = std::shared_ptr<buffering_channel>;
 using buffering_element_ptr = std::shared_ptr<buffering_element>;
-using reading_resource_ptr = std::shared_ptr<reading_resource>;
 using player_resource_ptr = std::shared_ptr<player_resource>;
+using signal_file_cache_ptr = std::shared_ptr<signal_file_cache>;
 }  // namespace yas::playing
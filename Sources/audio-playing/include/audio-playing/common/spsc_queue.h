@@ -0,0 +1,42 @@
+//
+//  spsc_queue.h
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace yas::playing {
+/// 1つのスレッドから追加し、別の1つのスレッドから取り出す固定長のキュー
+/// 要素は最初にすべて確保し、追加も取り出しもロックやメモリの確保をしない
+template <typename T>
+struct spsc_queue final {
+    explicit spsc_queue(std::size_t const capacity);
+
+    [[nodiscard]] std::size_t capacity() const;
+
+    /// 追加する側のスレッドから呼ぶ。空きがなければ追加せずにfalseを返す
+    [[nodiscard]] bool push(T const &);
+    /// 取り出す側のスレッドから呼ぶ。空ならfalseを返す
+    [[nodiscard]] bool pop(T &);
+
+   private:
+    // 空と満杯を区別するために1つ多く確保する
+    std::vector<T> _elements;
+    // 取り出す位置。取り出す側だけが書き込む
+    alignas(64) std::atomic<std::size_t> _head{0};
+    // 追加する位置。追加する側だけが書き込む
+    alignas(64) std::atomic<std::size_t> _tail{0};
+
+    std::size_t _next(std::size_t const) const;
+
+    spsc_queue(spsc_queue const &) = delete;
+    spsc_queue(spsc_queue &&) = delete;
+    spsc_queue &operator=(spsc_queue const &) = delete;
+    spsc_queue &operator=(spsc_queue &&) = delete;
+};
+}  // namespace yas::playing
+
+#include "spsc_queue_private.h"
@@ -0,0 +1,51 @@
+//
+//  spsc_queue_private.h
+//
+
+#pragma once
+
+namespace yas::playing {
+template <typename T>
+spsc_queue<T>::spsc_queue(std::size_t const capacity) : _elements(capacity + 1) {
+}
+
+template <typename T>
+std::size_t spsc_queue<T>::capacity() const {
+    return this->_elements.size() - 1;
+}
+
+template <typename T>
+bool spsc_queue<T>::push(T const &value) {
+    auto const tail = this->_tail.load(std::memory_order_relaxed);
+    auto const next = this->_next(tail);
+
+    if (next == this->_head.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    this->_elements[tail] = value;
+    this->_tail.store(next, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+bool spsc_queue<T>::pop(T &value) {
+    auto const head = this->_head.load(std::memory_order_relaxed);
+
+    if (head == this->_tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    value = this->_elements[head];
+    this->_head.store(this->_next(head), std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+std::size_t spsc_queue<T>::_next(std::size_t const idx) const {
+    auto const next = idx + 1;
+    return next < this->_elements.size() ? next : 0;
+}
+}  // namespace yas::playing
@@ -11,7 +11,6 @@
 #include <audio-playing/player/buffering_element.h>
 #include <audio-playing/player/buffering_resource.h>
 #include <audio-playing/player/player_resource.h>
-#include <audio-playing/player/reading_resource.h>
 #include <audio-playing/timeline/timeline_utils.h>
 #include <cpp-utils/fast_each.h>
 
@@ -97,6 +96,10 @@ void coordinator::overwrite(proc::time::range const &range) {
     player->overwrite(std::nullopt, {.index = begin_frag_idx, .length = length});
 }
 
+void coordinator::set_warming_frames(std::vector<frame_index_t> const &frames) {
+    this->_player->set_warming_frames(frames);
+}
+
 std::string const &coordinator::identifier() const {
     return this->_identifier;
 }
@@ -121,6 +124,10 @@ frame_index_t coordinator::current_frame() const {
     return this->_player->current_frame();
 }
 
+playing::buffering_statistics coordinator::buffering_statistics() const {
+    return this->_player->buffering_statistics();
+}
+
 renderer_format const &coordinator::format() const {
     return this->_renderer->format();
 }
@@ -143,8 +150,9 @@ coordinator_ptr coordinator::make_shared(std::string const &root_path, std::shar
 
     auto const player = player::make_shared(
         root_path, renderer, worker, {},
-        player_resource::make_shared(reading_resource::make_shared(),
-                                     buffering_resource::make_shared(3, root_path, playing::make_buffering_channel)));
+        player_resource::make_shared(buffering_resource::make_shared(
+            {.min_element_count = 3, .max_element_count = 8, .warming_fragment_count = 2}, root_path,
+            playing::make_buffering_channel)));
 
     auto const exporter =
         exporter::make_shared(root_path, exporter_task_queue::make_shared(2), {.timeline = 0, .fragment = 1});
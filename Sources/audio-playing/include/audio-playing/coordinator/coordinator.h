@@ -24,6 +24,8 @@ struct coordinator final {
     void set_playing(bool const);
     void seek(frame_index_t const);
     void overwrite(proc::time::range const &);
+    /// ループの位置などシークされそうなフレームを先読みしておく
+    void set_warming_frames(std::vector<frame_index_t> const &);
 
     [[nodiscard]] std::string const &identifier() const;
     [[nodiscard]] std::optional<proc::timeline_ptr> const &timeline() const;
@@ -31,6 +33,7 @@ struct coordinator final {
     [[nodiscard]] bool is_playing() const;
     [[nodiscard]] bool is_seeking() const;
     [[nodiscard]] frame_index_t current_frame() const;
+    [[nodiscard]] playing::buffering_statistics buffering_statistics() const;
 
     [[nodiscard]] renderer_format const &format() const;
 
@@ -6,6 +6,7 @@
 
 #include <audio-playing/common/channel_mapping.h>
 #include <audio-playing/exporter/exporter_types.h>
+#include <audio-playing/player/buffering_resource_types.h>
 #include <audio-playing/renderer/renderer_types.h>
 
 #include <observing/umbrella.hpp>
@@ -33,12 +34,14 @@ struct player_for_coordinator {
     virtual void set_playing(bool const) = 0;
     virtual void seek(frame_index_t const) = 0;
     virtual void overwrite(std::optional<channel_index_t> const, fragment_range const) = 0;
+    virtual void set_warming_frames(std::vector<frame_index_t> const &) = 0;
 
     [[nodiscard]] virtual std::string const &identifier() const = 0;
     [[nodiscard]] virtual playing::channel_mapping channel_mapping() const = 0;
     [[nodiscard]] virtual bool is_playing() const = 0;
     [[nodiscard]] virtual bool is_seeking() const = 0;
     [[nodiscard]] virtual frame_index_t current_frame() const = 0;
+    [[nodiscard]] virtual playing::buffering_statistics buffering_statistics() const = 0;
 
     [[nodiscard]] virtual observing::syncable observe_is_playing(std::function<void(bool const &)> &&) = 0;
 };
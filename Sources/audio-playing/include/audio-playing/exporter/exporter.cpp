@@ -25,12 +25,13 @@ using namespace yas;
 using namespace yas::playing;
 
 exporter::exporter(std::string const &root_path, std::shared_ptr<task_queue_t> const &queue,
-                   task_priority_t const &priority)
+                   task_priority_t const &priority, audio::worker_pool_ptr const &worker_pool,
+                   fragment_format_t const fragment_format)
     : _queue(queue),
       _priority(priority),
       _container(
           observing::value::holder<timeline_container_ptr>::make_shared(timeline_container::make_shared_empty())),
-      _resource(exporter_resource::make_shared(root_path)) {
+      _resource(exporter_resource::make_shared(root_path, worker_pool, fragment_format)) {
     this->_container
         ->observe(
             [this, canceller = observing::cancellable_ptr{nullptr}](timeline_container_ptr const &container) mutable {
@@ -217,18 +218,42 @@ void exporter::_erase_module(track_index_t const trk_idx, proc::time::range cons
 }
 
 void exporter::_push_export_task(proc::time::range const &range) {
-    this->_queue->cancel([range](timeline_cancel_matcher_ptr const &matcher) { return matcher->is_cancel(range); });
+    auto const sample_rate = this->_container->value()->sample_rate();
+    auto merged_range = timeline_utils::fragments_range(range, sample_rate);
+
+    // 続けて編集された時に同じフラグメントを何度も書き出さないよう、重なるか隣接する書き出しを1つにまとめる
+    this->_queue->cancel([&merged_range](timeline_cancel_matcher_ptr const &matcher) {
+        if (matcher->is_cancel(merged_range)) {
+            return true;
+        } else if (matcher->is_coalesce(merged_range)) {
+            merged_range = merged_range.merged(matcher->range.value());
+            return true;
+        } else {
+            return false;
+        }
+    });
 
     auto export_task = exporter_task::make_shared(
-        [resource = this->_resource, range](auto const &task) { resource->export_on_task(range, task); },
-        {.priority = this->_priority.fragment, .canceller = timeline_canceller::make_shared(range)});
+        [resource = this->_resource, merged_range](auto const &task) { resource->export_on_task(merged_range, task); },
+        {.priority = this->_priority.fragment, .canceller = timeline_canceller::make_shared(merged_range)});
 
     this->_queue->push_back(std::move(export_task));
 }
 
 exporter_ptr exporter::make_shared(std::string const &root_path, std::shared_ptr<task_queue_t> const &task_queue,
                                    task_priority_t const &task_priority) {
-    return exporter_ptr(new exporter{root_path, task_queue, task_priority});
+    return make_shared(root_path, task_queue, task_priority, nullptr);
+}
+
+exporter_ptr exporter::make_shared(std::string const &root_path, std::shared_ptr<task_queue_t> const &task_queue,
+                                   task_priority_t const &task_priority, audio::worker_pool_ptr const &worker_pool) {
+    return make_shared(root_path, task_queue, task_priority, worker_pool, fragment_format_t::directory);
+}
+
+exporter_ptr exporter::make_shared(std::string const &root_path, std::shared_ptr<task_queue_t> const &task_queue,
+                                   task_priority_t const &task_priority, audio::worker_pool_ptr const &worker_pool,
+                                   fragment_format_t const fragment_format) {
+    return exporter_ptr(new exporter{root_path, task_queue, task_priority, worker_pool, fragment_format});
 }
 
 std::string yas::to_string(exporter::method_t const &method) {
@@ -254,6 +279,8 @@ std::string yas::to_string(exporter::error_t const &error) {
             return "write_numbers_failed";
         case exporter::error_t::get_content_paths_failed:
             return "get_content_paths_failed";
+        case exporter::error_t::write_packed_fragment_failed:
+            return "write_packed_fragment_failed";
     }
 }
 
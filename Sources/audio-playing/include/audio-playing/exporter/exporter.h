@@ -18,6 +18,7 @@ struct exporter final : exporter_for_coordinator {
     using event_t = exporter_event;
     using task_priority_t = exporter_task_priority;
     using task_queue_t = exporter_task_queue;
+    using fragment_format_t = exporter_fragment_format;
 
     void set_timeline_container(timeline_container_ptr const &) override;
 
@@ -25,6 +26,12 @@ struct exporter final : exporter_for_coordinator {
 
     [[nodiscard]] static exporter_ptr make_shared(std::string const &root_path, std::shared_ptr<task_queue_t> const &,
                                                   task_priority_t const &);
+    /// worker_poolを渡すと、すべてのモジュールがstatelessのタイムラインはフラグメントを並列にレンダリングして書き出す
+    [[nodiscard]] static exporter_ptr make_shared(std::string const &root_path, std::shared_ptr<task_queue_t> const &,
+                                                  task_priority_t const &, audio::worker_pool_ptr const &);
+    [[nodiscard]] static exporter_ptr make_shared(std::string const &root_path, std::shared_ptr<task_queue_t> const &,
+                                                  task_priority_t const &, audio::worker_pool_ptr const &,
+                                                  fragment_format_t const);
 
    private:
     std::shared_ptr<task_queue_t> const _queue;
@@ -34,7 +41,8 @@ struct exporter final : exporter_for_coordinator {
 
     observing::canceller_pool _pool;
 
-    exporter(std::string const &root_path, std::shared_ptr<task_queue_t> const &, task_priority_t const &);
+    exporter(std::string const &root_path, std::shared_ptr<task_queue_t> const &, task_priority_t const &,
+             audio::worker_pool_ptr const &, fragment_format_t const);
 
     void _receive_timeline_event(proc::timeline_event const &event);
     void _receive_relayed_timeline_event(proc::timeline_event const &event);
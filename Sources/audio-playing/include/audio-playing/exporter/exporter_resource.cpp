@@ -6,19 +6,40 @@
 
 #include <audio-playing/common/path.h>
 #include <audio-playing/numbers_file/numbers_file.h>
+#include <audio-playing/packed_fragment_file/packed_fragment_file.h>
 #include <audio-playing/signal_file/signal_file.h>
 #include <audio-playing/timeline/timeline_utils.h>
 #include <cpp-utils/file_manager.h>
 #include <cpp-utils/thread.h>
-#include <cpp-utils/to_integer.h>
 #include <dispatch/dispatch.h>
 
+#include <audio-engine/utils/worker_pool.h>
+#include <audio-processing/timeline/timeline_utils.h>
 #include <audio-processing/umbrella.hpp>
 
+#include <atomic>
+#include <future>
+
 using namespace yas;
 using namespace yas::playing;
 
-exporter_resource::exporter_resource(std::string const &root_path) : _root_path(root_path) {
+namespace yas::playing::exporter_utils {
+// ワーカーごとに一度にレンダリングするフラグメントの数
+static std::size_t constexpr fragment_count_per_worker = 2;
+
+// streamはコピーやムーブでチャンネルを引き継がないので、イベントを取り出して残しておく
+static std::map<proc::channel_index_t, proc::channel> copy_channels(proc::stream const &stream) {
+    std::map<proc::channel_index_t, proc::channel> channels;
+    for (auto const &ch_pair : stream.channels()) {
+        channels.emplace(ch_pair.first, proc::channel{ch_pair.second.events()});
+    }
+    return channels;
+}
+}  // namespace yas::playing::exporter_utils
+
+exporter_resource::exporter_resource(std::string const &root_path, audio::worker_pool_ptr const &worker_pool,
+                                     exporter_fragment_format const fragment_format)
+    : _root_path(root_path), _worker_pool(worker_pool), _fragment_format(fragment_format) {
 }
 
 void exporter_resource::replace_timeline_on_task(proc::timeline::track_map_t &&tracks, std::string const &identifier,
@@ -27,14 +48,18 @@ void exporter_resource::replace_timeline_on_task(proc::timeline::track_map_t &&t
     this->_timeline = proc::timeline::make_shared(std::move(tracks));
     this->_sync_source.emplace(sample_rate, sample_rate);
 
-    if (task.is_canceled()) {
-        return;
-    }
-
+    // 索引を先に空にすると、消す前にキャンセルされた時に索引にないフラグメントが残り続けるので
+    // ファイルを消してから空にする
     if (auto const result = file_manager::remove_content(this->_root_path); !result) {
         std::runtime_error("remove timeline root directory failed.");
     }
 
+    this->_fragment_hashes.clear();
+
+    if (task.is_canceled()) {
+        return;
+    }
+
     this->_send_method_on_task(exporter_method::reset, std::nullopt);
 
     if (task.is_canceled()) {
@@ -100,11 +125,8 @@ void exporter_resource::export_on_task(proc::time::range const &range, task_t co
 
     this->_send_method_on_task(exporter_method::export_began, frags_range);
 
-    if (auto const error = this->_remove_fragments_on_task(frags_range, task)) {
-        this->_send_error_on_task(*error, range);
-    } else {
-        this->_export_fragments_on_task(frags_range, task);
-    }
+    // 先に消さずに、書き出す時に内容が変わったフラグメントだけを置き換える
+    this->_export_fragments_on_task(frags_range, task);
 }
 
 void exporter_resource::_export_fragments_on_task(proc::time::range const &frags_range, task_t const &task) {
@@ -114,121 +136,268 @@ void exporter_resource::_export_fragments_on_task(proc::time::range const &frags
         return;
     }
 
+    // 範囲を分けてレンダリングすると、スライスをまたいで値を持ち越すモジュールの結果が通した時と変わってしまう
+    if (this->_worker_pool && this->_worker_pool->thread_count() > 0 &&
+        proc::is_tracks_stateless(this->_timeline->tracks())) {
+        this->_export_fragments_in_parallel_on_task(frags_range, task);
+        return;
+    }
+
     this->_timeline->process(frags_range, this->_sync_source.value(),
                              [&task, this](proc::time::range const &range, proc::stream const &stream) {
                                  if (task.is_canceled()) {
                                      return proc::continuation::abort;
                                  }
 
-                                 if (auto error = this->_export_fragment_on_task(range, stream)) {
-                                     this->_send_error_on_task(*error, range);
-                                 } else {
-                                     this->_send_method_on_task(exporter_method::export_ended, range);
-                                 }
+                                 this->_export_rendered_fragment_on_task(range, stream.channels());
 
                                  return proc::continuation::keep;
                              });
 }
 
+void exporter_resource::_export_fragments_in_parallel_on_task(proc::time::range const &frags_range,
+                                                              task_t const &task) {
+    assert(!thread::is_main());
+
+    using rendered_fragments_t =
+        std::vector<std::optional<std::pair<proc::time::range, std::map<proc::channel_index_t, proc::channel>>>>;
+
+    auto const &worker_pool = this->_worker_pool;
+    auto const &sync_source = this->_sync_source.value();
+    auto const frag_length = static_cast<frame_index_t>(sync_source.slice_length);
+    auto const frag_count = static_cast<std::size_t>((frags_range.length + frag_length - 1) / frag_length);
+    std::size_t const worker_count = worker_pool->thread_count() + 1;
+    std::size_t const batch_frag_count = worker_count * exporter_utils::fragment_count_per_worker;
+
+    // モジュールの状態を共有しないよう、ワーカーごとに複製したtimelineでレンダリングする
+    std::vector<proc::timeline_ptr> timelines;
+    timelines.reserve(worker_count);
+    for (std::size_t idx = 0; idx < worker_count; ++idx) {
+        timelines.emplace_back(this->_timeline->copy());
+    }
+
+    std::atomic<bool> is_aborted{false};
+
+    auto render = [&worker_pool, &sync_source, &frags_range, &frag_length, &worker_count, &timelines, &is_aborted](
+                      std::size_t const begin_frag_idx, std::size_t const end_frag_idx) {
+        rendered_fragments_t rendered(end_frag_idx - begin_frag_idx);
+        std::size_t const chunk_frag_count = (rendered.size() + worker_count - 1) / worker_count;
+
+        worker_pool->parallel_for(worker_count, [&](std::size_t const worker_idx) {
+            auto const chunk_begin_idx = begin_frag_idx + worker_idx * chunk_frag_count;
+            auto const chunk_end_idx = std::min(chunk_begin_idx + chunk_frag_count, end_frag_idx);
+            if (chunk_begin_idx >= chunk_end_idx) {
+                return;
+            }
+
+            auto const chunk_frame = frags_range.frame + static_cast<frame_index_t>(chunk_begin_idx) * frag_length;
+            auto const chunk_next_frame = std::min(
+                frags_range.frame + static_cast<frame_index_t>(chunk_end_idx) * frag_length, frags_range.next_frame());
+            proc::time::range const chunk_range{chunk_frame, static_cast<length_t>(chunk_next_frame - chunk_frame)};
+
+            timelines.at(worker_idx)
+                ->process(chunk_range, sync_source,
+                          [&](proc::time::range const &range, proc::stream const &stream) {
+                              if (is_aborted) {
+                                  return proc::continuation::abort;
+                              }
+
+                              auto const frag_idx = static_cast<std::size_t>((range.frame - frags_range.frame) /
+                                                                             frag_length);
+                              rendered.at(frag_idx - begin_frag_idx)
+                                  .emplace(range, exporter_utils::copy_channels(stream));
+
+                              return proc::continuation::keep;
+                          });
+        });
+
+        return rendered;
+    };
+
+    // 書き出している間に次のフラグメントをレンダリングしておく
+    std::future<rendered_fragments_t> rendering =
+        std::async(std::launch::async, render, 0, std::min(batch_frag_count, frag_count));
+
+    for (std::size_t begin_frag_idx = 0; begin_frag_idx < frag_count; begin_frag_idx += batch_frag_count) {
+        auto const rendered = rendering.get();
+
+        auto const next_frag_idx = begin_frag_idx + batch_frag_count;
+        if (next_frag_idx < frag_count && !task.is_canceled()) {
+            rendering = std::async(std::launch::async, render, next_frag_idx,
+                                   std::min(next_frag_idx + batch_frag_count, frag_count));
+        }
+
+        for (auto const &fragment : rendered) {
+            if (task.is_canceled()) {
+                is_aborted = true;
+                break;
+            }
+
+            if (fragment.has_value()) {
+                this->_export_rendered_fragment_on_task(fragment->first, fragment->second);
+            }
+        }
+
+        if (is_aborted) {
+            break;
+        }
+    }
+
+    if (rendering.valid()) {
+        rendering.wait();
+    }
+}
+
+void exporter_resource::_export_rendered_fragment_on_task(
+    proc::time::range const &range, std::map<proc::channel_index_t, proc::channel> const &channels) {
+    if (auto error = this->_export_fragment_on_task(range, channels)) {
+        this->_send_error_on_task(*error, range);
+    } else {
+        this->_send_method_on_task(exporter_method::export_ended, range);
+    }
+}
+
 [[nodiscard]] std::optional<exporter_error> exporter_resource::_export_fragment_on_task(
-    proc::time::range const &frag_range, proc::stream const &stream) {
+    proc::time::range const &frag_range, std::map<proc::channel_index_t, proc::channel> const &channels) {
     assert(!thread::is_main());
 
     auto const &sync_source = this->_sync_source.value();
     path::timeline const tl_path{this->_root_path, this->_identifier, sync_source.sample_rate};
 
-    auto const frag_idx = frag_range.frame / stream.sync_source().sample_rate;
-
-    for (auto const &ch_pair : stream.channels()) {
-        auto const &ch_idx = ch_pair.first;
-        auto const &channel = ch_pair.second;
+    auto const frag_idx = frag_range.frame / sync_source.sample_rate;
+    auto &ch_hashes = this->_fragment_hashes[frag_idx];
 
-        path::channel const ch_path{tl_path, ch_idx};
-        auto const frag_path = path::fragment{ch_path, frag_idx};
-        auto const frag_path_value = frag_path.value();
+    // 前回書き出したが今回はイベントが無くなったチャンネルを消す
+    auto hash_it = ch_hashes.begin();
+    while (hash_it != ch_hashes.end()) {
+        auto const ch_it = channels.find(hash_it->first);
+        if (ch_it != channels.end() && ch_it->second.events().size() > 0) {
+            ++hash_it;
+            continue;
+        }
 
-        auto remove_result = file_manager::remove_content(frag_path_value);
-        if (!remove_result) {
-            return exporter_error::remove_fragment_failed;
+        if (auto const error = this->_remove_fragment_on_task(path::channel{tl_path, hash_it->first}, frag_idx)) {
+            return error;
         }
 
+        hash_it = ch_hashes.erase(hash_it);
+    }
+
+    for (auto const &ch_pair : channels) {
+        auto const &ch_idx = ch_pair.first;
+        auto const &channel = ch_pair.second;
+
         if (channel.events().size() == 0) {
-            return std::nullopt;
+            continue;
         }
 
-        auto const create_result = file_manager::create_directory_if_not_exists(frag_path_value);
-        if (!create_result) {
-            return exporter_error::create_directory_failed;
+        // 内容が前回書き出した時と同じならファイルに触れない
+        auto const hash = timeline_utils::content_hash(channel);
+        if (auto const it = ch_hashes.find(ch_idx); it != ch_hashes.end() && it->second == hash) {
+            continue;
         }
 
-        for (auto const &event_pair : channel.filtered_events<proc::signal_event>()) {
-            proc::time::range const &range = event_pair.first;
-            proc::signal_event_ptr const &event = event_pair.second;
+        // 書き出しに失敗してもファイルが残っているかもしれないので、索引からは消さずに内容が分からない印にしておく
+        ch_hashes.insert_or_assign(ch_idx, std::nullopt);
 
-            auto const signal_path_value = path::signal_event{frag_path, range, event->sample_type()}.value();
+        path::channel const ch_path{tl_path, ch_idx};
 
-            if (auto const result = signal_file::write(signal_path_value, *event); !result) {
-                return exporter_error::write_signal_failed;
-            }
+        if (auto const error = this->_remove_fragment_on_task(ch_path, frag_idx)) {
+            return error;
         }
 
-        if (auto const number_events = channel.filtered_events<proc::number_event>(); number_events.size() > 0) {
-            auto const number_path_value = path::number_events{frag_path}.value();
-
-            if (auto const result = numbers_file::write(number_path_value, number_events); !result) {
-                return exporter_error::write_numbers_failed;
+        if (this->_fragment_format == exporter_fragment_format::packed) {
+            if (auto const error = this->_export_packed_fragment_on_task(frag_idx, ch_path, channel)) {
+                return error;
+            }
+        } else {
+            if (auto const error = this->_export_directory_fragment_on_task(frag_idx, ch_path, channel)) {
+                return error;
             }
         }
+
+        ch_hashes.insert_or_assign(ch_idx, hash);
+    }
+
+    if (ch_hashes.empty()) {
+        this->_fragment_hashes.erase(frag_idx);
     }
 
     return std::nullopt;
 }
 
-std::optional<exporter_error> exporter_resource::_remove_fragments_on_task(proc::time::range const &frags_range,
-                                                                           task_t const &task) {
+std::optional<exporter_error> exporter_resource::_export_directory_fragment_on_task(fragment_index_t const frag_idx,
+                                                                                   path::channel const &ch_path,
+                                                                                   proc::channel const &channel) {
     assert(!thread::is_main());
 
-    auto const &sync_source = this->_sync_source.value();
-    auto const &sample_rate = sync_source.sample_rate;
-    path::timeline const tl_path{this->_root_path, this->_identifier, sample_rate};
+    auto const frag_path = path::fragment{ch_path, frag_idx};
+    auto const frag_path_value = frag_path.value();
 
-    auto ch_paths_result = file_manager::content_paths_in_directory(tl_path.value());
-    if (!ch_paths_result) {
-        if (ch_paths_result.error() == file_manager::content_paths_error::directory_not_found) {
-            return std::nullopt;
-        } else {
-            return exporter_error::get_content_paths_failed;
-        }
+    auto const create_result = file_manager::create_directory_if_not_exists(frag_path_value);
+    if (!create_result) {
+        return exporter_error::create_directory_failed;
     }
 
-    auto const ch_names = to_vector<std::string>(ch_paths_result.value(),
-                                                 [](std::filesystem::path const &path) { return path.filename(); });
+    for (auto const &event_pair : channel.filtered_events<proc::signal_event>()) {
+        proc::time::range const &range = event_pair.first;
+        proc::signal_event_ptr const &event = event_pair.second;
 
-    auto const begin_frag_idx = frags_range.frame / sample_rate;
-    auto const end_frag_idx = frags_range.next_frame() / sample_rate;
+        auto const signal_path_value = path::signal_event{frag_path, range, event->sample_type()}.value();
 
-    for (auto const &ch_name : ch_names) {
-        if (task.is_canceled()) {
-            return std::nullopt;
+        if (auto const result = signal_file::write(signal_path_value, *event); !result) {
+            return exporter_error::write_signal_failed;
         }
+    }
 
-        auto const ch_idx = yas::to_integer<channel_index_t>(ch_name);
-        path::channel const ch_path{tl_path, ch_idx};
+    if (auto const number_events = channel.filtered_events<proc::number_event>(); number_events.size() > 0) {
+        auto const number_path_value = path::number_events{frag_path}.value();
 
-        auto each = make_fast_each(begin_frag_idx, end_frag_idx);
-        while (yas_each_next(each)) {
-            auto const &frag_idx = yas_each_index(each);
-            auto const frag_path_value = path::fragment{ch_path, frag_idx}.value();
-            auto const remove_result = file_manager::remove_content(frag_path_value);
-            if (!remove_result) {
-                return exporter_error::remove_fragment_failed;
-            }
+        if (auto const result = numbers_file::write(number_path_value, number_events); !result) {
+            return exporter_error::write_numbers_failed;
         }
     }
 
     return std::nullopt;
 }
 
+std::optional<exporter_error> exporter_resource::_export_packed_fragment_on_task(fragment_index_t const frag_idx,
+                                                                                path::channel const &ch_path,
+                                                                                proc::channel const &channel) {
+    assert(!thread::is_main());
+
+    auto const create_result = file_manager::create_directory_if_not_exists(ch_path.value());
+    if (!create_result) {
+        return exporter_error::create_directory_failed;
+    }
+
+    auto const packed_path_value = path::packed_fragment{ch_path, frag_idx}.value();
+
+    if (auto const result = packed_fragment_file::write(packed_path_value, channel); !result) {
+        return exporter_error::write_packed_fragment_failed;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<exporter_error> exporter_resource::_remove_fragment_on_task(path::channel const &ch_path,
+                                                                          fragment_index_t const frag_idx) {
+    assert(!thread::is_main());
+
+    auto const remove_result = file_manager::remove_content(path::fragment{ch_path, frag_idx}.value());
+    if (!remove_result) {
+        return exporter_error::remove_fragment_failed;
+    }
+
+    // 書き出す形式に関わらず、どちらの形式のフラグメントも残らないようにする
+    auto const packed_remove_result = file_manager::remove_content(path::packed_fragment{ch_path, frag_idx}.value());
+    if (!packed_remove_result) {
+        return exporter_error::remove_fragment_failed;
+    }
+
+    return std::nullopt;
+}
+
 void exporter_resource::_send_method_on_task(exporter_method const type,
                                              std::optional<proc::time::range> const &range) {
     assert(!thread::is_main());
@@ -253,5 +422,16 @@ void exporter_resource::_send_event_on_task(exporter_event event) {
 }
 
 exporter_resource_ptr exporter_resource::make_shared(std::string const &root_path) {
-    return exporter_resource_ptr{new exporter_resource{root_path}};
+    return make_shared(root_path, nullptr);
+}
+
+exporter_resource_ptr exporter_resource::make_shared(std::string const &root_path,
+                                                     audio::worker_pool_ptr const &worker_pool) {
+    return make_shared(root_path, worker_pool, exporter_fragment_format::directory);
+}
+
+exporter_resource_ptr exporter_resource::make_shared(std::string const &root_path,
+                                                     audio::worker_pool_ptr const &worker_pool,
+                                                     exporter_fragment_format const fragment_format) {
+    return exporter_resource_ptr{new exporter_resource{root_path, worker_pool, fragment_format}};
 }
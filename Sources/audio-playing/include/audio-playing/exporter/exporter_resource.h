@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include <audio-playing/common/path.h>
 #include <audio-playing/common/ptr.h>
 #include <audio-playing/common/types.h>
+#include <audio-processing/channel/channel.h>
 #include <audio-processing/sync_source/sync_source.h>
 #include <audio-processing/timeline/timeline.h>
 
+#include <audio-engine/common/ptr.h>
+
 #include "exporter_types.h"
 
 namespace yas::playing {
@@ -29,23 +33,43 @@ struct exporter_resource final {
     void export_on_task(proc::time::range const &, task_t const &);
 
     [[nodiscard]] static exporter_resource_ptr make_shared(std::string const &root_path);
+    /// worker_poolを渡すと、すべてのモジュールがstatelessのタイムラインはフラグメントを並列にレンダリングして書き出す
+    [[nodiscard]] static exporter_resource_ptr make_shared(std::string const &root_path,
+                                                           audio::worker_pool_ptr const &);
+    [[nodiscard]] static exporter_resource_ptr make_shared(std::string const &root_path,
+                                                           audio::worker_pool_ptr const &,
+                                                           exporter_fragment_format const);
 
    private:
     std::string const _root_path;
+    audio::worker_pool_ptr const _worker_pool;
+    exporter_fragment_format const _fragment_format;
     std::string _identifier;
     proc::timeline_ptr _timeline;
     std::optional<proc::sync_source> _sync_source;
+    /// 書き出したフラグメントの内容のハッシュ。フラグメントとチャンネルごとに持つ
+    /// 書き出しに失敗してディスク上の内容が分からないチャンネルはnullopt
+    std::map<fragment_index_t, std::map<channel_index_t, std::optional<uint64_t>>> _fragment_hashes;
 
-    exporter_resource(std::string const &root_path);
+    exporter_resource(std::string const &root_path, audio::worker_pool_ptr const &, exporter_fragment_format const);
 
     void _send_method_on_task(exporter_method const type, std::optional<proc::time::range> const &range);
     void _send_error_on_task(exporter_error const type, std::optional<proc::time::range> const &range);
     void _send_event_on_task(exporter_event event);
 
     void _export_fragments_on_task(proc::time::range const &, task_t const &);
-    [[nodiscard]] std::optional<exporter_error> _export_fragment_on_task(proc::time::range const &frag_range,
-                                                                         proc::stream const &stream);
-    [[nodiscard]] std::optional<exporter_error> _remove_fragments_on_task(proc::time::range const &frags_range,
-                                                                          task_t const &task);
+    void _export_fragments_in_parallel_on_task(proc::time::range const &, task_t const &);
+    void _export_rendered_fragment_on_task(proc::time::range const &,
+                                           std::map<proc::channel_index_t, proc::channel> const &);
+    [[nodiscard]] std::optional<exporter_error> _export_fragment_on_task(
+        proc::time::range const &frag_range, std::map<proc::channel_index_t, proc::channel> const &channels);
+    [[nodiscard]] std::optional<exporter_error> _export_directory_fragment_on_task(fragment_index_t const,
+                                                                                   path::channel const &,
+                                                                                   proc::channel const &);
+    [[nodiscard]] std::optional<exporter_error> _export_packed_fragment_on_task(fragment_index_t const,
+                                                                                path::channel const &,
+                                                                                proc::channel const &);
+    [[nodiscard]] std::optional<exporter_error> _remove_fragment_on_task(path::channel const &,
+                                                                         fragment_index_t const);
 };
 }  // namespace yas::playing
@@ -22,6 +22,14 @@ enum class exporter_error {
     write_signal_failed,
     write_numbers_failed,
     get_content_paths_failed,
+    write_packed_fragment_failed,
+};
+
+enum class exporter_fragment_format {
+    /// フラグメントごとのディレクトリにイベントごとのファイルを書き出す
+    directory,
+    /// フラグメントごとに1つのファイルにまとめて書き出す
+    packed,
 };
 
 using exporter_result_t = result<exporter_method, exporter_error>;
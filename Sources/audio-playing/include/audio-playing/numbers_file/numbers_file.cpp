@@ -7,7 +7,11 @@
 #include <audio-playing/timeline/timeline_utils.h>
 #include <cpp-utils/boolean.h>
 
+#include <cstddef>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <stdexcept>
 
 using namespace yas;
 using namespace yas::playing;
@@ -18,165 +22,435 @@ numbers_file::write_result_t numbers_file::write(std::string const &path, event_
         return write_result_t{write_error::open_stream_failed};
     }
 
-    for (auto const &event_pair : events) {
-        proc::time::frame::type const &frame = event_pair.first;
+    if (auto result = write(stream, events); !result) {
+        return result;
+    }
+
+    stream.close();
+    if (stream.fail()) {
+        return write_result_t{write_error::close_stream_failed};
+    }
+
+    return write_result_t{nullptr};
+}
+
+namespace yas::playing::numbers_file_utils {
+static char constexpr magic[4] = {'y', 'a', 's', 'n'};
+static uint32_t constexpr version = 1;
+static std::size_t constexpr value_slot_size = 8;
+
+using make_data_result_t = result<std::vector<char>, numbers_file::read_error>;
+using numbers_file::read_error;
+
+struct header {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    // すべて同じ型ならその型。混ざっていればunknownで、イベントごとの型の列と8バイトずつの値の列を置く
+    sample_store_type store_type;
+    char reserved[15];
+};
+
+static_assert(sizeof(header) == 32);
+
+static std::size_t byte_count(sample_store_type const store_type) {
+    switch (store_type) {
+        case sample_store_type::float64:
+        case sample_store_type::int64:
+        case sample_store_type::uint64:
+            return 8;
+        case sample_store_type::float32:
+        case sample_store_type::int32:
+        case sample_store_type::uint32:
+            return 4;
+        case sample_store_type::int16:
+        case sample_store_type::uint16:
+            return 2;
+        case sample_store_type::int8:
+        case sample_store_type::uint8:
+            return 1;
+        case sample_store_type::boolean:
+            return sizeof(bool);
+        case sample_store_type::unknown:
+            return 0;
+    }
+    return 0;
+}
+
+static std::size_t aligned(std::size_t const value) {
+    return (value + value_slot_size - 1) / value_slot_size * value_slot_size;
+}
+
+static std::size_t frames_offset() {
+    return sizeof(header);
+}
+
+static std::size_t store_types_offset(std::size_t const count) {
+    return frames_offset() + sizeof(frame_index_t) * count;
+}
+
+static std::size_t values_offset(std::size_t const count, sample_store_type const store_type) {
+    if (store_type == sample_store_type::unknown) {
+        return aligned(store_types_offset(count) + sizeof(sample_store_type) * count);
+    } else {
+        return store_types_offset(count);
+    }
+}
+
+static std::size_t value_stride(sample_store_type const store_type) {
+    return store_type == sample_store_type::unknown ? value_slot_size : byte_count(store_type);
+}
+
+static std::size_t data_size(std::size_t const count, sample_store_type const store_type) {
+    return values_offset(count, store_type) + value_stride(store_type) * count;
+}
+
+/// フレーム・値の型・値の位置を受け取り、ヘッダと列を並べたデータを作る
+struct builder {
+    std::vector<frame_index_t> frames;
+    std::vector<sample_store_type> store_types;
+    std::vector<char const *> values;
+
+    void reserve(std::size_t const count) {
+        this->frames.reserve(count);
+        this->store_types.reserve(count);
+        this->values.reserve(count);
+    }
+
+    void append(frame_index_t const frame, sample_store_type const store_type, char const *const value) {
+        this->frames.emplace_back(frame);
+        this->store_types.emplace_back(store_type);
+        this->values.emplace_back(value);
+    }
 
-        if (char const *data = timeline_utils::char_data(frame)) {
-            stream.write(data, sizeof(proc::time::frame::type));
-            if (stream.fail()) {
-                return write_result_t{write_error::write_to_stream_failed};
+    std::vector<char> make_data() const {
+        auto const count = this->frames.size();
+
+        auto store_type = count > 0 ? this->store_types.front() : sample_store_type::unknown;
+        for (auto const &type : this->store_types) {
+            if (type != store_type) {
+                store_type = sample_store_type::unknown;
+                break;
             }
         }
 
-        proc::number_event_ptr const &event = event_pair.second;
+        std::vector<char> data(data_size(count, store_type), 0);
 
-        auto const store_type = timeline_utils::to_sample_store_type(event->sample_type());
-        if (char const *data = timeline_utils::char_data(store_type)) {
-            stream.write(data, sizeof(sample_store_type));
-            if (stream.fail()) {
-                return write_result_t{write_error::write_to_stream_failed};
-            }
+        header const head{.magic = {magic[0], magic[1], magic[2], magic[3]},
+                          .version = version,
+                          .count = count,
+                          .store_type = store_type,
+                          .reserved = {0}};
+        std::memcpy(data.data(), &head, sizeof(header));
+        std::memcpy(&data[frames_offset()], this->frames.data(), sizeof(frame_index_t) * count);
+
+        if (store_type == sample_store_type::unknown) {
+            std::memcpy(&data[store_types_offset(count)], this->store_types.data(), sizeof(sample_store_type) * count);
         }
 
-        if (char const *data = timeline_utils::char_data(*event)) {
-            stream.write(data, event->sample_byte_count());
-            if (stream.fail()) {
-                return write_result_t{write_error::write_to_stream_failed};
-            }
+        auto const offset = values_offset(count, store_type);
+        auto const stride = value_stride(store_type);
+
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            std::memcpy(&data[offset + stride * idx], this->values.at(idx), byte_count(this->store_types.at(idx)));
         }
+
+        return data;
     }
+};
 
-    stream.close();
-    if (stream.fail()) {
-        return write_result_t{write_error::close_stream_failed};
+// 旧形式は先頭がフレームなので、マジックとバージョンの両方が一致した場合だけヘッダがあるとみなす
+static bool has_header(char const *const data, std::size_t const size) {
+    return size >= sizeof(header) && std::memcmp(data, magic, sizeof(magic)) == 0 &&
+           std::memcmp(&data[offsetof(header, version)], &version, sizeof(uint32_t)) == 0;
+}
+
+static bool is_valid_store_type(sample_store_type const store_type) {
+    return byte_count(store_type) > 0;
+}
+
+/// 旧形式のデータを読み込んで、ヘッダと列を並べたデータに作り直す
+static make_data_result_t make_data_from_legacy(char const *const legacy_data, std::size_t const size) {
+    builder builder;
+
+    std::size_t position = 0;
+
+    // 旧形式のファイルはフレームの途中で終わっていても、そこまでを読み込んだものとしていた
+    while (position + sizeof(frame_index_t) <= size) {
+        frame_index_t frame;
+        std::memcpy(&frame, &legacy_data[position], sizeof(frame_index_t));
+        position += sizeof(frame_index_t);
+
+        if (position + sizeof(sample_store_type) > size) {
+            return make_data_result_t{read_error::read_sample_store_type_failed};
+        }
+
+        sample_store_type const store_type = static_cast<sample_store_type>(legacy_data[position]);
+        position += sizeof(sample_store_type);
+
+        if (!is_valid_store_type(store_type)) {
+            return make_data_result_t{read_error::sample_store_type_not_found};
+        }
+
+        auto const value_size = byte_count(store_type);
+        if (position + value_size > size) {
+            return make_data_result_t{read_error::read_value_failed};
+        }
+
+        builder.append(frame, store_type, &legacy_data[position]);
+        position += value_size;
     }
 
-    return write_result_t{nullptr};
+    return make_data_result_t{builder.make_data()};
 }
 
-namespace yas::playing::numbers_file {
-using read_value_result_t = result<proc::number_event_ptr, std::nullptr_t>;
+using header_result_t = result<header, numbers_file::read_error>;
+
+/// ヘッダと列の大きさを確かめる
+static header_result_t validated_header(char const *const data, std::size_t const size) {
+    header head;
+    std::memcpy(&head, data, sizeof(header));
+
+    if (head.store_type != sample_store_type::unknown && !is_valid_store_type(head.store_type)) {
+        return header_result_t{read_error::sample_store_type_not_found};
+    }
+
+    // 大きさが合わないものは壊れているものとして扱う
+    auto const count = static_cast<std::size_t>(head.count);
+    if (head.count > size || size < data_size(count, head.store_type)) {
+        return header_result_t{read_error::invalid_header};
+    }
+
+    if (head.store_type == sample_store_type::unknown) {
+        auto const *const store_types = &data[store_types_offset(count)];
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            if (!is_valid_store_type(static_cast<sample_store_type>(store_types[idx]))) {
+                return header_result_t{read_error::sample_store_type_not_found};
+            }
+        }
+    }
+
+    return header_result_t{head};
+}
 
 template <typename T>
-read_value_result_t read_value(std::ifstream &stream) {
+static proc::number_event_ptr make_event(char const *const data) {
     T value;
-    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
-    if (stream.fail() || stream.gcount() != sizeof(T)) {
-        return read_value_result_t{nullptr};
+    std::memcpy(&value, data, sizeof(T));
+    return proc::number_event::make_shared(value);
+}
+}  // namespace yas::playing::numbers_file_utils
+
+numbers_file::write_result_t numbers_file::write(std::ostream &stream, event_map_t const &events) {
+    numbers_file_utils::builder builder;
+    builder.reserve(events.size());
+
+    for (auto const &event_pair : events) {
+        proc::number_event_ptr const &event = event_pair.second;
+        builder.append(event_pair.first, timeline_utils::to_sample_store_type(event->sample_type()),
+                       timeline_utils::char_data(*event));
+    }
+
+    auto const data = builder.make_data();
+
+    stream.write(data.data(), data.size());
+    if (stream.fail()) {
+        return write_result_t{write_error::write_to_stream_failed};
     }
-    return read_value_result_t{proc::number_event::make_shared(value)};
+
+    return write_result_t{nullptr};
 }
-}  // namespace yas::playing::numbers_file
 
 numbers_file::read_result_t numbers_file::read(std::string const &path) {
+    if (auto result = read_columns(path)) {
+        return read_result_t{result.value().events()};
+    } else {
+        return read_result_t{result.error()};
+    }
+}
+
+numbers_file::read_result_t numbers_file::read(std::istream &stream) {
+    if (auto result = read_columns(stream)) {
+        return read_result_t{result.value().events()};
+    } else {
+        return read_result_t{result.error()};
+    }
+}
+
+numbers_file::read_columns_result_t numbers_file::read_columns(std::string const &path) {
     std::ifstream stream{path, std::ios_base::in | std::ios_base::binary};
     if (stream.fail()) {
-        return read_result_t{read_error::open_stream_failed};
+        return read_columns_result_t{read_error::open_stream_failed};
     }
 
-    event_map_t result;
+    return read_columns(stream);
+}
+
+numbers_file::read_columns_result_t numbers_file::read_columns(void const *data, std::size_t const byte_size) {
+    return columns::make(data, byte_size);
+}
+
+numbers_file::read_columns_result_t numbers_file::read_columns(std::istream &stream) {
+    std::vector<char> data;
 
-    while (true) {
-        proc::time::frame::type frame;
-        stream.read((char *)&frame, sizeof(proc::time::frame::type));
-        if (stream.eof()) {
-            break;
+    std::streamoff const begin = stream.tellg();
+    stream.seekg(0, std::ios_base::end);
+    std::streamoff const end = stream.tellg();
+
+    if (begin >= 0 && end >= begin) {
+        // 残りの大きさが分かれば1回で読み込む
+        stream.seekg(begin);
+        data.resize(static_cast<std::size_t>(end - begin));
+        stream.read(data.data(), data.size());
+        if (stream.fail() || static_cast<std::size_t>(stream.gcount()) != data.size()) {
+            return read_columns_result_t{read_error::read_from_stream_failed};
+        }
+    } else {
+        stream.clear();
+        data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        if (stream.bad()) {
+            return read_columns_result_t{read_error::read_from_stream_failed};
         }
-        if (stream.fail() || stream.gcount() != sizeof(proc::time::frame::type)) {
-            return read_result_t{read_error::read_frame_failed};
+    }
+
+    return columns::make(std::move(data));
+}
+
+#pragma mark - columns
+
+numbers_file::columns::columns(std::vector<char> &&data, char const *const unowned_data, std::size_t const size,
+                               sample_store_type const store_type)
+    : _data(std::move(data)),
+      _unowned_data(unowned_data),
+      _size(size),
+      _store_type(store_type),
+      _store_types_offset(numbers_file_utils::store_types_offset(size)),
+      _values_offset(numbers_file_utils::values_offset(size, store_type)),
+      _value_stride(numbers_file_utils::value_stride(store_type)) {
+}
+
+std::size_t numbers_file::columns::size() const {
+    return this->_size;
+}
+
+frame_index_t numbers_file::columns::frame_at(std::size_t const idx) const {
+    if (idx >= this->_size) {
+        throw std::out_of_range(std::string(__PRETTY_FUNCTION__) + " : out of range. idx(" + std::to_string(idx) +
+                                ")");
+    }
+
+    frame_index_t frame;
+    std::memcpy(&frame, &this->_bytes()[numbers_file_utils::frames_offset() + sizeof(frame_index_t) * idx],
+                sizeof(frame_index_t));
+    return frame;
+}
+
+sample_store_type numbers_file::columns::store_type_at(std::size_t const idx) const {
+    if (idx >= this->_size) {
+        throw std::out_of_range(std::string(__PRETTY_FUNCTION__) + " : out of range. idx(" + std::to_string(idx) +
+                                ")");
+    }
+
+    if (this->_store_type != sample_store_type::unknown) {
+        return this->_store_type;
+    }
+
+    return static_cast<sample_store_type>(this->_bytes()[this->_store_types_offset + idx]);
+}
+
+proc::number_event_ptr numbers_file::columns::event_at(std::size_t const idx) const {
+    using namespace numbers_file_utils;
+
+    auto const store_type = this->store_type_at(idx);
+    char const *const data = &this->_bytes()[this->_values_offset + this->_value_stride * idx];
+
+    switch (store_type) {
+        case sample_store_type::float64:
+            return make_event<double>(data);
+        case sample_store_type::float32:
+            return make_event<float>(data);
+        case sample_store_type::int64:
+            return make_event<int64_t>(data);
+        case sample_store_type::uint64:
+            return make_event<uint64_t>(data);
+        case sample_store_type::int32:
+            return make_event<int32_t>(data);
+        case sample_store_type::uint32:
+            return make_event<uint32_t>(data);
+        case sample_store_type::int16:
+            return make_event<int16_t>(data);
+        case sample_store_type::uint16:
+            return make_event<uint16_t>(data);
+        case sample_store_type::int8:
+            return make_event<int8_t>(data);
+        case sample_store_type::uint8:
+            return make_event<uint8_t>(data);
+        case sample_store_type::boolean: {
+            bool value;
+            std::memcpy(&value, data, sizeof(bool));
+            return proc::number_event::make_shared(yas::boolean{value});
         }
+        case sample_store_type::unknown:
+            // 読み込むときに確かめているので来ない
+            throw std::runtime_error(std::string(__PRETTY_FUNCTION__) + " : unknown store type.");
+    }
+}
+
+numbers_file::event_map_t numbers_file::columns::events() const {
+    event_map_t events;
+
+    // フレーム順に並んでいるので末尾に足していく
+    for (std::size_t idx = 0; idx < this->_size; ++idx) {
+        events.emplace_hint(events.end(), this->frame_at(idx), this->event_at(idx));
+    }
+
+    return events;
+}
 
-        sample_store_type store_type;
-        stream.read((char *)&store_type, sizeof(sample_store_type));
-        if (stream.fail() || stream.gcount() != sizeof(sample_store_type)) {
-            return read_result_t{read_error::read_sample_store_type_failed};
+numbers_file::read_columns_result_t numbers_file::columns::make(std::vector<char> &&data) {
+    using namespace numbers_file_utils;
+
+    if (!has_header(data.data(), data.size())) {
+        if (auto result = make_data_from_legacy(data.data(), data.size())) {
+            data = std::move(result.value());
+        } else {
+            return read_columns_result_t{result.error()};
         }
+    }
 
-        switch (store_type) {
-            case sample_store_type::float64: {
-                if (auto read_result = read_value<double>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-            } break;
-            case sample_store_type::float32: {
-                if (auto read_result = read_value<float>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-            } break;
-            case sample_store_type::int64: {
-                if (auto read_result = read_value<int64_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-            } break;
-            case sample_store_type::uint64: {
-                if (auto read_result = read_value<uint64_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-            } break;
-            case sample_store_type::int32:
-                if (auto read_result = read_value<int32_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                break;
-            case sample_store_type::uint32:
-                if (auto read_result = read_value<uint32_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                break;
-            case sample_store_type::int16:
-                if (auto read_result = read_value<int16_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                break;
-            case sample_store_type::uint16:
-                if (auto read_result = read_value<uint16_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                break;
-            case sample_store_type::int8:
-                if (auto read_result = read_value<int8_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                break;
-            case sample_store_type::uint8:
-                if (auto read_result = read_value<uint8_t>(stream)) {
-                    result.emplace(frame, std::move(read_result.value()));
-                } else {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                break;
-            case sample_store_type::boolean:
-                bool value;
-                stream.read(reinterpret_cast<char *>(&value), sizeof(bool));
-                if (stream.fail() || stream.gcount() != sizeof(bool)) {
-                    return read_result_t{read_error::read_value_failed};
-                }
-                result.emplace(frame, proc::number_event::make_shared(yas::boolean{value}));
-                break;
-            case sample_store_type::unknown:
-                return read_result_t{read_error::sample_store_type_not_found};
+    if (auto const result = validated_header(data.data(), data.size())) {
+        auto const &head = result.value();
+        return read_columns_result_t{
+            columns{std::move(data), nullptr, static_cast<std::size_t>(head.count), head.store_type}};
+    } else {
+        return read_columns_result_t{result.error()};
+    }
+}
+
+numbers_file::read_columns_result_t numbers_file::columns::make(void const *data, std::size_t const byte_size) {
+    using namespace numbers_file_utils;
+
+    auto const *const bytes = static_cast<char const *>(data);
+
+    if (!has_header(bytes, byte_size)) {
+        // 旧形式は並べ直すので参照できない
+        if (auto result = make_data_from_legacy(bytes, byte_size)) {
+            return make(std::move(result.value()));
+        } else {
+            return read_columns_result_t{result.error()};
         }
     }
 
-    return read_result_t{std::move(result)};
+    if (auto const result = validated_header(bytes, byte_size)) {
+        auto const &head = result.value();
+        return read_columns_result_t{columns{{}, bytes, static_cast<std::size_t>(head.count), head.store_type}};
+    } else {
+        return read_columns_result_t{result.error()};
+    }
+}
+
+char const *numbers_file::columns::_bytes() const {
+    return this->_unowned_data ? this->_unowned_data : this->_data.data();
 }
 
 std::string yas::to_string(numbers_file::write_error const &error) {
@@ -202,6 +476,10 @@ std::string yas::to_string(numbers_file::read_error const &error) {
             return "read_value_failed";
         case numbers_file::read_error::sample_store_type_not_found:
             return "sample_store_type_not_found";
+        case numbers_file::read_error::read_from_stream_failed:
+            return "read_from_stream_failed";
+        case numbers_file::read_error::invalid_header:
+            return "invalid_header";
     }
 }
 
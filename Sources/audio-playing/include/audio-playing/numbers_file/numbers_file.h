@@ -8,9 +8,14 @@
 #include <audio-processing/event/number_event.h>
 #include <cpp-utils/result.h>
 
+#include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
+/// 数値イベントを書き込むファイル
+/// 先頭のヘッダにイベントの数と値の型を置き、その後にフレームの列と値の列を並べる
+/// ヘッダのない旧形式のファイル（フレーム・値の型・値の繰り返し）も読み込める
 namespace yas::playing::numbers_file {
 enum class write_error {
     open_stream_failed,
@@ -24,14 +29,60 @@ enum class read_error {
     read_sample_store_type_failed,
     read_value_failed,
     sample_store_type_not_found,
+    read_from_stream_failed,
+    invalid_header,
 };
 
+struct columns;
+
 using event_map_t = std::multimap<playing::frame_index_t, proc::number_event_ptr>;
 using write_result_t = result<std::nullptr_t, write_error>;
 using read_result_t = result<event_map_t, read_error>;
+using read_columns_result_t = result<columns, read_error>;
+
+/// 読み込んだファイルの中身を1つの領域に持ち、列のまま参照する
+/// number_eventは取り出すときに作る
+struct columns final {
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] frame_index_t frame_at(std::size_t const idx) const;
+    [[nodiscard]] sample_store_type store_type_at(std::size_t const idx) const;
+    [[nodiscard]] proc::number_event_ptr event_at(std::size_t const idx) const;
+    /// すべてのイベントを作ってまとめる
+    [[nodiscard]] event_map_t events() const;
+
+    /// ファイルの中身を受け取る。旧形式なら列に並べ直す
+    [[nodiscard]] static read_columns_result_t make(std::vector<char> &&data);
+    /// マップしたファイルの中身などをコピーせずに参照する。使い終わるまで領域を保つこと
+    /// 旧形式なら並べ直したものを持つ
+    [[nodiscard]] static read_columns_result_t make(void const *data, std::size_t const byte_size);
+
+   private:
+    std::vector<char> _data;
+    char const *_unowned_data;
+    std::size_t _size;
+    sample_store_type _store_type;
+    std::size_t _store_types_offset;
+    std::size_t _values_offset;
+    std::size_t _value_stride;
+
+    columns(std::vector<char> &&data, char const *const unowned_data, std::size_t const size,
+            sample_store_type const store_type);
+
+    [[nodiscard]] char const *_bytes() const;
+};
 
 write_result_t write(std::string const &path, event_map_t const &);
 read_result_t read(std::string const &path);
+/// ファイル全体を1回で読み込む
+read_columns_result_t read_columns(std::string const &path);
+/// マップしたファイルの中身などをコピーせずに参照する。返したcolumnsを使う間は領域を保つこと
+read_columns_result_t read_columns(void const *data, std::size_t const byte_size);
+
+/// 開いたストリームの現在位置から書き込む。閉じるのは呼び出し側で行う
+write_result_t write(std::ostream &, event_map_t const &);
+/// ストリームの終わりまで読み込む
+read_result_t read(std::istream &);
+read_columns_result_t read_columns(std::istream &);
 }  // namespace yas::playing::numbers_file
 
 namespace yas {
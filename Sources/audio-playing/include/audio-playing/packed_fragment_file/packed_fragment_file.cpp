@@ -0,0 +1,287 @@
+//
+//  packed_fragment_file.cpp
+//
+
+#include "packed_fragment_file.h"
+
+#include <audio-engine/format/format.h>
+#include <audio-playing/timeline/timeline_utils.h>
+#include <audio-processing/event/number_event.h>
+#include <audio-processing/event/signal_event.h>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace yas;
+using namespace yas::playing;
+
+namespace yas::playing::packed_fragment_file {
+static char constexpr magic[4] = {'y', 'a', 's', 'f'};
+static uint32_t constexpr version = 1;
+// マップしたまま読めるように信号のデータの位置を揃える
+static std::size_t constexpr data_alignment = 16;
+
+struct header {
+    char magic[4];
+    uint32_t version;
+    uint32_t signal_count;
+    uint32_t reserved;
+    uint64_t numbers_offset;
+    uint64_t numbers_byte_size;
+};
+
+struct signal_index {
+    int64_t frame;
+    uint64_t length;
+    uint64_t data_offset;
+    sample_store_type store_type;
+    char reserved[7];
+};
+
+static_assert(sizeof(header) == 32);
+static_assert(sizeof(signal_index) == 32);
+
+static uint64_t aligned(uint64_t const value) {
+    return (value + data_alignment - 1) / data_alignment * data_alignment;
+}
+
+static bool write_padding(std::ostream &stream, uint64_t const byte_size) {
+    static char const zeros[data_alignment] = {0};
+    stream.write(zeros, byte_size);
+    return !stream.fail();
+}
+}  // namespace yas::playing::packed_fragment_file
+
+packed_fragment_file::write_result_t packed_fragment_file::write(std::string const &path,
+                                                                 proc::channel const &channel) {
+    auto const signal_events = channel.filtered_events<proc::signal_event>();
+    auto const number_events = channel.filtered_events<proc::number_event>();
+
+    std::vector<signal_index> indices;
+    indices.reserve(signal_events.size());
+
+    uint64_t offset = aligned(sizeof(header) + sizeof(signal_index) * signal_events.size());
+
+    for (auto const &event_pair : signal_events) {
+        proc::time::range const &range = event_pair.first;
+        proc::signal_event_ptr const &event = event_pair.second;
+
+        indices.emplace_back(signal_index{.frame = range.frame,
+                                          .length = range.length,
+                                          .data_offset = offset,
+                                          .store_type = timeline_utils::to_sample_store_type(event->sample_type()),
+                                          .reserved = {0}});
+        offset = aligned(offset + event->byte_size());
+    }
+
+    header const head{.magic = {magic[0], magic[1], magic[2], magic[3]},
+                      .version = version,
+                      .signal_count = static_cast<uint32_t>(indices.size()),
+                      .reserved = 0,
+                      .numbers_offset = offset,
+                      .numbers_byte_size = 0};
+
+    auto const tmp_path = path + ".tmp";
+
+    // 途中で失敗しても一時ファイルを残さない
+    auto const write_tmp = [&]() -> write_result_t {
+        std::ofstream stream{tmp_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        if (!stream) {
+            return write_result_t{write_error::open_stream_failed};
+        }
+
+        stream.write(reinterpret_cast<char const *>(&head), sizeof(header));
+        stream.write(reinterpret_cast<char const *>(indices.data()), sizeof(signal_index) * indices.size());
+
+        uint64_t position = sizeof(header) + sizeof(signal_index) * indices.size();
+
+        auto index_it = indices.begin();
+        for (auto const &event_pair : signal_events) {
+            proc::signal_event_ptr const &event = event_pair.second;
+
+            if (!write_padding(stream, index_it->data_offset - position)) {
+                return write_result_t{write_error::write_to_stream_failed};
+            }
+
+            if (char const *data = timeline_utils::char_data(*event)) {
+                stream.write(data, event->byte_size());
+            }
+
+            if (stream.fail()) {
+                return write_result_t{write_error::write_to_stream_failed};
+            }
+
+            position = index_it->data_offset + event->byte_size();
+            ++index_it;
+        }
+
+        if (!write_padding(stream, head.numbers_offset - position)) {
+            return write_result_t{write_error::write_to_stream_failed};
+        }
+
+        if (number_events.size() > 0) {
+            if (auto const result = numbers_file::write(stream, number_events); !result) {
+                return write_result_t{write_error::write_to_stream_failed};
+            }
+
+            // 数値イベントの大きさは書いた後に分かるのでヘッダを書き直す
+            uint64_t const numbers_byte_size = static_cast<uint64_t>(stream.tellp()) - head.numbers_offset;
+            stream.seekp(offsetof(header, numbers_byte_size));
+            stream.write(reinterpret_cast<char const *>(&numbers_byte_size), sizeof(uint64_t));
+
+            if (stream.fail()) {
+                return write_result_t{write_error::write_to_stream_failed};
+            }
+        }
+
+        stream.close();
+        if (stream.fail()) {
+            return write_result_t{write_error::close_stream_failed};
+        }
+
+        return write_result_t{nullptr};
+    };
+
+    if (auto const result = write_tmp(); !result) {
+        std::error_code error_code;
+        std::filesystem::remove(tmp_path, error_code);
+        return result;
+    }
+
+    std::error_code error_code;
+    std::filesystem::rename(tmp_path, path, error_code);
+    if (error_code) {
+        std::filesystem::remove(tmp_path, error_code);
+        return write_result_t{write_error::rename_failed};
+    }
+
+    return write_result_t{nullptr};
+}
+
+packed_fragment_file::read_result_t packed_fragment_file::read_signals(void const *data, std::size_t const byte_size,
+                                                                       audio::pcm_buffer &buffer,
+                                                                       frame_index_t const buf_top_frame) {
+    char const *const bytes = static_cast<char const *>(data);
+
+    if (byte_size < sizeof(header)) {
+        return read_result_t{read_error::invalid_header};
+    }
+
+    header head;
+    std::memcpy(&head, bytes, sizeof(header));
+
+    if (std::memcmp(head.magic, magic, sizeof(magic)) != 0 || head.version != version) {
+        return read_result_t{read_error::invalid_header};
+    }
+
+    if (byte_size < sizeof(header) + sizeof(signal_index) * head.signal_count) {
+        return read_result_t{read_error::invalid_header};
+    }
+
+    auto const buf_store_type = timeline_utils::to_sample_store_type(yas::to_sample_type(buffer.format().pcm_format()));
+    std::size_t const sample_byte_count = buffer.format().sample_byte_count();
+    frame_index_t const buf_next_frame = buf_top_frame + buffer.frame_length();
+    char *const buf_ptr = timeline_utils::char_data(buffer);
+
+    for (uint32_t idx = 0; idx < head.signal_count; ++idx) {
+        signal_index index;
+        std::memcpy(&index, &bytes[sizeof(header) + sizeof(signal_index) * idx], sizeof(signal_index));
+
+        if (index.store_type != buf_store_type) {
+            continue;
+        }
+
+        // ファイルの値をそのまま足したり掛けたりすると溢れることがあるので、残りの大きさと比べる
+        if (byte_size < index.data_offset || (byte_size - index.data_offset) / sample_byte_count < index.length) {
+            return read_result_t{read_error::invalid_signal_index};
+        }
+
+        uint64_t const length = index.length * sample_byte_count;
+
+        if (index.frame < buf_top_frame || buf_next_frame < index.frame + static_cast<frame_index_t>(index.length)) {
+            return read_result_t{read_error::out_of_range};
+        }
+
+        std::memcpy(&buf_ptr[(index.frame - buf_top_frame) * sample_byte_count], &bytes[index.data_offset], length);
+    }
+
+    return read_result_t{nullptr};
+}
+
+packed_fragment_file::read_numbers_result_t packed_fragment_file::read_numbers(std::string const &path) {
+    std::ifstream stream{path, std::ios_base::in | std::ios_base::binary};
+    if (!stream) {
+        return read_numbers_result_t{read_error::open_stream_failed};
+    }
+
+    header head;
+    stream.read(reinterpret_cast<char *>(&head), sizeof(header));
+    if (stream.fail() || stream.gcount() != sizeof(header)) {
+        return read_numbers_result_t{read_error::read_from_stream_failed};
+    }
+
+    if (std::memcmp(head.magic, magic, sizeof(magic)) != 0 || head.version != version) {
+        return read_numbers_result_t{read_error::invalid_header};
+    }
+
+    std::vector<char> numbers_data(head.numbers_byte_size);
+
+    stream.seekg(head.numbers_offset);
+    stream.read(numbers_data.data(), numbers_data.size());
+    if (stream.fail() || static_cast<uint64_t>(stream.gcount()) != head.numbers_byte_size) {
+        return read_numbers_result_t{read_error::read_from_stream_failed};
+    }
+
+    if (auto result = numbers_file::columns::make(std::move(numbers_data))) {
+        return read_numbers_result_t{result.value().events()};
+    } else {
+        return read_numbers_result_t{read_error::read_numbers_failed};
+    }
+}
+
+std::string yas::to_string(packed_fragment_file::write_error const &error) {
+    switch (error) {
+        case packed_fragment_file::write_error::open_stream_failed:
+            return "open_stream_failed";
+        case packed_fragment_file::write_error::write_to_stream_failed:
+            return "write_to_stream_failed";
+        case packed_fragment_file::write_error::close_stream_failed:
+            return "close_stream_failed";
+        case packed_fragment_file::write_error::rename_failed:
+            return "rename_failed";
+    }
+
+    throw "error not found.";
+}
+
+std::string yas::to_string(packed_fragment_file::read_error const &error) {
+    switch (error) {
+        case packed_fragment_file::read_error::open_stream_failed:
+            return "open_stream_failed";
+        case packed_fragment_file::read_error::read_from_stream_failed:
+            return "read_from_stream_failed";
+        case packed_fragment_file::read_error::invalid_header:
+            return "invalid_header";
+        case packed_fragment_file::read_error::invalid_signal_index:
+            return "invalid_signal_index";
+        case packed_fragment_file::read_error::out_of_range:
+            return "out_of_range";
+        case packed_fragment_file::read_error::read_numbers_failed:
+            return "read_numbers_failed";
+    }
+
+    throw "error not found.";
+}
+
+std::ostream &operator<<(std::ostream &os, yas::playing::packed_fragment_file::write_error const &value) {
+    os << to_string(value);
+    return os;
+}
+
+std::ostream &operator<<(std::ostream &os, yas::playing::packed_fragment_file::read_error const &value) {
+    os << to_string(value);
+    return os;
+}
@@ -0,0 +1,53 @@
+//
+//  packed_fragment_file.h
+//
+
+#pragma once
+
+#include <audio-engine/pcm_buffer/pcm_buffer.h>
+#include <audio-playing/common/types.h>
+#include <audio-playing/numbers_file/numbers_file.h>
+#include <audio-processing/channel/channel.h>
+#include <cpp-utils/result.h>
+
+#include <ostream>
+#include <string>
+
+/// 1チャンネル1フラグメント分のイベントを1つのファイルにまとめる
+/// 先頭のヘッダに信号イベントの範囲・サンプルの型・データの位置を並べ、その後に信号のデータと数値イベントを置く
+namespace yas::playing::packed_fragment_file {
+enum class write_error {
+    open_stream_failed,
+    write_to_stream_failed,
+    close_stream_failed,
+    rename_failed,
+};
+
+enum class read_error {
+    open_stream_failed,
+    read_from_stream_failed,
+    invalid_header,
+    invalid_signal_index,
+    out_of_range,
+    read_numbers_failed,
+};
+
+using write_result_t = result<std::nullptr_t, write_error>;
+using read_result_t = result<std::nullptr_t, read_error>;
+using read_numbers_result_t = result<numbers_file::event_map_t, read_error>;
+
+/// 一時ファイルに書き込んでからリネームするので、読み込み側が書きかけのファイルを見ることはない
+write_result_t write(std::string const &path, proc::channel const &);
+/// マップしたファイルの中身から、バッファと同じサンプルの型の信号をコピーする
+read_result_t read_signals(void const *data, std::size_t const byte_size, audio::pcm_buffer &,
+                           frame_index_t const buf_top_frame);
+read_numbers_result_t read_numbers(std::string const &path);
+}  // namespace yas::playing::packed_fragment_file
+
+namespace yas {
+std::string to_string(playing::packed_fragment_file::write_error const &);
+std::string to_string(playing::packed_fragment_file::read_error const &);
+}  // namespace yas
+
+std::ostream &operator<<(std::ostream &, yas::playing::packed_fragment_file::write_error const &);
+std::ostream &operator<<(std::ostream &, yas::playing::packed_fragment_file::read_error const &);
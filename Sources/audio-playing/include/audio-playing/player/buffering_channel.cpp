@@ -5,33 +5,117 @@
 #include "buffering_channel.h"
 
 #include <audio-playing/player/buffering_element.h>
+#include <audio-playing/signal_file/signal_file_cache.h>
 #include <cpp-utils/fast_each.h>
 
+#include <algorithm>
 #include <thread>
 
 using namespace yas;
 using namespace yas::playing;
 
-buffering_channel::buffering_channel(std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&elements)
-    : _elements(std::move(elements)) {
+namespace yas::playing::buffering_channel_utils {
+static bool is_readable(std::shared_ptr<buffering_element_for_buffering_channel> const &element,
+                        fragment_index_t const frag_idx) {
+    return element->state() == audio_buffering_element_state::readable &&
+           element->fragment_index_on_render() == frag_idx;
 }
+}  // namespace yas::playing::buffering_channel_utils
 
-void buffering_channel::write_all_elements_on_task(path::channel const &ch_path, fragment_index_t const top_frag_idx) {
+buffering_channel::buffering_channel(std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&elements,
+                                     make_element_f &&make_element_handler)
+    : _element_buffers{std::move(elements), elements_t{}}, _make_element_handler(std::move(make_element_handler)) {
+}
+
+std::size_t buffering_channel::write_all_elements_on_task(path::channel const &ch_path,
+                                                          fragment_index_t const top_frag_idx) {
+    using namespace buffering_channel_utils;
+
+    // 前回と違うファイルを読むなら読み込み済みのものは使えない
+    bool const is_reusable = this->_ch_path.has_value() && this->_ch_path.value() == ch_path;
     this->_ch_path = ch_path;
 
-    fragment_index_t element_frag_idx = top_frag_idx;
-    for (auto &element : this->_elements) {
-        element->force_write_on_task(ch_path, element_frag_idx);
-        ++element_frag_idx;
+    this->_apply_added_element_on_task();
+    this->_clear_warm_elements_if_needed_on_task();
+
+    if (!is_reusable) {
+        this->_warm_elements.clear();
+    }
+
+    auto &elements = this->_elements();
+    auto const count = elements.size();
+    elements_t next_elements(count, nullptr);
+    std::vector<bool> is_used(count, false);
+    std::size_t reused_count = 0;
+
+    if (is_reusable) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            fragment_index_t const frag_idx = top_frag_idx + idx;
+
+            for (std::size_t element_idx = 0; element_idx < count; ++element_idx) {
+                if (!is_used.at(element_idx) && is_readable(elements.at(element_idx), frag_idx)) {
+                    next_elements.at(idx) = elements.at(element_idx);
+                    is_used.at(element_idx) = true;
+                    ++reused_count;
+                    break;
+                }
+            }
+
+            if (next_elements.at(idx)) {
+                continue;
+            }
+
+            auto const warm_it = std::find_if(
+                this->_warm_elements.begin(), this->_warm_elements.end(),
+                [&frag_idx](auto const &element) { return element && is_readable(element, frag_idx); });
+
+            if (warm_it != this->_warm_elements.end()) {
+                next_elements.at(idx) = std::move(*warm_it);
+                *warm_it = nullptr;
+                ++reused_count;
+            }
+        }
+    }
+
+    std::size_t unused_idx = 0;
+    auto const pull_unused_element = [&elements, &is_used, &unused_idx] {
+        while (is_used.at(unused_idx)) {
+            ++unused_idx;
+        }
+        is_used.at(unused_idx) = true;
+        return elements.at(unused_idx);
+    };
+
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        if (next_elements.at(idx)) {
+            continue;
+        }
+
+        auto const element = pull_unused_element();
+        element->force_write_on_task(ch_path, top_frag_idx + idx);
+        next_elements.at(idx) = element;
 
         std::this_thread::yield();
     }
+
+    // 先読み用から使った分は、使われなかったエレメントと入れ替える
+    for (auto &element : this->_warm_elements) {
+        if (!element) {
+            element = pull_unused_element();
+        }
+    }
+
+    elements = std::move(next_elements);
+    this->_top_frag_idx.store(top_frag_idx);
+
+    return reused_count;
 }
 
 bool buffering_channel::write_elements_if_needed_on_task() {
     bool is_written = false;
 
-    for (auto &element : this->_elements) {
+    // renderで並びが切り替わっても、前の並びは次にtaskで増やすまで残っている
+    for (auto &element : this->_elements()) {
         if (element->write_if_needed_on_task(this->_ch_path.value())) {
             is_written = true;
         }
@@ -40,25 +124,153 @@ bool buffering_channel::write_elements_if_needed_on_task() {
     return is_written;
 }
 
+void buffering_channel::set_element_count_on_task(std::size_t const count) {
+    this->_apply_added_element_on_task();
+    this->_clear_warm_elements_if_needed_on_task();
+
+    auto &elements = this->_elements();
+
+    while (count < elements.size()) {
+        this->_warm_elements.emplace_back(std::move(elements.back()));
+        elements.pop_back();
+    }
+
+    while (elements.size() < count) {
+        if (!this->_warm_elements.empty()) {
+            elements.emplace_back(std::move(this->_warm_elements.back()));
+            this->_warm_elements.pop_back();
+        } else if (this->_make_element_handler) {
+            elements.emplace_back(this->_make_element_handler());
+        } else {
+            break;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+bool buffering_channel::add_element_on_task() {
+    // 前に加えたものがrenderで並びに入るまでは増やさない
+    if (!this->_ch_path.has_value() || this->_is_element_added.load()) {
+        return false;
+    }
+
+    this->_clear_warm_elements_if_needed_on_task();
+
+    std::shared_ptr<buffering_element_for_buffering_channel> element = nullptr;
+
+    if (!this->_warm_elements.empty()) {
+        element = std::move(this->_warm_elements.back());
+        this->_warm_elements.pop_back();
+    } else if (this->_make_element_handler) {
+        element = this->_make_element_handler();
+    } else {
+        return false;
+    }
+
+    auto const &elements = this->_elements();
+
+    // 次にrenderで進んだ時に並びの最後になるフラグメント
+    element->force_write_on_task(this->_ch_path.value(), this->_top_frag_idx.load() + elements.size() + 1);
+
+    if (element->state() != audio_buffering_element_state::readable) {
+        this->_warm_elements.emplace_back(std::move(element));
+        return false;
+    }
+
+    auto &next_elements = this->_element_buffers.at(1 - this->_elements_idx.load());
+    next_elements = elements;
+    next_elements.emplace_back(std::move(element));
+
+    this->_is_element_added.store(true);
+
+    return true;
+}
+
+bool buffering_channel::write_warm_elements_if_needed_on_task(std::vector<fragment_index_t> const &frag_indices) {
+    using namespace buffering_channel_utils;
+
+    if (!this->_ch_path.has_value()) {
+        return false;
+    }
+
+    this->_clear_warm_elements_if_needed_on_task();
+
+    auto const is_required = [&frag_indices](auto const &element) {
+        return std::any_of(frag_indices.begin(), frag_indices.end(),
+                           [&element](fragment_index_t const frag_idx) { return is_readable(element, frag_idx); });
+    };
+
+    for (auto const &frag_idx : frag_indices) {
+        if (std::any_of(this->_warm_elements.begin(), this->_warm_elements.end(),
+                        [&frag_idx](auto const &element) { return is_readable(element, frag_idx); })) {
+            continue;
+        }
+
+        auto it = std::find_if_not(this->_warm_elements.begin(), this->_warm_elements.end(), is_required);
+
+        if (it == this->_warm_elements.end()) {
+            if (!this->_make_element_handler) {
+                return false;
+            }
+            it = this->_warm_elements.insert(this->_warm_elements.end(), this->_make_element_handler());
+        }
+
+        // 1回の呼び出しではひとつだけ書き込む
+        (*it)->force_write_on_task(this->_ch_path.value(), frag_idx);
+
+        return true;
+    }
+
+    // 全て読み込み済みなら先読みの対象から外れたものを捨てる
+    std::erase_if(this->_warm_elements, [&is_required](auto const &element) { return !is_required(element); });
+
+    return false;
+}
+
 void buffering_channel::advance_on_render(fragment_index_t const frag_idx) {
-    for (auto const &element : this->_elements) {
+    auto const &elements = this->_elements();
+
+    for (auto const &element : elements) {
         if (element->fragment_index_on_render() == frag_idx) {
-            element->advance_on_render(frag_idx + this->_elements.size());
+            element->advance_on_render(frag_idx + elements.size());
         }
     }
+
+    this->_top_frag_idx.store(frag_idx + 1);
+
+    if (!this->_is_element_added.load()) {
+        return;
+    }
+
+    // taskで用意した、エレメントを増やした並びに切り替える
+    auto const next_idx = 1 - this->_elements_idx.load();
+    auto const &next_elements = this->_element_buffers.at(next_idx);
+    auto const &added_element = next_elements.back();
+    fragment_index_t const added_frag_idx = frag_idx + next_elements.size();
+
+    // 用意してから進んでいたら読み直させる
+    if (added_element->fragment_index_on_render() != added_frag_idx) {
+        added_element->advance_on_render(added_frag_idx);
+    }
+
+    this->_elements_idx.store(next_idx);
+    this->_is_element_added.store(false);
 }
 
 void buffering_channel::overwrite_element_on_render(fragment_range const range) {
-    for (auto const &element : this->_elements) {
+    for (auto const &element : this->_elements()) {
         auto const frag_idx = element->fragment_index_on_render();
         if (range.contains(frag_idx)) {
             element->overwrite_on_render();
         }
     }
+
+    this->_is_warm_invalidated.store(true);
 }
 
 bool buffering_channel::read_into_buffer_on_render(audio::pcm_buffer *out_buffer, frame_index_t const frame) {
-    for (auto const &element : this->_elements) {
+    for (auto const &element : this->_elements()) {
         if (element->contains_frame_on_render(frame)) {
             return element->read_into_buffer_on_render(out_buffer, frame);
         }
@@ -67,14 +279,60 @@ bool buffering_channel::read_into_buffer_on_render(audio::pcm_buffer *out_buffer
     return false;
 }
 
+bool buffering_channel::read_into_channel_on_render(audio::pcm_buffer *out_buffer, uint32_t const out_ch_idx,
+                                                    uint32_t const out_begin_frame, frame_index_t const frame,
+                                                    uint32_t const length) {
+    for (auto const &element : this->_elements()) {
+        if (element->contains_frame_on_render(frame)) {
+            return element->read_into_channel_on_render(out_buffer, out_ch_idx, out_begin_frame, frame, length);
+        }
+    }
+
+    return false;
+}
+
+buffering_channel::elements_t &buffering_channel::_elements() {
+    return this->_element_buffers.at(this->_elements_idx.load());
+}
+
+buffering_channel::elements_t const &buffering_channel::_elements() const {
+    return this->_element_buffers.at(this->_elements_idx.load());
+}
+
+void buffering_channel::_apply_added_element_on_task() {
+    // renderで切り替えられる前に全体を書き込むことになったら、ここで切り替える
+    if (this->_is_element_added.exchange(false)) {
+        this->_elements_idx.store(1 - this->_elements_idx.load());
+    }
+
+    this->_element_buffers.at(1 - this->_elements_idx.load()).clear();
+}
+
+void buffering_channel::_clear_warm_elements_if_needed_on_task() {
+    if (this->_is_warm_invalidated.exchange(false)) {
+        this->_warm_elements.clear();
+    }
+}
+
 std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> const &buffering_channel::elements_for_test()
     const {
-    return this->_elements;
+    return this->_elements();
+}
+
+std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> const &
+buffering_channel::warm_elements_for_test() const {
+    return this->_warm_elements;
 }
 
 buffering_channel_ptr buffering_channel::make_shared(
     std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&elements) {
-    return buffering_channel_ptr{new buffering_channel{std::move(elements)}};
+    return make_shared(std::move(elements), nullptr);
+}
+
+buffering_channel_ptr buffering_channel::make_shared(
+    std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&elements,
+    make_element_f &&make_element_handler) {
+    return buffering_channel_ptr{new buffering_channel{std::move(elements), std::move(make_element_handler)}};
 }
 
 buffering_channel_ptr playing::make_buffering_channel(std::size_t const element_count, audio::format const &format,
@@ -82,11 +340,16 @@ buffering_channel_ptr playing::make_buffering_channel(std::size_t const element_
     std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> elements;
     elements.reserve(element_count);
 
+    // シークで戻った時にエレメントが一巡する分のファイルを開き直さずに済むようにする
+    auto const file_cache = signal_file_cache::make_shared(element_count);
+
     auto element_each = make_fast_each(element_count);
     while (yas_each_next(element_each)) {
-        elements.emplace_back(buffering_element::make_shared(format, frag_length));
+        elements.emplace_back(buffering_element::make_shared(format, frag_length, file_cache));
         std::this_thread::yield();
     }
 
-    return buffering_channel::make_shared(std::move(elements));
+    return buffering_channel::make_shared(std::move(elements), [format, frag_length, file_cache] {
+        return buffering_element::make_shared(format, frag_length, file_cache);
+    });
 }
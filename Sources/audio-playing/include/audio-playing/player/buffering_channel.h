@@ -8,26 +8,63 @@
 #include <audio-playing/player/buffering_channel_dependency.h>
 #include <audio-playing/player/buffering_resource_dependency.h>
 
+#include <array>
+#include <atomic>
+#include <functional>
+
 namespace yas::playing {
 struct buffering_channel final : buffering_channel_for_buffering_resource {
-    void write_all_elements_on_task(path::channel const &, fragment_index_t const top_frag_idx) override;
+    using make_element_f = std::function<std::shared_ptr<buffering_element_for_buffering_channel>()>;
+
+    /// 同じフラグメントを読み込み済みのエレメントがあれば読み直さずに並べ替えて使う
+    std::size_t write_all_elements_on_task(path::channel const &, fragment_index_t const top_frag_idx) override;
     [[nodiscard]] bool write_elements_if_needed_on_task() override;
+    /// 減らしたエレメントは先読み用に回し、増やす時は先読み用のものから優先して使う
+    void set_element_count_on_task(std::size_t const) override;
+    /// 先読み用のものか新しく作ったエレメントに、加わった時に読むフラグメントを書き込んでおく
+    [[nodiscard]] bool add_element_on_task() override;
+    [[nodiscard]] bool write_warm_elements_if_needed_on_task(std::vector<fragment_index_t> const &) override;
 
     void advance_on_render(fragment_index_t const prev_frag_idx) override;
     void overwrite_element_on_render(fragment_range const) override;
     [[nodiscard]] bool read_into_buffer_on_render(audio::pcm_buffer *, frame_index_t const) override;
+    [[nodiscard]] bool read_into_channel_on_render(audio::pcm_buffer *, uint32_t const out_ch_idx,
+                                                   uint32_t const out_begin_frame, frame_index_t const frame,
+                                                   uint32_t const length) override;
 
     [[nodiscard]] std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> const &elements_for_test()
         const;
+    [[nodiscard]] std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> const &warm_elements_for_test()
+        const;
 
     [[nodiscard]] static buffering_channel_ptr make_shared(
         std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&);
+    [[nodiscard]] static buffering_channel_ptr make_shared(
+        std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&, make_element_f &&);
 
    private:
-    std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> const _elements;
+    using elements_t = std::vector<std::shared_ptr<buffering_element_for_buffering_channel>>;
+
+    // 再生中に増やす時は使っていない方に増やした並びを用意して、renderで切り替える
+    std::array<elements_t, 2> _element_buffers;
+    std::atomic<std::size_t> _elements_idx{0};
+    std::atomic<bool> _is_element_added{false};
+    // renderで次に読み終わるフラグメント
+    std::atomic<fragment_index_t> _top_frag_idx{0};
+    make_element_f const _make_element_handler;
     std::optional<path::channel> _ch_path = std::nullopt;
 
-    explicit buffering_channel(std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&);
+    // taskからのみ触る
+    std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> _warm_elements;
+    // renderで上書きされたら先読みしたものは捨てる
+    std::atomic<bool> _is_warm_invalidated{false};
+
+    buffering_channel(std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> &&, make_element_f &&);
+
+    [[nodiscard]] elements_t &_elements();
+    [[nodiscard]] elements_t const &_elements() const;
+    void _apply_added_element_on_task();
+    void _clear_warm_elements_if_needed_on_task();
 };
 
 [[nodiscard]] buffering_channel_ptr make_buffering_channel(std::size_t const element_count, audio::format const &format,
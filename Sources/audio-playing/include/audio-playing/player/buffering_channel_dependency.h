@@ -22,6 +22,9 @@ struct buffering_element_for_buffering_channel {
 
     [[nodiscard]] virtual bool contains_frame_on_render(frame_index_t const) = 0;
     [[nodiscard]] virtual bool read_into_buffer_on_render(audio::pcm_buffer *, frame_index_t const) = 0;
+    [[nodiscard]] virtual bool read_into_channel_on_render(audio::pcm_buffer *, uint32_t const out_ch_idx,
+                                                           uint32_t const out_begin_frame, frame_index_t const frame,
+                                                           uint32_t const length) = 0;
     virtual void advance_on_render(fragment_index_t const) = 0;
     virtual void overwrite_on_render() = 0;
 };
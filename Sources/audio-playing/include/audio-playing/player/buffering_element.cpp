@@ -4,15 +4,21 @@
 
 #include "buffering_element.h"
 
-#include <audio-playing/signal_file/signal_file.h>
+#include <audio-engine/pcm_buffer/pcm_buffer_allocator.h>
+#include <audio-playing/packed_fragment_file/packed_fragment_file.h>
+#include <audio-playing/signal_file/signal_file_cache.h>
 #include <audio-playing/signal_file/signal_file_info.h>
 #include <cpp-utils/file_manager.h>
 
 using namespace yas;
 using namespace yas::playing;
 
-buffering_element::buffering_element(audio::format const &format, sample_rate_t const frag_length)
-    : _frag_length(frag_length), _buffer(format, frag_length) {
+buffering_element::buffering_element(audio::format const &format, sample_rate_t const frag_length,
+                                     signal_file_cache_ptr const &file_cache)
+    : _frag_length(frag_length),
+      // 書き込む前に必ずクリアするので0で埋めない
+      _buffer(format, frag_length, {.zero_filled = false, .allocator = audio::pcm_buffer_pool::shared()}),
+      _file_cache(file_cache) {
 }
 
 [[nodiscard]] buffering_element::state_t buffering_element::state() const {
@@ -87,6 +93,36 @@ bool buffering_element::read_into_buffer_on_render(audio::pcm_buffer *out_buffer
     }
 }
 
+bool buffering_element::read_into_channel_on_render(audio::pcm_buffer *out_buffer, uint32_t const out_ch_idx,
+                                                    uint32_t const out_begin_frame, frame_index_t const frame,
+                                                    uint32_t const length) {
+    if (this->_current_state.load() != state_t::readable) {
+        throw std::runtime_error("state is not reading.");
+    }
+
+    frame_index_t const begin_frame = this->begin_frame_on_render();
+    frame_index_t const from_frame = frame - begin_frame;
+
+    if (from_frame < 0 || this->_buffer.frame_length() <= from_frame) {
+        return false;
+    }
+
+    if (begin_frame + this->_buffer.frame_length() < frame + length) {
+        return false;
+    }
+
+    if (auto const result = out_buffer->copy_channel_from(this->_buffer,
+                                                          {.from_begin_frame = static_cast<uint32_t>(from_frame),
+                                                           .from_channel = 0,
+                                                           .to_begin_frame = out_begin_frame,
+                                                           .to_channel = out_ch_idx,
+                                                           .length = length})) {
+        return true;
+    } else {
+        return false;
+    }
+}
+
 void buffering_element::advance_on_render(fragment_index_t const frag_idx) {
     if (this->_current_state.load() != state_t::readable) {
         return;
@@ -113,6 +149,10 @@ bool buffering_element::_write_on_task(path::channel const &ch_path) {
 
     auto const frag_idx = this->_frag_idx;
 
+    if (auto const result = this->_write_packed_on_task(ch_path)) {
+        return *result;
+    }
+
     auto const frag_path = path::fragment{ch_path, frag_idx};
     auto const paths_result = file_manager::content_paths_in_directory(frag_path.value());
     if (!paths_result) {
@@ -150,7 +190,7 @@ bool buffering_element::_write_on_task(path::channel const &ch_path) {
     frame_index_t const buf_top_frame = frag_idx * sample_rate;
 
     for (signal_file_info const &info : infos) {
-        if (auto const result = signal_file::read(info, this->_buffer, buf_top_frame); !result) {
+        if (auto const result = this->_file_cache->read(info, this->_buffer, buf_top_frame); !result) {
             return false;
         }
     }
@@ -158,6 +198,31 @@ bool buffering_element::_write_on_task(path::channel const &ch_path) {
     return true;
 }
 
+std::optional<bool> buffering_element::_write_packed_on_task(path::channel const &ch_path) {
+    auto const packed_path = path::packed_fragment{ch_path, this->_frag_idx}.value();
+
+    auto const map_result = this->_file_cache->map(packed_path);
+    if (!map_result) {
+        if (map_result.error() == signal_file::read_error::open_stream_failed) {
+            // まとめたファイルが無ければディレクトリから読む
+            return std::nullopt;
+        } else {
+            return false;
+        }
+    }
+
+    auto const &mapping = map_result.value();
+    frame_index_t const buf_top_frame = this->_frag_idx * this->_frag_length;
+
+    return static_cast<bool>(
+        packed_fragment_file::read_signals(mapping->data, mapping->byte_size, this->_buffer, buf_top_frame));
+}
+
 buffering_element_ptr buffering_element::make_shared(audio::format const &format, sample_rate_t const frag_length) {
-    return buffering_element_ptr{new buffering_element{format, frag_length}};
+    return make_shared(format, frag_length, signal_file_cache::make_shared(1));
+}
+
+buffering_element_ptr buffering_element::make_shared(audio::format const &format, sample_rate_t const frag_length,
+                                                     signal_file_cache_ptr const &file_cache) {
+    return buffering_element_ptr{new buffering_element{format, frag_length, file_cache}};
 }
@@ -19,22 +19,32 @@ struct buffering_element final : buffering_element_for_buffering_channel {
 
     [[nodiscard]] bool contains_frame_on_render(frame_index_t const) override;
     [[nodiscard]] bool read_into_buffer_on_render(audio::pcm_buffer *, frame_index_t const) override;
+    /// frameからlength分を、出力のバッファのout_ch_idxのチャンネルのout_begin_frameの位置へ直接コピーする
+    [[nodiscard]] bool read_into_channel_on_render(audio::pcm_buffer *, uint32_t const out_ch_idx,
+                                                   uint32_t const out_begin_frame, frame_index_t const frame,
+                                                   uint32_t const length) override;
     void advance_on_render(fragment_index_t const) override;
     void overwrite_on_render() override;
 
     [[nodiscard]] audio::pcm_buffer const &buffer_for_test() const;
 
     [[nodiscard]] static buffering_element_ptr make_shared(audio::format const &, sample_rate_t const frag_length);
+    /// 同じチャンネルのエレメント間でファイルのマップを共有する
+    [[nodiscard]] static buffering_element_ptr make_shared(audio::format const &, sample_rate_t const frag_length,
+                                                           signal_file_cache_ptr const &);
 
    private:
     sample_rate_t const _frag_length;
     audio::pcm_buffer _buffer;
+    signal_file_cache_ptr const _file_cache;
 
     std::atomic<state_t> _current_state{state_t::initial};
     fragment_index_t _frag_idx = 0;
 
-    buffering_element(audio::format const &, sample_rate_t const frag_length);
+    buffering_element(audio::format const &, sample_rate_t const frag_length, signal_file_cache_ptr const &);
 
     bool _write_on_task(path::channel const &ch_path);
+    /// まとめたファイルが無ければnulloptを返す
+    std::optional<bool> _write_packed_on_task(path::channel const &ch_path);
 };
 }  // namespace yas::playing
@@ -15,19 +15,43 @@
 #include <cpp-utils/file_manager.h>
 #include <cpp-utils/result.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <mutex>
 #include <thread>
 
 using namespace yas;
 using namespace yas::playing;
 
-buffering_resource::buffering_resource(std::size_t const element_count, std::string const &root_path,
+namespace yas::playing::buffering_resource_utils {
+// 書き込みにかかる時間の倍を、読み込み中のもの以外のエレメントで賄えるようにする
+static double constexpr refill_headroom = 2.0;
+// 書き込みごとに最大の時間を減衰させて、速くなったら少しずつエレメントを減らす
+static double constexpr refill_peak_decay = 0.95;
+static std::size_t constexpr recent_seek_count = 2;
+
+static std::size_t element_count(double const refill_peak_seconds, double const frag_seconds,
+                                 buffering_prefetch_args const &args) {
+    auto const count = 1 + static_cast<std::size_t>(std::ceil(refill_peak_seconds * refill_headroom / frag_seconds));
+    return std::clamp(count, args.min_element_count, args.max_element_count);
+}
+}  // namespace yas::playing::buffering_resource_utils
+
+buffering_resource::buffering_resource(buffering_prefetch_args const &args, std::string const &root_path,
                                        make_channel_f &&make_channel_handler)
-    : _element_count(element_count), _root_path(root_path), _make_channel_handler(make_channel_handler), _ch_mapping() {
+    : _prefetch_args(args),
+      _element_count(args.min_element_count),
+      _root_path(root_path),
+      _make_channel_handler(make_channel_handler),
+      _ch_mapping() {
+    if (args.min_element_count == 0 || args.max_element_count < args.min_element_count) {
+        throw std::invalid_argument("invalid element count.");
+    }
 }
 
 std::size_t buffering_resource::element_count() const {
-    return this->_element_count;
+    return this->_element_count.load();
 }
 
 buffering_resource::setup_state_t buffering_resource::setup_state() const {
@@ -114,7 +138,8 @@ void buffering_resource::create_buffer_on_task() {
 
     auto ch_each = make_fast_each(this->_ch_count);
     while (yas_each_next(ch_each)) {
-        this->_channels.emplace_back(this->_make_channel_handler(this->_element_count, format, this->_sample_rate));
+        this->_channels.emplace_back(
+            this->_make_channel_handler(this->_element_count.load(), format, this->_sample_rate));
 
         std::this_thread::yield();
     }
@@ -155,6 +180,12 @@ void buffering_resource::write_all_elements_on_task() {
 
     std::this_thread::yield();
 
+    if (auto frames = this->_pull_warming_frames_request_on_task(); frames.has_value()) {
+        this->_warming_frames = std::move(frames.value());
+    }
+
+    std::this_thread::yield();
+
     this->_tl_path = path::timeline{.root_path = this->_root_path,
                                     .identifier = this->_identifier,
                                     .sample_rate = static_cast<sample_rate_t>(this->_sample_rate)};
@@ -166,17 +197,33 @@ void buffering_resource::write_all_elements_on_task() {
         throw std::runtime_error("sample_rate is empty.");
     }
 
+    this->_update_element_count_on_task();
+
+    std::size_t reused_count = 0;
     channel_index_t ch_idx = 0;
     auto const ch_count = this->_channels.size();
     for (auto const &channel : this->_channels) {
         path::channel const ch_path{*this->_tl_path, this->_ch_mapping.file_index(ch_idx, ch_count).value()};
-        channel->write_all_elements_on_task(ch_path, top_frag_idx.value());
+        reused_count += channel->write_all_elements_on_task(ch_path, top_frag_idx.value());
 
         ++ch_idx;
 
         std::this_thread::yield();
     }
 
+    this->_warm_hit_count.fetch_add(reused_count, std::memory_order_relaxed);
+    this->_warm_miss_count.fetch_add(ch_count * this->_element_count.load() - reused_count,
+                                     std::memory_order_relaxed);
+
+    auto &recent_indices = this->_recent_top_frag_indices;
+    std::erase(recent_indices, top_frag_idx.value());
+    recent_indices.insert(recent_indices.begin(), top_frag_idx.value());
+    if (buffering_resource_utils::recent_seek_count < recent_indices.size()) {
+        recent_indices.resize(buffering_resource_utils::recent_seek_count);
+    }
+
+    this->_update_warming_fragment_indices_on_task();
+
     std::this_thread::yield();
 
     this->_rendering_state.store(rendering_state_t::advancing);
@@ -200,6 +247,8 @@ bool buffering_resource::write_elements_if_needed_on_task() {
         return false;
     }
 
+    auto const begin = std::chrono::steady_clock::now();
+
     bool is_loaded = false;
 
     for (auto const &channel : this->_channels) {
@@ -210,7 +259,42 @@ bool buffering_resource::write_elements_if_needed_on_task() {
         std::this_thread::yield();
     }
 
-    return is_loaded;
+    if (is_loaded) {
+        std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - begin;
+        this->_add_refill_seconds_on_task(duration.count());
+    }
+
+    // シークを待たずに、再生中も書き込みが間に合わなければ増やす
+    if (this->_add_element_if_needed_on_task()) {
+        is_loaded = true;
+    }
+
+    if (is_loaded) {
+        return true;
+    }
+
+    if (this->_prefetch_args.warming_fragment_count == 0) {
+        return false;
+    }
+
+    // 再生に必要なエレメントが揃っていれば先読みする
+
+    if (auto frames = this->_pull_warming_frames_request_on_task(); frames.has_value()) {
+        this->_warming_frames = std::move(frames.value());
+        this->_update_warming_fragment_indices_on_task();
+    }
+
+    bool is_warmed = false;
+
+    for (auto const &channel : this->_channels) {
+        if (channel->write_warm_elements_if_needed_on_task(this->_warming_frag_indices)) {
+            is_warmed = true;
+        }
+
+        std::this_thread::yield();
+    }
+
+    return is_warmed;
 }
 
 void buffering_resource::overwrite_element_on_render(element_address const &address) {
@@ -254,6 +338,23 @@ void buffering_resource::set_identifier_request_on_main(std::string const &ident
     this->_identifier_request = identifier;
 }
 
+void buffering_resource::set_warming_frames_request_on_main(std::vector<frame_index_t> const &frames) {
+    std::lock_guard<std::mutex> lock(this->_request_mutex);
+    this->_warming_frames_request = frames;
+}
+
+buffering_statistics buffering_resource::statistics() const {
+    return {.element_count = this->_element_count.load(),
+            .read_count = this->_read_count.load(std::memory_order_relaxed),
+            .underrun_count = this->_underrun_count.load(std::memory_order_relaxed),
+            .refill_count = this->_refill_count.load(std::memory_order_relaxed),
+            .last_refill_seconds = this->_last_refill_seconds.load(std::memory_order_relaxed),
+            .max_refill_seconds = this->_max_refill_seconds.load(std::memory_order_relaxed),
+            .total_refill_seconds = this->_total_refill_seconds.load(std::memory_order_relaxed),
+            .warm_hit_count = this->_warm_hit_count.load(std::memory_order_relaxed),
+            .warm_miss_count = this->_warm_miss_count.load(std::memory_order_relaxed)};
+}
+
 bool buffering_resource::read_into_buffer_on_render(audio::pcm_buffer *out_buffer, channel_index_t const ch_idx,
                                                     frame_index_t const frame) {
     if (auto const state = this->_rendering_state.load(); state != rendering_state_t::advancing) {
@@ -264,7 +365,22 @@ bool buffering_resource::read_into_buffer_on_render(audio::pcm_buffer *out_buffe
         return false;
     }
 
-    return this->_channels.at(ch_idx)->read_into_buffer_on_render(out_buffer, frame);
+    return this->_count_read_on_render(this->_channels.at(ch_idx)->read_into_buffer_on_render(out_buffer, frame));
+}
+
+bool buffering_resource::read_into_channel_on_render(audio::pcm_buffer *out_buffer, channel_index_t const ch_idx,
+                                                     uint32_t const out_begin_frame, frame_index_t const frame,
+                                                     uint32_t const length) {
+    if (auto const state = this->_rendering_state.load(); state != rendering_state_t::advancing) {
+        throw std::runtime_error("state (" + to_string(state) + ") is not advancing.");
+    }
+
+    if (this->_channels.size() <= ch_idx) {
+        return false;
+    }
+
+    return this->_count_read_on_render(this->_channels.at(ch_idx)->read_into_channel_on_render(
+        out_buffer, static_cast<uint32_t>(ch_idx), out_begin_frame, frame, length));
 }
 
 std::optional<channel_mapping> buffering_resource::_pull_ch_mapping_request_on_task() {
@@ -285,10 +401,151 @@ std::optional<std::string> buffering_resource::_pull_identifier_request_on_task(
     return std::nullopt;
 }
 
+std::optional<std::vector<frame_index_t>> buffering_resource::_pull_warming_frames_request_on_task() {
+    if (auto lock = std::unique_lock<std::mutex>(this->_request_mutex, std::try_to_lock); lock.owns_lock()) {
+        auto frames = std::move(this->_warming_frames_request);
+        this->_warming_frames_request = std::nullopt;
+        return frames;
+    }
+    return std::nullopt;
+}
+
+void buffering_resource::_add_refill_seconds_on_task(double const seconds) {
+    this->_refill_peak_seconds =
+        std::max(seconds, this->_refill_peak_seconds * buffering_resource_utils::refill_peak_decay);
+
+    this->_refill_count.fetch_add(1, std::memory_order_relaxed);
+    this->_last_refill_seconds.store(seconds, std::memory_order_relaxed);
+    this->_total_refill_seconds.store(this->_total_refill_seconds.load(std::memory_order_relaxed) + seconds,
+                                      std::memory_order_relaxed);
+    if (this->_max_refill_seconds.load(std::memory_order_relaxed) < seconds) {
+        this->_max_refill_seconds.store(seconds, std::memory_order_relaxed);
+    }
+}
+
+std::size_t buffering_resource::_adapted_element_count_on_task() {
+    auto const current_count = this->_element_count.load();
+    double const frag_seconds = static_cast<double>(this->_frag_length) / static_cast<double>(this->_sample_rate);
+
+    if (auto const underrun_count = this->_underrun_count.load(); underrun_count != this->_handled_underrun_count) {
+        // 書き込みが間に合わなかったので、少なくともひとつ増やす
+        this->_handled_underrun_count = underrun_count;
+        this->_refill_peak_seconds = std::max(
+            this->_refill_peak_seconds, frag_seconds * current_count / buffering_resource_utils::refill_headroom);
+    }
+
+    return buffering_resource_utils::element_count(this->_refill_peak_seconds, frag_seconds, this->_prefetch_args);
+}
+
+void buffering_resource::_update_element_count_on_task() {
+    auto const &args = this->_prefetch_args;
+
+    if (args.min_element_count == args.max_element_count) {
+        return;
+    }
+
+    auto const current_count = this->_element_count.load();
+    auto const count = this->_adapted_element_count_on_task();
+
+    if (count == current_count && !this->_is_element_count_uneven) {
+        return;
+    }
+
+    for (auto const &channel : this->_channels) {
+        channel->set_element_count_on_task(count);
+
+        std::this_thread::yield();
+    }
+
+    this->_element_count.store(count);
+    this->_is_element_count_uneven = false;
+}
+
+bool buffering_resource::_add_element_if_needed_on_task() {
+    auto const &args = this->_prefetch_args;
+
+    if (args.min_element_count == args.max_element_count) {
+        return false;
+    }
+
+    auto const current_count = this->_element_count.load();
+
+    // 減らすのは全体を書き込む時だけにして、再生中はひとつずつ増やす
+    if (this->_adapted_element_count_on_task() <= current_count) {
+        return false;
+    }
+
+    std::size_t added_count = 0;
+
+    for (auto const &channel : this->_channels) {
+        if (channel->add_element_on_task()) {
+            ++added_count;
+        }
+
+        std::this_thread::yield();
+    }
+
+    if (added_count == 0) {
+        return false;
+    }
+
+    if (added_count < this->_channels.size()) {
+        // 増やせなかったチャンネルは全体を書き込む時にそろえる
+        this->_is_element_count_uneven = true;
+    }
+
+    this->_element_count.store(current_count + 1);
+
+    return true;
+}
+
+void buffering_resource::_update_warming_fragment_indices_on_task() {
+    auto &frag_indices = this->_warming_frag_indices;
+    frag_indices.clear();
+
+    auto const add_frag_indices = [this, &frag_indices](fragment_index_t const top_frag_idx) {
+        auto each = make_fast_each(this->_prefetch_args.warming_fragment_count);
+        while (yas_each_next(each)) {
+            fragment_index_t const frag_idx = top_frag_idx + yas_each_index(each);
+            if (std::find(frag_indices.begin(), frag_indices.end(), frag_idx) == frag_indices.end()) {
+                frag_indices.emplace_back(frag_idx);
+            }
+        }
+    };
+
+    for (auto const &frame : this->_warming_frames) {
+        if (auto const top_frag_idx = player_utils::top_fragment_idx(this->_frag_length, frame);
+            top_frag_idx.has_value()) {
+            add_frag_indices(top_frag_idx.value());
+        }
+    }
+
+    for (auto const &top_frag_idx : this->_recent_top_frag_indices) {
+        add_frag_indices(top_frag_idx);
+    }
+}
+
+bool buffering_resource::_count_read_on_render(bool const is_read) {
+    this->_read_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (!is_read) {
+        this->_underrun_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return is_read;
+}
+
 buffering_resource_ptr buffering_resource::make_shared(std::size_t const element_count, std::string const &root_path,
+                                                       make_channel_f &&make_channel_handler) {
+    return make_shared(
+        {.min_element_count = element_count, .max_element_count = element_count, .warming_fragment_count = 0},
+        root_path, std::move(make_channel_handler));
+}
 
+buffering_resource_ptr buffering_resource::make_shared(buffering_prefetch_args const &args,
+                                                       std::string const &root_path,
                                                        make_channel_f &&make_channel_handler) {
-    return buffering_resource_ptr{new buffering_resource{element_count, root_path, std::move(make_channel_handler)}};
+    return buffering_resource_ptr{new buffering_resource{args, root_path, std::move(make_channel_handler)}};
 }
 
 frame_index_t buffering_resource::all_writing_frame_for_test() const {
@@ -302,3 +559,7 @@ channel_mapping const &buffering_resource::ch_mapping_for_test() const {
 std::string const &buffering_resource::identifier_for_test() const {
     return this->_identifier;
 }
+
+std::vector<fragment_index_t> const &buffering_resource::warming_fragment_indices_for_test() const {
+    return this->_warming_frag_indices;
+}
@@ -9,7 +9,9 @@
 #include <audio-playing/player/buffering_resource_types.h>
 #include <audio-playing/player/player_resource_dependency.h>
 
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace yas::playing {
 struct buffering_resource final : buffering_resource_for_player_resource {
@@ -34,22 +36,31 @@ struct buffering_resource final : buffering_resource_for_player_resource {
     bool needs_all_writing_on_render() const override;
     void set_channel_mapping_request_on_main(channel_mapping const &) override;
     void set_identifier_request_on_main(std::string const &) override;
+    void set_warming_frames_request_on_main(std::vector<frame_index_t> const &) override;
+    [[nodiscard]] buffering_statistics statistics() const override;
 
     [[nodiscard]] bool read_into_buffer_on_render(audio::pcm_buffer *, channel_index_t const,
                                                   frame_index_t const) override;
+    [[nodiscard]] bool read_into_channel_on_render(audio::pcm_buffer *, channel_index_t const ch_idx,
+                                                   uint32_t const out_begin_frame, frame_index_t const frame,
+                                                   uint32_t const length) override;
 
     using make_channel_f = std::function<std::shared_ptr<buffering_channel_for_buffering_resource>(
         std::size_t const, audio::format const &, sample_rate_t const)>;
 
     static buffering_resource_ptr make_shared(std::size_t const element_count, std::string const &root_path,
                                               make_channel_f &&);
+    static buffering_resource_ptr make_shared(buffering_prefetch_args const &, std::string const &root_path,
+                                              make_channel_f &&);
 
     frame_index_t all_writing_frame_for_test() const;
     channel_mapping const &ch_mapping_for_test() const;
     std::string const &identifier_for_test() const;
+    std::vector<fragment_index_t> const &warming_fragment_indices_for_test() const;
 
    private:
-    std::size_t const _element_count;
+    buffering_prefetch_args const _prefetch_args;
+    std::atomic<std::size_t> _element_count;
     std::string const _root_path;
     make_channel_f const _make_channel_handler;
 
@@ -71,10 +82,36 @@ struct buffering_resource final : buffering_resource_for_player_resource {
     mutable std::mutex _request_mutex;
     std::optional<channel_mapping> _ch_mapping_request = std::nullopt;
     std::optional<std::string> _identifier_request = std::nullopt;
-
-    buffering_resource(std::size_t const element_count, std::string const &root_path, make_channel_f &&);
+    std::optional<std::vector<frame_index_t>> _warming_frames_request = std::nullopt;
+
+    // 先読みするフラグメントはtaskからのみ触る
+    std::vector<frame_index_t> _warming_frames;
+    std::vector<fragment_index_t> _recent_top_frag_indices;
+    std::vector<fragment_index_t> _warming_frag_indices;
+    double _refill_peak_seconds = 0.0;
+    uint64_t _handled_underrun_count = 0;
+    bool _is_element_count_uneven = false;
+
+    std::atomic<uint64_t> _read_count{0};
+    std::atomic<uint64_t> _underrun_count{0};
+    std::atomic<uint64_t> _refill_count{0};
+    std::atomic<double> _last_refill_seconds{0.0};
+    std::atomic<double> _max_refill_seconds{0.0};
+    std::atomic<double> _total_refill_seconds{0.0};
+    std::atomic<uint64_t> _warm_hit_count{0};
+    std::atomic<uint64_t> _warm_miss_count{0};
+
+    buffering_resource(buffering_prefetch_args const &, std::string const &root_path, make_channel_f &&);
 
     std::optional<channel_mapping> _pull_ch_mapping_request_on_task();
     std::optional<std::string> _pull_identifier_request_on_task();
+    std::optional<std::vector<frame_index_t>> _pull_warming_frames_request_on_task();
+
+    void _add_refill_seconds_on_task(double const);
+    [[nodiscard]] std::size_t _adapted_element_count_on_task();
+    void _update_element_count_on_task();
+    [[nodiscard]] bool _add_element_if_needed_on_task();
+    void _update_warming_fragment_indices_on_task();
+    [[nodiscard]] bool _count_read_on_render(bool const is_read);
 };
 }  // namespace yas::playing
@@ -7,15 +7,27 @@
 #include <audio-engine/pcm_buffer/pcm_buffer.h>
 #include <audio-playing/common/path.h>
 
+#include <vector>
+
 namespace yas::playing {
 struct buffering_channel_for_buffering_resource {
     virtual ~buffering_channel_for_buffering_resource() = default;
 
-    virtual void write_all_elements_on_task(path::channel const &, fragment_index_t const top_frag_idx) = 0;
+    /// 読み込み済みのエレメントを使い回した数を返す
+    virtual std::size_t write_all_elements_on_task(path::channel const &, fragment_index_t const top_frag_idx) = 0;
     [[nodiscard]] virtual bool write_elements_if_needed_on_task() = 0;
+    /// renderから触られていない間に呼ぶ
+    virtual void set_element_count_on_task(std::size_t const) = 0;
+    /// 再生中にエレメントをひとつ増やす。renderで次に進んだ時に並びの最後に加わる
+    [[nodiscard]] virtual bool add_element_on_task() = 0;
+    /// 先読みするフラグメントのエレメントをひとつ書き込んだらtrueを返す
+    [[nodiscard]] virtual bool write_warm_elements_if_needed_on_task(std::vector<fragment_index_t> const &) = 0;
 
     virtual void advance_on_render(fragment_index_t const prev_frag_idx) = 0;
     virtual void overwrite_element_on_render(fragment_range const) = 0;
     [[nodiscard]] virtual bool read_into_buffer_on_render(audio::pcm_buffer *, frame_index_t const) = 0;
+    [[nodiscard]] virtual bool read_into_channel_on_render(audio::pcm_buffer *, uint32_t const out_ch_idx,
+                                                           uint32_t const out_begin_frame, frame_index_t const frame,
+                                                           uint32_t const length) = 0;
 };
 }  // namespace yas::playing
@@ -7,6 +7,28 @@
 using namespace yas;
 using namespace yas::playing;
 
+double buffering_statistics::read_hit_rate() const {
+    if (this->read_count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(this->read_count - this->underrun_count) / static_cast<double>(this->read_count);
+}
+
+double buffering_statistics::warm_hit_rate() const {
+    auto const count = this->warm_hit_count + this->warm_miss_count;
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(this->warm_hit_count) / static_cast<double>(count);
+}
+
+double buffering_statistics::average_refill_seconds() const {
+    if (this->refill_count == 0) {
+        return 0.0;
+    }
+    return this->total_refill_seconds / static_cast<double>(this->refill_count);
+}
+
 std::string yas::to_string(playing::audio_buffering_setup_state const state) {
     switch (state) {
         case playing::audio_buffering_setup_state::initial:
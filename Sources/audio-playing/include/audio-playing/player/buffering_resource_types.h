@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <string>
 
@@ -45,6 +47,35 @@ enum class audio_buffering_rendering_state {
     /// 個別のバッファがwritableならファイルから読み込んで、終わったらreadableにする
     advancing,
 };
+
+struct buffering_prefetch_args final {
+    /// チャンネルごとのエレメント数。書き込みにかかった時間に合わせて範囲内で増減させる
+    std::size_t min_element_count = 3;
+    std::size_t max_element_count = 3;
+    /// シーク先やwarming_framesの位置から先読みしておくフラグメントの数。0なら先読みしない
+    std::size_t warming_fragment_count = 0;
+};
+
+/// bufferingの状態を監視するためのカウンタ
+struct buffering_statistics final {
+    std::size_t element_count = 0;
+    /// renderで読み込んだ回数と、エレメントの書き込みが間に合わず読めなかった回数
+    uint64_t read_count = 0;
+    uint64_t underrun_count = 0;
+    /// taskでエレメントを書き込み直した回数と、1回にかかった時間
+    uint64_t refill_count = 0;
+    double last_refill_seconds = 0.0;
+    double max_refill_seconds = 0.0;
+    double total_refill_seconds = 0.0;
+    /// 全体の書き込みで、読み込み済みのエレメントを使えた数とファイルから読んだ数
+    uint64_t warm_hit_count = 0;
+    uint64_t warm_miss_count = 0;
+
+    /// 回数が0なら0を返す
+    [[nodiscard]] double read_hit_rate() const;
+    [[nodiscard]] double warm_hit_rate() const;
+    [[nodiscard]] double average_refill_seconds() const;
+};
 }  // namespace yas::playing
 
 namespace yas {
@@ -12,7 +12,6 @@
 #include <audio-playing/player/buffering_resource.h>
 #include <audio-playing/player/player_resource.h>
 #include <audio-playing/player/player_utils.h>
-#include <audio-playing/player/reading_resource.h>
 #include <cpp-utils/fast_each.h>
 
 #include <thread>
@@ -24,7 +23,6 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
                workable_ptr const &worker, player_task_priority const &priority,
                std::shared_ptr<player_resource_for_player> const &resource)
     : _renderer(renderer), _worker(worker), _priority(priority), _resource(resource), _ch_mapping(), _identifier("") {
-    using reading_state_t = reading_resource::state_t;
     using rendering_state_t = buffering_resource::rendering_state_t;
     using setup_state_t = buffering_resource::setup_state_t;
 
@@ -35,26 +33,15 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
     // setup worker
 
     worker->add_task(priority.setup, [resource = this->_resource] {
-        auto const &reading = resource->reading();
         auto const &buffering = resource->buffering();
 
-        auto result = worker::task_result::unprocessed;
-
-        if (reading->state() == reading_state_t::creating) {
-            reading->create_buffer_on_task();
-            std::this_thread::yield();
-            result = worker::task_result::processed;
-            std::this_thread::yield();
-        }
-
         if (buffering->setup_state() == setup_state_t::creating) {
             buffering->create_buffer_on_task();
             std::this_thread::yield();
-            result = worker::task_result::processed;
-            std::this_thread::yield();
+            return worker::task_result::processed;
         }
 
-        return result;
+        return worker::task_result::unprocessed;
     });
 
     worker->add_task(priority.rendering, [buffering = this->_resource->buffering()] {
@@ -86,7 +73,6 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
     this->_renderer->set_rendering_handler([resource = this->_resource,
                                             overwrite_requests_handler = std::move(overwrite_requests_handler)](
                                                audio::pcm_buffer *const out_buffer) {
-        auto const &reading = resource->reading();
         auto const &buffering = resource->buffering();
 
         auto const &out_format = out_buffer->format();
@@ -99,28 +85,6 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
             throw std::invalid_argument("out_buffer is not non-interleaved.");
         }
 
-        // reading_resourceのセットアップ
-
-        switch (reading->state()) {
-            case reading_state_t::initial:
-                // 初期状態なのでバッファ生成開始
-                reading->set_creating_on_render(sample_rate, pcm_format, out_length);
-                return;
-            case reading_state_t::creating:
-                // task側で生成中
-                return;
-            case reading_state_t::rendering:
-                // バッファ生成済み
-                break;
-        }
-
-        // 生成済みのreadingバッファを作り直すかチェック
-        if (reading->needs_create_on_render(sample_rate, pcm_format, out_length)) {
-            // バッファを再生成
-            reading->set_creating_on_render(sample_rate, pcm_format, out_length);
-            return;
-        }
-
         // buffering_resourceのセットアップ
 
         switch (buffering->setup_state()) {
@@ -159,7 +123,12 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
 
                 if (rendering_state == rendering_state_t::waiting || seek_frame.has_value() || needs_all_writing) {
                     // 全バッファ再書き込み開始
-                    resource->reset_overwrite_requests_on_render();
+                    if (rendering_state == rendering_state_t::advancing) {
+                        // 読み込み済みのエレメントが使い回されるので、上書きを捨てずに反映しておく
+                        resource->perform_overwrite_requests_on_render(overwrite_requests_handler);
+                    } else {
+                        resource->reset_overwrite_requests_on_render();
+                    }
                     auto const frame = seek_frame.has_value() ? seek_frame.value() : resource->current_frame();
                     if (seek_frame.has_value()) {
                         resource->set_current_frame_on_render(frame);
@@ -180,11 +149,6 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
 
         // 以下レンダリング
 
-        audio::pcm_buffer *reading_buffer = reading->buffer_on_render();
-        if (!reading_buffer) {
-            return;
-        }
-
         frame_index_t const begin_frame = resource->current_frame();
         frame_index_t current_frame = begin_frame;
         frame_index_t const next_frame = current_frame + out_length;
@@ -204,16 +168,11 @@ player::player(std::string const &root_path, std::shared_ptr<renderer_for_player
                     break;
                 }
 
-                reading_buffer->clear();
-                reading_buffer->set_frame_length(proc_length);
-
-                if (!buffering->read_into_buffer_on_render(reading_buffer, idx, current_frame)) {
+                // bufferingのエレメントから出力のバッファへ直接コピーする
+                if (!buffering->read_into_channel_on_render(out_buffer, idx, to_frame, current_frame, proc_length)) {
                     read_failed = true;
                     break;
                 }
-
-                out_buffer->copy_channel_from(*reading_buffer,
-                                              {.to_channel = idx, .to_begin_frame = to_frame, .length = proc_length});
             }
 
             if (read_failed) {
@@ -263,6 +222,10 @@ void player::overwrite(std::optional<channel_index_t> const file_ch_idx, fragmen
     this->_resource->add_overwrite_request_on_main({.file_channel_index = file_ch_idx, .fragment_range = frag_range});
 }
 
+void player::set_warming_frames(std::vector<frame_index_t> const &frames) {
+    this->_resource->buffering()->set_warming_frames_request_on_main(frames);
+}
+
 std::string const &player::identifier() const {
     return this->_identifier;
 }
@@ -283,6 +246,10 @@ frame_index_t player::current_frame() const {
     return this->_resource->current_frame();
 }
 
+playing::buffering_statistics player::buffering_statistics() const {
+    return this->_resource->buffering()->statistics();
+}
+
 observing::syncable player::observe_is_playing(std::function<void(bool const &)> &&handler) {
     return this->_is_playing->observe(std::move(handler));
 }
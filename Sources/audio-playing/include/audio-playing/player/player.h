@@ -19,12 +19,14 @@ struct player final : player_for_coordinator {
     void set_playing(bool const) override;
     void seek(frame_index_t const) override;
     void overwrite(std::optional<channel_index_t> const file_ch_idx, fragment_range const) override;
+    void set_warming_frames(std::vector<frame_index_t> const &) override;
 
     [[nodiscard]] std::string const &identifier() const override;
     [[nodiscard]] playing::channel_mapping channel_mapping() const override;
     [[nodiscard]] bool is_playing() const override;
     [[nodiscard]] bool is_seeking() const override;
     [[nodiscard]] frame_index_t current_frame() const override;
+    [[nodiscard]] playing::buffering_statistics buffering_statistics() const override;
 
     [[nodiscard]] observing::syncable observe_is_playing(std::function<void(bool const &)> &&) override;
 
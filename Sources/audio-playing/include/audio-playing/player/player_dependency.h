@@ -20,7 +20,6 @@ struct player_resource_for_player {
 
     virtual ~player_resource_for_player() = default;
 
-    virtual std::shared_ptr<reading_resource_for_player_resource> const &reading() const = 0;
     virtual std::shared_ptr<buffering_resource_for_player_resource> const &buffering() const = 0;
 
     virtual void set_playing_on_main(bool const) = 0;
@@ -5,19 +5,36 @@
 #include "player_resource.h"
 
 #include <audio-playing/player/buffering_resource.h>
-#include <audio-playing/player/reading_resource.h>
 #include <cpp-utils/fast_each.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace yas;
 using namespace yas::playing;
 
-player_resource::player_resource(std::shared_ptr<reading_resource_for_player_resource> const &reading,
-                                 std::shared_ptr<buffering_resource_for_player_resource> const &buffering)
-    : _reading(reading), _buffering(buffering) {
+namespace yas::playing::player_resource_utils {
+/// すべてのチャンネルのすべてのフラグメントを含む
+static element_address const all_elements{
+    .file_channel_index = std::nullopt,
+    .fragment_range = {.index = std::numeric_limits<fragment_index_t>::min() / 2,
+                       .length = static_cast<length_t>(std::numeric_limits<fragment_index_t>::max())}};
+
+static bool contains(element_address const &lhs, element_address const &rhs) {
+    if (lhs.file_channel_index.has_value() && lhs.file_channel_index != rhs.file_channel_index) {
+        return false;
+    }
+
+    return lhs.fragment_range.index <= rhs.fragment_range.index &&
+           rhs.fragment_range.end_index() <= lhs.fragment_range.end_index();
 }
+}  // namespace yas::playing::player_resource_utils
 
-std::shared_ptr<reading_resource_for_player_resource> const &player_resource::reading() const {
-    return this->_reading;
+player_resource::player_resource(std::shared_ptr<buffering_resource_for_player_resource> const &buffering,
+                                 std::size_t const overwrite_capacity)
+    : _buffering(buffering), _overwrite_queue(overwrite_capacity) {
+    // renderで確保しないように、キューが溢れた場合の1つ分も含めて確保しておく
+    this->_overwrite_requests.reserve(overwrite_capacity + 1);
 }
 
 std::shared_ptr<buffering_resource_for_player_resource> const &player_resource::buffering() const {
@@ -33,19 +50,15 @@ bool player_resource::is_playing_on_render() const {
 }
 
 void player_resource::seek_on_main(frame_index_t const frame) {
-    std::lock_guard<std::mutex> lock(this->_seek_mutex);
-    this->_seek_frame = frame;
-    this->_seek_state = seek_state::requested;
+    this->_seek_frame.store(frame);
+    this->_seek_state.store(seek_state::requested);
 }
 
 std::optional<frame_index_t> player_resource::pull_seek_frame_on_render() {
-    if (auto lock = std::unique_lock<std::mutex>(this->_seek_mutex, std::try_to_lock); lock.owns_lock()) {
-        if (this->_seek_frame.has_value()) {
-            auto frame = this->_seek_frame;
-            this->_seek_frame = std::nullopt;
-            this->_seek_state = seek_state::pulled;
-            return frame;
-        }
+    auto state = seek_state::requested;
+    if (this->_seek_state.compare_exchange_strong(state, seek_state::pulled)) {
+        // 読む前にmainで上書きされた場合は、次のrenderでも同じフレームを受け取る
+        return this->_seek_frame.load();
     }
     return std::nullopt;
 }
@@ -55,11 +68,9 @@ bool player_resource::is_seeking_on_main() const {
 }
 
 void player_resource::set_current_frame_on_render(frame_index_t const frame) {
-    if (auto lock = std::unique_lock<std::mutex>(this->_seek_mutex, std::try_to_lock); lock.owns_lock()) {
-        if (this->_seek_state == seek_state::pulled) {
-            this->_seek_state = seek_state::waiting;
-        }
-    }
+    // pullした後にmainでシークされていればrequestedのまま残す
+    auto state = seek_state::pulled;
+    this->_seek_state.compare_exchange_strong(state, seek_state::waiting);
     this->_current_frame.store(frame);
 }
 
@@ -68,31 +79,60 @@ frame_index_t player_resource::current_frame() const {
 }
 
 void player_resource::add_overwrite_request_on_main(element_address &&request) {
-    std::lock_guard<std::mutex> lock(this->_overwrite_mutex);
-    if (this->_is_overwritten) {
-        this->_overwrite_requests.clear();
-        this->_is_overwritten = false;
+    if (!this->_overwrite_queue.push(request)) {
+        this->_is_overwrite_overflowed.store(true);
     }
-    this->_overwrite_requests.emplace_back(std::move(request));
 }
 
 void player_resource::perform_overwrite_requests_on_render(overwrite_requests_f const &handler) {
-    if (auto lock = std::unique_lock<std::mutex>(this->_overwrite_mutex, std::try_to_lock); lock.owns_lock()) {
-        if (!this->_is_overwritten) {
-            handler(this->_overwrite_requests);
-            this->_is_overwritten = true;
-        }
+    this->_pull_overwrite_requests_on_render();
+
+    if (!this->_is_overwritten || !this->_overwrite_requests.empty()) {
+        handler(this->_overwrite_requests);
+        this->_overwrite_requests.clear();
+        this->_is_overwritten = true;
     }
 }
 
 void player_resource::reset_overwrite_requests_on_render() {
-    if (auto lock = std::unique_lock<std::mutex>(this->_overwrite_mutex, std::try_to_lock); lock.owns_lock()) {
-        this->_is_overwritten = true;
+    this->_pull_overwrite_requests_on_render();
+
+    this->_overwrite_requests.clear();
+    this->_is_overwritten = true;
+}
+
+void player_resource::_pull_overwrite_requests_on_render() {
+    using namespace player_resource_utils;
+
+    auto &requests = this->_overwrite_requests;
+    element_address request{};
+
+    while (this->_overwrite_queue.pop(request)) {
+        // 既にあるリクエストに含まれていれば追加しない
+        if (std::any_of(requests.begin(), requests.end(),
+                        [&request](element_address const &pending) { return contains(pending, request); })) {
+            continue;
+        }
+
+        if (requests.size() < requests.capacity()) {
+            requests.emplace_back(request);
+        } else {
+            this->_is_overwrite_overflowed.store(true);
+        }
+    }
+
+    if (this->_is_overwrite_overflowed.exchange(false)) {
+        requests.clear();
+        requests.emplace_back(all_elements);
     }
 }
 
 player_resource_ptr player_resource::make_shared(
-    std::shared_ptr<reading_resource_for_player_resource> const &reading,
     std::shared_ptr<buffering_resource_for_player_resource> const &buffering) {
-    return player_resource_ptr{new player_resource{reading, buffering}};
+    return make_shared(buffering, default_overwrite_capacity);
+}
+
+player_resource_ptr player_resource::make_shared(
+    std::shared_ptr<buffering_resource_for_player_resource> const &buffering, std::size_t const overwrite_capacity) {
+    return player_resource_ptr{new player_resource{buffering, overwrite_capacity}};
 }
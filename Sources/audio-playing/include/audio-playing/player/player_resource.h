@@ -6,13 +6,11 @@
 
 #include <audio-playing/common/ptr.h>
 #include <audio-playing/player/player_dependency.h>
+#include <audio-playing/common/spsc_queue.h>
 #include <audio-playing/player/player_resource_dependency.h>
 
-#include <mutex>
-
 namespace yas::playing {
 struct player_resource final : player_resource_for_player {
-    std::shared_ptr<reading_resource_for_player_resource> const &reading() const override;
     std::shared_ptr<buffering_resource_for_player_resource> const &buffering() const override;
 
     void set_playing_on_main(bool const) override;
@@ -29,18 +27,20 @@ struct player_resource final : player_resource_for_player {
     void perform_overwrite_requests_on_render(overwrite_requests_f const &) override;
     void reset_overwrite_requests_on_render() override;
 
-    static player_resource_ptr make_shared(std::shared_ptr<reading_resource_for_player_resource> const &,
-                                           std::shared_ptr<buffering_resource_for_player_resource> const &);
+    /// mainからrenderへ上書きのリクエストを渡すキューの長さ
+    static std::size_t constexpr default_overwrite_capacity = 256;
+
+    static player_resource_ptr make_shared(std::shared_ptr<buffering_resource_for_player_resource> const &);
+    static player_resource_ptr make_shared(std::shared_ptr<buffering_resource_for_player_resource> const &,
+                                           std::size_t const overwrite_capacity);
 
    private:
-    std::shared_ptr<reading_resource_for_player_resource> const _reading;
     std::shared_ptr<buffering_resource_for_player_resource> const _buffering;
 
     std::atomic<bool> _is_playing{false};
     std::atomic<frame_index_t> _current_frame{0};
 
-    std::mutex _seek_mutex;
-    std::optional<frame_index_t> _seek_frame = std::nullopt;
+    std::atomic<frame_index_t> _seek_frame{0};
 
     enum class seek_state {
         waiting,
@@ -50,11 +50,15 @@ struct player_resource final : player_resource_for_player {
 
     std::atomic<seek_state> _seek_state = seek_state::waiting;
 
-    std::mutex _overwrite_mutex;
+    spsc_queue<element_address> _overwrite_queue;
+    // キューに入りきらなかった場合は全体を上書きする
+    std::atomic<bool> _is_overwrite_overflowed{false};
+    // 以下はrender側だけで触る
     overwrite_requests_t _overwrite_requests;
     bool _is_overwritten = false;
 
-    player_resource(std::shared_ptr<reading_resource_for_player_resource> const &,
-                    std::shared_ptr<buffering_resource_for_player_resource> const &);
+    player_resource(std::shared_ptr<buffering_resource_for_player_resource> const &, std::size_t const);
+
+    void _pull_overwrite_requests_on_render();
 };
 }  // namespace yas::playing
@@ -8,24 +8,8 @@
 #include <audio-engine/pcm_buffer/pcm_buffer.h>
 #include <audio-playing/common/channel_mapping.h>
 #include <audio-playing/player/buffering_resource_types.h>
-#include <audio-playing/player/reading_resource_types.h>
 
 namespace yas::playing {
-struct reading_resource_for_player_resource {
-    using state_t = reading_resource_state;
-
-    virtual ~reading_resource_for_player_resource() = default;
-
-    [[nodiscard]] virtual state_t state() const = 0;
-    [[nodiscard]] virtual audio::pcm_buffer *buffer_on_render() = 0;
-
-    [[nodiscard]] virtual bool needs_create_on_render(sample_rate_t const sample_rate, audio::pcm_format const,
-                                                      uint32_t const length) const = 0;
-    virtual void set_creating_on_render(sample_rate_t const sample_rate, audio::pcm_format const,
-                                        uint32_t const length) = 0;
-    virtual void create_buffer_on_task() = 0;
-};
-
 struct buffering_resource_for_player_resource {
     using setup_state_t = audio_buffering_setup_state;
     using rendering_state_t = audio_buffering_rendering_state;
@@ -54,8 +38,15 @@ struct buffering_resource_for_player_resource {
     virtual bool needs_all_writing_on_render() const = 0;
     virtual void set_channel_mapping_request_on_main(channel_mapping const &) = 0;
     virtual void set_identifier_request_on_main(std::string const &) = 0;
+    /// ループの位置などで、シークされる前から先読みしておくフレーム
+    virtual void set_warming_frames_request_on_main(std::vector<frame_index_t> const &) = 0;
+    [[nodiscard]] virtual buffering_statistics statistics() const = 0;
 
     [[nodiscard]] virtual bool read_into_buffer_on_render(audio::pcm_buffer *, channel_index_t const,
                                                           frame_index_t const) = 0;
+    /// ch_idxのチャンネルのframeからlength分を、出力のバッファの同じチャンネルのout_begin_frameの位置へ直接コピーする
+    [[nodiscard]] virtual bool read_into_channel_on_render(audio::pcm_buffer *, channel_index_t const ch_idx,
+                                                           uint32_t const out_begin_frame, frame_index_t const frame,
+                                                           uint32_t const length) = 0;
 };
 }  // namespace yas::playing
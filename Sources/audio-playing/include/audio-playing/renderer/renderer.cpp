@@ -24,7 +24,7 @@ renderer::renderer(audio::io_device_ptr const &device)
       _format(observing::value::holder<renderer_format>::make_shared(
           {.sample_rate = 0, .pcm_format = audio::pcm_format::float32, .channel_count = 0})),
       _io(this->graph->add_io(this->_device)),
-      _converter(audio::graph_avf_au::make_shared(kAudioUnitType_FormatConverter, kAudioUnitSubType_AUConverter)),
+      _converter(audio::graph_resampler::make_shared(audio::resampler_quality::high)),
       _tap(audio::graph_tap::make_shared()) {
     this->_update_format();
 
@@ -151,9 +151,6 @@ void renderer::_update_connection() {
             audio::format const output_format{{.sample_rate = static_cast<double>(output_sample_rate),
                                                .channel_count = static_cast<uint32_t>(ch_count),
                                                .pcm_format = pcm_format}};
-            this->_converter->raw_au->set_input_format(input_format, 0);
-            this->_converter->raw_au->set_output_format(output_format, 0);
-
             this->_converter_connection = this->graph->connect(this->_tap->node, this->_converter->node, input_format);
             this->_connection = this->graph->connect(this->_converter->node, this->_io->output_node, output_format);
         } else {
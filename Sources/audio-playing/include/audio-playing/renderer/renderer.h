@@ -5,7 +5,7 @@
 #pragma once
 
 #include <audio-engine/graph/graph.h>
-#include <audio-engine/graph/graph_avf_au.h>
+#include <audio-engine/graph/graph_resampler.h>
 #include <audio-engine/graph/graph_tap.h>
 #include <audio-playing/common/ptr.h>
 #include <audio-playing/coordinator/coordinator_dependency.h>
@@ -42,7 +42,7 @@ struct renderer final : renderer_for_coordinator, renderer_for_player {
     observing::value::holder_ptr<renderer_format> const _format;
 
     audio::graph_io_ptr const _io;
-    audio::graph_avf_au_ptr const _converter;
+    audio::graph_resampler_ptr const _converter;
     audio::graph_tap_ptr const _tap;
     std::optional<audio::graph_connection_ptr> _connection{std::nullopt};
     std::optional<audio::graph_connection_ptr> _converter_connection{std::nullopt};
@@ -104,6 +104,8 @@ std::string yas::to_string(signal_file::read_error const &error) {
             return "read_count_not_match";
         case signal_file::read_error::close_stream_failed:
             return "close_stream_failed";
+        case signal_file::read_error::map_file_failed:
+            return "map_file_failed";
     }
 }
 
@@ -28,6 +28,7 @@ enum class read_error {
     read_from_stream_failed,
     read_count_not_match,
     close_stream_failed,
+    map_file_failed,
 };
 
 using write_result_t = result<std::nullptr_t, write_error>;
@@ -0,0 +1,169 @@
+//
+//  signal_file_cache.cpp
+//
+
+#include "signal_file_cache.h"
+
+#include <audio-engine/format/format.h>
+#include <audio-playing/timeline/timeline_utils.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace yas;
+using namespace yas::playing;
+
+namespace yas::playing::signal_file_cache_utils {
+// マップしている間はinodeが再利用されないので、別のファイルに置き換わっていればinodeで分かる
+static bool is_same_file(signal_file_cache::mapping const &mapping, struct stat const &st) {
+    return mapping.device == static_cast<uint64_t>(st.st_dev) && mapping.inode == static_cast<uint64_t>(st.st_ino) &&
+           mapping.byte_size == static_cast<std::size_t>(st.st_size);
+}
+}  // namespace yas::playing::signal_file_cache_utils
+
+#pragma mark - mapping
+
+signal_file_cache::mapping::mapping(std::string const &path, uint64_t const device, uint64_t const inode,
+                                    std::size_t const byte_size, void const *const data)
+    : path(path), device(device), inode(inode), byte_size(byte_size), data(data) {
+}
+
+signal_file_cache::mapping::~mapping() {
+    ::munmap(const_cast<void *>(this->data), this->byte_size);
+}
+
+#pragma mark - signal_file_cache
+
+signal_file_cache::signal_file_cache(std::size_t const capacity) : _capacity(capacity) {
+}
+
+signal_file_cache::~signal_file_cache() = default;
+
+signal_file::read_result_t signal_file_cache::read(signal_file_info const &info, audio::pcm_buffer &buffer,
+                                                   frame_index_t const buf_top_frame) {
+    using read_error = signal_file::read_error;
+    using read_result_t = signal_file::read_result_t;
+
+    if (info.sample_type != yas::to_sample_type(buffer.format().pcm_format())) {
+        return read_result_t{read_error::invalid_sample_type};
+    }
+
+    frame_index_t const buf_next_frame = buf_top_frame + buffer.frame_length();
+
+    if (info.range.frame < buf_top_frame || buf_next_frame < info.range.next_frame()) {
+        return read_result_t{read_error::out_of_range};
+    }
+
+    std::size_t const sample_byte_count = buffer.format().sample_byte_count();
+    std::size_t const offset = (info.range.frame - buf_top_frame) * sample_byte_count;
+    std::size_t const length = info.range.length * sample_byte_count;
+
+    if (length == 0) {
+        return read_result_t{nullptr};
+    }
+
+    auto const map_result = this->map(info.path);
+    if (!map_result) {
+        return read_result_t{map_result.error()};
+    }
+
+    auto const &mapping = map_result.value();
+    if (mapping->byte_size != length) {
+        return read_result_t{read_error::read_count_not_match};
+    }
+
+    char *const data_ptr = timeline_utils::char_data(buffer);
+    std::memcpy(&data_ptr[offset], mapping->data, length);
+
+    return read_result_t{nullptr};
+}
+
+signal_file_cache::map_result_t signal_file_cache::map(std::string const &path) {
+    using read_error = signal_file::read_error;
+
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        return map_result_t{read_error::open_stream_failed};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        auto each = this->_mappings.begin();
+        while (each != this->_mappings.end()) {
+            if ((*each)->path == path) {
+                if (signal_file_cache_utils::is_same_file(**each, st)) {
+                    this->_mappings.splice(this->_mappings.begin(), this->_mappings, each);
+                    return map_result_t{this->_mappings.front()};
+                } else {
+                    this->_mappings.erase(each);
+                    break;
+                }
+            }
+            ++each;
+        }
+    }
+
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return map_result_t{read_error::open_stream_failed};
+    }
+
+    struct stat fd_st;
+    if (::fstat(fd, &fd_st) != 0 || fd_st.st_size == 0) {
+        ::close(fd);
+        return map_result_t{read_error::read_count_not_match};
+    }
+
+    std::size_t const byte_size = static_cast<std::size_t>(fd_st.st_size);
+    void *const data = ::mmap(nullptr, byte_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // マップした後はファイルディスクリプタが無くても読める
+    if (::close(fd) != 0) {
+        if (data != MAP_FAILED) {
+            ::munmap(data, byte_size);
+        }
+        return map_result_t{read_error::close_stream_failed};
+    }
+
+    if (data == MAP_FAILED) {
+        return map_result_t{read_error::map_file_failed};
+    }
+
+    auto mapping = std::make_shared<signal_file_cache::mapping const>(path, static_cast<uint64_t>(fd_st.st_dev),
+                                                                      static_cast<uint64_t>(fd_st.st_ino),
+                                                                      byte_size, data);
+
+    if (this->_capacity > 0) {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        this->_mappings.emplace_front(mapping);
+
+        while (this->_mappings.size() > this->_capacity) {
+            this->_mappings.pop_back();
+        }
+    }
+
+    return map_result_t{std::move(mapping)};
+}
+
+void signal_file_cache::clear() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_mappings.clear();
+}
+
+std::size_t signal_file_cache::capacity() const {
+    return this->_capacity;
+}
+
+std::size_t signal_file_cache::mapped_count() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_mappings.size();
+}
+
+signal_file_cache_ptr signal_file_cache::make_shared(std::size_t const capacity) {
+    return signal_file_cache_ptr{new signal_file_cache{capacity}};
+}
@@ -0,0 +1,65 @@
+//
+//  signal_file_cache.h
+//
+
+#pragma once
+
+#include <audio-playing/common/ptr.h>
+#include <audio-playing/signal_file/signal_file.h>
+
+#include <list>
+#include <mutex>
+
+namespace yas::playing {
+/// 信号ファイルをmmapしたまま保持し、読み込みをマップからのコピーだけで済ませる
+struct signal_file_cache final {
+    struct mapping final {
+        std::string const path;
+        uint64_t const device;
+        uint64_t const inode;
+        std::size_t const byte_size;
+        void const *const data;
+
+        mapping(std::string const &path, uint64_t const device, uint64_t const inode, std::size_t const byte_size,
+                void const *const data);
+        ~mapping();
+
+       private:
+        mapping(mapping const &) = delete;
+        mapping(mapping &&) = delete;
+        mapping &operator=(mapping const &) = delete;
+        mapping &operator=(mapping &&) = delete;
+    };
+
+    using mapping_ptr = std::shared_ptr<mapping const>;
+    using map_result_t = result<mapping_ptr, signal_file::read_error>;
+
+    ~signal_file_cache();
+
+    /// キャッシュにあればファイルを開かずにコピーする。ファイルが書き換えられていたらマップし直す
+    [[nodiscard]] signal_file::read_result_t read(signal_file_info const &, audio::pcm_buffer &,
+                                                  frame_index_t const buf_top_frame);
+    /// ファイル全体のマップを返す。キャッシュから追い出されても返したマップは使える
+    [[nodiscard]] map_result_t map(std::string const &path);
+
+    void clear();
+
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] std::size_t mapped_count() const;
+
+    [[nodiscard]] static signal_file_cache_ptr make_shared(std::size_t const capacity);
+
+   private:
+    std::size_t const _capacity;
+    mutable std::mutex _mutex;
+    // 最近使ったものが先頭
+    std::list<mapping_ptr> _mappings;
+
+    explicit signal_file_cache(std::size_t const capacity);
+
+    signal_file_cache(signal_file_cache const &) = delete;
+    signal_file_cache(signal_file_cache &&) = delete;
+    signal_file_cache &operator=(signal_file_cache const &) = delete;
+    signal_file_cache &operator=(signal_file_cache &&) = delete;
+};
+}  // namespace yas::playing
@@ -20,6 +20,15 @@ bool timeline_canceller::is_cancel(proc::time::range const &range) const {
     }
 }
 
+bool timeline_canceller::is_coalesce(proc::time::range const &range) const {
+    if (this->range.has_value()) {
+        auto const &self_range = this->range.value();
+        return self_range.frame <= range.next_frame() && range.frame <= self_range.next_frame();
+    } else {
+        return false;
+    }
+}
+
 timeline_cancel_matcher_ptr timeline_canceller::make_shared(std::optional<proc::time::range> const &range) {
     return timeline_cancel_matcher_ptr(new timeline_canceller{range});
 }
@@ -14,6 +14,8 @@ struct timeline_canceller final {
 
     // requestの範囲に完全に含まれていたらキャンセルさせる
     bool is_cancel(proc::time::range const &range) const;
+    // requestの範囲と重なるか隣接していたらまとめられる
+    bool is_coalesce(proc::time::range const &range) const;
 
     static timeline_cancel_matcher_ptr make_shared(std::optional<proc::time::range> const &);
 
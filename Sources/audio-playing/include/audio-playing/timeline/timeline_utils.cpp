@@ -6,6 +6,7 @@
 
 #include <audio-engine/format/format.h>
 #include <audio-playing/common/math.h>
+#include <audio-processing/event/event.h>
 #include <cpp-utils/boolean.h>
 
 #include <fstream>
@@ -158,3 +159,58 @@ std::type_info const &timeline_utils::to_sample_type(sample_store_type const &st
             return typeid(std::nullptr_t);
     }
 }
+
+namespace yas::playing::timeline_utils {
+// FNV-1a
+static uint64_t constexpr hash_offset_basis = 14695981039346656037ull;
+static uint64_t constexpr hash_prime = 1099511628211ull;
+
+static void hash_bytes(uint64_t &hash, char const *data, std::size_t const size) {
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        hash ^= static_cast<uint8_t>(data[idx]);
+        hash *= hash_prime;
+    }
+}
+
+template <typename T>
+static void hash_value(uint64_t &hash, T const &value) {
+    hash_bytes(hash, reinterpret_cast<char const *>(&value), sizeof(T));
+}
+}  // namespace yas::playing::timeline_utils
+
+uint64_t timeline_utils::content_hash(proc::channel const &channel) {
+    uint64_t hash = hash_offset_basis;
+
+    for (auto const &event_pair : channel.events()) {
+        proc::time const &time = event_pair.first;
+        proc::event const &event = event_pair.second;
+
+        if (time.is_range_type()) {
+            auto const &range = time.get<proc::time::range>();
+            hash_value(hash, range.frame);
+            hash_value(hash, range.length);
+        } else if (time.is_frame_type()) {
+            hash_value(hash, time.get<proc::time::frame>());
+        }
+
+        hash_value(hash, event.type());
+        hash_value(hash, to_sample_store_type(event.sample_type()));
+
+        switch (event.type()) {
+            case proc::event_type::signal: {
+                auto const &signal = *event.get<proc::signal_event>();
+                if (char const *data = char_data(signal)) {
+                    hash_bytes(hash, data, signal.byte_size());
+                }
+            } break;
+            case proc::event_type::number: {
+                auto const &number = *event.get<proc::number_event>();
+                if (char const *data = char_data(number)) {
+                    hash_bytes(hash, data, number.sample_byte_count());
+                }
+            } break;
+        }
+    }
+
+    return hash;
+}
@@ -7,6 +7,7 @@
 #include <audio-engine/common/types.h>
 #include <audio-engine/pcm_buffer/pcm_buffer.h>
 #include <audio-playing/common/types.h>
+#include <audio-processing/channel/channel.h>
 #include <audio-processing/event/number_event.h>
 #include <audio-processing/event/signal_event.h>
 #include <audio-processing/time/time.h>
@@ -23,4 +24,7 @@ namespace yas::playing::timeline_utils {
 
 [[nodiscard]] sample_store_type to_sample_store_type(std::type_info const &);
 [[nodiscard]] std::type_info const &to_sample_type(sample_store_type const &);
+
+/// 書き出す内容が変わったかを比べるためのハッシュ。イベントの時間・型・データから求める
+[[nodiscard]] uint64_t content_hash(proc::channel const &);
 }  // namespace yas::playing::timeline_utils
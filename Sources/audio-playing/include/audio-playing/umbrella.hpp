@@ -7,10 +7,12 @@
 #include <audio-playing/common/channel_mapping.h>
 #include <audio-playing/common/math.h>
 #include <audio-playing/common/path.h>
+#include <audio-playing/common/spsc_queue.h>
 #include <audio-playing/common/types.h>
 #include <audio-playing/coordinator/coordinator.h>
 #include <audio-playing/exporter/exporter.h>
 #include <audio-playing/numbers_file/numbers_file.h>
+#include <audio-playing/packed_fragment_file/packed_fragment_file.h>
 #include <audio-playing/player/buffering_channel.h>
 #include <audio-playing/player/buffering_element.h>
 #include <audio-playing/player/buffering_resource.h>
@@ -19,6 +21,7 @@
 #include <audio-playing/player/reading_resource.h>
 #include <audio-playing/renderer/renderer.h>
 #include <audio-playing/signal_file/signal_file.h>
+#include <audio-playing/signal_file/signal_file_cache.h>
 #include <audio-playing/timeline/timeline_canceller.h>
 #include <audio-playing/timeline/timeline_container.h>
 #include <audio-playing/timeline/timeline_utils.h>
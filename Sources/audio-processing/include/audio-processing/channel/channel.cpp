@@ -6,6 +6,8 @@
 
 #include <audio-processing/event/signal_event.h>
 
+#include <limits>
+
 using namespace yas;
 using namespace yas::proc;
 
@@ -108,36 +110,33 @@ proc::channel::events_map_t proc::channel::copied_events(time::range const &copy
 }
 
 void proc::channel::erase_events(time::range const &erase_range) {
+    auto const [any_begin, any_end] = this->_events_bounds(typeid(time::any), std::nullopt);
+    this->_events.erase(any_begin, any_end);
+
+    auto const [frame_begin, frame_end] = this->_events_bounds(typeid(time::frame), erase_range);
+    this->_events.erase(frame_begin, frame_end);
+
     signal_event::pair_vector_t remained_signal;
 
-    std::erase_if(this->events(), [erase_range, &remained_signal](std::pair<time, event> const &event_pair) {
-        time const &event_time = event_pair.first;
-        if (event_time.is_any_type()) {
-            return true;
-        } else if (event_time.is_frame_type()) {
-            if (erase_range.is_contain(event_time.get<time::frame>())) {
-                return true;
+    auto [it, range_end] = this->_events_bounds(typeid(time::range), erase_range);
+
+    while (it != range_end) {
+        auto const &event_range = it->first.get<time::range>();
+        if (auto overlapped_range = erase_range.intersected(event_range)) {
+            auto const &signal = it->second.get<signal_event>();
+            auto const range = time::range{overlapped_range->frame - event_range.frame, overlapped_range->length};
+            signal_event::pair_vector_t cropped_signals = signal->cropped(range);
+            for (auto const &cropped_signal : cropped_signals) {
+                auto const &cropped_range = cropped_signal.first;
+                remained_signal.emplace_back(
+                    std::make_pair(cropped_range.offset(event_range.frame), cropped_signal.second));
             }
-        } else if (event_time.is_range_type()) {
-            auto const &event_range = event_time.get<time::range>();
-            if (auto overlapped_range = erase_range.intersected(event_range)) {
-                auto const &signal = event_pair.second.get<signal_event>();
-                auto const range = time::range{overlapped_range->frame - event_range.frame, overlapped_range->length};
-                signal_event::pair_vector_t cropped_signals = signal->cropped(range);
-                for (auto const &cropped_signal : cropped_signals) {
-                    auto const &cropped_range = cropped_signal.first;
-                    remained_signal.emplace_back(
-                        std::make_pair(cropped_range.offset(event_range.frame), cropped_signal.second));
-                }
 
-                return true;
-            }
+            it = this->_events.erase(it);
         } else {
-            throw "unreachable code.";
+            ++it;
         }
-
-        return false;
-    });
+    }
 
     if (remained_signal.size() > 0) {
         for (auto const &signal_pair : remained_signal) {
@@ -145,3 +144,45 @@ void proc::channel::erase_events(time::range const &erase_range) {
         }
     }
 }
+
+#pragma mark - private
+
+namespace yas::proc::channel_utils {
+// timeの並び順はany、frame、rangeの順なので、それぞれの先頭を探すための値
+static time const &min_frame_time() {
+    static time const value = make_frame_time(std::numeric_limits<frame_index_t>::min());
+    return value;
+}
+
+static time const &min_range_time() {
+    static time const value = make_range_time(std::numeric_limits<frame_index_t>::min(), 1);
+    return value;
+}
+}  // namespace yas::proc::channel_utils
+
+proc::channel::events_bounds_t proc::channel::_events_bounds(std::type_info const &time_type,
+                                                             std::optional<time::range> const &range) const {
+    auto const &events = this->_events;
+
+    if (time_type == typeid(time::any)) {
+        return std::make_pair(events.begin(), events.lower_bound(channel_utils::min_frame_time()));
+    } else if (time_type == typeid(time::frame)) {
+        if (range.has_value()) {
+            return std::make_pair(events.lower_bound(make_frame_time(range->frame)),
+                                  events.lower_bound(make_frame_time(range->next_frame())));
+        } else {
+            return std::make_pair(events.lower_bound(channel_utils::min_frame_time()),
+                                  events.lower_bound(channel_utils::min_range_time()));
+        }
+    } else if (time_type == typeid(time::range)) {
+        auto const begin = events.lower_bound(channel_utils::min_range_time());
+        if (range.has_value()) {
+            // 隣接するrangeも含める
+            return std::make_pair(begin, events.lower_bound(make_range_time(range->next_frame() + 1, 1)));
+        } else {
+            return std::make_pair(begin, events.end());
+        }
+    } else {
+        throw "unreachable code.";
+    }
+}
@@ -4,16 +4,20 @@
 
 #pragma once
 
+#include <audio-processing/channel/channel_event_view.h>
 #include <audio-processing/common/ptr.h>
 #include <audio-processing/time/time.h>
 
 #include <map>
+#include <optional>
 
 namespace yas::proc {
 class event;
 class signal_event;
 
 struct channel {
+    /// eventは時間の順にmultimapで持ち、timeの型ごとにまとまって並ぶ
+    /// 処理の中で型を絞り込んで読むときは、新たなコンテナを作らないfiltered_viewを使う
     using events_map_t = std::multimap<time, event>;
 
     channel();
@@ -38,6 +42,14 @@ struct channel {
         P predicate) const;
     events_map_t copied_events(time::range const &, frame_index_t const offset) const;
 
+    template <typename Event>
+    [[nodiscard]] channel_event_view<Event> filtered_view() const;
+    template <typename SampleType, typename Event>
+    [[nodiscard]] channel_event_view<Event, SampleType> filtered_view() const;
+    /// rangeに重なるか隣接する可能性のあるeventだけを参照する。判定は呼び出し側で行う
+    template <typename SampleType, typename Event>
+    [[nodiscard]] channel_event_view<Event, SampleType> filtered_view(time::range const &) const;
+
     void insert_event(time, event);
     void insert_events(events_map_t);
 
@@ -49,11 +61,18 @@ struct channel {
     void erase_event();
     template <typename SampleType, typename Event, typename P>
     void erase_event(P predicate);
+    template <typename SampleType, typename Event, typename P>
+    void erase_event(time::range const &, P predicate);
     void erase_events(time::range const &);
 
    private:
     events_map_t _events;
 
+    using events_bounds_t = std::pair<events_map_t::const_iterator, events_map_t::const_iterator>;
+
+    [[nodiscard]] events_bounds_t _events_bounds(std::type_info const &time_type,
+                                                 std::optional<time::range> const &) const;
+
     channel(channel const &) = delete;
     channel &operator=(channel const &) = delete;
 };
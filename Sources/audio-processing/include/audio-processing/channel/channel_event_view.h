@@ -0,0 +1,107 @@
+//
+//  channel_event_view.h
+//
+
+#pragma once
+
+#include <audio-processing/event/event.h>
+#include <audio-processing/time/time.h>
+
+#include <iterator>
+#include <map>
+#include <type_traits>
+
+namespace yas::proc {
+/// channelのeventsを型で絞り込んで参照する。新たなコンテナは作らない
+template <typename Event, typename SampleType = void>
+struct channel_event_view final {
+    using base_iterator_t = std::multimap<time, event>::const_iterator;
+    using time_type = typename Event::time_type;
+    using value_type = std::pair<typename time_type::type const &, std::shared_ptr<Event> const &>;
+
+    struct iterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = channel_event_view::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        iterator(base_iterator_t const current, base_iterator_t const end) : _current(current), _end(end) {
+            this->_skip();
+        }
+
+        reference operator*() const {
+            return reference{this->_current->first.template get<time_type>(),
+                             this->_current->second.template get<Event>()};
+        }
+
+        iterator &operator++() {
+            ++this->_current;
+            this->_skip();
+            return *this;
+        }
+
+        bool operator==(iterator const &rhs) const {
+            return this->_current == rhs._current;
+        }
+
+        bool operator!=(iterator const &rhs) const {
+            return this->_current != rhs._current;
+        }
+
+        [[nodiscard]] base_iterator_t base() const {
+            return this->_current;
+        }
+
+       private:
+        base_iterator_t _current;
+        base_iterator_t _end;
+
+        void _skip() {
+            while (this->_current != this->_end && !channel_event_view::is_matched(*this->_current)) {
+                ++this->_current;
+            }
+        }
+    };
+
+    channel_event_view(base_iterator_t const begin, base_iterator_t const end) : _begin(begin), _end(end) {
+    }
+
+    [[nodiscard]] iterator begin() const {
+        return iterator{this->_begin, this->_end};
+    }
+
+    [[nodiscard]] iterator end() const {
+        return iterator{this->_end, this->_end};
+    }
+
+    [[nodiscard]] bool empty() const {
+        return this->begin() == this->end();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return static_cast<std::size_t>(std::distance(this->begin(), this->end()));
+    }
+
+    [[nodiscard]] static bool is_matched(std::pair<time const, event> const &pair) {
+        if (pair.first.type() != typeid(time_type)) {
+            return false;
+        }
+
+        auto const &casted_event = pair.second.template get<Event>();
+        if (!casted_event) {
+            return false;
+        }
+
+        if constexpr (std::is_void_v<SampleType>) {
+            return true;
+        } else {
+            return casted_event->sample_type() == typeid(SampleType);
+        }
+    }
+
+   private:
+    base_iterator_t _begin;
+    base_iterator_t _end;
+};
+}  // namespace yas::proc
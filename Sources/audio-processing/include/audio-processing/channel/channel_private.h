@@ -34,6 +34,41 @@ void proc::channel::erase_event(P predicate) {
     });
 }
 
+template <typename SampleType, typename Event, typename P>
+void proc::channel::erase_event(time::range const &range, P predicate) {
+    using view_t = channel_event_view<Event, SampleType>;
+
+    auto [it, end] = this->_events_bounds(typeid(typename Event::time_type), range);
+
+    while (it != end) {
+        if (view_t::is_matched(*it) &&
+            predicate(typename view_t::value_type{it->first.template get<typename Event::time_type>(),
+                                                  it->second.template get<Event>()})) {
+            it = this->_events.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template <typename Event>
+proc::channel_event_view<Event> proc::channel::filtered_view() const {
+    auto const [begin, end] = this->_events_bounds(typeid(typename Event::time_type), std::nullopt);
+    return channel_event_view<Event>{begin, end};
+}
+
+template <typename SampleType, typename Event>
+proc::channel_event_view<Event, SampleType> proc::channel::filtered_view() const {
+    auto const [begin, end] = this->_events_bounds(typeid(typename Event::time_type), std::nullopt);
+    return channel_event_view<Event, SampleType>{begin, end};
+}
+
+template <typename SampleType, typename Event>
+proc::channel_event_view<Event, SampleType> proc::channel::filtered_view(time::range const &range) const {
+    auto const [begin, end] = this->_events_bounds(typeid(typename Event::time_type), range);
+    return channel_event_view<Event, SampleType>{begin, end};
+}
+
 template <typename Event>
 std::multimap<typename Event::time_type::type, std::shared_ptr<Event>> proc::channel::filtered_events() const {
     return filtered_events<Event>([](auto const &) { return true; });
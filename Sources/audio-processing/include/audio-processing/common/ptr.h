@@ -14,6 +14,7 @@ class module_set;
 class event;
 class number_event;
 class signal_event;
+class signal_event_pool;
 
 using track_ptr = std::shared_ptr<track>;
 using timeline_ptr = std::shared_ptr<timeline>;
@@ -21,4 +22,5 @@ using module_ptr = std::shared_ptr<module>;
 using module_set_ptr = std::shared_ptr<module_set>;
 using number_event_ptr = std::shared_ptr<number_event>;
 using signal_event_ptr = std::shared_ptr<signal_event>;
+using signal_event_pool_ptr = std::shared_ptr<signal_event_pool>;
 }  // namespace yas::proc
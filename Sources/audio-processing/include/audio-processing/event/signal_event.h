@@ -57,6 +57,8 @@ struct signal_event final {
     explicit signal_event(std::vector<T> &&bytes);
     template <typename T>
     explicit signal_event(std::vector<T> &bytes);
+    template <typename T>
+    signal_event(std::vector<T> &&bytes, signal_event_pool_ptr const &);
 
     signal_event(signal_event const &) = delete;
     signal_event(signal_event &&) = delete;
@@ -72,6 +74,11 @@ struct signal_event final {
     static proc::signal_event_ptr make_shared(std::vector<T> &&);
     template <typename T>
     static proc::signal_event_ptr make_shared(std::vector<T> &);
+    // poolから取り出したvectorを使う。イベントが破棄されたらvectorはpoolに戻る
+    template <typename T>
+    static proc::signal_event_ptr make_shared(std::size_t const size, signal_event_pool_ptr const &);
+    template <typename T>
+    static proc::signal_event_ptr make_shared(std::vector<T> &&, signal_event_pool_ptr const &);
 };
 }  // namespace yas::proc
 
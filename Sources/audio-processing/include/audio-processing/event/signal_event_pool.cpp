@@ -0,0 +1,121 @@
+//
+//  signal_event_pool.cpp
+//
+
+#include "signal_event_pool.h"
+
+#include <algorithm>
+
+using namespace yas;
+using namespace yas::proc;
+
+proc::signal_event_pool::signal_event_pool(std::size_t const max_vector_count) : _max_vector_count(max_vector_count) {
+}
+
+template <typename T>
+std::vector<T> proc::signal_event_pool::take(std::size_t const size) {
+    std::vector<T> result;
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        auto &vectors = std::get<vectors_t<T>>(this->_vectors);
+        auto const it = std::find_if(vectors.rbegin(), vectors.rend(),
+                                     [&size](std::vector<T> const &vector) { return vector.capacity() >= size; });
+
+        if (it != vectors.rend()) {
+            result = std::move(*it);
+            vectors.erase(std::next(it).base());
+            ++this->_reuse_count;
+        } else {
+            ++this->_allocation_count;
+        }
+    }
+
+    result.resize(size);
+
+    return result;
+}
+
+template std::vector<double> proc::signal_event_pool::take(std::size_t const);
+template std::vector<float> proc::signal_event_pool::take(std::size_t const);
+template std::vector<int64_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<int32_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<int16_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<int8_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<uint64_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<uint32_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<uint16_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<uint8_t> proc::signal_event_pool::take(std::size_t const);
+template std::vector<boolean> proc::signal_event_pool::take(std::size_t const);
+
+template <typename T>
+void proc::signal_event_pool::put(std::vector<T> &&vector) {
+    if (vector.capacity() == 0) {
+        return;
+    }
+
+    vector.clear();
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto &vectors = std::get<vectors_t<T>>(this->_vectors);
+
+    if (vectors.size() >= this->_max_vector_count) {
+        return;
+    }
+
+    if (vectors.capacity() < this->_max_vector_count) {
+        vectors.reserve(this->_max_vector_count);
+    }
+
+    vectors.emplace_back(std::move(vector));
+}
+
+template void proc::signal_event_pool::put(std::vector<double> &&);
+template void proc::signal_event_pool::put(std::vector<float> &&);
+template void proc::signal_event_pool::put(std::vector<int64_t> &&);
+template void proc::signal_event_pool::put(std::vector<int32_t> &&);
+template void proc::signal_event_pool::put(std::vector<int16_t> &&);
+template void proc::signal_event_pool::put(std::vector<int8_t> &&);
+template void proc::signal_event_pool::put(std::vector<uint64_t> &&);
+template void proc::signal_event_pool::put(std::vector<uint32_t> &&);
+template void proc::signal_event_pool::put(std::vector<uint16_t> &&);
+template void proc::signal_event_pool::put(std::vector<uint8_t> &&);
+template void proc::signal_event_pool::put(std::vector<boolean> &&);
+
+void proc::signal_event_pool::clear() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::apply([](auto &...vectors) { (vectors.clear(), ...); }, this->_vectors);
+    this->_allocation_count = 0;
+    this->_reuse_count = 0;
+}
+
+std::size_t proc::signal_event_pool::max_vector_count() const {
+    return this->_max_vector_count;
+}
+
+std::size_t proc::signal_event_pool::vector_count() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return std::apply([](auto const &...vectors) { return (vectors.size() + ...); }, this->_vectors);
+}
+
+std::size_t proc::signal_event_pool::allocation_count() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_allocation_count;
+}
+
+std::size_t proc::signal_event_pool::reuse_count() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_reuse_count;
+}
+
+proc::signal_event_pool_ptr proc::signal_event_pool::make_shared() {
+    return make_shared(default_max_vector_count);
+}
+
+proc::signal_event_pool_ptr proc::signal_event_pool::make_shared(std::size_t const max_vector_count) {
+    return signal_event_pool_ptr(new signal_event_pool{max_vector_count});
+}
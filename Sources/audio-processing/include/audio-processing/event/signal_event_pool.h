@@ -0,0 +1,66 @@
+//
+//  signal_event_pool.h
+//
+
+#pragma once
+
+#include <audio-processing/common/ptr.h>
+#include <cpp-utils/boolean.h>
+
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace yas::proc {
+struct signal_event_pool final {
+    static std::size_t constexpr default_max_vector_count = 256;
+
+    // take/putで扱えるサンプルの型。それ以外の型のsignal_eventはプールを使わない
+    template <typename T>
+    static bool constexpr is_poolable =
+        std::is_same_v<T, double> || std::is_same_v<T, float> || std::is_same_v<T, int64_t> ||
+        std::is_same_v<T, int32_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int8_t> ||
+        std::is_same_v<T, uint64_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, uint16_t> ||
+        std::is_same_v<T, uint8_t> || std::is_same_v<T, boolean>;
+
+    // size分の0で埋めたvectorを返す。プールに十分な容量のものがあれば再利用する
+    template <typename T>
+    [[nodiscard]] std::vector<T> take(std::size_t const size);
+    // 使い終わったvectorを戻す。max_vector_countを超えた分は解放する
+    template <typename T>
+    void put(std::vector<T> &&);
+
+    void clear();
+
+    [[nodiscard]] std::size_t max_vector_count() const;
+    [[nodiscard]] std::size_t vector_count() const;
+    // takeでメモリの確保が必要だった回数
+    [[nodiscard]] std::size_t allocation_count() const;
+    // takeで確保済みのメモリを再利用した回数
+    [[nodiscard]] std::size_t reuse_count() const;
+
+    [[nodiscard]] static signal_event_pool_ptr make_shared();
+    [[nodiscard]] static signal_event_pool_ptr make_shared(std::size_t const max_vector_count);
+
+   private:
+    template <typename T>
+    using vectors_t = std::vector<std::vector<T>>;
+
+    std::size_t const _max_vector_count;
+    std::tuple<vectors_t<double>, vectors_t<float>, vectors_t<int64_t>, vectors_t<int32_t>, vectors_t<int16_t>,
+               vectors_t<int8_t>, vectors_t<uint64_t>, vectors_t<uint32_t>, vectors_t<uint16_t>, vectors_t<uint8_t>,
+               vectors_t<boolean>>
+        _vectors;
+    std::size_t _allocation_count = 0;
+    std::size_t _reuse_count = 0;
+    mutable std::mutex _mutex;
+
+    explicit signal_event_pool(std::size_t const max_vector_count);
+
+    signal_event_pool(signal_event_pool const &) = delete;
+    signal_event_pool(signal_event_pool &&) = delete;
+    signal_event_pool &operator=(signal_event_pool const &) = delete;
+    signal_event_pool &operator=(signal_event_pool &&) = delete;
+};
+}  // namespace yas::proc
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <audio-processing/event/signal_event_pool.h>
 #include <audio-processing/time/time.h>
 
 namespace yas {
@@ -29,6 +30,18 @@ struct proc::signal_event::type_impl : impl {
     type_impl(std::vector<T> &bytes) : _vector_ref(bytes) {
     }
 
+    type_impl(std::vector<T> &&bytes, signal_event_pool_ptr const &pool)
+        : _vector(std::move(bytes)), _vector_ref(_vector), _pool(pool) {
+    }
+
+    ~type_impl() {
+        if constexpr (signal_event_pool::is_poolable<T>) {
+            if (auto const pool = this->_pool.lock()) {
+                pool->put(std::move(this->_vector));
+            }
+        }
+    }
+
     signal_event_ptr copy() override {
         return signal_event::make_shared(std::vector<T>{_vector_ref});
     }
@@ -141,6 +154,7 @@ struct proc::signal_event::type_impl : impl {
    private:
     std::vector<T> _vector;
     std::vector<T> &_vector_ref;
+    std::weak_ptr<signal_event_pool> _pool;
 };
 
 template <typename T>
@@ -151,6 +165,11 @@ template <typename T>
 proc::signal_event::signal_event(std::vector<T> &bytes) : _impl(std::make_shared<type_impl<T>>(bytes)) {
 }
 
+template <typename T>
+proc::signal_event::signal_event(std::vector<T> &&bytes, signal_event_pool_ptr const &pool)
+    : _impl(std::make_shared<type_impl<T>>(std::move(bytes), pool)) {
+}
+
 template <typename T>
 std::vector<T> const &proc::signal_event::vector() const {
     return std::dynamic_pointer_cast<signal_event::type_impl<T>>(this->_impl)->vector();
@@ -202,4 +221,20 @@ template <typename T>
 proc::signal_event_ptr proc::signal_event::make_shared(std::vector<T> &vec) {
     return proc::signal_event_ptr(new signal_event{vec});
 }
+
+template <typename T>
+proc::signal_event_ptr proc::signal_event::make_shared(std::size_t const size, signal_event_pool_ptr const &pool) {
+    if constexpr (signal_event_pool::is_poolable<T>) {
+        if (pool) {
+            return make_shared(pool->take<T>(size), pool);
+        }
+    }
+
+    return make_shared<T>(size);
+}
+
+template <typename T>
+proc::signal_event_ptr proc::signal_event::make_shared(std::vector<T> &&vec, signal_event_pool_ptr const &pool) {
+    return proc::signal_event_ptr(new signal_event{std::move(vec), pool});
+}
 }  // namespace yas
@@ -69,7 +69,7 @@ proc::module_ptr make_signal_module() {
                                      std::move(remove_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template <typename In, typename Out>
@@ -112,6 +112,6 @@ proc::module_ptr make_number_module() {
                                      std::move(remove_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 }  // namespace yas::proc::cast
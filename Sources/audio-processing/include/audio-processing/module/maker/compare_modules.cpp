@@ -97,7 +97,7 @@ proc::module_ptr proc::make_signal_module(compare::kind const kind) {
             {std::move(prepare_processor), std::move(receive_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_signal_module<double>(compare::kind const);
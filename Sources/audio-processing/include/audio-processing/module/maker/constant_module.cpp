@@ -28,7 +28,7 @@ proc::module_ptr proc::make_signal_module(T value) {
             })}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_signal_module(double);
@@ -51,7 +51,7 @@ proc::module_ptr proc::make_number_module(T value) {
                     connector_index_t const) { return number_event::value_map_t<T>{{time_range.frame, value}}; })}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_number_module(double);
@@ -69,9 +69,10 @@ struct context {
 
 template <typename T>
 proc::module_ptr proc::envelope::make_signal_module(anchors_t<T> anchors, frame_index_t const module_offset) {
-    auto context = std::make_shared<envelope::context<T>>(std::move(anchors));
+    // 読み進めた位置を持つので、コピーしたモジュールどうしで共有しないようにmake_processorsごとに作る
+    auto make_processors = [anchors = std::move(anchors), module_offset] {
+        auto context = std::make_shared<envelope::context<T>>(anchors_t<T>{anchors});
 
-    auto make_processors = [context = std::move(context), module_offset] {
         auto prepare_processor = [context](time::range const &current_range, connector_map_t const &,
                                            connector_map_t const &,
                                            stream &) mutable { context->reset(current_range); };
@@ -95,7 +96,7 @@ proc::module_ptr proc::envelope::make_signal_module(anchors_t<T> anchors, frame_
         return module::processors_t{{std::move(prepare_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::envelope::make_signal_module(anchors_t<double>, frame_index_t const);
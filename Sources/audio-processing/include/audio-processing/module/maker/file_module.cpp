@@ -30,7 +30,7 @@ module_ptr file::make_signal_module(std::filesystem::path const &path, frame_ind
         return module::processors_t{{std::move(prepare_processor), std::move(send_processor)}};
     };
 
-    return module::make_shared(std::move(make_processors));
+    return module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::file::make_signal_module<double>(std::filesystem::path const &, frame_index_t const,
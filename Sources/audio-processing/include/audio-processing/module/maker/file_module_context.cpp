@@ -16,56 +16,68 @@ using namespace yas::proc;
 template <typename SampleType>
 file::context<SampleType>::context(std::filesystem::path const &path, frame_index_t const module_offset,
                                    frame_index_t const file_offset)
-    : _path(path), _module_offset(module_offset), _file_offset(file_offset) {
+    : context(path, module_offset, file_offset, reader_cache::shared()) {
+}
+
+template <typename SampleType>
+file::context<SampleType>::context(std::filesystem::path const &path, frame_index_t const module_offset,
+                                   frame_index_t const file_offset, reader_cache_ptr const &reader_cache)
+    : _path(path), _module_offset(module_offset), _file_offset(file_offset), _reader_cache(reader_cache) {
 }
 
 template file::context<double>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const);
 template file::context<float>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const);
 template file::context<int32_t>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const);
 template file::context<int16_t>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const);
+template file::context<double>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const,
+                                        reader_cache_ptr const &);
+template file::context<float>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const,
+                                       reader_cache_ptr const &);
+template file::context<int32_t>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const,
+                                         reader_cache_ptr const &);
+template file::context<int16_t>::context(std::filesystem::path const &, frame_index_t const, frame_index_t const,
+                                         reader_cache_ptr const &);
 
 template <typename SampleType>
 void file::context<SampleType>::read_from_file(time::range const &time_range, sync_source const &sync_src,
                                                connector_index_t const co_idx, SampleType *const signal_ptr) const {
     memset(signal_ptr, 0, time_range.length * sizeof(SampleType));
 
-    auto file_result =
-        audio::file::make_opened({.file_path = this->_path, .pcm_format = proc::pcm_format<SampleType>()});
-    if (file_result.is_error()) {
+    reader_ptr reader = this->_reader_cache->acquire(this->_path, proc::pcm_format<SampleType>());
+    if (!reader) {
         return;
     }
 
-    audio::file_ptr const &file = file_result.value();
-
-    audio::format const &file_format = file->file_format();
+    audio::format const &file_format = reader->file_format();
     if (file_format.channel_count() <= co_idx) {
+        this->_reader_cache->release(std::move(reader));
         return;
     }
 
     if ((sample_rate_t)(roundl(file_format.sample_rate())) != sync_src.sample_rate) {
+        this->_reader_cache->release(std::move(reader));
         return;
     }
 
     auto const range_result_opt =
-        module_file_range(time_range, this->_module_offset, this->_file_offset, file->file_length());
+        module_file_range(time_range, this->_module_offset, this->_file_offset, reader->file_length());
     if (!range_result_opt.has_value()) {
+        this->_reader_cache->release(std::move(reader));
         return;
     }
     module_file_range_result const &range_result = range_result_opt.value();
 
-    audio::pcm_buffer buffer{file->processing_format(), static_cast<uint32_t>(range_result.range.length)};
-
-    if (range_result.range.frame > 0) {
-        file->set_file_frame_position(static_cast<uint32_t>(range_result.range.frame));
-    }
-
-    auto read_result = file->read_into_buffer(buffer);
-    if (read_result.is_error()) {
+    // 読み込みに失敗したreaderは状態が不明なのでキャッシュに戻さない
+    audio::pcm_buffer const *buffer =
+        reader->read(range_result.range.frame, static_cast<uint32_t>(range_result.range.length));
+    if (!buffer) {
         return;
     }
 
-    auto copy_result = buffer.copy_to(&signal_ptr[range_result.offset], 1, 0, co_idx, 0,
-                                      static_cast<uint32_t>(range_result.range.length));
+    auto copy_result = buffer->copy_to(&signal_ptr[range_result.offset], 1, 0, co_idx, 0,
+                                       static_cast<uint32_t>(range_result.range.length));
+
+    this->_reader_cache->release(std::move(reader));
 };
 
 template void file::context<double>::read_from_file(time::range const &, sync_source const &, connector_index_t const,
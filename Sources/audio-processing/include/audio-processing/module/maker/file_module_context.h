@@ -6,6 +6,7 @@
 
 #include <audio-processing/common/common_types.h>
 #include <audio-processing/common/ptr.h>
+#include <audio-processing/module/maker/file_reader_cache.h>
 #include <audio-processing/sync_source/sync_source.h>
 #include <audio-processing/time/time.h>
 
@@ -15,6 +16,8 @@ namespace yas::proc::file {
 template <typename SampleType>
 struct context {
     context(std::filesystem::path const &, frame_index_t const module_offset, frame_index_t const file_offset);
+    context(std::filesystem::path const &, frame_index_t const module_offset, frame_index_t const file_offset,
+            reader_cache_ptr const &);
 
     void read_from_file(time::range const &time_range, sync_source const &sync_src, connector_index_t const co_idx,
                         SampleType *const signal_ptr) const;
@@ -23,5 +26,6 @@ struct context {
     std::filesystem::path _path;
     frame_index_t const _module_offset;
     frame_index_t const _file_offset;
+    reader_cache_ptr const _reader_cache;
 };
 }  // namespace yas::proc::file
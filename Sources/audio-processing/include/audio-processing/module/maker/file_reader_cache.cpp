@@ -0,0 +1,170 @@
+//
+//  file_reader_cache.cpp
+//
+
+#include "file_reader_cache.h"
+
+#include <algorithm>
+
+using namespace yas;
+using namespace yas::proc;
+
+#pragma mark - file::reader
+
+file::reader::reader(audio::file_ptr &&file, audio::pcm_format const pcm_format,
+                     std::filesystem::file_time_type const last_write_time)
+    : _file(std::move(file)),
+      _pcm_format(pcm_format),
+      _file_length(this->_file->file_length()),
+      _last_write_time(last_write_time) {
+}
+
+std::filesystem::path const &file::reader::path() const {
+    return this->_file->path();
+}
+
+audio::pcm_format file::reader::pcm_format() const {
+    return this->_pcm_format;
+}
+
+audio::format const &file::reader::file_format() const {
+    return this->_file->file_format();
+}
+
+frame_index_t file::reader::file_length() const {
+    return this->_file_length;
+}
+
+bool file::reader::is_modified() const {
+    std::error_code error;
+    auto const last_write_time = std::filesystem::last_write_time(this->path(), error);
+    return error || last_write_time != this->_last_write_time;
+}
+
+audio::pcm_buffer const *file::reader::read(frame_index_t const file_frame, uint32_t const length) {
+    if (file_frame < 0 || length == 0) {
+        return nullptr;
+    }
+
+    if (!this->_buffer.has_value() || this->_buffer->frame_capacity() < length) {
+        this->_buffer.emplace(this->_file->processing_format(), length);
+    }
+
+    audio::pcm_buffer &buffer = this->_buffer.value();
+
+    // 前回の読み込みで位置が進んでいれば続きなのでシークしない
+    if (this->_file->file_frame_position() != file_frame) {
+        this->_file->set_file_frame_position(static_cast<uint32_t>(file_frame));
+        if (this->_file->file_frame_position() != file_frame) {
+            return nullptr;
+        }
+    }
+
+    if (this->_file->read_into_buffer(buffer, length).is_error()) {
+        return nullptr;
+    }
+
+    return &buffer;
+}
+
+file::reader_ptr file::reader::make_opened(std::filesystem::path const &path, audio::pcm_format const pcm_format) {
+    std::error_code error;
+    auto const last_write_time = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return nullptr;
+    }
+
+    auto file_result = audio::file::make_opened({.file_path = path, .pcm_format = pcm_format});
+    if (file_result.is_error()) {
+        return nullptr;
+    }
+
+    return reader_ptr(new reader{std::move(file_result.value()), pcm_format, last_write_time});
+}
+
+#pragma mark - file::reader_cache
+
+file::reader_cache::reader_cache(std::size_t const capacity) : _capacity(capacity) {
+}
+
+file::reader_ptr file::reader_cache::acquire(std::filesystem::path const &path, audio::pcm_format const pcm_format) {
+    reader_ptr cached = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        auto const it =
+            std::find_if(this->_readers.begin(), this->_readers.end(), [&path, &pcm_format](auto const &reader) {
+                return reader->pcm_format() == pcm_format && reader->path() == path;
+            });
+
+        if (it != this->_readers.end()) {
+            cached = std::move(*it);
+            this->_readers.erase(it);
+        }
+    }
+
+    // 同じパスに書き直されたファイルを古いハンドルで読まないようにする
+    if (cached && !cached->is_modified()) {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        ++this->_hit_count;
+        return cached;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        ++this->_miss_count;
+    }
+
+    return reader::make_opened(path, pcm_format);
+}
+
+void file::reader_cache::release(reader_ptr &&reader) {
+    if (!reader || this->_capacity == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_readers.emplace_front(std::move(reader));
+
+    while (this->_readers.size() > this->_capacity) {
+        this->_readers.pop_back();
+    }
+}
+
+void file::reader_cache::clear() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_readers.clear();
+    this->_hit_count = 0;
+    this->_miss_count = 0;
+}
+
+std::size_t file::reader_cache::capacity() const {
+    return this->_capacity;
+}
+
+std::size_t file::reader_cache::size() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_readers.size();
+}
+
+std::size_t file::reader_cache::hit_count() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_hit_count;
+}
+
+std::size_t file::reader_cache::miss_count() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_miss_count;
+}
+
+file::reader_cache_ptr file::reader_cache::make_shared(std::size_t const capacity) {
+    return reader_cache_ptr(new reader_cache{capacity});
+}
+
+file::reader_cache_ptr const &file::reader_cache::shared() {
+    static reader_cache_ptr const cache = make_shared();
+    return cache;
+}
@@ -0,0 +1,82 @@
+//
+//  file_reader_cache.h
+//
+
+#pragma once
+
+#include <audio-processing/common/common_types.h>
+
+#include <audio-engine/umbrella.hpp>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+
+namespace yas::proc::file {
+struct reader;
+struct reader_cache;
+
+using reader_ptr = std::shared_ptr<reader>;
+using reader_cache_ptr = std::shared_ptr<reader_cache>;
+
+struct reader final {
+    [[nodiscard]] std::filesystem::path const &path() const;
+    [[nodiscard]] audio::pcm_format pcm_format() const;
+    [[nodiscard]] audio::format const &file_format() const;
+    [[nodiscard]] frame_index_t file_length() const;
+    // 開いた後にファイルが書き換えられたか削除されていればtrue
+    [[nodiscard]] bool is_modified() const;
+
+    // file_frameからlength分を読み込んだバッファを返す。読み込みに失敗したらnullptr
+    // 前回の読み込みの続きであればシークしない
+    [[nodiscard]] audio::pcm_buffer const *read(frame_index_t const file_frame, uint32_t const length);
+
+    [[nodiscard]] static reader_ptr make_opened(std::filesystem::path const &, audio::pcm_format const);
+
+   private:
+    audio::file_ptr const _file;
+    audio::pcm_format const _pcm_format;
+    frame_index_t const _file_length;
+    std::filesystem::file_time_type const _last_write_time;
+    std::optional<audio::pcm_buffer> _buffer = std::nullopt;
+
+    reader(audio::file_ptr &&, audio::pcm_format const, std::filesystem::file_time_type const);
+
+    reader(reader const &) = delete;
+    reader(reader &&) = delete;
+    reader &operator=(reader const &) = delete;
+    reader &operator=(reader &&) = delete;
+};
+
+struct reader_cache final {
+    static std::size_t constexpr default_capacity = 64;
+
+    // 開いているreaderを取り出す。キャッシュになければ新たに開く。開けなければnullptr
+    [[nodiscard]] reader_ptr acquire(std::filesystem::path const &, audio::pcm_format const);
+    // 使い終わったreaderを戻す。capacityを超えたら最も古いものから閉じる
+    void release(reader_ptr &&);
+    void clear();
+
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t hit_count() const;
+    [[nodiscard]] std::size_t miss_count() const;
+
+    [[nodiscard]] static reader_cache_ptr make_shared(std::size_t const capacity = default_capacity);
+    [[nodiscard]] static reader_cache_ptr const &shared();
+
+   private:
+    std::size_t const _capacity;
+    std::list<reader_ptr> _readers;
+    std::size_t _hit_count = 0;
+    std::size_t _miss_count = 0;
+    mutable std::mutex _mutex;
+
+    explicit reader_cache(std::size_t const capacity);
+
+    reader_cache(reader_cache const &) = delete;
+    reader_cache(reader_cache &&) = delete;
+    reader_cache &operator=(reader_cache const &) = delete;
+    reader_cache &operator=(reader_cache &&) = delete;
+};
+}  // namespace yas::proc::file
@@ -47,7 +47,7 @@ proc::module_ptr proc::make_signal_module(generator::kind const kind, frame_inde
         return module::processors_t{{std::move(prepare_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_signal_module<double>(generator::kind const, frame_index_t const);
@@ -8,12 +8,12 @@
 #include <audio-processing/event/signal_event.h>
 #include <audio-processing/module/context/number_process_context.h>
 #include <audio-processing/module/context/signal_process_context.h>
+#include <audio-processing/module/maker/math_kernels.h>
 #include <audio-processing/module/module.h>
 #include <audio-processing/processor/maker/receive_number_processor.h>
 #include <audio-processing/processor/maker/receive_signal_processor.h>
 #include <audio-processing/processor/maker/send_number_processor.h>
 #include <audio-processing/processor/maker/send_signal_processor.h>
-#include <cpp-utils/fast_each.h>
 
 using namespace yas;
 using namespace yas::proc;
@@ -42,9 +42,9 @@ proc::module_ptr proc::make_signal_module(math1::kind const kind) {
             });
 
         auto send_processor = proc::make_send_signal_processor<T>(
-            [context, kind, out_each = fast_each<T *>{}](proc::time::range const &time_range, sync_source const &,
-                                                         channel_index_t const, connector_index_t const co_idx,
-                                                         T *const signal_ptr) mutable {
+            [context, kernel = signal_kernel<T>(kind)](proc::time::range const &time_range, sync_source const &,
+                                                       channel_index_t const, connector_index_t const co_idx,
+                                                       T *const signal_ptr) mutable {
                 if (co_idx == to_connector_index(output::result)) {
                     auto const input_co_idx = to_connector_index(input::parameter);
 
@@ -54,100 +54,7 @@ proc::module_ptr proc::make_signal_module(math1::kind const kind) {
                     auto const &input_length =
                         input_time ? input_time.get<time::range>().length : constant::zero_length;
 
-                    out_each.reset(signal_ptr, time_range.length);
-                    while (yas_each_next(out_each)) {
-                        auto const &idx = yas_each_index(out_each);
-                        auto const input_idx = idx + input_offset;
-
-                        static T constexpr zero_value = 0;
-                        auto const &input_value =
-                            (input_idx >= 0 && input_idx < input_length) ? input_ptr[input_idx] : zero_value;
-
-                        switch (kind) {
-                            case kind::sin:
-                                yas_each_value(out_each) = std::sin(input_value);
-                                break;
-                            case kind::cos:
-                                yas_each_value(out_each) = std::cos(input_value);
-                                break;
-                            case kind::tan:
-                                yas_each_value(out_each) = std::tan(input_value);
-                                break;
-                            case kind::asin:
-                                yas_each_value(out_each) = std::asin(input_value);
-                                break;
-                            case kind::acos:
-                                yas_each_value(out_each) = std::acos(input_value);
-                                break;
-                            case kind::atan:
-                                yas_each_value(out_each) = std::atan(input_value);
-                                break;
-
-                            case kind::sinh:
-                                yas_each_value(out_each) = std::sinh(input_value);
-                                break;
-                            case kind::cosh:
-                                yas_each_value(out_each) = std::cosh(input_value);
-                                break;
-                            case kind::tanh:
-                                yas_each_value(out_each) = std::tanh(input_value);
-                                break;
-                            case kind::asinh:
-                                yas_each_value(out_each) = std::asinh(input_value);
-                                break;
-                            case kind::acosh:
-                                yas_each_value(out_each) = std::acosh(input_value);
-                                break;
-                            case kind::atanh:
-                                yas_each_value(out_each) = std::atanh(input_value);
-                                break;
-
-                            case kind::exp:
-                                yas_each_value(out_each) = std::exp(input_value);
-                                break;
-                            case kind::exp2:
-                                yas_each_value(out_each) = std::exp2(input_value);
-                                break;
-                            case kind::expm1:
-                                yas_each_value(out_each) = std::expm1(input_value);
-                                break;
-                            case kind::log:
-                                yas_each_value(out_each) = std::log(input_value);
-                                break;
-                            case kind::log10:
-                                yas_each_value(out_each) = std::log10(input_value);
-                                break;
-                            case kind::log1p:
-                                yas_each_value(out_each) = std::log1p(input_value);
-                                break;
-                            case kind::log2:
-                                yas_each_value(out_each) = std::log2(input_value);
-                                break;
-
-                            case kind::sqrt:
-                                yas_each_value(out_each) = std::sqrt(input_value);
-                                break;
-                            case kind::cbrt:
-                                yas_each_value(out_each) = std::cbrt(input_value);
-                                break;
-                            case kind::abs:
-                                yas_each_value(out_each) = std::abs(input_value);
-                                break;
-
-                            case kind::ceil:
-                                yas_each_value(out_each) = std::ceil(input_value);
-                                break;
-                            case kind::floor:
-                                yas_each_value(out_each) = std::floor(input_value);
-                                break;
-                            case kind::trunc:
-                                yas_each_value(out_each) = std::trunc(input_value);
-                                break;
-                            case kind::round:
-                                yas_each_value(out_each) = std::round(input_value);
-                                break;
-                        }
-                    }
+                    process_signal(kernel, input_ptr, input_offset, input_length, signal_ptr, time_range.length);
                 }
             });
 
@@ -155,7 +62,7 @@ proc::module_ptr proc::make_signal_module(math1::kind const kind) {
             {std::move(prepare_processor), std::move(receive_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_signal_module<double>(math1::kind const);
@@ -192,92 +99,7 @@ proc::module_ptr proc::make_number_module(math1::kind const kind) {
 
                 for (auto const &input_pair : context->inputs()) {
                     auto const &input_value = *input_pair.second.values[input_co_idx];
-                    T result_value = 0;
-
-                    switch (kind) {
-                        case kind::sin:
-                            result_value = std::sin(input_value);
-                            break;
-                        case kind::cos:
-                            result_value = std::cos(input_value);
-                            break;
-                        case kind::tan:
-                            result_value = std::tan(input_value);
-                            break;
-                        case kind::asin:
-                            result_value = std::asin(input_value);
-                            break;
-                        case kind::acos:
-                            result_value = std::acos(input_value);
-                            break;
-                        case kind::atan:
-                            result_value = std::atan(input_value);
-                            break;
-
-                        case kind::sinh:
-                            result_value = std::sinh(input_value);
-                            break;
-                        case kind::cosh:
-                            result_value = std::cosh(input_value);
-                            break;
-                        case kind::tanh:
-                            result_value = std::tanh(input_value);
-                            break;
-                        case kind::asinh:
-                            result_value = std::asinh(input_value);
-                            break;
-                        case kind::acosh:
-                            result_value = std::acosh(input_value);
-                            break;
-                        case kind::atanh:
-                            result_value = std::atanh(input_value);
-                            break;
-
-                        case kind::exp:
-                            result_value = std::exp(input_value);
-                            break;
-                        case kind::exp2:
-                            result_value = std::exp2(input_value);
-                            break;
-                        case kind::expm1:
-                            result_value = std::expm1(input_value);
-                            break;
-                        case kind::log:
-                            result_value = std::log(input_value);
-                            break;
-                        case kind::log10:
-                            result_value = std::log10(input_value);
-                            break;
-                        case kind::log1p:
-                            result_value = std::log1p(input_value);
-                            break;
-                        case kind::log2:
-                            result_value = std::log2(input_value);
-                            break;
-
-                        case kind::sqrt:
-                            result_value = std::sqrt(input_value);
-                            break;
-                        case kind::cbrt:
-                            result_value = std::cbrt(input_value);
-                            break;
-                        case kind::abs:
-                            result_value = std::abs(input_value);
-                            break;
-
-                        case kind::ceil:
-                            result_value = std::ceil(input_value);
-                            break;
-                        case kind::floor:
-                            result_value = std::floor(input_value);
-                            break;
-                        case kind::trunc:
-                            result_value = std::trunc(input_value);
-                            break;
-                        case kind::round:
-                            result_value = std::round(input_value);
-                            break;
-                    }
+                    T const result_value = calc(kind, input_value);
 
                     result.emplace(input_pair.first, result_value);
                 }
@@ -290,7 +112,7 @@ proc::module_ptr proc::make_number_module(math1::kind const kind) {
             {std::move(prepare_processor), std::move(receive_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_number_module<double>(math1::kind const);
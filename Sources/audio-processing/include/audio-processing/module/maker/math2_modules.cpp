@@ -9,12 +9,12 @@
 #include <audio-processing/event/signal_event.h>
 #include <audio-processing/module/context/number_process_context.h>
 #include <audio-processing/module/context/signal_process_context.h>
+#include <audio-processing/module/maker/math_kernels.h>
 #include <audio-processing/module/module.h>
 #include <audio-processing/processor/maker/receive_number_processor.h>
 #include <audio-processing/processor/maker/receive_signal_processor.h>
 #include <audio-processing/processor/maker/send_number_processor.h>
 #include <audio-processing/processor/maker/send_signal_processor.h>
-#include <cpp-utils/fast_each.h>
 
 using namespace yas;
 using namespace yas::proc;
@@ -42,67 +42,34 @@ proc::module_ptr proc::make_signal_module(math2::kind const kind) {
                 }
             });
 
-        auto send_processor = proc::make_send_signal_processor<T>([context, kind, out_each = fast_each<T *>{}](
-                                                                      proc::time::range const &time_range,
-                                                                      sync_source const &, channel_index_t const,
-                                                                      connector_index_t const co_idx,
-                                                                      T *const signal_ptr) mutable {
-            if (co_idx == to_connector_index(output::result)) {
-                static auto const left_co_idx = to_connector_index(input::left);
-                static auto const right_co_idx = to_connector_index(input::right);
-
-                auto const *left_ptr = context->data(left_co_idx);
-                auto const *right_ptr = context->data(right_co_idx);
-                proc::time const &left_time = context->time(left_co_idx);
-                proc::time const &right_time = context->time(right_co_idx);
-                auto const left_offset = left_time ? time_range.frame - left_time.get<time::range>().frame : 0;
-                auto const right_offset = right_time ? time_range.frame - right_time.get<time::range>().frame : 0;
-                auto const &left_length = left_time ? left_time.get<time::range>().length : constant::zero_length;
-                auto const &right_length = right_time ? right_time.get<time::range>().length : constant::zero_length;
-
-                out_each.reset(signal_ptr, time_range.length);
-                while (yas_each_next(out_each)) {
-                    auto const &idx = yas_each_index(out_each);
-                    auto const left_idx = idx + left_offset;
-                    auto const right_idx = idx + right_offset;
-                    auto const &left_value = (left_idx >= 0 && left_idx < left_length) ? left_ptr[left_idx] : 0;
-                    auto const &right_value = (right_idx >= 0 && right_idx < right_length) ? right_ptr[right_idx] : 0;
-
-                    switch (kind) {
-                        case kind::plus:
-                            yas_each_value(out_each) = left_value + right_value;
-                            break;
-                        case kind::minus:
-                            yas_each_value(out_each) = left_value - right_value;
-                            break;
-                        case kind::multiply:
-                            yas_each_value(out_each) = left_value * right_value;
-                            break;
-                        case kind::divide:
-                            yas_each_value(out_each) =
-                                (left_value == 0 || right_value == 0) ? 0 : left_value / right_value;
-                            break;
-
-                        case kind::atan2:
-                            yas_each_value(out_each) = std::atan2(left_value, right_value);
-                            break;
-
-                        case kind::pow:
-                            yas_each_value(out_each) = std::pow(left_value, right_value);
-                            break;
-                        case kind::hypot:
-                            yas_each_value(out_each) = std::hypot(left_value, right_value);
-                            break;
-                    }
+        auto send_processor = proc::make_send_signal_processor<T>(
+            [context, kernel = signal_kernel<T>(kind)](proc::time::range const &time_range, sync_source const &,
+                                                       channel_index_t const, connector_index_t const co_idx,
+                                                       T *const signal_ptr) mutable {
+                if (co_idx == to_connector_index(output::result)) {
+                    static auto const left_co_idx = to_connector_index(input::left);
+                    static auto const right_co_idx = to_connector_index(input::right);
+
+                    auto const *left_ptr = context->data(left_co_idx);
+                    auto const *right_ptr = context->data(right_co_idx);
+                    proc::time const &left_time = context->time(left_co_idx);
+                    proc::time const &right_time = context->time(right_co_idx);
+                    auto const left_offset = left_time ? time_range.frame - left_time.get<time::range>().frame : 0;
+                    auto const right_offset = right_time ? time_range.frame - right_time.get<time::range>().frame : 0;
+                    auto const &left_length = left_time ? left_time.get<time::range>().length : constant::zero_length;
+                    auto const &right_length =
+                        right_time ? right_time.get<time::range>().length : constant::zero_length;
+
+                    process_signal(kernel, left_ptr, left_offset, left_length, right_ptr, right_offset, right_length,
+                                   signal_ptr, time_range.length);
                 }
-            }
-        });
+            });
 
         return module::processors_t{
             {std::move(prepare_processor), std::move(receive_processor), std::move(send_processor)}};
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_signal_module<double>(math2::kind const);
@@ -153,33 +120,7 @@ proc::module_ptr proc::make_number_module(math2::kind const kind) {
                     context->update_last_values(input_pair.second);
                     T const &left_value = last_values[left_co_idx];
                     T const &right_value = last_values[right_co_idx];
-                    T result_value;
-
-                    switch (kind) {
-                        case kind::plus:
-                            result_value = left_value + right_value;
-                            break;
-                        case kind::minus:
-                            result_value = left_value - right_value;
-                            break;
-                        case kind::multiply:
-                            result_value = left_value * right_value;
-                            break;
-                        case kind::divide:
-                            result_value = (left_value == 0 || right_value == 0) ? 0 : left_value / right_value;
-                            break;
-
-                        case kind::atan2:
-                            result_value = std::atan2(left_value, right_value);
-                            break;
-
-                        case kind::pow:
-                            result_value = std::pow(left_value, right_value);
-                            break;
-                        case kind::hypot:
-                            result_value = std::hypot(left_value, right_value);
-                            break;
-                    }
+                    T const result_value = calc(kind, left_value, right_value);
 
                     result.emplace(input_pair.first, result_value);
                 }
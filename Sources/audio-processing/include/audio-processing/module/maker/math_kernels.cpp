@@ -0,0 +1,429 @@
+//
+//  math_kernels.cpp
+//
+
+#include "math_kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::math_kernels {
+struct span {
+    std::size_t begin;
+    std::size_t end;
+
+    [[nodiscard]] bool is_contain(std::size_t const begin, std::size_t const end) const {
+        return this->begin <= begin && end <= this->end;
+    }
+};
+
+/// 出力のうち入力が存在するインデックスの範囲を返す
+static span make_span(frame_index_t const in_offset, length_t const in_length, length_t const out_length) {
+    auto const out_end = static_cast<frame_index_t>(out_length);
+    auto const begin = std::clamp<frame_index_t>(-in_offset, 0, out_end);
+    auto const end = std::clamp<frame_index_t>(static_cast<frame_index_t>(in_length) - in_offset, begin, out_end);
+    return span{static_cast<std::size_t>(begin), static_cast<std::size_t>(end)};
+}
+}  // namespace yas::proc::math_kernels
+
+#pragma mark - math1
+
+namespace yas::proc::math1 {
+template <kind K, typename T>
+static T calc_value(T const value) {
+    if constexpr (K == kind::sin) {
+        return std::sin(value);
+    } else if constexpr (K == kind::cos) {
+        return std::cos(value);
+    } else if constexpr (K == kind::tan) {
+        return std::tan(value);
+    } else if constexpr (K == kind::asin) {
+        return std::asin(value);
+    } else if constexpr (K == kind::acos) {
+        return std::acos(value);
+    } else if constexpr (K == kind::atan) {
+        return std::atan(value);
+    } else if constexpr (K == kind::sinh) {
+        return std::sinh(value);
+    } else if constexpr (K == kind::cosh) {
+        return std::cosh(value);
+    } else if constexpr (K == kind::tanh) {
+        return std::tanh(value);
+    } else if constexpr (K == kind::asinh) {
+        return std::asinh(value);
+    } else if constexpr (K == kind::acosh) {
+        return std::acosh(value);
+    } else if constexpr (K == kind::atanh) {
+        return std::atanh(value);
+    } else if constexpr (K == kind::exp) {
+        return std::exp(value);
+    } else if constexpr (K == kind::exp2) {
+        return std::exp2(value);
+    } else if constexpr (K == kind::expm1) {
+        return std::expm1(value);
+    } else if constexpr (K == kind::log) {
+        return std::log(value);
+    } else if constexpr (K == kind::log10) {
+        return std::log10(value);
+    } else if constexpr (K == kind::log1p) {
+        return std::log1p(value);
+    } else if constexpr (K == kind::log2) {
+        return std::log2(value);
+    } else if constexpr (K == kind::sqrt) {
+        return std::sqrt(value);
+    } else if constexpr (K == kind::cbrt) {
+        return std::cbrt(value);
+    } else if constexpr (K == kind::abs) {
+        return std::abs(value);
+    } else if constexpr (K == kind::ceil) {
+        return std::ceil(value);
+    } else if constexpr (K == kind::floor) {
+        return std::floor(value);
+    } else if constexpr (K == kind::trunc) {
+        return std::trunc(value);
+    } else if constexpr (K == kind::round) {
+        return std::round(value);
+    }
+}
+
+template <kind K, typename T>
+static void kernel(T const *const __restrict in_ptr, T *const __restrict out_ptr, std::size_t const count) {
+    if (in_ptr) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            out_ptr[idx] = calc_value<K>(in_ptr[idx]);
+        }
+    } else {
+        std::fill_n(out_ptr, count, calc_value<K>(static_cast<T>(0)));
+    }
+}
+}  // namespace yas::proc::math1
+
+template <typename T>
+T math1::calc(kind const kind, T const value) {
+    switch (kind) {
+        case kind::sin:
+            return calc_value<kind::sin>(value);
+        case kind::cos:
+            return calc_value<kind::cos>(value);
+        case kind::tan:
+            return calc_value<kind::tan>(value);
+        case kind::asin:
+            return calc_value<kind::asin>(value);
+        case kind::acos:
+            return calc_value<kind::acos>(value);
+        case kind::atan:
+            return calc_value<kind::atan>(value);
+
+        case kind::sinh:
+            return calc_value<kind::sinh>(value);
+        case kind::cosh:
+            return calc_value<kind::cosh>(value);
+        case kind::tanh:
+            return calc_value<kind::tanh>(value);
+        case kind::asinh:
+            return calc_value<kind::asinh>(value);
+        case kind::acosh:
+            return calc_value<kind::acosh>(value);
+        case kind::atanh:
+            return calc_value<kind::atanh>(value);
+
+        case kind::exp:
+            return calc_value<kind::exp>(value);
+        case kind::exp2:
+            return calc_value<kind::exp2>(value);
+        case kind::expm1:
+            return calc_value<kind::expm1>(value);
+        case kind::log:
+            return calc_value<kind::log>(value);
+        case kind::log10:
+            return calc_value<kind::log10>(value);
+        case kind::log1p:
+            return calc_value<kind::log1p>(value);
+        case kind::log2:
+            return calc_value<kind::log2>(value);
+
+        case kind::sqrt:
+            return calc_value<kind::sqrt>(value);
+        case kind::cbrt:
+            return calc_value<kind::cbrt>(value);
+        case kind::abs:
+            return calc_value<kind::abs>(value);
+
+        case kind::ceil:
+            return calc_value<kind::ceil>(value);
+        case kind::floor:
+            return calc_value<kind::floor>(value);
+        case kind::trunc:
+            return calc_value<kind::trunc>(value);
+        case kind::round:
+            return calc_value<kind::round>(value);
+    }
+
+    throw "kind not found.";
+}
+
+template <typename T>
+math1::signal_kernel_f<T> math1::signal_kernel(kind const kind) {
+    switch (kind) {
+        case kind::sin:
+            return kernel<kind::sin, T>;
+        case kind::cos:
+            return kernel<kind::cos, T>;
+        case kind::tan:
+            return kernel<kind::tan, T>;
+        case kind::asin:
+            return kernel<kind::asin, T>;
+        case kind::acos:
+            return kernel<kind::acos, T>;
+        case kind::atan:
+            return kernel<kind::atan, T>;
+
+        case kind::sinh:
+            return kernel<kind::sinh, T>;
+        case kind::cosh:
+            return kernel<kind::cosh, T>;
+        case kind::tanh:
+            return kernel<kind::tanh, T>;
+        case kind::asinh:
+            return kernel<kind::asinh, T>;
+        case kind::acosh:
+            return kernel<kind::acosh, T>;
+        case kind::atanh:
+            return kernel<kind::atanh, T>;
+
+        case kind::exp:
+            return kernel<kind::exp, T>;
+        case kind::exp2:
+            return kernel<kind::exp2, T>;
+        case kind::expm1:
+            return kernel<kind::expm1, T>;
+        case kind::log:
+            return kernel<kind::log, T>;
+        case kind::log10:
+            return kernel<kind::log10, T>;
+        case kind::log1p:
+            return kernel<kind::log1p, T>;
+        case kind::log2:
+            return kernel<kind::log2, T>;
+
+        case kind::sqrt:
+            return kernel<kind::sqrt, T>;
+        case kind::cbrt:
+            return kernel<kind::cbrt, T>;
+        case kind::abs:
+            return kernel<kind::abs, T>;
+
+        case kind::ceil:
+            return kernel<kind::ceil, T>;
+        case kind::floor:
+            return kernel<kind::floor, T>;
+        case kind::trunc:
+            return kernel<kind::trunc, T>;
+        case kind::round:
+            return kernel<kind::round, T>;
+    }
+
+    throw "kind not found.";
+}
+
+template <typename T>
+void math1::process_signal(signal_kernel_f<T> const kernel_f, T const *const in_ptr, frame_index_t const in_offset,
+                           length_t const in_length, T *const out_ptr, length_t const out_length) {
+    auto const span = math_kernels::make_span(in_offset, in_length, out_length);
+
+    kernel_f(nullptr, out_ptr, span.begin);
+
+    if (span.begin < span.end) {
+        kernel_f(in_ptr + (static_cast<frame_index_t>(span.begin) + in_offset), out_ptr + span.begin,
+               span.end - span.begin);
+    }
+
+    kernel_f(nullptr, out_ptr + span.end, out_length - span.end);
+}
+
+template double math1::calc(kind const, double const);
+template float math1::calc(kind const, float const);
+template math1::signal_kernel_f<double> math1::signal_kernel(kind const);
+template math1::signal_kernel_f<float> math1::signal_kernel(kind const);
+template void math1::process_signal(signal_kernel_f<double> const, double const *const, frame_index_t const,
+                                    length_t const, double *const, length_t const);
+template void math1::process_signal(signal_kernel_f<float> const, float const *const, frame_index_t const,
+                                    length_t const, float *const, length_t const);
+
+#pragma mark - math2
+
+namespace yas::proc::math2 {
+template <kind K, typename T>
+static T calc_value(T const left, T const right) {
+    if constexpr (K == kind::plus) {
+        return static_cast<T>(left + right);
+    } else if constexpr (K == kind::minus) {
+        return static_cast<T>(left - right);
+    } else if constexpr (K == kind::multiply) {
+        return static_cast<T>(left * right);
+    } else if constexpr (K == kind::divide) {
+        return static_cast<T>((left == 0 || right == 0) ? 0 : left / right);
+    } else if constexpr (K == kind::atan2) {
+        return static_cast<T>(std::atan2(left, right));
+    } else if constexpr (K == kind::pow) {
+        return static_cast<T>(std::pow(left, right));
+    } else if constexpr (K == kind::hypot) {
+        return static_cast<T>(std::hypot(left, right));
+    }
+}
+
+template <kind K, typename T>
+static void kernel(T const *const __restrict left_ptr, T const *const __restrict right_ptr, T *const __restrict out_ptr,
+                   std::size_t const count) {
+    static T constexpr zero = 0;
+
+    if (left_ptr && right_ptr) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            out_ptr[idx] = calc_value<K>(left_ptr[idx], right_ptr[idx]);
+        }
+    } else if (left_ptr) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            out_ptr[idx] = calc_value<K>(left_ptr[idx], zero);
+        }
+    } else if (right_ptr) {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            out_ptr[idx] = calc_value<K>(zero, right_ptr[idx]);
+        }
+    } else {
+        std::fill_n(out_ptr, count, calc_value<K>(zero, zero));
+    }
+}
+}  // namespace yas::proc::math2
+
+template <typename T>
+T math2::calc(kind const kind, T const left, T const right) {
+    switch (kind) {
+        case kind::plus:
+            return calc_value<kind::plus>(left, right);
+        case kind::minus:
+            return calc_value<kind::minus>(left, right);
+        case kind::multiply:
+            return calc_value<kind::multiply>(left, right);
+        case kind::divide:
+            return calc_value<kind::divide>(left, right);
+
+        case kind::atan2:
+            return calc_value<kind::atan2>(left, right);
+
+        case kind::pow:
+            return calc_value<kind::pow>(left, right);
+        case kind::hypot:
+            return calc_value<kind::hypot>(left, right);
+    }
+
+    throw "kind not found.";
+}
+
+template <typename T>
+math2::signal_kernel_f<T> math2::signal_kernel(kind const kind) {
+    switch (kind) {
+        case kind::plus:
+            return kernel<kind::plus, T>;
+        case kind::minus:
+            return kernel<kind::minus, T>;
+        case kind::multiply:
+            return kernel<kind::multiply, T>;
+        case kind::divide:
+            return kernel<kind::divide, T>;
+
+        case kind::atan2:
+            return kernel<kind::atan2, T>;
+
+        case kind::pow:
+            return kernel<kind::pow, T>;
+        case kind::hypot:
+            return kernel<kind::hypot, T>;
+    }
+
+    throw "kind not found.";
+}
+
+template <typename T>
+void math2::process_signal(signal_kernel_f<T> const kernel_f, T const *const left_ptr, frame_index_t const left_offset,
+                           length_t const left_length, T const *const right_ptr, frame_index_t const right_offset,
+                           length_t const right_length, T *const out_ptr, length_t const out_length) {
+    auto const left_span = math_kernels::make_span(left_offset, left_length, out_length);
+    auto const right_span = math_kernels::make_span(right_offset, right_length, out_length);
+
+    // 入力の有無が切り替わる位置で区切る
+    std::array<std::size_t, 6> bounds{0, left_span.begin, left_span.end, right_span.begin, right_span.end,
+                                      static_cast<std::size_t>(out_length)};
+    std::sort(bounds.begin(), bounds.end());
+
+    for (std::size_t idx = 1; idx < bounds.size(); ++idx) {
+        auto const &begin = bounds.at(idx - 1);
+        auto const &end = bounds.at(idx);
+
+        if (begin == end) {
+            continue;
+        }
+
+        T const *const segment_left_ptr =
+            left_span.is_contain(begin, end) ? left_ptr + (static_cast<frame_index_t>(begin) + left_offset) : nullptr;
+        T const *const segment_right_ptr = right_span.is_contain(begin, end)
+                                               ? right_ptr + (static_cast<frame_index_t>(begin) + right_offset)
+                                               : nullptr;
+
+        kernel_f(segment_left_ptr, segment_right_ptr, out_ptr + begin, end - begin);
+    }
+}
+
+template double math2::calc(kind const, double const, double const);
+template float math2::calc(kind const, float const, float const);
+template int64_t math2::calc(kind const, int64_t const, int64_t const);
+template int32_t math2::calc(kind const, int32_t const, int32_t const);
+template int16_t math2::calc(kind const, int16_t const, int16_t const);
+template int8_t math2::calc(kind const, int8_t const, int8_t const);
+template uint64_t math2::calc(kind const, uint64_t const, uint64_t const);
+template uint32_t math2::calc(kind const, uint32_t const, uint32_t const);
+template uint16_t math2::calc(kind const, uint16_t const, uint16_t const);
+template uint8_t math2::calc(kind const, uint8_t const, uint8_t const);
+template math2::signal_kernel_f<double> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<float> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<int64_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<int32_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<int16_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<int8_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<uint64_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<uint32_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<uint16_t> math2::signal_kernel(kind const);
+template math2::signal_kernel_f<uint8_t> math2::signal_kernel(kind const);
+template void math2::process_signal(signal_kernel_f<double> const, double const *const, frame_index_t const,
+                                    length_t const, double const *const, frame_index_t const, length_t const,
+                                    double *const, length_t const);
+template void math2::process_signal(signal_kernel_f<float> const, float const *const, frame_index_t const,
+                                    length_t const, float const *const, frame_index_t const, length_t const,
+                                    float *const, length_t const);
+template void math2::process_signal(signal_kernel_f<int64_t> const, int64_t const *const, frame_index_t const,
+                                    length_t const, int64_t const *const, frame_index_t const, length_t const,
+                                    int64_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<int32_t> const, int32_t const *const, frame_index_t const,
+                                    length_t const, int32_t const *const, frame_index_t const, length_t const,
+                                    int32_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<int16_t> const, int16_t const *const, frame_index_t const,
+                                    length_t const, int16_t const *const, frame_index_t const, length_t const,
+                                    int16_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<int8_t> const, int8_t const *const, frame_index_t const,
+                                    length_t const, int8_t const *const, frame_index_t const, length_t const,
+                                    int8_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<uint64_t> const, uint64_t const *const, frame_index_t const,
+                                    length_t const, uint64_t const *const, frame_index_t const, length_t const,
+                                    uint64_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<uint32_t> const, uint32_t const *const, frame_index_t const,
+                                    length_t const, uint32_t const *const, frame_index_t const, length_t const,
+                                    uint32_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<uint16_t> const, uint16_t const *const, frame_index_t const,
+                                    length_t const, uint16_t const *const, frame_index_t const, length_t const,
+                                    uint16_t *const, length_t const);
+template void math2::process_signal(signal_kernel_f<uint8_t> const, uint8_t const *const, frame_index_t const,
+                                    length_t const, uint8_t const *const, frame_index_t const, length_t const,
+                                    uint8_t *const, length_t const);
@@ -0,0 +1,49 @@
+//
+//  math_kernels.h
+//
+
+#pragma once
+
+#include <audio-processing/module/maker/math1_modules.h>
+#include <audio-processing/module/maker/math2_modules.h>
+
+#include <cstddef>
+
+namespace yas::proc {
+namespace math1 {
+    /// 入力がnullptrなら0が並んでいるものとして扱う
+    template <typename T>
+    using signal_kernel_f = void (*)(T const *const, T *const, std::size_t const);
+
+    template <typename T>
+    [[nodiscard]] T calc(kind const, T const);
+
+    /// kindごとに分岐のないループで処理する関数を返す。モジュール生成時に一度だけ選ぶ
+    template <typename T>
+    [[nodiscard]] signal_kernel_f<T> signal_kernel(kind const);
+
+    /// 入力のある範囲とない範囲に分けてkernelを呼ぶ
+    template <typename T>
+    void process_signal(signal_kernel_f<T> const, T const *const in_ptr, frame_index_t const in_offset,
+                        length_t const in_length, T *const out_ptr, length_t const out_length);
+}  // namespace math1
+
+namespace math2 {
+    /// 入力がnullptrなら0が並んでいるものとして扱う
+    template <typename T>
+    using signal_kernel_f = void (*)(T const *const, T const *const, T *const, std::size_t const);
+
+    template <typename T>
+    [[nodiscard]] T calc(kind const, T const left, T const right);
+
+    /// kindごとに分岐のないループで処理する関数を返す。モジュール生成時に一度だけ選ぶ
+    template <typename T>
+    [[nodiscard]] signal_kernel_f<T> signal_kernel(kind const);
+
+    /// left・rightそれぞれの入力のある範囲で区切ってkernelを呼ぶ
+    template <typename T>
+    void process_signal(signal_kernel_f<T> const, T const *const left_ptr, frame_index_t const left_offset,
+                        length_t const left_length, T const *const right_ptr, frame_index_t const right_offset,
+                        length_t const right_length, T *const out_ptr, length_t const out_length);
+}  // namespace math2
+}  // namespace yas::proc
@@ -0,0 +1,118 @@
+//
+//  oscillator_module.cpp
+//
+
+#include "oscillator_module.h"
+
+#include <audio-processing/module/module.h>
+#include <audio-processing/processor/maker/send_signal_processor.h>
+#include <audio-processing/sync_source/sync_source.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::oscillator {
+template <typename T>
+struct context {
+    context(std::vector<audio::oscillator_voice> const &voices, std::vector<T> const &table)
+        : _voices(voices), _table(table) {
+        for (auto &voice : this->_voices) {
+            voice.channel = 0;
+        }
+    }
+
+    /// 描画する前にサンプルレートに合わせて作っておく
+    void prepare(sample_rate_t const sample_rate) {
+        double const sr = sample_rate;
+
+        if (this->_bank.has_value() && this->_bank->sample_rate() == sr) {
+            return;
+        }
+
+        this->_bank.emplace(sr, 1);
+        for (auto const &voice : this->_voices) {
+            this->_bank->add_voice(voice);
+        }
+        this->_bank->set_table(this->_table);
+    }
+
+    void render(time::range const &time_range, frame_index_t const frame_offset, T *const signal_ptr) {
+        if (!this->_bank.has_value()) {
+            return;
+        }
+
+        double const sr = this->_bank->sample_rate();
+
+        // 範囲の先頭での位置に合わせる。周波数はoscillator_bankと同じくナイキスト周波数までに収める
+        auto const frame = static_cast<double>(frame_offset + time_range.frame);
+        for (std::size_t idx = 0; idx < this->_voices.size(); ++idx) {
+            auto const &voice = this->_voices.at(idx);
+            double const increment = std::clamp(voice.frequency / sr, 0.0, 0.5);
+            this->_bank->set_phase(idx, voice.phase + std::fmod(increment * frame, 1.0));
+        }
+
+        T *const outs[1] = {signal_ptr};
+        this->_bank->render(outs, static_cast<uint32_t>(time_range.length));
+    }
+
+   private:
+    std::vector<audio::oscillator_voice> _voices;
+    std::vector<T> const _table;
+    std::optional<audio::oscillator_bank<T>> _bank = std::nullopt;
+};
+}  // namespace yas::proc::oscillator
+
+template <typename T>
+proc::module_ptr proc::oscillator::make_signal_module(std::vector<audio::oscillator_voice> voices,
+                                                      std::vector<T> table, frame_index_t const frame_offset) {
+    auto make_processors = [voices = std::move(voices), table = std::move(table), frame_offset] {
+        auto context = std::make_shared<oscillator::context<T>>(voices, table);
+
+        auto prepare_processor = [context](time::range const &, connector_map_t const &, connector_map_t const &,
+                                           stream &stream) { context->prepare(stream.sync_source().sample_rate); };
+
+        auto send_processor = proc::make_send_signal_processor<T>(
+            [context, frame_offset](proc::time::range const &time_range, sync_source const &, channel_index_t const,
+                                    connector_index_t const co_idx, T *const signal_ptr) {
+                if (co_idx == to_connector_index(output::value)) {
+                    context->render(time_range, frame_offset, signal_ptr);
+                }
+            });
+
+        return module::processors_t{{std::move(prepare_processor), std::move(send_processor)}};
+    };
+
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
+}
+
+template proc::module_ptr proc::oscillator::make_signal_module(std::vector<audio::oscillator_voice>,
+                                                               std::vector<double>, frame_index_t const);
+template proc::module_ptr proc::oscillator::make_signal_module(std::vector<audio::oscillator_voice>,
+                                                               std::vector<float>, frame_index_t const);
+
+#pragma mark -
+
+void yas::connect(proc::module_ptr const &module, proc::oscillator::output const &output,
+                  proc::channel_index_t const &ch_idx) {
+    module->connect_output(proc::to_connector_index(output), ch_idx);
+}
+
+std::string yas::to_string(proc::oscillator::output const &output) {
+    using namespace yas::proc::oscillator;
+
+    switch (output) {
+        case output::value:
+            return "value";
+    }
+
+    throw "output not found.";
+}
+
+std::ostream &operator<<(std::ostream &os, yas::proc::oscillator::output const &value) {
+    os << to_string(value);
+    return os;
+}
@@ -0,0 +1,35 @@
+//
+//  oscillator_module.h
+//
+
+#pragma once
+
+#include <audio-engine/utils/oscillator_bank.h>
+#include <audio-processing/common/common_types.h>
+#include <audio-processing/common/ptr.h>
+
+#include <ostream>
+#include <vector>
+
+namespace yas::proc {
+/// audio::oscillator_bankで発振器の和を生成するモジュール
+namespace oscillator {
+    enum class output : connector_index_t {
+        value,
+    };
+
+    /// voiceのchannelは使わずにすべて同じ出力へ足す
+    /// 位置はframe_offsetを足した絶対的な時間から求めるので、どの範囲から処理しても続いた波形になる
+    template <typename T>
+    [[nodiscard]] module_ptr make_signal_module(std::vector<audio::oscillator_voice>, std::vector<T> table,
+                                                frame_index_t const frame_offset);
+}  // namespace oscillator
+}  // namespace yas::proc
+
+namespace yas {
+void connect(proc::module_ptr const &, proc::oscillator::output const &, proc::channel_index_t const &);
+
+[[nodiscard]] std::string to_string(proc::oscillator::output const &);
+}  // namespace yas
+
+std::ostream &operator<<(std::ostream &, yas::proc::oscillator::output const &);
@@ -74,7 +74,7 @@ proc::module_ptr proc::make_signal_module(proc::routing::kind const kind) {
         return processors;
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_signal_module<double>(proc::routing::kind const);
@@ -137,7 +137,7 @@ proc::module_ptr proc::make_number_module(routing::kind const kind) {
         return processors;
     };
 
-    return proc::module::make_shared(std::move(make_processors));
+    return proc::module::make_shared(std::move(make_processors), module_state::stateless);
 }
 
 template proc::module_ptr proc::make_number_module<double>(proc::routing::kind const);
@@ -33,7 +33,7 @@ proc::module_ptr proc::make_module(timeline_ptr const &timeline, frame_index_t c
     auto make_processors = [context = std::move(context), offset] {
         auto processor = [context, offset](time::range const &time_range, connector_map_t const &input_connectors,
                                            connector_map_t const &output_connectors, stream &stream) mutable {
-            proc::stream sub_stream{stream.sync_source()};
+            proc::stream sub_stream{stream.sync_source(), stream.signal_event_pool()};
 
             for (auto const &connector : input_connectors) {
                 auto const &ch_idx = connector.second.channel_index;
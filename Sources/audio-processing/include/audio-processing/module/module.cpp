@@ -13,16 +13,20 @@ using namespace yas::proc;
 #pragma mark - utility
 
 namespace yas::proc {
-static void connect(connector_map_t &connectors, connector_index_t const idx, channel_index_t const ch_idx) {
+static void connect(connector_map_t &connectors, connector_index_t const idx, channel_index_t const ch_idx,
+                    uint64_t &generation) {
     if (connectors.count(idx) == 0) {
         connectors.erase(idx);
     }
-    connectors.emplace(idx, connector{.channel_index = ch_idx});
+    if (connectors.emplace(idx, connector{.channel_index = ch_idx}).second) {
+        ++generation;
+    }
 }
 
-static void disconnect(connector_map_t &connectors, connector_index_t const idx) {
+static void disconnect(connector_map_t &connectors, connector_index_t const idx, uint64_t &generation) {
     if (connectors.count(idx) > 0) {
         connectors.erase(idx);
+        ++generation;
     }
 }
 }  // namespace yas::proc
@@ -30,11 +34,12 @@ static void disconnect(connector_map_t &connectors, connector_index_t const idx)
 #pragma mark - module
 
 proc::module::module(make_processors_t &&handler, connector_map_t &&input_connectors,
-                     connector_map_t &&output_connectors)
+                     connector_map_t &&output_connectors, module_state const state)
     : _make_handler(std::move(handler)),
       _processors(_make_handler()),
       _input_connectors(std::move(input_connectors)),
-      _output_connectors(std::move(output_connectors)) {
+      _output_connectors(std::move(output_connectors)),
+      _state(state) {
 }
 
 void proc::module::process(time::range const &time_range, stream &stream) {
@@ -54,38 +59,56 @@ proc::connector_map_t const &proc::module::output_connectors() const {
 }
 
 void proc::module::connect_input(connector_index_t const co_idx, channel_index_t const ch_idx) {
-    connect(this->_input_connectors, co_idx, ch_idx);
+    connect(this->_input_connectors, co_idx, ch_idx, this->_connector_generation);
 }
 
 void proc::module::connect_output(connector_index_t const co_idx, channel_index_t const ch_idx) {
-    connect(this->_output_connectors, co_idx, ch_idx);
+    connect(this->_output_connectors, co_idx, ch_idx, this->_connector_generation);
 }
 
 void proc::module::disconnect_input(connector_index_t const idx) {
-    disconnect(this->_input_connectors, idx);
+    disconnect(this->_input_connectors, idx, this->_connector_generation);
 }
 
 void proc::module::disconnect_output(connector_index_t const idx) {
-    disconnect(this->_output_connectors, idx);
+    disconnect(this->_output_connectors, idx, this->_connector_generation);
 }
 
 proc::module::processors_t const &proc::module::processors() const {
     return this->_processors;
 }
 
+proc::module_state proc::module::state() const {
+    return this->_state;
+}
+
 proc::module_ptr proc::module::copy() const {
     if (!this->_make_handler) {
         throw std::runtime_error("make_handler is null.");
     }
-    return module::make_shared(this->_make_handler, this->_input_connectors, this->_output_connectors);
+    return module::make_shared(this->_make_handler, this->_input_connectors, this->_output_connectors,
+                               this->_state);
+}
+
+uint64_t proc::module::connector_generation() const {
+    return this->_connector_generation;
 }
 
 proc::module_ptr proc::module::make_shared(make_processors_t handler) {
-    return make_shared(std::move(handler), {}, {});
+    return make_shared(std::move(handler), module_state::stateful);
+}
+
+proc::module_ptr proc::module::make_shared(make_processors_t handler, module_state const state) {
+    return make_shared(std::move(handler), {}, {}, state);
 }
 
 proc::module_ptr proc::module::make_shared(make_processors_t handler, connector_map_t inputs, connector_map_t outputs) {
-    return module_ptr(new module{std::move(handler), std::move(inputs), std::move(outputs)});
+    return make_shared(std::move(handler), std::move(inputs), std::move(outputs), module_state::stateful);
+}
+
+proc::module_ptr proc::module::make_shared(make_processors_t handler, connector_map_t inputs, connector_map_t outputs,
+                                           module_state const state) {
+    return module_ptr(new module{std::move(handler), std::move(inputs), std::move(outputs), state});
 }
 
 std::vector<proc::module_ptr> proc::copy(std::vector<proc::module_ptr> const &modules) {
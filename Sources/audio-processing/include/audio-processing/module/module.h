@@ -13,6 +13,14 @@
 #include <vector>
 
 namespace yas::proc {
+/// タイムラインを区切って別々に処理しても、通して処理したときと結果が変わるか
+enum class module_state {
+    /// 前のスライスで受け取った値を後のスライスへ持ち越す
+    stateful,
+    /// 各スライスの入力だけで出力が決まる
+    stateless,
+};
+
 struct module final {
     using processors_t = std::vector<processor_f>;
     using make_processors_t = std::function<std::vector<processor_f>()>;
@@ -27,20 +35,30 @@ struct module final {
     void disconnect_output(connector_index_t const);
 
     [[nodiscard]] processors_t const &processors() const;
+    [[nodiscard]] module_state state() const;
 
     [[nodiscard]] module_ptr copy() const;
 
+    /// このmoduleのconnectorが変更されるたびに増える。module_set_planの作り直しの判定に使う
+    [[nodiscard]] uint64_t connector_generation() const;
+
     [[nodiscard]] static module_ptr make_shared(make_processors_t);
+    [[nodiscard]] static module_ptr make_shared(make_processors_t, module_state const);
     [[nodiscard]] static module_ptr make_shared(make_processors_t, connector_map_t input_connectors,
                                                 connector_map_t output_connectors);
+    [[nodiscard]] static module_ptr make_shared(make_processors_t, connector_map_t input_connectors,
+                                                connector_map_t output_connectors, module_state const);
 
    private:
     make_processors_t const _make_handler;
     processors_t const _processors;
     connector_map_t _input_connectors;
     connector_map_t _output_connectors;
+    module_state const _state;
+    uint64_t _connector_generation = 0;
 
-    module(make_processors_t &&, connector_map_t &&input_connectors, connector_map_t &&output_connectors);
+    module(make_processors_t &&, connector_map_t &&input_connectors, connector_map_t &&output_connectors,
+           module_state const);
 };
 
 using module_vector_t = std::vector<module_ptr>;
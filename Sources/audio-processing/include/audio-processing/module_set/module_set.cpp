@@ -26,16 +26,23 @@ module_ptr const &module_set::at(std::size_t const idx) {
     return this->_modules_holder->at(idx);
 }
 
+uint64_t module_set::generation() const {
+    return this->_generation;
+}
+
 void module_set::push_back(module_ptr const &module) {
+    ++this->_generation;
     this->_modules_holder->push_back(module);
 }
 
 void module_set::insert(module_ptr const &module, std::size_t const idx) {
+    ++this->_generation;
     this->_modules_holder->insert(module, idx);
 }
 
 bool module_set::erase(std::size_t const idx) {
     if (idx < this->_modules_holder->size()) {
+        ++this->_generation;
         this->_modules_holder->erase(idx);
         return true;
     } else {
@@ -11,6 +11,8 @@ struct module_set final {
     [[nodiscard]] module_vector_t const &modules() const;
     [[nodiscard]] std::size_t size() const;
     [[nodiscard]] module_ptr const &at(std::size_t const);
+    /// moduleが追加や削除されるたびに、変更を通知する前に増える
+    [[nodiscard]] uint64_t generation() const;
 
     void push_back(module_ptr const &);
     void insert(module_ptr const &, std::size_t const);
@@ -26,6 +28,7 @@ struct module_set final {
 
    private:
     module_vector_holder_ptr_t _modules_holder;
+    uint64_t _generation = 0;
 
     module_set(module_vector_t &&);
 };
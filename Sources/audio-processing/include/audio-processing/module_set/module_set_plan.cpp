@@ -0,0 +1,119 @@
+//
+//  module_set_plan.cpp
+//
+
+#include "module_set_plan.h"
+
+#include <audio-processing/channel/channel.h>
+#include <audio-processing/module/module.h>
+#include <audio-processing/module_set/module_set.h>
+#include <audio-processing/stream/stream.h>
+
+#include <algorithm>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::module_set_plan_utils {
+static std::vector<channel_index_t> input_channels(input_processor const &processor, connector_map_t const &inputs) {
+    std::vector<channel_index_t> channels;
+
+    for (auto const &connector_pair : inputs) {
+        auto const &indices = processor.connector_indices;
+        if (indices.has_value() && indices->count(connector_pair.first) == 0) {
+            continue;
+        }
+
+        auto const &ch_idx = connector_pair.second.channel_index;
+        if (std::find(channels.begin(), channels.end(), ch_idx) == channels.end()) {
+            channels.emplace_back(ch_idx);
+        }
+    }
+
+    return channels;
+}
+
+static bool has_events(stream &stream, std::vector<channel_index_t> const &channels) {
+    for (auto const &ch_idx : channels) {
+        if (stream.has_channel(ch_idx) && !stream.channel(ch_idx).events().empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace yas::proc::module_set_plan_utils
+
+module_set_plan::module_set_plan(module_set_ptr const &module_set)
+    : _module_set(module_set),
+      _modules(module_set->modules()),
+      _generation(module_set->generation()) {
+    std::size_t count = 0;
+    this->_connector_generations.reserve(this->_modules.size());
+
+    for (auto const &module : this->_modules) {
+        count += module->processors().size();
+        this->_connector_generations.emplace_back(module->connector_generation());
+    }
+
+    this->_steps.reserve(count);
+
+    for (auto const &module : this->_modules) {
+        auto const &inputs = module->input_connectors();
+        auto const &outputs = module->output_connectors();
+
+        for (auto const &processor : module->processors()) {
+            if (!processor) {
+                continue;
+            }
+
+            if (auto const *input_processor = processor.target<proc::input_processor>()) {
+                auto channels = module_set_plan_utils::input_channels(*input_processor, inputs);
+                // 読むチャンネルが繋がっていなければ何もしないので並べない
+                if (channels.empty()) {
+                    continue;
+                }
+
+                this->_steps.emplace_back(step{.processor = &input_processor->handler,
+                                               .inputs = &inputs,
+                                               .outputs = &outputs,
+                                               .input_channels = std::move(channels)});
+            } else {
+                this->_steps.emplace_back(step{
+                    .processor = &processor, .inputs = &inputs, .outputs = &outputs, .input_channels = std::nullopt});
+            }
+        }
+    }
+}
+
+module_set_ptr const &module_set_plan::module_set() const {
+    return this->_module_set;
+}
+
+std::vector<module_set_plan::step> const &module_set_plan::steps() const {
+    return this->_steps;
+}
+
+bool module_set_plan::is_outdated() const {
+    if (this->_generation != this->_module_set->generation()) {
+        return true;
+    }
+
+    // module_setのmoduleが変わっていなければ、_modulesは今のmoduleと同じ並び
+    for (std::size_t idx = 0; idx < this->_modules.size(); ++idx) {
+        if (this->_modules.at(idx)->connector_generation() != this->_connector_generations.at(idx)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void module_set_plan::process(time::range const &time_range, stream &stream) const {
+    for (auto const &step : this->_steps) {
+        if (step.input_channels.has_value() && !module_set_plan_utils::has_events(stream, *step.input_channels)) {
+            continue;
+        }
+
+        (*step.processor)(time_range, *step.inputs, *step.outputs, stream);
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  module_set_plan.h
+//
+
+#pragma once
+
+#include <audio-processing/connector/connector.h>
+#include <audio-processing/module_set/module_set_types.h>
+#include <audio-processing/processor/processor.h>
+#include <audio-processing/time/time.h>
+
+#include <optional>
+#include <vector>
+
+namespace yas::proc {
+class stream;
+
+/// module_setに含まれるprocessorを実行する順に並べておき、moduleやmodule_setを辿らずに処理する
+/// input_processorは読むチャンネルを前もって解決しておき、読むものが無いstepは省く
+/// module_setのmoduleや、含まれるmoduleのconnectorが変更されたら作り直す必要がある
+struct module_set_plan final {
+    struct step {
+        processor_f const *processor;
+        connector_map_t const *inputs;
+        connector_map_t const *outputs;
+        /// input_processorの読むチャンネル。どれにもイベントが無ければ呼び出さない。nulloptなら必ず呼び出す
+        std::optional<std::vector<channel_index_t>> input_channels;
+    };
+
+    explicit module_set_plan(module_set_ptr const &);
+
+    [[nodiscard]] module_set_ptr const &module_set() const;
+    [[nodiscard]] std::vector<step> const &steps() const;
+    /// 作った後にmodule_setのmoduleか、含まれるmoduleのconnectorが変更されていたらtrue
+    [[nodiscard]] bool is_outdated() const;
+
+    /// module_setのmoduleを順番にprocessしたのと同じ結果になる
+    void process(time::range const &, stream &) const;
+
+   private:
+    module_set_ptr _module_set;
+    // stepが指しているprocessorとconnectorを保持しておく
+    module_vector_t _modules;
+    std::vector<step> _steps;
+    uint64_t _generation;
+    // _modulesと同じ順に、作ったときのconnectorの世代を持っておく
+    std::vector<uint64_t> _connector_generations;
+};
+}  // namespace yas::proc
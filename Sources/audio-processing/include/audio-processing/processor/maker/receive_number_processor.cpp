@@ -14,7 +14,7 @@ using namespace yas::proc;
 
 template <typename T>
 proc::processor_f proc::make_receive_number_processor(proc::receive_number_process_f<T> handler) {
-    return
+    auto processor =
         [handler = std::move(handler)](time::range const &current_time_range, connector_map_t const &input_connectors,
                                        connector_map_t const &, stream &stream) {
             if (handler) {
@@ -26,9 +26,7 @@ proc::processor_f proc::make_receive_number_processor(proc::receive_number_proce
 
                     if (stream.has_channel(ch_idx)) {
                         auto const &channel = stream.channel(ch_idx);
-                        auto const filtered_events = channel.filtered_events<T, proc::number_event>();
-
-                        for (auto const &pair : filtered_events) {
+                        for (auto const &pair : channel.filtered_view<T, proc::number_event>(current_time_range)) {
                             auto const &event_frame = pair.first;
                             if (current_time_range.is_contain(event_frame)) {
                                 number_event_ptr const &number_event = pair.second;
@@ -40,6 +38,8 @@ proc::processor_f proc::make_receive_number_processor(proc::receive_number_proce
                 }
             }
         };
+
+    return input_processor{.handler = std::move(processor)};
 }
 
 template proc::processor_f proc::make_receive_number_processor(proc::receive_number_process_f<double>);
@@ -15,7 +15,7 @@ using namespace yas::proc;
 
 template <typename T>
 proc::processor_f proc::make_receive_signal_processor(proc::receive_signal_process_f<T> handler) {
-    return
+    auto processor =
         [handler = std::move(handler)](time::range const &current_time_range, connector_map_t const &input_connectors,
                                        connector_map_t const &, stream &stream) {
             if (handler) {
@@ -27,9 +27,7 @@ proc::processor_f proc::make_receive_signal_processor(proc::receive_signal_proce
 
                     if (stream.has_channel(ch_idx)) {
                         auto const &channel = stream.channel(ch_idx);
-                        auto const filtered_events = channel.filtered_events<T, proc::signal_event>();
-
-                        for (auto const &pair : filtered_events) {
+                        for (auto const &pair : channel.filtered_view<T, proc::signal_event>(current_time_range)) {
                             auto const &event_time_range = pair.first;
                             if (auto const time_range_opt = current_time_range.intersected(event_time_range)) {
                                 auto const &time_range = *time_range_opt;
@@ -43,6 +41,8 @@ proc::processor_f proc::make_receive_signal_processor(proc::receive_signal_proce
                 }
             }
         };
+
+    return input_processor{.handler = std::move(processor)};
 }
 
 template proc::processor_f proc::make_receive_signal_processor(proc::receive_signal_process_f<double>);
@@ -15,8 +15,8 @@ using namespace yas::proc;
 
 template <typename T>
 proc::processor_f proc::make_remove_number_processor(connector_index_set_t keys) {
-    return [keys = std::move(keys)](time::range const &time_range, connector_map_t const &input_connectors,
-                                    connector_map_t const &, stream &stream) {
+    auto processor = [keys](time::range const &time_range, connector_map_t const &input_connectors,
+                            connector_map_t const &, stream &stream) {
         for (auto const &connector_pair : input_connectors) {
             if (keys.count(connector_pair.first) == 0) {
                 continue;
@@ -45,6 +45,8 @@ proc::processor_f proc::make_remove_number_processor(connector_index_set_t keys)
             }
         }
     };
+
+    return input_processor{.handler = std::move(processor), .connector_indices = std::move(keys)};
 }
 
 template proc::processor_f proc::make_remove_number_processor<double>(connector_index_set_t);
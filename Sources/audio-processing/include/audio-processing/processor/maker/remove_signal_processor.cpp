@@ -14,8 +14,8 @@ using namespace yas::proc;
 
 template <typename T>
 proc::processor_f proc::make_remove_signal_processor(connector_index_set_t keys) {
-    return [keys = std::move(keys)](time::range const &current_time_range, connector_map_t const &input_connectors,
-                                    connector_map_t const &, stream &stream) {
+    auto processor = [keys](time::range const &current_time_range, connector_map_t const &input_connectors,
+                            connector_map_t const &, stream &stream) {
         for (auto const &connector_pair : input_connectors) {
             if (keys.count(connector_pair.first) == 0) {
                 continue;
@@ -32,23 +32,26 @@ proc::processor_f proc::make_remove_signal_processor(connector_index_set_t keys)
                     return event_time_range.is_overlap(current_time_range);
                 };
 
-                auto const filtered_events = channel.filtered_events<T, signal_event>(predicate);
-
                 std::vector<std::pair<time::range, signal_event_ptr>> cropped_signals;
 
-                for (auto const &event_pair : filtered_events) {
+                for (auto const &event_pair : channel.filtered_view<T, signal_event>(current_time_range)) {
+                    if (!predicate(event_pair)) {
+                        continue;
+                    }
+
                     auto const &src_frame = event_pair.first.frame;
                     auto const cropped_ranges = event_pair.first.cropped(current_time_range);
                     signal_event_ptr const &src_signal = event_pair.second;
                     for (auto const &cropped_range : cropped_ranges) {
-                        signal_event_ptr dst_signal = signal_event::make_shared<T>(cropped_range.length);
+                        signal_event_ptr dst_signal =
+                            signal_event::make_shared<T>(cropped_range.length, stream.signal_event_pool());
                         auto const *src_ptr = &src_signal->data<T>()[cropped_range.frame - src_frame];
                         dst_signal->copy_from(src_ptr, cropped_range.length);
                         cropped_signals.emplace_back(std::make_pair(cropped_range, std::move(dst_signal)));
                     }
                 }
 
-                channel.erase_event<T, signal_event>(std::move(predicate));
+                channel.erase_event<T, signal_event>(current_time_range, std::move(predicate));
 
                 for (auto const &pair : cropped_signals) {
                     channel.insert_event(time{pair.first}, pair.second);
@@ -56,6 +59,8 @@ proc::processor_f proc::make_remove_signal_processor(connector_index_set_t keys)
             }
         }
     };
+
+    return input_processor{.handler = std::move(processor), .connector_indices = std::move(keys)};
 }
 
 template proc::processor_f proc::make_remove_signal_processor<double>(connector_index_set_t);
@@ -24,10 +24,9 @@ proc::processor_f proc::make_send_signal_processor(proc::send_signal_process_f<T
 
                 auto const &ch_idx = connector.channel_index;
                 auto &channel = stream.add_channel(ch_idx);
+                auto const &pool = stream.signal_event_pool();
 
                 if (channel.events().size() > 0) {
-                    proc::time::range combined_time_range = current_time_range;
-
                     auto predicate = [&current_time_range](auto const &pair) {
                         if (pair.first.can_combine(current_time_range)) {
                             return true;
@@ -35,40 +34,50 @@ proc::processor_f proc::make_send_signal_processor(proc::send_signal_process_f<T
                         return false;
                     };
 
-                    auto const filtered_events = channel.filtered_events<T, signal_event>(predicate);
+                    auto const candidates = channel.filtered_view<T, signal_event>(current_time_range);
 
-                    if (filtered_events.size() > 0) {
-                        for (auto const &pair : filtered_events) {
+                    proc::time::range combined_time_range = current_time_range;
+                    bool is_combined = false;
+
+                    for (auto const &pair : candidates) {
+                        if (predicate(pair)) {
                             combined_time_range = *combined_time_range.combined(pair.first);
+                            is_combined = true;
                         }
+                    }
 
-                        std::vector<T> vec(combined_time_range.length);
-                        for (auto const &pair : filtered_events) {
-                            auto const &time_range = pair.first;
-                            auto const length = time_range.length;
-                            auto const dst_idx = time_range.frame - combined_time_range.frame;
-                            auto *dst_ptr = &vec[dst_idx];
-                            signal_event_ptr const &signal = pair.second;
-                            signal->copy_to<T>(dst_ptr, length);
+                    if (is_combined) {
+                        signal_event_ptr combined_signal =
+                            signal_event::make_shared<T>(combined_time_range.length, pool);
+                        auto *const combined_ptr = combined_signal->data<T>();
+
+                        for (auto const &pair : candidates) {
+                            if (predicate(pair)) {
+                                auto const &time_range = pair.first;
+                                auto const length = time_range.length;
+                                auto const dst_idx = time_range.frame - combined_time_range.frame;
+                                auto *dst_ptr = &combined_ptr[dst_idx];
+                                signal_event_ptr const &signal = pair.second;
+                                signal->copy_to<T>(dst_ptr, length);
+                            }
                         }
 
-                        channel.erase_event<T, signal_event>(std::move(predicate));
+                        channel.erase_event<T, signal_event>(current_time_range, std::move(predicate));
 
                         handler(current_time_range, stream.sync_source(), ch_idx, co_idx,
-                                &vec[current_time_range.frame - combined_time_range.frame]);
+                                &combined_ptr[current_time_range.frame - combined_time_range.frame]);
 
-                        channel.insert_event(time{combined_time_range},
-                                             proc::signal_event::make_shared(std::move(vec)));
+                        channel.insert_event(time{combined_time_range}, std::move(combined_signal));
 
                         continue;
                     }
                 }
 
-                std::vector<T> vec(current_time_range.length);
+                signal_event_ptr signal = signal_event::make_shared<T>(current_time_range.length, pool);
 
-                handler(current_time_range, stream.sync_source(), ch_idx, co_idx, vec.data());
+                handler(current_time_range, stream.sync_source(), ch_idx, co_idx, signal->data<T>());
 
-                channel.insert_event(time{current_time_range}, signal_event::make_shared(std::move(vec)));
+                channel.insert_event(time{current_time_range}, std::move(signal));
             }
         }
     };
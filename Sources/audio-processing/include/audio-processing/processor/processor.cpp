@@ -0,0 +1,13 @@
+//
+//  processor.cpp
+//
+
+#include "processor.h"
+
+using namespace yas;
+using namespace yas::proc;
+
+void input_processor::operator()(time::range const &time_range, connector_map_t const &inputs,
+                                 connector_map_t const &outputs, stream &stream) const {
+    this->handler(time_range, inputs, outputs, stream);
+}
@@ -4,14 +4,27 @@
 
 #pragma once
 
+#include <audio-processing/common/common_types.h>
 #include <audio-processing/connector/connector.h>
 #include <audio-processing/time/time.h>
 
 #include <functional>
+#include <optional>
 
 namespace yas::proc {
 class stream;
 
 using processor_f =
     std::function<void(time::range const &, connector_map_t const &inputs, connector_map_t const &outputs, stream &)>;
+
+/// 入力のチャンネルのイベントだけを扱い、読むチャンネルにイベントが無ければ何もしないprocessor
+/// module_set_planは読むチャンネルを前もって解決しておき、どれにもイベントが無ければ呼び出さない
+struct input_processor final {
+    processor_f handler;
+    /// 読む入力のコネクタ。nulloptなら入力のすべて
+    std::optional<connector_index_set_t> connector_indices = std::nullopt;
+
+    void operator()(time::range const &, connector_map_t const &inputs, connector_map_t const &outputs,
+                    stream &) const;
+};
 }  // namespace yas::proc
@@ -19,16 +19,26 @@ proc::stream::stream(proc::sync_source const &sync_src) : _sync_source(sync_src)
 proc::stream::stream(proc::sync_source &&sync_src) : _sync_source(std::move(sync_src)) {
 }
 
-proc::stream::stream(stream &&other) : _sync_source(std::move(other._sync_source)) {
+proc::stream::stream(proc::sync_source const &sync_src, signal_event_pool_ptr const &pool)
+    : _sync_source(sync_src), _signal_event_pool(pool) {
 }
 
-proc::stream::stream(stream const &other) : _sync_source(other._sync_source) {
+proc::stream::stream(stream &&other)
+    : _sync_source(std::move(other._sync_source)), _signal_event_pool(other._signal_event_pool) {
+}
+
+proc::stream::stream(stream const &other)
+    : _sync_source(other._sync_source), _signal_event_pool(other._signal_event_pool) {
 }
 
 proc::sync_source const &proc::stream::sync_source() const {
     return this->_sync_source;
 }
 
+proc::signal_event_pool_ptr const &proc::stream::signal_event_pool() const {
+    return this->_signal_event_pool;
+}
+
 proc::channel &proc::stream::add_channel(channel_index_t const ch_idx) {
     auto &channels = this->_channels;
     if (channels.count(ch_idx) == 0) {
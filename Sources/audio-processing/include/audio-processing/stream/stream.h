@@ -6,6 +6,7 @@
 
 #include <audio-processing/channel/channel.h>
 #include <audio-processing/common/common_types.h>
+#include <audio-processing/common/ptr.h>
 #include <audio-processing/sync_source/sync_source.h>
 #include <audio-processing/time/time.h>
 
@@ -13,11 +14,13 @@ namespace yas::proc {
 struct stream final {
     explicit stream(sync_source const &);
     explicit stream(sync_source &&);
+    stream(sync_source const &, signal_event_pool_ptr const &);
 
     stream(stream &&);
     stream(stream const &);
 
     [[nodiscard]] sync_source const &sync_source() const;
+    [[nodiscard]] signal_event_pool_ptr const &signal_event_pool() const;
 
     proc::channel &add_channel(channel_index_t const);
     proc::channel &add_channel(channel_index_t const, channel::events_map_t);
@@ -30,6 +33,7 @@ struct stream final {
 
    private:
     proc::sync_source _sync_source;
+    signal_event_pool_ptr const _signal_event_pool;
     std::map<channel_index_t, proc::channel> _channels;
 
     stream &operator=(stream &&) = delete;
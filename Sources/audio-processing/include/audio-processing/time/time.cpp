@@ -148,64 +148,30 @@ bool proc::time::any::operator!=(time::any const &) const {
     return false;
 }
 
-#pragma mark - time::impl
-
-struct proc::time::impl_base {
-    virtual std::type_info const &type() const = 0;
-    virtual bool is_equal(std::shared_ptr<impl_base> const &) const = 0;
-};
-
-template <typename T>
-struct proc::time::impl : impl_base {
-    typename T::type _value;
-
-    impl(typename T::type const &val) : _value(val) {
-    }
-
-    impl(typename T::type &&val) : _value(std::move(val)) {
-    }
-
-    virtual bool is_equal(std::shared_ptr<impl_base> const &rhs) const override {
-        if (auto casted_rhs = std::dynamic_pointer_cast<impl>(rhs)) {
-            auto const &type_info = typeid(T);
-            if (type_info == casted_rhs->type()) {
-                return this->_value == casted_rhs->_value;
-            }
-        }
-
-        return false;
-    }
-
-    std::type_info const &type() const override {
-        return typeid(T);
-    }
-};
-
 #pragma mark - proc::time
 
-proc::time::time(frame_index_t const frame, length_t const length)
-    : _impl(std::make_shared<impl<time::range>>(time::range{frame, length})) {
+proc::time::time(frame_index_t const frame, length_t const length) : _value(time::range{frame, length}) {
 }
 
-proc::time::time(range range) : _impl(std::make_shared<impl<time::range>>(std::move(range))) {
+proc::time::time(range range) : _value(std::move(range)) {
 }
 
-proc::time::time(frame_index_t const frame) : _impl(std::make_shared<impl<time::frame>>(frame)) {
+proc::time::time(frame_index_t const frame) : _value(std::in_place_type<frame::type>, frame) {
 }
 
-proc::time::time() : _impl(any_impl_ptr()) {
+proc::time::time() : _value(time::any{}) {
 }
 
-proc::time::time(std::nullptr_t) : _impl(nullptr) {
+proc::time::time(std::nullptr_t) : _value(nullptr) {
 }
 
 proc::time &proc::time::operator=(time::range const &range) {
-    this->_impl = std::make_shared<impl<time::range>>(range);
+    this->_value = range;
     return *this;
 }
 
 proc::time &proc::time::operator=(time::range &&range) {
-    this->_impl = std::make_shared<impl<time::range>>(std::move(range));
+    this->_value = std::move(range);
     return *this;
 }
 
@@ -238,19 +204,27 @@ bool proc::time::operator<(time const &rhs) const {
 }
 
 std::type_info const &proc::time::type() const {
-    return this->_impl->type();
+    if (this->is_range_type()) {
+        return typeid(range);
+    } else if (this->is_frame_type()) {
+        return typeid(frame);
+    } else if (this->is_any_type()) {
+        return typeid(any);
+    }
+
+    throw "unreachable code.";
 }
 
 bool proc::time::is_range_type() const {
-    return this->type() == typeid(range);
+    return std::holds_alternative<range::type>(this->_value);
 }
 
 bool proc::time::is_frame_type() const {
-    return this->type() == typeid(frame);
+    return std::holds_alternative<frame::type>(this->_value);
 }
 
 bool proc::time::is_any_type() const {
-    return this->type() == typeid(any);
+    return std::holds_alternative<any::type>(this->_value);
 }
 
 bool proc::time::is_contain(time const &rhs) const {
@@ -270,19 +244,6 @@ bool proc::time::is_contain(time const &rhs) const {
     }
 }
 
-template <typename T>
-typename T::type const &proc::time::get() const {
-    if (auto ip = std::dynamic_pointer_cast<impl<T>>(this->_impl)) {
-        return ip->_value;
-    }
-
-    throw "unreachable code.";
-}
-
-template proc::time::range::type const &proc::time::get<proc::time::range>() const;
-template proc::time::frame::type const &proc::time::get<proc::time::frame>() const;
-template proc::time::any::type const &proc::time::get<proc::time::any>() const;
-
 proc::time proc::time::offset(frame_index_t const &offset) const {
     if (offset == 0 || this->is_any_type()) {
         return *this;
@@ -296,11 +257,11 @@ proc::time proc::time::offset(frame_index_t const &offset) const {
 }
 
 proc::time::operator bool() const {
-    return this->_impl != nullptr;
+    return !std::holds_alternative<std::nullptr_t>(this->_value);
 }
 
 bool proc::time::operator==(proc::time const &rhs) const {
-    return this->_impl->is_equal(rhs._impl);
+    return this->_value == rhs._value;
 }
 
 bool proc::time::operator!=(proc::time const &rhs) const {
@@ -333,13 +294,6 @@ std::ostream &operator<<(std::ostream &os, yas::proc::time::range const &value)
     return os;
 }
 
-#pragma mark - private
-
-std::shared_ptr<proc::time::impl<proc::time::any>> const &proc::time::any_impl_ptr() {
-    static auto impl_ptr = std::make_shared<time::impl<time::any>>(time::any{});
-    return impl_ptr;
-}
-
 #pragma mark - make
 
 proc::time proc::make_range_time(frame_index_t const frame, length_t const length) {
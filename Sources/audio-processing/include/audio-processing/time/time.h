@@ -10,15 +10,11 @@
 #include <optional>
 #include <ostream>
 #include <typeinfo>
+#include <variant>
 #include <vector>
 
 namespace yas::proc {
 struct time {
-    template <typename T>
-    class impl;
-
-    class impl_base;
-
     struct frame {
         using type = frame_index_t;
     };
@@ -84,11 +80,11 @@ struct time {
     bool operator!=(time const &) const;
 
    private:
-    static std::shared_ptr<proc::time::impl<time::any>> const &any_impl_ptr();
-
-    std::shared_ptr<impl_base> _impl;
+    std::variant<std::nullptr_t, any, frame::type, range> _value;
 };
 
+static_assert(std::is_trivially_copyable_v<time>);
+
 [[nodiscard]] time make_range_time(frame_index_t const, length_t const);
 [[nodiscard]] time make_frame_time(frame_index_t const);
 [[nodiscard]] time make_any_time();
@@ -101,3 +97,5 @@ namespace yas {
 
 std::ostream &operator<<(std::ostream &, yas::proc::time const &);
 std::ostream &operator<<(std::ostream &, yas::proc::time::range const &);
+
+#include "time_private.h"
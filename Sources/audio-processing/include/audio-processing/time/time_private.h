@@ -0,0 +1,16 @@
+//
+//  time_private.h
+//
+
+#pragma once
+
+namespace yas {
+template <typename T>
+typename T::type const &proc::time::get() const {
+    if (auto const *value = std::get_if<typename T::type>(&this->_value)) {
+        return *value;
+    }
+
+    throw "unreachable code.";
+}
+}  // namespace yas
@@ -4,11 +4,14 @@
 
 #include "timeline.h"
 
+#include <audio-processing/event/signal_event_pool.h>
 #include <audio-processing/stream/stream.h>
 #include <audio-processing/sync_source/sync_source.h>
 #include <audio-processing/timeline/timeline_utils.h>
 #include <audio-processing/track/track.h>
 
+#include <audio-engine/utils/worker_pool.h>
+
 using namespace yas;
 using namespace yas::proc;
 
@@ -100,6 +103,15 @@ void timeline::process(time::range const &time_range, stream &stream) {
 }
 
 void timeline::process(time::range const &range, sync_source const &sync_src, process_f const &handler) {
+    this->process(range, sync_src, handler, nullptr);
+}
+
+void timeline::process(time::range const &range, sync_source const &sync_src, process_track_f const &handler) {
+    this->_process_continuously(range, sync_src, handler, nullptr);
+}
+
+void timeline::process(time::range const &range, sync_source const &sync_src, process_f const &handler,
+                       audio::worker_pool_ptr const &worker_pool) {
     this->_process_continuously(
         range, sync_src,
         [&handler](time::range const &range, stream const &stream, std::optional<track_index_t> const &trk_idx) {
@@ -107,11 +119,13 @@ void timeline::process(time::range const &range, sync_source const &sync_src, pr
                 return handler(range, stream);
             }
             return continuation::keep;
-        });
+        },
+        worker_pool);
 }
 
-void timeline::process(time::range const &range, sync_source const &sync_src, process_track_f const &handler) {
-    this->_process_continuously(range, sync_src, handler);
+void timeline::process(time::range const &range, sync_source const &sync_src, process_track_f const &handler,
+                       audio::worker_pool_ptr const &worker_pool) {
+    this->_process_continuously(range, sync_src, handler, worker_pool);
 }
 
 observing::syncable timeline::observe(observing_handler_f &&handler) {
@@ -119,20 +133,30 @@ observing::syncable timeline::observe(observing_handler_f &&handler) {
 }
 
 void timeline::_process_continuously(time::range const &range, sync_source const &sync_src,
-                                     process_track_f const &handler) {
+                                     process_track_f const &handler, audio::worker_pool_ptr const &worker_pool) {
     frame_index_t frame = range.frame;
 
+    bool const is_parallel = worker_pool && worker_pool->thread_count() > 0 && this->track_count() > 1 &&
+                             is_tracks_independent(this->tracks());
+
+    // スライスごとのstreamで破棄されたsignalのメモリを次のスライスで再利用する
+    auto const pool = signal_event_pool::make_shared();
+
     while (frame < range.next_frame()) {
         frame_index_t const sync_next_frame = frame + sync_src.slice_length;
         frame_index_t const &end_next_frame = range.next_frame();
 
-        stream stream{sync_src};
+        stream stream{sync_src, pool};
 
         time::range const current_range = time::range{
             frame,
             static_cast<length_t>(sync_next_frame < end_next_frame ? sync_next_frame - frame : end_next_frame - frame)};
 
-        if (this->_process_tracks(current_range, stream, handler) == continuation::abort) {
+        auto const result = is_parallel
+                                ? this->_process_tracks_in_parallel(current_range, stream, handler, worker_pool)
+                                : this->_process_tracks(current_range, stream, handler);
+
+        if (result == continuation::abort) {
             break;
         }
 
@@ -156,6 +180,38 @@ proc::continuation timeline::_process_tracks(time::range const &current_range, s
     return continuation::keep;
 }
 
+proc::continuation timeline::_process_tracks_in_parallel(time::range const &current_range, stream &stream,
+                                                         process_track_f const &handler,
+                                                         audio::worker_pool_ptr const &worker_pool) {
+    auto const &tracks = this->_tracks_holder->elements();
+
+    std::vector<std::pair<track_index_t, track_ptr>> const track_pairs{tracks.begin(), tracks.end()};
+    std::vector<std::optional<proc::stream>> track_streams(track_pairs.size());
+
+    // スライスの始めのstreamは空なので、トラックごとに空のstreamで処理する
+    worker_pool->parallel_for(track_pairs.size(), [&current_range, &stream, &track_pairs, &track_streams](
+                                                      std::size_t const idx) {
+        auto &track_stream = track_streams.at(idx).emplace(stream.sync_source(), stream.signal_event_pool());
+        track_pairs.at(idx).second->process(current_range, track_stream);
+    });
+
+    // トラックの順番にまとめてhandlerを呼ぶ
+    for (std::size_t idx = 0; idx < track_pairs.size(); ++idx) {
+        auto &track_stream = *track_streams.at(idx);
+
+        for (auto const &channel_pair : track_stream.channels()) {
+            auto const &ch_idx = channel_pair.first;
+            stream.add_channel(ch_idx, std::move(track_stream.channel(ch_idx).events()));
+        }
+
+        if (handler(current_range, stream, track_pairs.at(idx).first) == continuation::abort) {
+            return continuation::abort;
+        }
+    }
+
+    return continuation::keep;
+}
+
 void timeline::_push_timeline_event(timeline_event const &event) {
     this->_fetcher->push(event);
 }
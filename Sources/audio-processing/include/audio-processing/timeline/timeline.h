@@ -8,6 +8,7 @@
 #include <audio-processing/timeline/timeline_types.h>
 #include <audio-processing/track/track.h>
 
+#include <audio-engine/common/ptr.h>
 #include <functional>
 #include <optional>
 
@@ -42,6 +43,10 @@ struct timeline final {
     /// スライス分の処理を繰り返す
     void process(time::range const &, sync_source const &, process_f const &);
     void process(time::range const &, sync_source const &, process_track_f const &);
+    /// トラック同士が独立していれば、スライスごとにworker_poolで並列に処理する。独立していなければ順番に処理する
+    /// 結果とhandlerの呼ばれる順番は順番に処理した場合と同じ
+    void process(time::range const &, sync_source const &, process_f const &, audio::worker_pool_ptr const &);
+    void process(time::range const &, sync_source const &, process_track_f const &, audio::worker_pool_ptr const &);
 
     using observing_handler_f = std::function<void(timeline_event const &)>;
     [[nodiscard]] observing::syncable observe(observing_handler_f &&);
@@ -57,8 +62,11 @@ struct timeline final {
 
     timeline(track_map_t &&);
 
-    void _process_continuously(time::range const &range, sync_source const &sync_src, process_track_f const &handler);
+    void _process_continuously(time::range const &range, sync_source const &sync_src, process_track_f const &handler,
+                               audio::worker_pool_ptr const &);
     continuation _process_tracks(time::range const &, stream &, process_track_f const &);
+    continuation _process_tracks_in_parallel(time::range const &, stream &, process_track_f const &,
+                                             audio::worker_pool_ptr const &);
     void _push_timeline_event(timeline_event const &);
     void _observe_track(track_index_t const &);
     void _observe_all_tracks();
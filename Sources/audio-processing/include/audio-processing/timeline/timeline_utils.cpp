@@ -4,8 +4,12 @@
 
 #include "timeline_utils.h"
 
+#include <audio-processing/module/module.h>
+#include <audio-processing/module_set/module_set.h>
 #include <audio-processing/track/track.h>
 
+#include <set>
+
 using namespace yas;
 using namespace yas::proc;
 
@@ -45,3 +49,61 @@ std::optional<proc::time::range> proc::total_range(std::map<track_index_t, track
 
     return result;
 }
+
+bool proc::is_tracks_independent(timeline_track_map_t const &tracks) {
+    struct channel_usage {
+        std::set<track_index_t> tracks;
+        bool is_written = false;
+    };
+
+    std::map<channel_index_t, channel_usage> usages;
+    std::map<module const *, track_index_t> module_tracks;
+
+    for (auto const &track_pair : tracks) {
+        auto const &trk_idx = track_pair.first;
+
+        for (auto const &module_set_pair : track_pair.second->module_sets()) {
+            for (auto const &module : module_set_pair.second->modules()) {
+                // 同じモジュールを複数のトラックで使っていると状態を共有してしまう
+                auto const [iterator, is_inserted] = module_tracks.emplace(module.get(), trk_idx);
+                if (!is_inserted && iterator->second != trk_idx) {
+                    return false;
+                }
+
+                // inputもremove系のプロセッサで書き換えられることがある
+                for (auto const &connector_pair : module->input_connectors()) {
+                    usages[connector_pair.second.channel_index].tracks.insert(trk_idx);
+                }
+
+                for (auto const &connector_pair : module->output_connectors()) {
+                    auto &usage = usages[connector_pair.second.channel_index];
+                    usage.tracks.insert(trk_idx);
+                    usage.is_written = true;
+                }
+            }
+        }
+    }
+
+    for (auto const &usage_pair : usages) {
+        auto const &usage = usage_pair.second;
+        if (usage.is_written && usage.tracks.size() > 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool proc::is_tracks_stateless(timeline_track_map_t const &tracks) {
+    for (auto const &track_pair : tracks) {
+        for (auto const &module_set_pair : track_pair.second->module_sets()) {
+            for (auto const &module : module_set_pair.second->modules()) {
+                if (module->state() != module_state::stateless) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
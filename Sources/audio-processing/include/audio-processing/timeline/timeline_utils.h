@@ -16,4 +16,12 @@ namespace yas::proc {
 [[nodiscard]] timeline_track_map_t copy_tracks(timeline_track_map_t const &);
 
 [[nodiscard]] std::optional<time::range> total_range(std::map<track_index_t, track_ptr> const &);
+
+/// 書き込まれるチャンネルを複数のトラックで扱っておらず、同じモジュールを共有していなければtrue
+/// trueならスライスの始めからトラックを並列に処理しても結果が変わらない
+[[nodiscard]] bool is_tracks_independent(timeline_track_map_t const &);
+
+/// すべてのモジュールがmodule_state::statelessならtrue
+/// trueならタイムラインをコピーして範囲を分けて処理しても、通して処理したときと結果が変わらない
+[[nodiscard]] bool is_tracks_stateless(timeline_track_map_t const &);
 }  // namespace yas::proc
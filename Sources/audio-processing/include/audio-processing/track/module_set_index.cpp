@@ -0,0 +1,111 @@
+//
+//  module_set_index.cpp
+//
+
+#include "module_set_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+using namespace yas;
+using namespace yas::proc;
+
+void module_set_index::rebuild(track_module_set_map_t const &module_sets) {
+    this->_ranges.clear();
+    this->_plans.clear();
+
+    this->_ranges.reserve(module_sets.size());
+    this->_plans.reserve(module_sets.size());
+
+    for (auto const &pair : module_sets) {
+        this->_ranges.emplace_back(pair.first);
+        this->_plans.emplace_back(pair.second);
+    }
+
+    this->_build();
+}
+
+void module_set_index::insert_or_replace(time::range const &range, module_set_ptr const &module_set) {
+    auto const iterator = std::lower_bound(this->_ranges.begin(), this->_ranges.end(), range);
+    auto const idx = static_cast<std::size_t>(std::distance(this->_ranges.begin(), iterator));
+
+    if (iterator != this->_ranges.end() && *iterator == range) {
+        this->_plans.at(idx) = module_set_plan{module_set};
+        return;
+    }
+
+    this->_ranges.insert(iterator, range);
+    this->_plans.emplace(this->_plans.begin() + idx, module_set);
+
+    this->_build();
+}
+
+void module_set_index::erase(time::range const &range) {
+    if (auto const idx = this->_index(range)) {
+        this->_ranges.erase(this->_ranges.begin() + *idx);
+        this->_plans.erase(this->_plans.begin() + *idx);
+
+        this->_build();
+    }
+}
+
+void module_set_index::update_plan(time::range const &range) {
+    if (auto const idx = this->_index(range)) {
+        auto &plan = this->_plans.at(*idx);
+        plan = module_set_plan{plan.module_set()};
+    }
+}
+
+void module_set_index::update_outdated_plans(time::range const &range) {
+    // 範囲は変わらないので、重なりを辿りながらplanだけを入れ替えられる
+    this->for_each_overlapped(range, [this](time::range const &, time::range const &, module_set_plan const &plan) {
+        if (plan.is_outdated()) {
+            this->_plans.at(static_cast<std::size_t>(&plan - this->_plans.data())) =
+                module_set_plan{plan.module_set()};
+        }
+    });
+}
+
+std::size_t module_set_index::size() const {
+    return this->_ranges.size();
+}
+
+std::optional<time::range> module_set_index::total_range() const {
+    if (this->_ranges.empty()) {
+        return std::nullopt;
+    }
+
+    // 範囲の順に並んでいるので先頭が最も前から始まり、根が最も後ろの終わりを持っている
+    auto const frame = this->_ranges.front().frame;
+    auto const next_frame = this->_max_next_frames[this->_ranges.size() / 2];
+    return time::range{frame, static_cast<length_t>(next_frame - frame)};
+}
+
+std::optional<std::size_t> module_set_index::_index(time::range const &range) const {
+    auto const iterator = std::lower_bound(this->_ranges.begin(), this->_ranges.end(), range);
+    if (iterator != this->_ranges.end() && *iterator == range) {
+        return static_cast<std::size_t>(std::distance(this->_ranges.begin(), iterator));
+    }
+    return std::nullopt;
+}
+
+// 範囲の並びが変わったら、部分木の終わりの最大値を求め直す。planは作り直さない
+void module_set_index::_build() {
+    this->_max_next_frames.resize(this->_ranges.size());
+    this->_build(0, this->_ranges.size());
+}
+
+frame_index_t module_set_index::_build(std::size_t const begin, std::size_t const end) {
+    if (begin >= end) {
+        return std::numeric_limits<frame_index_t>::min();
+    }
+
+    std::size_t const mid = begin + (end - begin) / 2;
+
+    auto const max_next_frame =
+        std::max({this->_ranges[mid].next_frame(), this->_build(begin, mid), this->_build(mid + 1, end)});
+    this->_max_next_frames[mid] = max_next_frame;
+
+    return max_next_frame;
+}
@@ -0,0 +1,48 @@
+//
+//  module_set_index.h
+//
+
+#pragma once
+
+#include <audio-processing/module_set/module_set_plan.h>
+#include <audio-processing/track/track_types.h>
+
+#include <optional>
+#include <vector>
+
+namespace yas::proc {
+/// module_setの範囲を区間木として持ち、重なるmodule_setだけを辿れるようにする
+/// module_setごとにmodule_set_planを作っておく
+/// 範囲の順に並べた配列を、中央の要素を節とする二分木とみなして、節ごとに部分木の終わりの最大値を持つ
+struct module_set_index final {
+    void rebuild(track_module_set_map_t const &);
+    /// rangeのmodule_setを加えるか入れ替えて、そのplanだけを作る
+    void insert_or_replace(time::range const &, module_set_ptr const &);
+    void erase(time::range const &);
+    /// rangeのmodule_setのplanだけを作り直す
+    void update_plan(time::range const &);
+    /// rangeに重なるmodule_setのうち、作った後に変更されていたもののplanだけを作り直す
+    void update_outdated_plans(time::range const &);
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::optional<time::range> total_range() const;
+
+    /// rangeに重なるmodule_setのplanを、track_module_set_map_tと同じ範囲の順に渡す
+    template <typename F>
+    void for_each_overlapped(time::range const &, F &&handler) const;
+
+   private:
+    std::vector<time::range> _ranges;
+    std::vector<module_set_plan> _plans;
+    std::vector<frame_index_t> _max_next_frames;
+
+    [[nodiscard]] std::optional<std::size_t> _index(time::range const &) const;
+    void _build();
+    frame_index_t _build(std::size_t const begin, std::size_t const end);
+
+    template <typename F>
+    void _for_each_overlapped(std::size_t const begin, std::size_t const end, time::range const &, F &handler) const;
+};
+}  // namespace yas::proc
+
+#include "module_set_index_private.h"
@@ -0,0 +1,46 @@
+//
+//  module_set_index_private.h
+//
+
+#pragma once
+
+namespace yas::proc {
+template <typename F>
+void module_set_index::for_each_overlapped(time::range const &range, F &&handler) const {
+    if (range.length == 0) {
+        return;
+    }
+
+    this->_for_each_overlapped(0, this->_ranges.size(), range, handler);
+}
+
+template <typename F>
+void module_set_index::_for_each_overlapped(std::size_t const begin, std::size_t const end, time::range const &range,
+                                            F &handler) const {
+    if (begin >= end) {
+        return;
+    }
+
+    std::size_t const mid = begin + (end - begin) / 2;
+
+    // 部分木のどれもrangeの先頭まで届いていない
+    if (this->_max_next_frames[mid] <= range.frame) {
+        return;
+    }
+
+    this->_for_each_overlapped(begin, mid, range, handler);
+
+    auto const &mid_range = this->_ranges[mid];
+
+    // これより後ろはrangeの後ろから始まる
+    if (range.next_frame() <= mid_range.frame) {
+        return;
+    }
+
+    if (auto const intersected = mid_range.intersected(range)) {
+        handler(mid_range, *intersected, this->_plans[mid]);
+    }
+
+    this->_for_each_overlapped(mid + 1, end, range, handler);
+}
+}  // namespace yas::proc
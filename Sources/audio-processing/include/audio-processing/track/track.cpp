@@ -16,12 +16,15 @@ using namespace yas::proc;
 
 track::track(track_module_set_map_t &&modules)
     : _module_sets_holder(track_module_set_map_holder_t::make_shared(std::move(modules))) {
+    this->_module_set_index.rebuild(this->_module_sets_holder->elements());
+
     this->_fetcher = observing::fetcher<track_event>::make_shared([this] {
         return track_event{.type = track_event_type::any, .module_sets = this->_module_sets_holder->elements()};
     });
 
     this->_module_sets_canceller = this->_module_sets_holder
                                        ->observe([this](track_module_set_map_holder_t::event const &module_sets_event) {
+                                           this->_update_module_set_index(module_sets_event);
                                            this->_push_track_event({.type = to_track_event_type(module_sets_event.type),
                                                                     .module_sets = module_sets_event.elements,
                                                                     .inserted = module_sets_event.inserted,
@@ -36,17 +39,7 @@ track_module_set_map_t const &track::module_sets() const {
 }
 
 std::optional<time::range> track::total_range() const {
-    std::optional<time::range> result{std::nullopt};
-
-    for (auto const &pair : this->_module_sets_holder->elements()) {
-        if (result) {
-            result = result->merged(pair.first);
-        } else {
-            result = pair.first;
-        }
-    }
-
-    return result;
+    return this->_module_set_index.total_range();
 }
 
 void track::push_back_module(module_ptr const &module, time::range const &range) {
@@ -123,16 +116,49 @@ void track::erase_modules_for_range(time::range const &range) {
 }
 
 track_ptr track::copy() const {
-    return track::make_shared(proc::copy_module_sets(this->_module_sets_holder->elements()));
+    auto copied = track::make_shared(proc::copy_module_sets(this->_module_sets_holder->elements()));
+    copied->set_plan_enabled(this->_is_plan_enabled);
+    return copied;
+}
+
+void track::set_plan_enabled(bool const is_enabled) {
+    this->_is_plan_enabled = is_enabled;
+}
+
+bool track::is_plan_enabled() const {
+    return this->_is_plan_enabled;
 }
 
 void track::process(time::range const &time_range, stream &stream) {
-    for (auto const &pair : this->_module_sets_holder->elements()) {
-        if (auto const current_time_range = pair.first.intersected(time_range)) {
-            for (auto &module : pair.second->modules()) {
-                module->process(*current_time_range, stream);
+    auto const &index = this->_module_set_index;
+
+    if (this->_is_plan_enabled) {
+        bool is_outdated = false;
+
+        index.for_each_overlapped(time_range, [&stream, &is_outdated](time::range const &,
+                                                                      time::range const &current_time_range,
+                                                                      module_set_plan const &plan) {
+            if (plan.is_outdated()) {
+                // moduleのconnectorが変更されていたので、今回はmoduleから処理して後で作り直す
+                is_outdated = true;
+                for (auto &module : plan.module_set()->modules()) {
+                    module->process(current_time_range, stream);
+                }
+            } else {
+                plan.process(current_time_range, stream);
             }
+        });
+
+        if (is_outdated) {
+            this->_module_set_index.update_outdated_plans(time_range);
         }
+    } else {
+        index.for_each_overlapped(time_range, [&stream](time::range const &, time::range const &current_time_range,
+                                                        module_set_plan const &plan) {
+            for (auto &module : plan.module_set()->modules()) {
+                module->process(current_time_range, stream);
+            }
+        });
     }
 }
 
@@ -147,6 +173,7 @@ void track::_push_track_event(track_event const &track_event) {
 void track::_observe_module_set(time::range const &range) {
     auto canceller = this->_module_sets_holder->at(range)
                          ->observe([this, range](module_set_event const &set_event) {
+                             this->_module_set_index.update_plan(range);
                              this->_push_track_event({.type = track_event_type::relayed,
                                                       .module_sets = this->_module_sets_holder->elements(),
                                                       .relayed = &this->_module_sets_holder->at(range),
@@ -158,6 +185,23 @@ void track::_observe_module_set(time::range const &range) {
     this->_module_set_cancellers.emplace(range, std::move(canceller));
 }
 
+void track::_update_module_set_index(track_module_set_map_holder_t::event const &event) {
+    auto &index = this->_module_set_index;
+
+    switch (event.type) {
+        case observing::map::event_type::any:
+            index.rebuild(event.elements);
+            break;
+        case observing::map::event_type::inserted:
+        case observing::map::event_type::replaced:
+            index.insert_or_replace(*event.key, *event.inserted);
+            break;
+        case observing::map::event_type::erased:
+            index.erase(*event.key);
+            break;
+    }
+}
+
 track_ptr track::make_shared() {
     return make_shared({});
 }
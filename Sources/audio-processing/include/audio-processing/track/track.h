@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <audio-processing/track/module_set_index.h>
 #include <audio-processing/track/track_types.h>
 
 #include <optional>
@@ -25,6 +26,10 @@ struct track final {
 
     [[nodiscard]] track_ptr copy() const;
 
+    /// 有効にするとmodule_set_planで処理する。結果は無効の場合と変わらない
+    void set_plan_enabled(bool const);
+    [[nodiscard]] bool is_plan_enabled() const;
+
     void process(time::range const &, stream &);
 
     using observing_handler_f = std::function<void(track_event const &)>;
@@ -41,10 +46,14 @@ struct track final {
     observing::fetcher_ptr<track_event> _fetcher = nullptr;
     observing::cancellable_ptr _module_sets_canceller = nullptr;
     std::map<time::range, observing::cancellable_ptr> _module_set_cancellers;
+    // module_setsが変更されたらその場で変更のあった範囲だけを更新し、constの関数からは読むだけにする
+    module_set_index _module_set_index;
+    bool _is_plan_enabled = false;
 
     explicit track(track_module_set_map_t &&);
 
     void _push_track_event(track_event const &);
     void _observe_module_set(time::range const &);
+    void _update_module_set_index(track_module_set_map_holder_t::event const &);
 };
 }  // namespace yas::proc
@@ -6,19 +6,24 @@
 #include <audio-processing/common/constants.h>
 #include <audio-processing/event/number_event.h>
 #include <audio-processing/event/signal_event.h>
+#include <audio-processing/event/signal_event_pool.h>
 #include <audio-processing/module/maker/cast_module.h>
 #include <audio-processing/module/maker/compare_modules.h>
 #include <audio-processing/module/maker/constant_module.h>
 #include <audio-processing/module/maker/envelope_module.h>
 #include <audio-processing/module/maker/file_module.h>
+#include <audio-processing/module/maker/file_reader_cache.h>
 #include <audio-processing/module/maker/generator_modules.h>
 #include <audio-processing/module/maker/math1_modules.h>
 #include <audio-processing/module/maker/math2_modules.h>
+#include <audio-processing/module/maker/math_kernels.h>
 #include <audio-processing/module/maker/number_to_signal_module.h>
+#include <audio-processing/module/maker/oscillator_module.h>
 #include <audio-processing/module/maker/routing_modules.h>
 #include <audio-processing/module/maker/sub_timeline_module.h>
 #include <audio-processing/module/module.h>
 #include <audio-processing/module_set/module_set.h>
+#include <audio-processing/module_set/module_set_plan.h>
 #include <audio-processing/processor/maker/receive_number_processor.h>
 #include <audio-processing/processor/maker/receive_signal_processor.h>
 #include <audio-processing/processor/maker/remove_number_processor.h>
@@ -26,4 +31,5 @@
 #include <audio-processing/processor/maker/send_signal_processor.h>
 #include <audio-processing/sync_source/sync_source.h>
 #include <audio-processing/timeline/timeline.h>
+#include <audio-processing/track/module_set_index.h>
 #include <audio-processing/track/track.h>
@@ -0,0 +1,28 @@
+//
+//  allocation_counter.h
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace yas::test {
+struct allocation_count {
+    std::size_t count = 0;
+    /// 一度に確保した中で最も大きいバイト数
+    std::size_t max_byte_size = 0;
+};
+
+/// 呼んだスレッドでのoperator newの呼び出しを数え始める。入れ子にはできない
+void begin_counting_allocations();
+[[nodiscard]] allocation_count end_counting_allocations();
+
+/// handlerを呼んでいる間に、呼んだスレッドで確保された回数を返す
+/// operator newの置き換えはallocation_counter.mmにあり、サイズやアラインメントを指定する形も数える
+template <typename Handler>
+[[nodiscard]] allocation_count count_allocations(Handler &&handler) {
+    begin_counting_allocations();
+    handler();
+    return end_counting_allocations();
+}
+}  // namespace yas::test
@@ -0,0 +1,141 @@
+//
+//  allocation_counter.mm
+//
+
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+using namespace yas;
+
+namespace yas::test::allocation_counter_utils {
+struct state {
+    bool is_counting = false;
+    allocation_count count;
+};
+
+static thread_local state current;
+
+static void add(std::size_t const size) {
+    if (current.is_counting) {
+        ++current.count.count;
+        current.count.max_byte_size = std::max(current.count.max_byte_size, size);
+    }
+}
+
+static void *allocate(std::size_t const size) {
+    add(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+static void *allocate(std::size_t const size, std::align_val_t const alignment) {
+    add(size);
+
+    void *ptr = nullptr;
+    auto const align = std::max(static_cast<std::size_t>(alignment), sizeof(void *));
+    if (posix_memalign(&ptr, align, size > 0 ? size : 1) != 0) {
+        return nullptr;
+    }
+    return ptr;
+}
+}  // namespace yas::test::allocation_counter_utils
+
+void test::begin_counting_allocations() {
+    allocation_counter_utils::current = {.is_counting = true, .count = {}};
+}
+
+test::allocation_count test::end_counting_allocations() {
+    auto const count = allocation_counter_utils::current.count;
+    allocation_counter_utils::current = {};
+    return count;
+}
+
+#pragma mark - replaced operators
+
+void *operator new(std::size_t const size) {
+    if (void *const ptr = test::allocation_counter_utils::allocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t const size) {
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t const size, std::nothrow_t const &) noexcept {
+    return test::allocation_counter_utils::allocate(size);
+}
+
+void *operator new[](std::size_t const size, std::nothrow_t const &) noexcept {
+    return test::allocation_counter_utils::allocate(size);
+}
+
+void *operator new(std::size_t const size, std::align_val_t const alignment) {
+    if (void *const ptr = test::allocation_counter_utils::allocate(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t const size, std::align_val_t const alignment) {
+    return ::operator new(size, alignment);
+}
+
+void *operator new(std::size_t const size, std::align_val_t const alignment, std::nothrow_t const &) noexcept {
+    return test::allocation_counter_utils::allocate(size, alignment);
+}
+
+void *operator new[](std::size_t const size, std::align_val_t const alignment, std::nothrow_t const &) noexcept {
+    return test::allocation_counter_utils::allocate(size, alignment);
+}
+
+void operator delete(void *const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, std::size_t const) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, std::size_t const) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, std::nothrow_t const &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, std::nothrow_t const &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, std::align_val_t const) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, std::align_val_t const) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, std::size_t const, std::align_val_t const) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, std::size_t const, std::align_val_t const) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *const ptr, std::align_val_t const, std::nothrow_t const &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *const ptr, std::align_val_t const, std::nothrow_t const &) noexcept {
+    std::free(ptr);
+}
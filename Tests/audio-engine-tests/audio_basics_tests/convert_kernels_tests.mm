@@ -0,0 +1,157 @@
+//
+//  convert_kernels_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <algorithm>
+#import <audio-engine/umbrella.hpp>
+#import <vector>
+
+using namespace yas;
+
+@interface convert_kernels_tests : XCTestCase
+
+@end
+
+@implementation convert_kernels_tests
+
+- (void)test_float_to_int16 {
+    std::vector<float> const from{0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.0f, -2.0f, 1.0f / 65536.0f};
+    std::vector<int16_t> to(from.size());
+
+    audio::convert::samples(from.data(), 1, to.data(), 1, from.size());
+
+    // 範囲を超えたら端に収める
+    XCTAssertEqual(to, (std::vector<int16_t>{0, 16384, -16384, 32767, -32768, 32767, -32768, 1}));
+}
+
+- (void)test_int16_to_float {
+    std::vector<int16_t> const from{0, 16384, -16384, -32768, 32767};
+    std::vector<double> to(from.size());
+
+    audio::convert::samples(from.data(), 1, to.data(), 1, from.size());
+
+    XCTAssertEqual(to, (std::vector<double>{0.0, 0.5, -0.5, -1.0, 32767.0 / 32768.0}));
+}
+
+- (void)test_fixed824 {
+    std::vector<double> const from{0.0, 0.5, -1.0, 128.0, -129.0};
+    std::vector<int32_t> fixed(from.size());
+
+    audio::convert::samples(from.data(), 1, fixed.data(), 1, from.size());
+
+    XCTAssertEqual(fixed, (std::vector<int32_t>{0, 8388608, -16777216, INT32_MAX, INT32_MIN}));
+
+    std::vector<int16_t> int16(from.size());
+
+    audio::convert::samples(fixed.data(), 1, int16.data(), 1, fixed.size());
+
+    XCTAssertEqual(int16, (std::vector<int16_t>{0, 16384, -32768, 32767, -32768}));
+
+    audio::convert::samples(int16.data(), 1, fixed.data(), 1, int16.size());
+
+    XCTAssertEqual(fixed, (std::vector<int32_t>{0, 8388608, -16777216, 16776704, -16777216}));
+}
+
+- (void)test_round {
+    std::vector<float> const from{0.4f / 32768.0f, 0.6f / 32768.0f, -0.4f / 32768.0f, -0.6f / 32768.0f};
+    std::vector<int16_t> to(from.size());
+
+    audio::convert::samples(from.data(), 1, to.data(), 1, from.size());
+
+    XCTAssertEqual(to, (std::vector<int16_t>{0, 1, 0, -1}));
+}
+
+- (void)test_stride {
+    std::vector<int16_t> const interleaved{1, 2, 3, 4, 5, 6};
+    std::vector<int16_t> left(3);
+    std::vector<int16_t> right(3);
+
+    audio::convert::samples(interleaved.data(), 2, left.data(), 1, 3);
+    audio::convert::samples(&interleaved[1], 2, right.data(), 1, 3);
+
+    XCTAssertEqual(left, (std::vector<int16_t>{1, 3, 5}));
+    XCTAssertEqual(right, (std::vector<int16_t>{2, 4, 6}));
+
+    std::vector<float> float_interleaved(6);
+
+    audio::convert::samples(left.data(), 1, float_interleaved.data(), 2, 3);
+    audio::convert::samples(right.data(), 1, &float_interleaved[1], 2, 3);
+
+    for (std::size_t idx = 0; idx < interleaved.size(); ++idx) {
+        XCTAssertEqual(float_interleaved.at(idx), static_cast<float>(interleaved.at(idx)) / 32768.0f);
+    }
+}
+
+- (void)test_dither {
+    // 1LSBに満たない直流はディザが無ければ消える
+    std::vector<double> const from(4096, 0.3 / 32768.0);
+    std::vector<int16_t> to(from.size());
+
+    audio::convert::samples(from.data(), 1, to.data(), 1, from.size(), audio::dither_type::none);
+
+    XCTAssertEqual(static_cast<std::size_t>(std::count(to.begin(), to.end(), 0)), to.size());
+
+    for (auto const dither : {audio::dither_type::rectangular, audio::dither_type::triangular}) {
+        audio::convert::samples(from.data(), 1, to.data(), 1, from.size(), dither);
+
+        double sum = 0.0;
+        for (auto const &value : to) {
+            XCTAssertGreaterThanOrEqual(value, -1);
+            XCTAssertLessThanOrEqual(value, 1);
+            sum += value;
+        }
+
+        // 平均すると元の値に近づく
+        XCTAssertEqualWithAccuracy(sum / to.size(), 0.3, 0.05);
+    }
+}
+
+- (void)test_dither_not_applied_to_float {
+    std::vector<int16_t> const from{1, -1};
+    std::vector<float> to(from.size());
+
+    audio::convert::samples(from.data(), 1, to.data(), 1, from.size(), audio::dither_type::triangular);
+
+    XCTAssertEqual(to, (std::vector<float>{1.0f / 32768.0f, -1.0f / 32768.0f}));
+}
+
+- (void)test_samples_with_pcm_format {
+    std::vector<float> const from{0.5f, -0.5f};
+    std::vector<int16_t> to(from.size());
+
+    XCTAssertTrue(audio::convert::samples(from.data(), audio::pcm_format::float32, 1, to.data(),
+                                          audio::pcm_format::int16, 1, from.size()));
+    XCTAssertEqual(to, (std::vector<int16_t>{16384, -16384}));
+
+    XCTAssertFalse(audio::convert::samples(from.data(), audio::pcm_format::other, 1, to.data(),
+                                           audio::pcm_format::int16, 1, from.size()));
+}
+
+- (void)test_is_convertible {
+    XCTAssertTrue(audio::convert::is_convertible(audio::pcm_format::float32));
+    XCTAssertTrue(audio::convert::is_convertible(audio::pcm_format::float64));
+    XCTAssertTrue(audio::convert::is_convertible(audio::pcm_format::int16));
+    XCTAssertTrue(audio::convert::is_convertible(audio::pcm_format::fixed824));
+    XCTAssertFalse(audio::convert::is_convertible(audio::pcm_format::other));
+}
+
+- (void)test_dither_type_to_string {
+    XCTAssertTrue(to_string(audio::dither_type::none) == "none");
+    XCTAssertTrue(to_string(audio::dither_type::rectangular) == "rectangular");
+    XCTAssertTrue(to_string(audio::dither_type::triangular) == "triangular");
+}
+
+- (void)test_float_to_int16_performance {
+    std::size_t const length = 1024 * 1024;
+    std::vector<float> const from(length, 0.25f);
+    std::vector<int16_t> to(length);
+    float const *const from_ptr = from.data();
+    int16_t *const to_ptr = to.data();
+
+    [self measureBlock:^{
+        audio::convert::samples(from_ptr, 1, to_ptr, 1, length, audio::dither_type::triangular);
+    }];
+}
+
+@end
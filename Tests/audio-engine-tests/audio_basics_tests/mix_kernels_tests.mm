@@ -0,0 +1,52 @@
+//
+//  mix_kernels_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/umbrella.hpp>
+#import <vector>
+
+using namespace yas;
+
+@interface mix_kernels_tests : XCTestCase
+
+@end
+
+@implementation mix_kernels_tests
+
+- (void)test_add_scaled {
+    std::vector<float> out{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    std::vector<float> const in{1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+    audio::mix::add_scaled(out.data(), in.data(), 4, 0.5f);
+
+    XCTAssertEqual(out, (std::vector<float>{1.5f, 2.5f, 3.5f, 4.5f, 5.0f}));
+
+    audio::mix::add_scaled(out.data(), in.data(), 5, 1.0f);
+
+    XCTAssertEqual(out, (std::vector<float>{2.5f, 3.5f, 4.5f, 5.5f, 6.0f}));
+}
+
+- (void)test_add_ramped {
+    std::vector<double> out(4, 0.0);
+    std::vector<double> const in(4, 2.0);
+
+    audio::mix::add_ramped(out.data(), in.data(), 4, 0.0, 1.0);
+
+    XCTAssertEqual(out, (std::vector<double>{0.5, 1.0, 1.5, 2.0}));
+
+    audio::mix::add_ramped(out.data(), in.data(), 4, 1.0, 1.0);
+
+    XCTAssertEqual(out, (std::vector<double>{2.5, 3.0, 3.5, 4.0}));
+}
+
+- (void)test_add_ramped_empty {
+    std::vector<float> out{1.0f};
+    std::vector<float> const in{1.0f};
+
+    audio::mix::add_ramped(out.data(), in.data(), 0, 0.0f, 1.0f);
+
+    XCTAssertEqual(out.at(0), 1.0f);
+}
+
+@end
@@ -0,0 +1,216 @@
+//
+//  oscillator_bank_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/umbrella.hpp>
+#import <cmath>
+#import <vector>
+
+using namespace yas;
+
+@interface oscillator_bank_tests : XCTestCase
+
+@end
+
+@implementation oscillator_bank_tests
+
+- (void)test_sine {
+    for (uint32_t idx = 0; idx <= 1000; ++idx) {
+        double const phase = static_cast<double>(idx) / 1000.0;
+        double const expected = std::sin(audio::math::two_pi * phase);
+
+        XCTAssertEqualWithAccuracy(audio::oscillator::sine(phase), expected, 2.0e-11);
+        XCTAssertEqualWithAccuracy(audio::oscillator::sine(static_cast<float>(phase)),
+                                   std::sin(audio::math::two_pi * static_cast<float>(phase)), 3.0e-7);
+    }
+}
+
+- (void)test_saw {
+    double const inverse_increment = 10.0;
+
+    XCTAssertEqualWithAccuracy(audio::oscillator::saw(0.5, inverse_increment), 0.0, 1.0e-12);
+    XCTAssertEqualWithAccuracy(audio::oscillator::saw(0.25, inverse_increment), -0.5, 1.0e-12);
+
+    // 不連続な点の前後は滑らかにつながる
+    XCTAssertEqualWithAccuracy(audio::oscillator::saw(0.0, inverse_increment), 0.0, 1.0e-12);
+    XCTAssertEqualWithAccuracy(audio::oscillator::saw(0.95, inverse_increment), 0.65, 1.0e-12);
+
+    // 進まなければ補正しない
+    XCTAssertEqualWithAccuracy(audio::oscillator::saw(0.0, 0.0), -1.0, 1.0e-12);
+}
+
+- (void)test_make {
+    audio::oscillator_bank<float> bank{48000.0, 2};
+
+    XCTAssertEqual(bank.sample_rate(), 48000.0);
+    XCTAssertEqual(bank.channel_count(), 2);
+    XCTAssertEqual(bank.voice_count(), 0);
+
+    XCTAssertThrows((audio::oscillator_bank<float>{0.0, 1}));
+}
+
+- (void)test_add_voice {
+    audio::oscillator_bank<double> bank{48000.0, 2};
+
+    XCTAssertEqual(bank.add_voice({.channel = 1, .frequency = 440.0, .phase = 1.25, .gain = 0.5}), 0);
+    XCTAssertEqual(bank.add_voice({.waveform = audio::oscillator_waveform::saw, .frequency = 100.0}), 1);
+
+    XCTAssertEqual(bank.voice_count(), 2);
+    XCTAssertEqual(bank.frequency(0), 440.0);
+    XCTAssertEqual(bank.phase(0), 0.25);
+    XCTAssertEqual(bank.gain(0), 0.5);
+    XCTAssertEqual(bank.frequency(1), 100.0);
+
+    XCTAssertThrows(bank.add_voice({.channel = 2}));
+    XCTAssertThrows(bank.set_frequency(2, 1.0));
+
+    bank.remove_all_voices();
+
+    XCTAssertEqual(bank.voice_count(), 0);
+}
+
+- (void)test_render_sine {
+    double const sample_rate = 48000.0;
+    uint32_t const length = 512;
+    audio::oscillator_bank<double> bank{sample_rate, 2};
+
+    bank.add_voice({.channel = 0, .frequency = 440.0, .phase = 0.25});
+    bank.add_voice({.channel = 0, .frequency = 1000.0, .gain = 0.5});
+    bank.add_voice({.channel = 1, .frequency = 100.0});
+
+    std::vector<double> left(length * 2);
+    std::vector<double> right(length * 2);
+
+    // 2回に分けても位置は続く
+    double *const first_outs[2] = {left.data(), right.data()};
+    bank.render(first_outs, length);
+    double *const second_outs[2] = {&left[length], &right[length]};
+    bank.render(second_outs, length);
+
+    for (uint32_t frm_idx = 0; frm_idx < length * 2; ++frm_idx) {
+        double const time = static_cast<double>(frm_idx) / sample_rate;
+        double const expected_left = std::sin(audio::math::two_pi * (0.25 + 440.0 * time)) +
+                                     0.5 * std::sin(audio::math::two_pi * 1000.0 * time);
+        double const expected_right = std::sin(audio::math::two_pi * 100.0 * time);
+
+        XCTAssertEqualWithAccuracy(left.at(frm_idx), expected_left, 1.0e-9);
+        XCTAssertEqualWithAccuracy(right.at(frm_idx), expected_right, 1.0e-9);
+    }
+}
+
+- (void)test_render_saw {
+    audio::oscillator_bank<float> bank{8.0, 1};
+    bank.add_voice({.waveform = audio::oscillator_waveform::saw, .frequency = 1.0});
+
+    std::vector<float> data(9);
+    float *const outs[1] = {data.data()};
+    bank.render(outs, 9);
+
+    // 不連続な点は-1と1の間になり、それ以外は補正されない
+    XCTAssertEqualWithAccuracy(data.at(0), 0.0f, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(data.at(1), -0.75f, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(data.at(4), 0.0f, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(data.at(6), 0.5f, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(data.at(7), 0.75f, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(data.at(8), 0.0f, 1.0e-6f);
+}
+
+- (void)test_render_table {
+    audio::oscillator_bank<float> bank{4.0, 1};
+    bank.add_voice({.waveform = audio::oscillator_waveform::table, .frequency = 1.0, .gain = 2.0});
+
+    std::vector<float> data(8, 1.0f);
+    float *const outs[1] = {data.data()};
+
+    // tableがなければ0になる
+    bank.render(outs, 4);
+
+    XCTAssertEqual(data, (std::vector<float>{0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f}));
+
+    bank.set_table({0.0f, 1.0f});
+    bank.set_phase(0, 0.0);
+    bank.render(outs, 8);
+
+    // 間を線形補間して、末尾から先頭へつながる
+    XCTAssertEqual(data, (std::vector<float>{0.0f, 1.0f, 2.0f, 1.0f, 0.0f, 1.0f, 2.0f, 1.0f}));
+}
+
+- (void)test_render_with_many_voices {
+    double const sample_rate = 44100.0;
+    uint32_t const length = 64;
+    uint32_t const voice_count = 37;
+    audio::oscillator_bank<float> bank{sample_rate, 1};
+
+    for (uint32_t idx = 0; idx < voice_count; ++idx) {
+        bank.add_voice({.frequency = 100.0 * (idx + 1), .gain = 1.0 / voice_count});
+    }
+
+    std::vector<float> data(length);
+    float *const outs[1] = {data.data()};
+    bank.render(outs, length);
+
+    for (uint32_t frm_idx = 0; frm_idx < length; ++frm_idx) {
+        double expected = 0.0;
+        for (uint32_t idx = 0; idx < voice_count; ++idx) {
+            expected += std::sin(audio::math::two_pi * 100.0 * (idx + 1) * frm_idx / sample_rate) / voice_count;
+        }
+
+        XCTAssertEqualWithAccuracy(data.at(frm_idx), expected, 1.0e-5);
+    }
+
+    XCTAssertEqualWithAccuracy(bank.phase(1), std::fmod(200.0 * length / sample_rate, 1.0), 1.0e-5);
+}
+
+- (void)test_set_values {
+    audio::oscillator_bank<double> bank{4.0, 1};
+    bank.add_voice({.frequency = 1.0});
+
+    bank.set_frequency(0, 100.0);
+
+    XCTAssertEqual(bank.frequency(0), 100.0);
+
+    bank.set_phase(0, -0.25);
+    bank.set_gain(0, 0.5);
+
+    XCTAssertEqual(bank.phase(0), 0.75);
+    XCTAssertEqual(bank.gain(0), 0.5);
+
+    std::vector<double> data(2);
+    double *const outs[1] = {data.data()};
+    bank.render(outs, 2);
+
+    // ナイキスト周波数に収められる
+    XCTAssertEqualWithAccuracy(data.at(0), -0.5, 1.0e-9);
+    XCTAssertEqualWithAccuracy(data.at(1), 0.5, 1.0e-9);
+}
+
+- (void)test_waveform_to_string {
+    XCTAssertTrue(to_string(audio::oscillator_waveform::sine) == "sine");
+    XCTAssertTrue(to_string(audio::oscillator_waveform::saw) == "saw");
+    XCTAssertTrue(to_string(audio::oscillator_waveform::table) == "table");
+}
+
+- (void)test_render_256_voices_performance {
+    audio::oscillator_bank<float> bank{48000.0, 2};
+
+    for (uint32_t idx = 0; idx < 256; ++idx) {
+        bank.add_voice({.waveform = (idx % 2 == 0) ? audio::oscillator_waveform::sine : audio::oscillator_waveform::saw,
+                        .channel = idx % 2,
+                        .frequency = 100.0 + idx * 37.0,
+                        .gain = 1.0 / 256.0});
+    }
+
+    std::vector<float> left(512);
+    std::vector<float> right(512);
+    float *const outs[2] = {left.data(), right.data()};
+    auto *const bank_ptr = &bank;
+
+    [self measureBlock:^{
+        for (uint32_t idx = 0; idx < 100; ++idx) {
+            bank_ptr->render(outs, 512);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,96 @@
+//
+//  pcm_buffer_allocator_tests.mm
+//
+
+#import "../test_utils.h"
+
+using namespace yas;
+
+@interface pcm_buffer_allocator_tests : XCTestCase
+
+@end
+
+@implementation pcm_buffer_allocator_tests
+
+- (void)test_default_allocator {
+    auto const &allocator = audio::pcm_buffer_allocator::default_allocator();
+
+    XCTAssertTrue(allocator != nullptr);
+    XCTAssertEqual(allocator, audio::pcm_buffer_allocator::default_allocator());
+
+    void *const ptr = allocator->allocate(100, audio::pcm_buffer_alignment);
+
+    XCTAssertTrue(ptr != nullptr);
+    XCTAssertEqual(reinterpret_cast<uintptr_t>(ptr) % audio::pcm_buffer_alignment, 0);
+
+    allocator->deallocate(ptr, 100, audio::pcm_buffer_alignment);
+}
+
+- (void)test_pool_reuse {
+    auto const pool = audio::pcm_buffer_pool::make_shared(1024);
+
+    XCTAssertEqual(pool->max_pooled_byte_size(), 1024);
+    XCTAssertEqual(pool->pooled_byte_size(), 0);
+
+    void *const ptr1 = pool->allocate(256, 64);
+    pool->deallocate(ptr1, 256, 64);
+
+    XCTAssertEqual(pool->pooled_byte_size(), 256);
+
+    // サイズが違えば使い回さない
+    void *const ptr2 = pool->allocate(128, 64);
+    XCTAssertNotEqual(ptr2, ptr1);
+    XCTAssertEqual(pool->pooled_byte_size(), 256);
+
+    void *const ptr3 = pool->allocate(256, 64);
+    XCTAssertEqual(ptr3, ptr1);
+    XCTAssertEqual(pool->pooled_byte_size(), 0);
+
+    pool->deallocate(ptr2, 128, 64);
+    pool->deallocate(ptr3, 256, 64);
+
+    XCTAssertEqual(pool->pooled_byte_size(), 384);
+
+    pool->purge();
+
+    XCTAssertEqual(pool->pooled_byte_size(), 0);
+}
+
+- (void)test_pool_max_pooled_byte_size {
+    auto const pool = audio::pcm_buffer_pool::make_shared(256);
+
+    void *const ptr1 = pool->allocate(256, 64);
+    void *const ptr2 = pool->allocate(256, 64);
+
+    pool->deallocate(ptr1, 256, 64);
+    // 上限を超える分は取っておかずに解放する
+    pool->deallocate(ptr2, 256, 64);
+
+    XCTAssertEqual(pool->pooled_byte_size(), 256);
+}
+
+- (void)test_pool_outlives_buffers {
+    auto pool = audio::pcm_buffer_pool::make_shared(1024 * 1024);
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+
+    auto const buffer = std::make_shared<audio::pcm_buffer>(format, 16, audio::pcm_buffer::allocation_options{
+                                                                            .allocator = pool});
+    std::weak_ptr<audio::pcm_buffer_pool> const weak_pool = pool;
+
+    pool = nullptr;
+
+    // バッファが解放されるまではプールも残る
+    XCTAssertFalse(weak_pool.expired());
+
+    buffer->data_ptr_at_index<float>(1)[15] = 1.0f;
+}
+
+- (void)test_shared_pool {
+    auto const &pool = audio::pcm_buffer_pool::shared();
+
+    XCTAssertTrue(pool != nullptr);
+    XCTAssertEqual(pool, audio::pcm_buffer_pool::shared());
+    XCTAssertGreaterThan(pool->max_pooled_byte_size(), 0);
+}
+
+@end
@@ -559,6 +559,107 @@ using namespace yas::audio;
     XCTAssertEqual(dst_ptr_1[3], 0);
 }
 
+- (void)test_convert_from_int16_interleaved_to_float32_deinterleaved {
+    uint32_t const frame_length = 4;
+
+    audio::format src_format{{.sample_rate = 48000.0,
+                              .channel_count = 2,
+                              .pcm_format = audio::pcm_format::int16,
+                              .interleaved = true}};
+    audio::format dst_format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::pcm_buffer src_buffer{src_format, frame_length};
+    audio::pcm_buffer dst_buffer{dst_format, frame_length};
+
+    int16_t *const src_ptr = src_buffer.data_ptr_at_index<int16_t>(0);
+    for (int16_t idx = 0; idx < 8; ++idx) {
+        src_ptr[idx] = (idx % 2 == 0) ? idx * 1024 : -idx * 1024;
+    }
+
+    auto const result = dst_buffer.convert_from(src_buffer);
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(result.value(), frame_length);
+
+    float const *const dst_ptr_0 = dst_buffer.data_ptr_at_index<float>(0);
+    float const *const dst_ptr_1 = dst_buffer.data_ptr_at_index<float>(1);
+
+    for (uint32_t frame = 0; frame < frame_length; ++frame) {
+        XCTAssertEqual(dst_ptr_0[frame], static_cast<float>(frame * 2 * 1024) / 32768.0f);
+        XCTAssertEqual(dst_ptr_1[frame], -static_cast<float>((frame * 2 + 1) * 1024) / 32768.0f);
+    }
+}
+
+- (void)test_convert_from_float64_deinterleaved_to_fixed824_interleaved {
+    uint32_t const frame_length = 600;
+
+    audio::format src_format{
+        {.sample_rate = 48000.0, .channel_count = 3, .pcm_format = audio::pcm_format::float64}};
+    audio::format dst_format{{.sample_rate = 48000.0,
+                              .channel_count = 3,
+                              .pcm_format = audio::pcm_format::fixed824,
+                              .interleaved = true}};
+    audio::pcm_buffer src_buffer{src_format, frame_length};
+    audio::pcm_buffer dst_buffer{dst_format, frame_length};
+
+    for (uint32_t ch_idx = 0; ch_idx < 3; ++ch_idx) {
+        double *const src_ptr = src_buffer.data_ptr_at_index<double>(ch_idx);
+        for (uint32_t frame = 0; frame < frame_length; ++frame) {
+            src_ptr[frame] = static_cast<double>(frame + ch_idx) / 1024.0;
+        }
+    }
+
+    // 区切って変換する長さを超えても続けて書き込まれる
+    XCTAssertTrue(dst_buffer.convert_from(src_buffer));
+
+    int32_t const *const dst_ptr = dst_buffer.data_ptr_at_index<int32_t>(0);
+
+    for (uint32_t frame = 0; frame < frame_length; ++frame) {
+        for (uint32_t ch_idx = 0; ch_idx < 3; ++ch_idx) {
+            XCTAssertEqual(dst_ptr[frame * 3 + ch_idx], static_cast<int32_t>((frame + ch_idx) * 16384));
+        }
+    }
+}
+
+- (void)test_convert_from_with_options {
+    audio::format src_format{{.sample_rate = 48000.0, .channel_count = 1}};
+    audio::format dst_format{
+        {.sample_rate = 48000.0, .channel_count = 1, .pcm_format = audio::pcm_format::int16}};
+    audio::pcm_buffer src_buffer{src_format, 4};
+    audio::pcm_buffer dst_buffer{dst_format, 4};
+
+    float *const src_ptr = src_buffer.data_ptr_at_index<float>(0);
+    src_ptr[0] = 0.125f;
+    src_ptr[1] = 0.25f;
+    src_ptr[2] = 0.5f;
+    src_ptr[3] = 1.0f;
+
+    auto const result = dst_buffer.convert_from(src_buffer, {.from_begin_frame = 1, .to_begin_frame = 2, .length = 2});
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(result.value(), 2);
+    XCTAssertEqual(dst_buffer.frame_length(), 4);
+
+    int16_t const *const dst_ptr = dst_buffer.data_ptr_at_index<int16_t>(0);
+
+    XCTAssertEqual(dst_ptr[0], 0);
+    XCTAssertEqual(dst_ptr[1], 0);
+    XCTAssertEqual(dst_ptr[2], 8192);
+    XCTAssertEqual(dst_ptr[3], 16384);
+
+    XCTAssertFalse(dst_buffer.convert_from(src_buffer, {.from_begin_frame = 3, .length = 2}));
+    XCTAssertFalse(dst_buffer.convert_from(src_buffer, {.to_begin_frame = 3, .length = 2}));
+}
+
+- (void)test_convert_from_invalid_format {
+    audio::pcm_buffer src_buffer{audio::format{{.sample_rate = 48000.0, .channel_count = 2}}, 4};
+    audio::pcm_buffer dst_buffer{audio::format{{.sample_rate = 48000.0, .channel_count = 1}}, 4};
+
+    auto const result = dst_buffer.convert_from(src_buffer);
+
+    XCTAssertFalse(result);
+    XCTAssertEqual(result.error(), audio::pcm_buffer::copy_error_t::invalid_format);
+}
+
 - (void)test_copy_channel_float64_data_deinterleaved_to_interleaved {
     double const sample_rate = 48000.0;
     uint32_t const frame_length = 4;
@@ -962,6 +1063,65 @@ using namespace yas::audio;
     }
 }
 
+- (void)test_allocate_abl_aligned_single_block {
+    uint32_t const buf = 3;
+    uint32_t const size = 100;
+
+    auto const pair = audio::allocate_audio_buffer_list(buf, 1, size);
+    audio::abl_uptr const &abl = pair.first;
+    audio::abl_data_uptr const &data = pair.second;
+
+    XCTAssertTrue(data != nullptr);
+    XCTAssertEqual(abl->mBuffers[0].mData, data.get());
+
+    for (uint32_t i = 0; i < buf; i++) {
+        auto const *const ptr = static_cast<uint8_t const *>(abl->mBuffers[i].mData);
+
+        XCTAssertEqual(abl->mBuffers[i].mDataByteSize, size);
+        XCTAssertEqual(reinterpret_cast<uintptr_t>(ptr) % audio::pcm_buffer_alignment, 0);
+        // 先頭を揃えるために切り上げた間隔で並ぶ
+        XCTAssertEqual(ptr, data.get() + 128 * i);
+
+        for (uint32_t byte_idx = 0; byte_idx < size; byte_idx++) {
+            XCTAssertEqual(ptr[byte_idx], 0);
+        }
+    }
+}
+
+- (void)test_create_buffer_with_allocation_options {
+    auto const pool = audio::pcm_buffer_pool::make_shared(1024 * 1024);
+    auto const format = audio::format({.sample_rate = 48000.0, .channel_count = 2});
+
+    void *data = nullptr;
+
+    {
+        audio::pcm_buffer buffer(format, 4, {.allocator = pool});
+        data = buffer.data_ptr_at_index<float>(0);
+
+        XCTAssertTrue(test::is_cleared_buffer(buffer));
+
+        test::fill_test_values_to_buffer(buffer);
+    }
+
+    XCTAssertGreaterThan(pool->pooled_byte_size(), 0);
+
+    {
+        // プールから同じ領域を使い回し、0で埋めなければ前の値が残る
+        audio::pcm_buffer buffer(format, 4, {.zero_filled = false, .allocator = pool});
+
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(0), data);
+        XCTAssertFalse(test::is_cleared_buffer(buffer));
+        XCTAssertEqual(pool->pooled_byte_size(), 0);
+    }
+
+    {
+        audio::pcm_buffer buffer(format, 4, {.allocator = pool});
+
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(0), data);
+        XCTAssertTrue(test::is_cleared_buffer(buffer));
+    }
+}
+
 - (void)test_is_equal_abl_structure_true {
     auto pair1 = audio::allocate_audio_buffer_list(2, 2);
     auto pair2 = audio::allocate_audio_buffer_list(2, 2);
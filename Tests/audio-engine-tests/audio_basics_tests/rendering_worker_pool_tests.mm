@@ -0,0 +1,117 @@
+//
+//  rendering_worker_pool_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/umbrella.hpp>
+#import <array>
+#import <atomic>
+#import <mutex>
+#import <set>
+#import <thread>
+#import "../allocation_counter.h"
+
+using namespace yas;
+
+@interface rendering_worker_pool_tests : XCTestCase
+
+@end
+
+@implementation rendering_worker_pool_tests
+
+- (void)test_make_shared {
+    XCTAssertEqual(audio::rendering_worker_pool::make_shared(2)->thread_count(), 2);
+    XCTAssertEqual(audio::rendering_worker_pool::make_shared(0)->thread_count(), 0);
+}
+
+- (void)test_parallel_for {
+    auto const pool = audio::rendering_worker_pool::make_shared(3);
+
+    for (std::size_t count = 0; count < 100; ++count) {
+        std::vector<std::size_t> values(count, 0);
+
+        pool->parallel_for(count, [&values](std::size_t const idx) { values.at(idx) += idx + 1; });
+
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            XCTAssertEqual(values.at(idx), idx + 1);
+        }
+    }
+}
+
+- (void)test_parallel_for_uses_threads {
+    auto const pool = audio::rendering_worker_pool::make_shared(3);
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic<std::size_t> waiting_count{0};
+
+    pool->parallel_for(4, [&mutex, &thread_ids, &waiting_count](std::size_t const) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            thread_ids.insert(std::this_thread::get_id());
+        }
+
+        // 4つが同時に走っていることを確かめる
+        ++waiting_count;
+        while (waiting_count < 4) {
+            std::this_thread::yield();
+        }
+    });
+
+    XCTAssertEqual(thread_ids.size(), 4);
+    XCTAssertTrue(thread_ids.count(std::this_thread::get_id()) > 0);
+}
+
+- (void)test_nested_parallel_for {
+    auto const pool = audio::rendering_worker_pool::make_shared(2);
+
+    std::atomic<std::size_t> total{0};
+
+    pool->parallel_for(3, [&pool, &total](std::size_t const) {
+        pool->parallel_for(5, [&total](std::size_t const) { ++total; });
+    });
+
+    XCTAssertEqual(total, 15);
+}
+
+- (void)test_parallel_for_from_multiple_threads {
+    auto const pool = audio::rendering_worker_pool::make_shared(2);
+
+    std::atomic<std::size_t> total{0};
+    std::vector<std::thread> threads;
+
+    // 枠が足りなくなった呼び出しは、呼び出したスレッドだけで処理される
+    for (std::size_t thread_idx = 0; thread_idx < audio::rendering_worker_pool::job_capacity * 2; ++thread_idx) {
+        threads.emplace_back([&pool, &total] {
+            for (std::size_t idx = 0; idx < 100; ++idx) {
+                pool->parallel_for(4, [&total](std::size_t const) { ++total; });
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    XCTAssertEqual(total, audio::rendering_worker_pool::job_capacity * 2 * 100 * 4);
+}
+
+- (void)test_parallel_for_without_allocating {
+    auto const pool = audio::rendering_worker_pool::make_shared(3);
+
+    std::array<std::atomic<std::size_t>, 8> values{};
+
+    auto const allocation = test::count_allocations([&pool, &values] {
+        for (std::size_t idx = 0; idx < 100; ++idx) {
+            pool->parallel_for(values.size(), [&values](std::size_t const value_idx) { ++values.at(value_idx); });
+        }
+    });
+
+    XCTAssertEqual(allocation.count, 0);
+
+    for (auto const &value : values) {
+        XCTAssertEqual(value, 100);
+    }
+}
+
+@end
@@ -0,0 +1,296 @@
+//
+//  resampler_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/umbrella.hpp>
+#import <cmath>
+#import <vector>
+
+using namespace yas;
+
+namespace yas::audio::test_utils::resampler {
+static uint32_t constexpr bench_length = 512;
+static uint32_t constexpr bench_count = 1000;
+
+/// サイン波をchunk_lengthフレームずつ変換し、遅れを戻した理想的なサイン波との誤差をdBで返す
+template <typename T>
+static double signal_to_noise(double const input_sample_rate, double const output_sample_rate,
+                              resampler_quality const quality, std::size_t const chunk_length) {
+    double const frequency = 1000.0;
+    std::size_t const out_length = 8192;
+
+    audio::resampler<T> resampler{input_sample_rate, output_sample_rate, 1, quality};
+
+    std::vector<T> output(out_length);
+    std::size_t input_frame = 0;
+
+    for (std::size_t out_frame = 0; out_frame < out_length; out_frame += chunk_length) {
+        auto const length = std::min(chunk_length, out_length - out_frame);
+        std::vector<T> input(resampler.input_length_for_output(length));
+
+        for (std::size_t idx = 0; idx < input.size(); ++idx) {
+            input.at(idx) = static_cast<T>(
+                std::sin(2.0 * M_PI * frequency * static_cast<double>(input_frame + idx) / input_sample_rate));
+        }
+        input_frame += input.size();
+
+        T const *const in_ptr = input.data();
+        T *const out_ptr = &output.at(out_frame);
+        resampler.process(&in_ptr, input.size(), &out_ptr, length);
+    }
+
+    double signal = 0.0;
+    double noise = 0.0;
+
+    // 最初に無音から立ち上がる範囲は比べない
+    for (std::size_t idx = 1024; idx < out_length; ++idx) {
+        double const seconds = (static_cast<double>(idx) - resampler.latency_frames()) / output_sample_rate;
+        double const expected = std::sin(2.0 * M_PI * frequency * seconds);
+        signal += expected * expected;
+        noise += (output.at(idx) - expected) * (output.at(idx) - expected);
+    }
+
+    return 10.0 * std::log10(signal / noise);
+}
+
+static void measure_process(XCTestCase *test_case, double const input_sample_rate, double const output_sample_rate,
+                            uint32_t const ch_count) {
+    auto const resampler = std::make_shared<audio::resampler<float>>(input_sample_rate, output_sample_rate, ch_count,
+                                                                     resampler_quality::high);
+
+    auto const in_capacity = resampler->input_length_for_output(bench_length) + 1;
+    auto const inputs =
+        std::make_shared<std::vector<std::vector<float>>>(ch_count, std::vector<float>(in_capacity, 0.1f));
+    auto const outputs = std::make_shared<std::vector<std::vector<float>>>(ch_count, std::vector<float>(bench_length));
+    std::vector<float const *> in_ptrs;
+    std::vector<float *> out_ptrs;
+
+    for (uint32_t ch_idx = 0; ch_idx < ch_count; ++ch_idx) {
+        in_ptrs.push_back(inputs->at(ch_idx).data());
+        out_ptrs.push_back(outputs->at(ch_idx).data());
+    }
+
+    [test_case measureBlock:^{
+        for (uint32_t idx = 0; idx < bench_count; ++idx) {
+            auto const in_length = resampler->input_length_for_output(bench_length);
+            resampler->process(in_ptrs.data(), in_length, out_ptrs.data(), bench_length);
+        }
+    }];
+}
+}  // namespace yas::audio::test_utils::resampler
+
+@interface resampler_tests : XCTestCase
+
+@end
+
+@implementation resampler_tests
+
+- (void)test_make {
+    audio::resampler<float> const resampler{44100.0, 48000.0, 2, audio::resampler_quality::medium};
+
+    XCTAssertEqual(resampler.input_sample_rate(), 44100.0);
+    XCTAssertEqual(resampler.output_sample_rate(), 48000.0);
+    XCTAssertEqual(resampler.channel_count(), 2);
+    XCTAssertEqual(resampler.quality(), audio::resampler_quality::medium);
+    XCTAssertEqual(resampler.tap_count(), 32);
+    XCTAssertEqual(resampler.phase_count(), 160);
+}
+
+- (void)test_make_invalid {
+    XCTAssertThrows((audio::resampler<float>{0.0, 48000.0, 1, audio::resampler_quality::low}));
+    XCTAssertThrows((audio::resampler<float>{44100.0, 0.0, 1, audio::resampler_quality::low}));
+    XCTAssertThrows((audio::resampler<float>{44100.0, 48000.0, 0, audio::resampler_quality::low}));
+}
+
+- (void)test_tap_count_by_quality {
+    XCTAssertEqual((audio::resampler<float>{48000.0, 96000.0, 1, audio::resampler_quality::low}.tap_count()), 16);
+    XCTAssertEqual((audio::resampler<float>{48000.0, 96000.0, 1, audio::resampler_quality::high}.tap_count()), 64);
+
+    // 間引くときはタップを増やす
+    XCTAssertEqual((audio::resampler<float>{96000.0, 48000.0, 1, audio::resampler_quality::high}.tap_count()), 128);
+}
+
+- (void)test_interpolated_phase {
+    // 約分しても大きな比はフェーズの間を補間する
+    audio::resampler<double> const resampler{44100.0, 44101.0, 1, audio::resampler_quality::low};
+
+    XCTAssertEqual(resampler.phase_count(), 512);
+}
+
+- (void)test_latency {
+    audio::resampler<double> resampler{48000.0, 96000.0, 1, audio::resampler_quality::high};
+
+    XCTAssertEqual(resampler.latency_frames(), 64.0);
+    XCTAssertEqual(resampler.latency_seconds(), 64.0 / 96000.0);
+    XCTAssertEqual(audio::resampler_latency_frames(48000.0, 96000.0, audio::resampler_quality::high), 64.0);
+    XCTAssertEqual(audio::resampler_latency_frames(96000.0, 48000.0, audio::resampler_quality::high), 32.0);
+
+    std::vector<double> input(256, 0.0);
+    input.at(0) = 1.0;
+    std::vector<double> output(256, 0.0);
+
+    double const *const in_ptr = input.data();
+    double *const out_ptr = output.data();
+    resampler.process(&in_ptr, input.size(), &out_ptr, output.size());
+
+    // インパルスは遅れた位置で最も大きくなる
+    auto const peak_iterator = std::max_element(output.begin(), output.end());
+    XCTAssertEqual(std::distance(output.begin(), peak_iterator), 64);
+}
+
+- (void)test_input_length_for_output {
+    audio::resampler<float> resampler{96000.0, 48000.0, 1, audio::resampler_quality::low};
+
+    XCTAssertEqual(resampler.input_length_for_output(0), 0);
+
+    // 最初は無音を置いてあるので、窓の最後の1フレーム分から足りなくなる
+    XCTAssertEqual(resampler.input_length_for_output(1), 1);
+    XCTAssertEqual(resampler.input_length_for_output(4), 7);
+
+    std::vector<float> input(7, 1.0f);
+    std::vector<float> output(4);
+    float const *const in_ptr = input.data();
+    float *const out_ptr = output.data();
+    resampler.process(&in_ptr, input.size(), &out_ptr, output.size());
+
+    XCTAssertEqual(resampler.input_length_for_output(4), 8);
+}
+
+- (void)test_same_rate {
+    audio::resampler<float> resampler{48000.0, 48000.0, 1, audio::resampler_quality::low};
+
+    std::vector<float> input(32);
+    for (std::size_t idx = 0; idx < input.size(); ++idx) {
+        input.at(idx) = static_cast<float>(idx + 1);
+    }
+    std::vector<float> output(32);
+
+    float const *const in_ptr = input.data();
+    float *const out_ptr = output.data();
+    resampler.process(&in_ptr, input.size(), &out_ptr, output.size());
+
+    // 同じレートでは遅れるだけになる
+    auto const latency = static_cast<std::size_t>(resampler.latency_frames());
+    for (std::size_t idx = 0; idx < output.size(); ++idx) {
+        float const expected = idx < latency ? 0.0f : input.at(idx - latency);
+        XCTAssertEqualWithAccuracy(output.at(idx), expected, 1.0e-5f);
+    }
+}
+
+- (void)test_process_multiple_channels {
+    audio::resampler<float> resampler{44100.0, 48000.0, 2, audio::resampler_quality::medium};
+
+    auto const in_length = resampler.input_length_for_output(1024);
+    std::vector<float> left(in_length, 0.5f);
+    std::vector<float> right(in_length, -0.25f);
+    std::vector<float> left_out(1024);
+    std::vector<float> right_out(1024);
+
+    std::vector<float const *> const in_ptrs{left.data(), right.data()};
+    std::vector<float *> const out_ptrs{left_out.data(), right_out.data()};
+    resampler.process(in_ptrs.data(), in_length, out_ptrs.data(), 1024);
+
+    // 直流は立ち上がったあとそのまま出る
+    XCTAssertEqualWithAccuracy(left_out.at(1023), 0.5f, 1.0e-5f);
+    XCTAssertEqualWithAccuracy(right_out.at(1023), -0.25f, 1.0e-5f);
+}
+
+- (void)test_process_over_maximum_frames {
+    audio::resampler<float> resampler{44100.0, 48000.0, 1, audio::resampler_quality::low};
+    audio::resampler<float> small_resampler{44100.0, 48000.0, 1, audio::resampler_quality::low, 64};
+
+    XCTAssertEqual(small_resampler.maximum_frames(), 64);
+    XCTAssertGreaterThanOrEqual(small_resampler.maximum_input_length(), small_resampler.input_length_for_output(64));
+
+    auto const in_length = resampler.input_length_for_output(1000);
+    XCTAssertEqual(small_resampler.input_length_for_output(1000), in_length);
+
+    std::vector<float> input(in_length);
+    for (std::size_t idx = 0; idx < input.size(); ++idx) {
+        input.at(idx) = static_cast<float>(std::sin(static_cast<double>(idx) * 0.01));
+    }
+    std::vector<float> output(1000);
+    std::vector<float> small_output(1000);
+
+    float const *const in_ptr = input.data();
+    float *const out_ptr = output.data();
+    float *const small_out_ptr = small_output.data();
+    resampler.process(&in_ptr, input.size(), &out_ptr, output.size());
+    small_resampler.process(&in_ptr, input.size(), &small_out_ptr, small_output.size());
+
+    // maximum_framesより長い出力は分けて処理しても同じになる
+    for (std::size_t idx = 0; idx < output.size(); ++idx) {
+        XCTAssertEqual(small_output.at(idx), output.at(idx));
+    }
+}
+
+- (void)test_process_without_input {
+    audio::resampler<double> resampler{48000.0, 44100.0, 1, audio::resampler_quality::low};
+
+    std::vector<double> output(16, 1.0);
+    double *const out_ptr = output.data();
+    resampler.process(nullptr, 0, &out_ptr, output.size());
+
+    // 足りない入力は無音として扱う
+    for (auto const &value : output) {
+        XCTAssertEqual(value, 0.0);
+    }
+}
+
+- (void)test_reset {
+    audio::resampler<float> resampler{48000.0, 96000.0, 1, audio::resampler_quality::low};
+
+    std::vector<float> input(64, 1.0f);
+    std::vector<float> output(64);
+    float const *const in_ptr = input.data();
+    float *const out_ptr = output.data();
+    resampler.process(&in_ptr, input.size(), &out_ptr, output.size());
+
+    resampler.reset();
+
+    XCTAssertEqual(resampler.input_length_for_output(1), 1);
+
+    resampler.process(nullptr, 0, &out_ptr, output.size());
+
+    for (auto const &value : output) {
+        XCTAssertEqual(value, 0.0f);
+    }
+}
+
+- (void)test_signal_to_noise {
+    using namespace audio::test_utils::resampler;
+
+    for (std::size_t const chunk_length : {7, 512}) {
+        XCTAssertGreaterThan(signal_to_noise<double>(44100.0, 48000.0, audio::resampler_quality::low, chunk_length),
+                             70.0);
+        XCTAssertGreaterThan(
+            signal_to_noise<double>(48000.0, 44100.0, audio::resampler_quality::medium, chunk_length), 90.0);
+        XCTAssertGreaterThan(signal_to_noise<double>(48000.0, 96000.0, audio::resampler_quality::high, chunk_length),
+                             100.0);
+        XCTAssertGreaterThan(signal_to_noise<double>(96000.0, 48000.0, audio::resampler_quality::high, chunk_length),
+                             100.0);
+        XCTAssertGreaterThan(signal_to_noise<double>(44100.0, 44101.0, audio::resampler_quality::high, chunk_length),
+                             100.0);
+        XCTAssertGreaterThan(signal_to_noise<float>(44100.0, 48000.0, audio::resampler_quality::high, chunk_length),
+                             100.0);
+    }
+}
+
+- (void)test_process_44100_to_48000_stereo_performance {
+    audio::test_utils::resampler::measure_process(self, 44100.0, 48000.0, 2);
+}
+
+- (void)test_process_48000_to_44100_stereo_performance {
+    audio::test_utils::resampler::measure_process(self, 48000.0, 44100.0, 2);
+}
+
+- (void)test_process_48000_to_96000_8ch_performance {
+    audio::test_utils::resampler::measure_process(self, 48000.0, 96000.0, 8);
+}
+
+- (void)test_process_96000_to_48000_8ch_performance {
+    audio::test_utils::resampler::measure_process(self, 96000.0, 48000.0, 8);
+}
+
+@end
@@ -0,0 +1,85 @@
+//
+//  worker_pool_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/umbrella.hpp>
+#import <atomic>
+#import <mutex>
+#import <set>
+#import <thread>
+
+using namespace yas;
+
+@interface worker_pool_tests : XCTestCase
+
+@end
+
+@implementation worker_pool_tests
+
+- (void)test_make_shared {
+    XCTAssertEqual(audio::worker_pool::make_shared(2)->thread_count(), 2);
+    XCTAssertEqual(audio::worker_pool::make_shared(0)->thread_count(), 0);
+}
+
+- (void)test_parallel_for {
+    auto const pool = audio::worker_pool::make_shared(3);
+
+    for (std::size_t count = 0; count < 100; ++count) {
+        std::vector<std::size_t> values(count, 0);
+
+        pool->parallel_for(count, [&values](std::size_t const idx) { values.at(idx) += idx + 1; });
+
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            XCTAssertEqual(values.at(idx), idx + 1);
+        }
+    }
+}
+
+- (void)test_parallel_for_uses_threads {
+    auto const pool = audio::worker_pool::make_shared(3);
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic<std::size_t> waiting_count{0};
+
+    pool->parallel_for(4, [&mutex, &thread_ids, &waiting_count](std::size_t const) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            thread_ids.insert(std::this_thread::get_id());
+        }
+
+        // 4つが同時に走っていることを確かめる
+        ++waiting_count;
+        while (waiting_count < 4) {
+            std::this_thread::yield();
+        }
+    });
+
+    XCTAssertEqual(thread_ids.size(), 4);
+    XCTAssertTrue(thread_ids.count(std::this_thread::get_id()) > 0);
+}
+
+- (void)test_nested_parallel_for {
+    auto const pool = audio::worker_pool::make_shared(2);
+
+    std::atomic<std::size_t> total{0};
+
+    pool->parallel_for(3, [&pool, &total](std::size_t const) {
+        pool->parallel_for(5, [&total](std::size_t const) { ++total; });
+    });
+
+    XCTAssertEqual(total, 15);
+}
+
+- (void)test_rethrow_exception {
+    auto const pool = audio::worker_pool::make_shared(2);
+
+    XCTAssertThrows(pool->parallel_for(10, [](std::size_t const idx) {
+        if (idx == 5) {
+            throw std::runtime_error("error");
+        }
+    }));
+}
+
+@end
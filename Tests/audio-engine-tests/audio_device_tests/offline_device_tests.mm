@@ -41,4 +41,32 @@ using namespace yas;
     XCTAssertFalse(device->completion_handler().has_value());
 }
 
+- (void)test_pipeline {
+    auto format = audio::format({.sample_rate = 44100, .channel_count = 2});
+
+    auto const device = audio::offline_device::make_shared(
+        format, [](audio::offline_render_args) { return audio::continuation::abort; }, [](bool const) {});
+
+    XCTAssertFalse(device->pipeline().has_value());
+
+    auto const pipeline_device = audio::offline_device::make_shared(
+        format, [](audio::offline_render_args) { return audio::continuation::abort; }, [](bool const) {},
+        {.buffer_count = 8});
+
+    XCTAssertTrue(pipeline_device->pipeline().has_value());
+    XCTAssertEqual(pipeline_device->pipeline()->buffer_count, 8);
+    XCTAssertFalse(pipeline_device->pipeline()->stats_handler.has_value());
+}
+
+- (void)test_render_stats {
+    audio::offline_render_stats stats;
+
+    XCTAssertEqual(stats.frames_per_second(), 0.0);
+
+    stats.consumed_frames = 44100;
+    stats.elapsed_seconds = 0.5;
+
+    XCTAssertEqual(stats.frames_per_second(), 88200.0);
+}
+
 @end
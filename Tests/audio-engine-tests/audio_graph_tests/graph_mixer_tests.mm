@@ -0,0 +1,195 @@
+//
+//  graph_mixer_tests.mm
+//
+
+#import "../test_utils.h"
+
+using namespace yas;
+
+namespace yas::audio::test_utils::mixer {
+struct context {
+    audio::graph_ptr const graph = audio::graph::make_shared();
+    audio::graph_mixer_ptr const mixer = audio::graph_mixer::make_shared();
+    test::node_object output_obj{1, 0};
+    test::node_object input_obj{0, 1};
+    std::vector<test::node_object> source_objs;
+
+    context(audio::format const &format, std::vector<double> const &values) {
+        for (uint32_t idx = 0; idx < values.size(); ++idx) {
+            auto const &source_obj = this->source_objs.emplace_back(0, 1);
+            auto const value = values.at(idx);
+
+            source_obj.node->set_render_handler([value](audio::node_render_args const &args) {
+                auto *const buffer = args.buffer;
+                for (uint32_t buf_idx = 0; buf_idx < buffer->format().buffer_count(); ++buf_idx) {
+                    for (uint32_t frm_idx = 0; frm_idx < buffer->frame_length(); ++frm_idx) {
+                        if (buffer->format().pcm_format() == audio::pcm_format::float32) {
+                            buffer->data_ptr_at_index<float>(buf_idx)[frm_idx] = static_cast<float>(value);
+                        } else {
+                            buffer->data_ptr_at_index<double>(buf_idx)[frm_idx] = value;
+                        }
+                    }
+                }
+            });
+
+            this->graph->connect(source_obj.node, this->mixer->node, 0, idx, format);
+        }
+
+        this->graph->connect(this->mixer->node, this->output_obj.node, 0, 0, format);
+    }
+};
+}  // namespace yas::audio::test_utils::mixer
+
+@interface graph_mixer_tests : XCTestCase
+
+@end
+
+@implementation graph_mixer_tests
+
+- (void)test_parameters {
+    auto const mixer = audio::graph_mixer::make_shared();
+
+    XCTAssertEqual(mixer->output_volume(0), 1.0f);
+    XCTAssertEqual(mixer->output_pan(0), 0.0f);
+    XCTAssertEqual(mixer->input_volume(3), 1.0f);
+    XCTAssertEqual(mixer->input_pan(3), 0.0f);
+    XCTAssertTrue(mixer->input_enabled(3));
+
+    mixer->set_output_volume(0.5f, 0);
+    mixer->set_output_pan(-0.5f, 0);
+    mixer->set_input_volume(0.25f, 3);
+    mixer->set_input_pan(1.0f, 3);
+    mixer->set_input_enabled(false, 3);
+
+    XCTAssertEqual(mixer->output_volume(0), 0.5f);
+    XCTAssertEqual(mixer->output_pan(0), -0.5f);
+    XCTAssertEqual(mixer->input_volume(3), 0.25f);
+    XCTAssertEqual(mixer->input_pan(3), 1.0f);
+    XCTAssertFalse(mixer->input_enabled(3));
+
+    XCTAssertEqual(mixer->input_volume(2), 1.0f);
+
+    XCTAssertThrows(mixer->set_output_volume(1.0f, 1));
+    XCTAssertThrows(mixer->output_pan(1));
+}
+
+- (void)test_bus {
+    auto const mixer = audio::graph_mixer::make_shared();
+
+    XCTAssertEqual(mixer->node->input_bus_count(), std::numeric_limits<uint32_t>::max());
+    XCTAssertEqual(mixer->node->output_bus_count(), 1);
+}
+
+- (void)test_render {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::mixer::context context{format, {1.0, 2.0, 4.0}};
+    auto const &mixer = context.mixer;
+
+    mixer->set_input_volume(0.5f, 1);
+    mixer->set_input_pan(-1.0f, 2);
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{format, 8};
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0}));
+
+    // 左は 1 + 2 * 0.5 + 4、右は 1 + 2 * 0.5
+    for (uint32_t frm_idx = 0; frm_idx < 8; ++frm_idx) {
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[frm_idx], 6.0f);
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(1)[frm_idx], 2.0f);
+    }
+
+    mixer->set_input_enabled(false, 0);
+    mixer->set_output_volume(0.5f, 0);
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{8}));
+
+    // 変更した値へ直線的に変化する
+    auto const *const left_data = buffer.data_ptr_at_index<float>(0);
+    XCTAssertEqual(left_data[7], 2.5f);
+    for (uint32_t frm_idx = 1; frm_idx < 8; ++frm_idx) {
+        XCTAssertLessThan(left_data[frm_idx], left_data[frm_idx - 1]);
+    }
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{16}));
+
+    for (uint32_t frm_idx = 0; frm_idx < 8; ++frm_idx) {
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[frm_idx], 2.5f);
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(1)[frm_idx], 0.5f);
+    }
+}
+
+- (void)test_render_float64 {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 1, .pcm_format = audio::pcm_format::float64}};
+    audio::test_utils::mixer::context context{format, {0.25, 0.5}};
+
+    context.mixer->set_input_pan(1.0f, 0);
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{format, 4};
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0}));
+
+    // 1チャンネルではパンを反映しない
+    for (uint32_t frm_idx = 0; frm_idx < 4; ++frm_idx) {
+        XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[frm_idx], 0.75);
+    }
+}
+
+- (void)test_render_over_maximum_frames {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 1}};
+    audio::test_utils::mixer::context context{format, {1.0, 2.0}};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node, 8};
+    auto const *const output_node = rendering_graph.output_node();
+
+    audio::pcm_buffer buffer{format, 8};
+    XCTAssertTrue(output_node->render(&buffer, audio::time{0}));
+    XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[7], 3.0f);
+
+    // 準備したフレーム数を超える描画では確保し直さずに無音にする
+    audio::pcm_buffer long_buffer{format, 16};
+    XCTAssertTrue(output_node->render(&long_buffer, audio::time{8}));
+
+    for (uint32_t frm_idx = 0; frm_idx < 16; ++frm_idx) {
+        XCTAssertEqual(long_buffer.data_ptr_at_index<float>(0)[frm_idx], 0.0f);
+    }
+}
+
+- (void)test_render_64_buses_float32_performance {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::mixer::context context{format, std::vector<double>(64, 0.01)};
+
+    for (uint32_t idx = 0; idx < 64; ++idx) {
+        context.mixer->set_input_pan(static_cast<float>(idx) / 32.0f - 1.0f, idx);
+    }
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+    auto const *const output_node = rendering_graph.output_node();
+    auto const buffer = std::make_shared<audio::pcm_buffer>(format, 512);
+    auto const mixer = context.mixer;
+
+    [self measureBlock:^{
+        for (uint32_t idx = 0; idx < 1000; ++idx) {
+            mixer->set_output_volume((idx % 2) ? 1.0f : 0.5f, 0);
+            output_node->render(buffer.get(), audio::time{idx * 512});
+        }
+    }];
+}
+
+- (void)test_render_64_buses_float64_performance {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2, .pcm_format = audio::pcm_format::float64}};
+    audio::test_utils::mixer::context context{format, std::vector<double>(64, 0.01)};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+    auto const *const output_node = rendering_graph.output_node();
+    auto const buffer = std::make_shared<audio::pcm_buffer>(format, 512);
+
+    [self measureBlock:^{
+        for (uint32_t idx = 0; idx < 1000; ++idx) {
+            output_node->render(buffer.get(), audio::time{idx * 512});
+        }
+    }];
+}
+
+@end
@@ -2,7 +2,9 @@
 //  graph_offline_io_tests.mm
 //
 
+#include <cmath>
 #include <future>
+#include <thread>
 #import "../test_utils.h"
 
 using namespace yas;
@@ -181,4 +183,289 @@ using namespace yas;
     XCTAssertFalse(graph->io().value()->raw_io()->is_running());
 }
 
+- (void)test_offline_render_parallel_branches {
+    auto graph = audio::graph::make_shared();
+
+    double const sample_rate = 44100.0;
+    auto const format = audio::format({.sample_rate = sample_rate, .channel_count = 2});
+    uint32_t const frames_per_render = 256;
+    uint32_t const length = 4096;
+    uint32_t const branch_count = 4;
+
+    test::node_object mixer_obj(branch_count, 1);
+    std::vector<test::node_object> source_objs;
+
+    for (uint32_t idx = 0; idx < branch_count; ++idx) {
+        auto const &source_obj = source_objs.emplace_back(0, 1);
+
+        source_obj.node->set_render_handler([idx](audio::node_render_args const &args) {
+            for (uint32_t buf_idx = 0; buf_idx < args.buffer->format().buffer_count(); ++buf_idx) {
+                auto *const data = args.buffer->data_ptr_at_index<float>(buf_idx);
+                for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                    data[frm_idx] = static_cast<float>(idx + 1);
+                }
+            }
+        });
+
+        graph->connect(source_obj.node, mixer_obj.node, 0, idx, format);
+    }
+
+    mixer_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        audio::pcm_buffer branch_buffer{args.buffer->format(), args.buffer->frame_length()};
+        args.buffer->clear();
+
+        for (auto const &pair : args.source_connections) {
+            pair.second.render(&branch_buffer, args.time);
+
+            for (uint32_t buf_idx = 0; buf_idx < args.buffer->format().buffer_count(); ++buf_idx) {
+                auto *const data = args.buffer->data_ptr_at_index<float>(buf_idx);
+                auto const *const branch_data = branch_buffer.data_ptr_at_index<float>(buf_idx);
+                for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                    data[frm_idx] += branch_data[frm_idx];
+                }
+            }
+        }
+    });
+
+    XCTestExpectation *completionExpectation = [self expectationWithDescription:@"offline render completion"];
+
+    uint32_t output_render_frame = 0;
+
+    auto render_handler = [&self, &output_render_frame](audio::offline_render_args args) {
+        auto &buffer = args.output_buffer;
+
+        for (uint32_t buf_idx = 0; buf_idx < buffer->format().buffer_count(); ++buf_idx) {
+            auto const *const data = buffer->data_ptr_at_index<float>(buf_idx);
+            for (uint32_t frm_idx = 0; frm_idx < buffer->frame_length(); ++frm_idx) {
+                if (data[frm_idx] != 10.0f) {
+                    XCTAssertEqual(data[frm_idx], 10.0f);
+                    return audio::continuation::abort;
+                }
+            }
+        }
+
+        output_render_frame += buffer->frame_length();
+        return output_render_frame >= length ? audio::continuation::abort : audio::continuation::keep;
+    };
+
+    auto completion_handler = [&completionExpectation](bool const) {
+        [completionExpectation fulfill];
+        completionExpectation = nil;
+    };
+
+    auto const device = audio::offline_device::make_shared(format, render_handler, completion_handler);
+    auto const offline_io = graph->add_io(device);
+    offline_io->raw_io()->set_maximum_frames_per_slice(frames_per_render);
+    offline_io->set_rendering_worker_pool(audio::rendering_worker_pool::make_shared(3));
+
+    graph->connect(mixer_obj.node, offline_io->output_node, format);
+
+    XCTAssertTrue(graph->start_render());
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(output_render_frame, length);
+}
+
+- (void)test_offline_render_pipeline {
+    auto graph = audio::graph::make_shared();
+
+    double const sample_rate = 44100.0;
+    auto const format = audio::format({.sample_rate = sample_rate, .channel_count = 2});
+    uint32_t const frames_per_render = 256;
+    uint32_t const length = 8192;
+
+    test::node_object source_obj(0, 1);
+
+    // サンプル位置をそのまま値にする
+    source_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        auto const frame = args.time.sample_time();
+        for (uint32_t buf_idx = 0; buf_idx < args.buffer->format().buffer_count(); ++buf_idx) {
+            auto *const data = args.buffer->data_ptr_at_index<float>(buf_idx);
+            for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                data[frm_idx] = static_cast<float>(frame + frm_idx);
+            }
+        }
+    });
+
+    XCTestExpectation *completionExpectation = [self expectationWithDescription:@"offline render completion"];
+
+    uint32_t output_render_frame = 0;
+    std::optional<audio::offline_render_stats> stats = std::nullopt;
+    std::thread::id render_thread_id;
+
+    auto render_handler = [&self, &output_render_frame, &render_thread_id,
+                           frames_per_render](audio::offline_render_args args) {
+        auto const &buffer = args.output_buffer;
+
+        XCTAssertEqual(args.output_time.sample_time(), output_render_frame);
+        XCTAssertEqual(buffer->frame_length(), frames_per_render);
+
+        for (uint32_t buf_idx = 0; buf_idx < buffer->format().buffer_count(); ++buf_idx) {
+            auto const *const data = buffer->data_ptr_at_index<float>(buf_idx);
+            XCTAssertEqual(data[0], static_cast<float>(output_render_frame));
+            XCTAssertEqual(data[frames_per_render - 1], static_cast<float>(output_render_frame + frames_per_render - 1));
+        }
+
+        render_thread_id = std::this_thread::get_id();
+
+        output_render_frame += buffer->frame_length();
+        return output_render_frame >= length ? audio::continuation::abort : audio::continuation::keep;
+    };
+
+    auto completion_handler = [&self, &completionExpectation, &stats](bool const cancelled) {
+        XCTAssertFalse(cancelled);
+        XCTAssertTrue(stats.has_value());
+        [completionExpectation fulfill];
+        completionExpectation = nil;
+    };
+
+    auto const device = audio::offline_device::make_shared(
+        format, render_handler, completion_handler,
+        {.buffer_count = 3, .stats_handler = [&stats](audio::offline_render_stats const &value) { stats = value; }});
+    auto const offline_io = graph->add_io(device);
+    offline_io->raw_io()->set_maximum_frames_per_slice(frames_per_render);
+
+    graph->connect(source_obj.node, offline_io->output_node, format);
+
+    XCTAssertTrue(graph->start_render());
+
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(output_render_frame, length);
+    XCTAssertNotEqual(render_thread_id, std::this_thread::get_id());
+
+    XCTAssertTrue(stats.has_value());
+    XCTAssertEqual(stats->consumed_frames, length);
+    // 先行して描画できるのはキューの長さと描画中の1つ分まで
+    XCTAssertGreaterThanOrEqual(stats->rendered_frames, length);
+    XCTAssertLessThanOrEqual(stats->rendered_frames, length + frames_per_render * 4);
+    XCTAssertGreaterThan(stats->elapsed_seconds, 0.0);
+    XCTAssertGreaterThan(stats->frames_per_second(), 0.0);
+}
+
+- (void)test_cancel_offline_render_pipeline {
+    auto graph = audio::graph::make_shared();
+
+    auto const format = audio::format({.sample_rate = 44100.0, .channel_count = 2});
+
+    test::node_object source_obj(0, 1);
+    source_obj.node->set_render_handler([](audio::node_render_args const &) {});
+
+    XCTestExpectation *renderExpectation = [self expectationWithDescription:@"offline render"];
+    renderExpectation.assertForOverFulfill = NO;
+
+    auto render_handler = [&renderExpectation](audio::offline_render_args) {
+        [renderExpectation fulfill];
+        return audio::continuation::keep;
+    };
+
+    XCTestExpectation *completionExpectation = [self expectationWithDescription:@"offline render completion"];
+
+    auto completion_handler = [&self, &completionExpectation](bool const cancelled) {
+        XCTAssertTrue(cancelled);
+        [completionExpectation fulfill];
+        completionExpectation = nil;
+    };
+
+    auto const device =
+        audio::offline_device::make_shared(format, render_handler, completion_handler, {.buffer_count = 2});
+    auto const offline_io = graph->add_io(device);
+
+    graph->connect(source_obj.node, offline_io->output_node, format);
+
+    XCTAssertTrue(graph->start_render());
+
+    [self waitForExpectations:@[renderExpectation] timeout:10.0];
+
+    graph->stop();
+
+    [self waitForExpectations:@[completionExpectation] timeout:10.0];
+
+    XCTAssertFalse(graph->io().value()->raw_io()->is_running());
+}
+
+- (void)test_offline_render_diamond_graph_performance {
+    double const sample_rate = 44100.0;
+    auto const format = audio::format({.sample_rate = sample_rate, .channel_count = 2});
+    uint32_t const frames_per_render = 512;
+    uint32_t const length = 44100 * 10;
+    uint32_t const branch_count = 4;
+
+    auto const pull_handler = [](audio::node_render_args const &args) {
+        args.source_connections.at(0).render(args.buffer, args.time);
+    };
+
+    [self measureBlock:^{
+        auto graph = audio::graph::make_shared();
+
+        // 重めの処理をするソースを分岐させてから1つにまとめる
+        test::node_object source_obj(0, 1);
+        test::node_object splitter_obj(1, branch_count);
+        test::node_object mixer_obj(branch_count, 1);
+        std::vector<test::node_object> branch_objs;
+
+        source_obj.node->set_render_handler([](audio::node_render_args const &args) {
+            auto const frame = args.time.sample_time();
+            for (uint32_t buf_idx = 0; buf_idx < args.buffer->format().buffer_count(); ++buf_idx) {
+                auto *const data = args.buffer->data_ptr_at_index<float>(buf_idx);
+                for (uint32_t idx = 0; idx < args.buffer->frame_length(); ++idx) {
+                    data[idx] = std::sin(static_cast<float>(frame + idx) * 0.01f);
+                }
+            }
+        });
+
+        splitter_obj.node->set_render_handler(pull_handler);
+
+        mixer_obj.node->set_render_handler([](audio::node_render_args const &args) {
+            audio::pcm_buffer branch_buffer{args.buffer->format(), args.buffer->frame_length()};
+            args.buffer->clear();
+
+            for (auto const &pair : args.source_connections) {
+                pair.second.render(&branch_buffer, args.time);
+
+                for (uint32_t buf_idx = 0; buf_idx < args.buffer->format().buffer_count(); ++buf_idx) {
+                    auto *const data = args.buffer->data_ptr_at_index<float>(buf_idx);
+                    auto const *const branch_data = branch_buffer.data_ptr_at_index<float>(buf_idx);
+                    for (uint32_t idx = 0; idx < args.buffer->frame_length(); ++idx) {
+                        data[idx] += branch_data[idx];
+                    }
+                }
+            }
+        });
+
+        graph->connect(source_obj.node, splitter_obj.node, 0, 0, format);
+
+        for (uint32_t idx = 0; idx < branch_count; ++idx) {
+            auto const &branch_obj = branch_objs.emplace_back(1, 1);
+            branch_obj.node->set_render_handler(pull_handler);
+            graph->connect(splitter_obj.node, branch_obj.node, idx, 0, format);
+            graph->connect(branch_obj.node, mixer_obj.node, 0, idx, format);
+        }
+
+        XCTestExpectation *completionExpectation = [self expectationWithDescription:@"offline render completion"];
+
+        auto render_frame = std::make_shared<uint32_t>(0);
+
+        auto render_handler = [render_frame, length](audio::offline_render_args args) {
+            *render_frame += args.output_buffer->frame_length();
+            return *render_frame >= length ? audio::continuation::abort : audio::continuation::keep;
+        };
+
+        auto completion_handler = [completionExpectation](bool const) { [completionExpectation fulfill]; };
+
+        auto const device = audio::offline_device::make_shared(format, render_handler, completion_handler);
+        auto const offline_io = graph->add_io(device);
+        offline_io->raw_io()->set_maximum_frames_per_slice(frames_per_render);
+
+        graph->connect(mixer_obj.node, offline_io->output_node, format);
+
+        XCTAssertTrue(graph->start_render());
+
+        [self waitForExpectations:@[completionExpectation] timeout:30.0];
+
+        graph->stop();
+    }];
+}
+
 @end
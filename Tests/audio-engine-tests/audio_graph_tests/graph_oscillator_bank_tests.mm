@@ -0,0 +1,123 @@
+//
+//  graph_oscillator_bank_tests.mm
+//
+
+#import "../test_utils.h"
+
+using namespace yas;
+
+namespace yas::audio::test_utils::oscillator_bank_node {
+struct context {
+    audio::graph_ptr const graph = audio::graph::make_shared();
+    audio::graph_oscillator_bank_ptr const oscillator_bank = audio::graph_oscillator_bank::make_shared();
+    test::node_object output_obj{1, 0};
+    test::node_object input_obj{0, 1};
+
+    context(audio::format const &format, std::vector<audio::oscillator_voice> voices) {
+        this->oscillator_bank->set_voices(std::move(voices));
+        this->graph->connect(this->oscillator_bank->node, this->output_obj.node, 0, 0, format);
+    }
+};
+}  // namespace yas::audio::test_utils::oscillator_bank_node
+
+@interface graph_oscillator_bank_tests : XCTestCase
+
+@end
+
+@implementation graph_oscillator_bank_tests
+
+- (void)test_make {
+    auto const oscillator_bank = audio::graph_oscillator_bank::make_shared();
+
+    XCTAssertEqual(oscillator_bank->node->input_bus_count(), 0);
+    XCTAssertEqual(oscillator_bank->node->output_bus_count(), 1);
+    XCTAssertEqual(oscillator_bank->voices().size(), 0);
+    XCTAssertEqual(oscillator_bank->table().size(), 0);
+
+    oscillator_bank->set_voices({{.channel = 1, .frequency = 440.0}});
+    oscillator_bank->set_table({0.0, 1.0});
+
+    XCTAssertEqual(oscillator_bank->voices().size(), 1);
+    XCTAssertEqual(oscillator_bank->voices().at(0).channel, 1);
+    XCTAssertEqual(oscillator_bank->voices().at(0).frequency, 440.0);
+    XCTAssertEqual(oscillator_bank->table(), (std::vector<double>{0.0, 1.0}));
+}
+
+- (void)test_render {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::oscillator_bank_node::context context{
+        format, {{.channel = 0, .frequency = 1000.0}, {.channel = 1, .frequency = 100.0, .gain = 0.5},
+                 // 出力のチャンネル数を超える発振器は使わない
+                 {.channel = 2, .frequency = 100.0}}};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{format, 256};
+
+    for (int64_t idx = 0; idx < 2; ++idx) {
+        XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{idx * 256, 48000.0}));
+    }
+
+    // 描画を続けると位置も続く
+    for (uint32_t frm_idx = 0; frm_idx < 256; ++frm_idx) {
+        double const time = static_cast<double>(frm_idx + 256) / 48000.0;
+        XCTAssertEqualWithAccuracy(buffer.data_ptr_at_index<float>(0)[frm_idx],
+                                   std::sin(audio::math::two_pi * 1000.0 * time), 1.0e-5);
+        XCTAssertEqualWithAccuracy(buffer.data_ptr_at_index<float>(1)[frm_idx],
+                                   0.5 * std::sin(audio::math::two_pi * 100.0 * time), 1.0e-5);
+    }
+}
+
+- (void)test_render_float64_table {
+    audio::format const format{{.sample_rate = 4.0, .channel_count = 1, .pcm_format = audio::pcm_format::float64}};
+    audio::test_utils::oscillator_bank_node::context context{
+        format, {{.waveform = audio::oscillator_waveform::table, .frequency = 1.0}}};
+    context.oscillator_bank->set_table({0.0, 1.0});
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{format, 4};
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0, 4.0}));
+
+    XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[0], 0.0);
+    XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[1], 0.5);
+    XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[2], 1.0);
+    XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[3], 0.5);
+}
+
+- (void)test_render_unsupported {
+    audio::format const format{
+        {.sample_rate = 48000.0, .channel_count = 2, .pcm_format = audio::pcm_format::int16, .interleaved = true}};
+    audio::test_utils::oscillator_bank_node::context context{format, {{.frequency = 1000.0}}};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{format, 16};
+    test::fill_test_values_to_buffer(buffer);
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0, 48000.0}));
+
+    XCTAssertTrue(test::is_cleared_buffer(buffer));
+}
+
+- (void)test_render_256_voices_performance {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+
+    std::vector<audio::oscillator_voice> voices;
+    for (uint32_t idx = 0; idx < 256; ++idx) {
+        voices.push_back({.channel = idx % 2, .frequency = 100.0 + idx * 37.0, .gain = 1.0 / 256.0});
+    }
+
+    auto const context = std::make_shared<audio::test_utils::oscillator_bank_node::context>(format, std::move(voices));
+    auto const rendering_graph =
+        std::make_shared<audio::rendering_graph>(context->output_obj.node, context->input_obj.node);
+    auto const buffer = std::make_shared<audio::pcm_buffer>(format, 512);
+
+    [self measureBlock:^{
+        for (int64_t idx = 0; idx < 100; ++idx) {
+            rendering_graph->output_node()->render(buffer.get(), audio::time{idx * 512, 48000.0});
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,245 @@
+//
+//  graph_resampler_tests.mm
+//
+
+#import "../test_utils.h"
+
+using namespace yas;
+
+namespace yas::audio::test_utils::resampler_node {
+struct context {
+    audio::graph_ptr const graph = audio::graph::make_shared();
+    audio::graph_resampler_ptr const resampler;
+    test::node_object output_obj{1, 0};
+    test::node_object input_obj{0, 1};
+    test::node_object source_obj{0, 1};
+    std::vector<std::pair<int64_t, uint32_t>> source_times;
+
+    context(audio::format const &input_format, audio::format const &output_format,
+            audio::resampler_quality const quality = audio::resampler_quality::high)
+        : resampler(audio::graph_resampler::make_shared(quality)) {
+        this->source_obj.node->set_render_handler([this](audio::node_render_args const &args) {
+            auto *const buffer = args.buffer;
+
+            if (args.time.is_sample_time_valid()) {
+                this->source_times.emplace_back(args.time.sample_time(), buffer->frame_length());
+            }
+
+            // チャンネルごとに違う直流を出す
+            for (uint32_t ch_idx = 0; ch_idx < buffer->format().channel_count(); ++ch_idx) {
+                double const value = 0.5 / static_cast<double>(ch_idx + 1);
+                for (uint32_t frm_idx = 0; frm_idx < buffer->frame_length(); ++frm_idx) {
+                    if (buffer->format().pcm_format() == audio::pcm_format::float32) {
+                        buffer->data_ptr_at_index<float>(ch_idx)[frm_idx] = static_cast<float>(value);
+                    } else {
+                        buffer->data_ptr_at_index<double>(ch_idx)[frm_idx] = value;
+                    }
+                }
+            }
+        });
+
+        this->graph->connect(this->source_obj.node, this->resampler->node, 0, 0, input_format);
+        this->graph->connect(this->resampler->node, this->output_obj.node, 0, 0, output_format);
+    }
+};
+
+static void measure_render(XCTestCase *test_case, double const input_sample_rate, double const output_sample_rate,
+                           uint32_t const ch_count) {
+    audio::format const input_format{{.sample_rate = input_sample_rate, .channel_count = ch_count}};
+    audio::format const output_format{{.sample_rate = output_sample_rate, .channel_count = ch_count}};
+    auto const context = std::make_shared<resampler_node::context>(input_format, output_format);
+
+    auto const rendering_graph =
+        std::make_shared<audio::rendering_graph>(context->output_obj.node, context->input_obj.node);
+    auto const buffer = std::make_shared<audio::pcm_buffer>(output_format, 512);
+
+    [test_case measureBlock:^{
+        for (int64_t idx = 0; idx < 1000; ++idx) {
+            rendering_graph->output_node()->render(buffer.get(), audio::time{idx * 512, output_sample_rate});
+        }
+    }];
+}
+}  // namespace yas::audio::test_utils::resampler_node
+
+@interface graph_resampler_tests : XCTestCase
+
+@end
+
+@implementation graph_resampler_tests
+
+- (void)test_make {
+    auto const resampler = audio::graph_resampler::make_shared();
+
+    XCTAssertEqual(resampler->quality(), audio::resampler_quality::high);
+    XCTAssertEqual(resampler->node->input_bus_count(), 1);
+    XCTAssertEqual(resampler->node->output_bus_count(), 1);
+
+    resampler->set_quality(audio::resampler_quality::low);
+
+    XCTAssertEqual(resampler->quality(), audio::resampler_quality::low);
+    XCTAssertEqual(audio::graph_resampler::make_shared(audio::resampler_quality::medium)->quality(),
+                   audio::resampler_quality::medium);
+}
+
+- (void)test_latency {
+    audio::format const input_format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::format const output_format{{.sample_rate = 96000.0, .channel_count = 2}};
+
+    XCTAssertEqual(audio::graph_resampler::make_shared()->latency_frames(), 0.0);
+
+    audio::test_utils::resampler_node::context context{input_format, output_format};
+    auto const &resampler = context.resampler;
+
+    XCTAssertEqual(resampler->latency_frames(), 64.0);
+    XCTAssertEqual(resampler->latency_seconds(), 64.0 / 96000.0);
+
+    resampler->set_quality(audio::resampler_quality::low);
+
+    XCTAssertEqual(resampler->latency_frames(), 16.0);
+}
+
+- (void)test_latency_same_rate {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::resampler_node::context context{format, format};
+
+    XCTAssertEqual(context.resampler->latency_frames(), 0.0);
+}
+
+- (void)test_render {
+    audio::format const input_format{{.sample_rate = 44100.0, .channel_count = 2}};
+    audio::format const output_format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::resampler_node::context context{input_format, output_format};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{output_format, 512};
+
+    for (int64_t idx = 0; idx < 4; ++idx) {
+        XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{idx * 512, 48000.0}));
+    }
+
+    // 遅れを過ぎれば入力の直流がそのまま出る
+    for (uint32_t frm_idx = 0; frm_idx < 512; ++frm_idx) {
+        XCTAssertEqualWithAccuracy(buffer.data_ptr_at_index<float>(0)[frm_idx], 0.5f, 1.0e-5f);
+        XCTAssertEqualWithAccuracy(buffer.data_ptr_at_index<float>(1)[frm_idx], 0.25f, 1.0e-5f);
+    }
+}
+
+- (void)test_render_float64 {
+    audio::format const input_format{
+        {.sample_rate = 96000.0, .channel_count = 1, .pcm_format = audio::pcm_format::float64}};
+    audio::format const output_format{
+        {.sample_rate = 48000.0, .channel_count = 1, .pcm_format = audio::pcm_format::float64}};
+    audio::test_utils::resampler_node::context context{input_format, output_format};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{output_format, 256};
+
+    for (int64_t idx = 0; idx < 2; ++idx) {
+        XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{idx * 256, 48000.0}));
+    }
+
+    for (uint32_t frm_idx = 0; frm_idx < 256; ++frm_idx) {
+        XCTAssertEqualWithAccuracy(buffer.data_ptr_at_index<double>(0)[frm_idx], 0.5, 1.0e-9);
+    }
+}
+
+- (void)test_render_input_time {
+    audio::format const input_format{{.sample_rate = 48000.0, .channel_count = 1}};
+    audio::format const output_format{{.sample_rate = 96000.0, .channel_count = 1}};
+    audio::test_utils::resampler_node::context context{input_format, output_format};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{output_format, 512};
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{1024, 96000.0}));
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{1536, 96000.0}));
+
+    XCTAssertEqual(context.source_times.size(), 2);
+    XCTAssertEqual(context.source_times.at(0).first, 512);
+    XCTAssertEqual(context.source_times.at(1).first, 512 + context.source_times.at(0).second);
+    XCTAssertEqual(context.source_times.at(0).second + context.source_times.at(1).second, 512);
+
+    // 時間が途切れたら変換後の時間から読み直す
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{4096, 96000.0}));
+
+    XCTAssertEqual(context.source_times.size(), 3);
+    XCTAssertEqual(context.source_times.at(2).first, 2048);
+}
+
+- (void)test_render_same_rate {
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::resampler_node::context context{format, format};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{format, 16};
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0, 48000.0}));
+
+    // 変換せずにそのまま渡すので遅れない
+    for (uint32_t frm_idx = 0; frm_idx < 16; ++frm_idx) {
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[frm_idx], 0.5f);
+        XCTAssertEqual(buffer.data_ptr_at_index<float>(1)[frm_idx], 0.25f);
+    }
+}
+
+- (void)test_render_over_maximum_frames {
+    audio::format const input_format{{.sample_rate = 44100.0, .channel_count = 1}};
+    audio::format const output_format{{.sample_rate = 48000.0, .channel_count = 1}};
+    audio::test_utils::resampler_node::context context{input_format, output_format};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node, 256};
+
+    // 準備したフレーム数を超える描画では確保し直さずに無音にする
+    audio::pcm_buffer buffer{output_format, 512};
+    test::fill_test_values_to_buffer(buffer);
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0, 48000.0}));
+
+    XCTAssertTrue(test::is_cleared_buffer(buffer));
+    XCTAssertEqual(context.source_times.size(), 0);
+
+    buffer.set_frame_length(256);
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0, 48000.0}));
+
+    XCTAssertEqual(context.source_times.size(), 1);
+}
+
+- (void)test_render_unsupported {
+    audio::format const input_format{{.sample_rate = 44100.0, .channel_count = 1}};
+    audio::format const output_format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::test_utils::resampler_node::context context{input_format, output_format};
+
+    XCTAssertEqual(context.resampler->latency_frames(), 0.0);
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+
+    audio::pcm_buffer buffer{output_format, 16};
+    test::fill_test_values_to_buffer(buffer);
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0, 48000.0}));
+
+    XCTAssertTrue(test::is_cleared_buffer(buffer));
+    XCTAssertEqual(context.source_times.size(), 0);
+}
+
+- (void)test_render_44100_to_48000_stereo_performance {
+    audio::test_utils::resampler_node::measure_render(self, 44100.0, 48000.0, 2);
+}
+
+- (void)test_render_48000_to_44100_stereo_performance {
+    audio::test_utils::resampler_node::measure_render(self, 48000.0, 44100.0, 2);
+}
+
+- (void)test_render_48000_to_96000_8ch_performance {
+    audio::test_utils::resampler_node::measure_render(self, 48000.0, 96000.0, 8);
+}
+
+- (void)test_render_96000_to_48000_8ch_performance {
+    audio::test_utils::resampler_node::measure_render(self, 96000.0, 48000.0, 8);
+}
+
+@end
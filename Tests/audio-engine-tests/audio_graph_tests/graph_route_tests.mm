@@ -2,10 +2,48 @@
 //  route_tests.m
 //
 
+#import "../allocation_counter.h"
 #import "../test_utils.h"
 
 using namespace yas;
 
+namespace yas::audio::test_utils::route {
+struct context {
+    audio::graph_ptr const graph = audio::graph::make_shared();
+    audio::graph_route_ptr const route = audio::graph_route::make_shared();
+    test::node_object output_obj{1, 0};
+    test::node_object input_obj{0, 1};
+    std::vector<test::node_object> source_objs;
+
+    // 入力のバスごとにバス番号+1の値で埋めるモノラルのソースをつなぎ、出力の同じ番号のチャンネルへルートを張る
+    explicit context(uint32_t const src_count) {
+        audio::format const src_format{{.sample_rate = 48000.0, .channel_count = 1}};
+        audio::format const dst_format{{.sample_rate = 48000.0, .channel_count = src_count}};
+
+        audio::route_set_t routes;
+
+        for (uint32_t idx = 0; idx < src_count; ++idx) {
+            auto const &source_obj = this->source_objs.emplace_back(0, 1);
+            float const value = static_cast<float>(idx + 1);
+
+            source_obj.node->set_render_handler([value](audio::node_render_args const &args) {
+                auto *const data = args.buffer->data_ptr_at_index<float>(0);
+                for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                    data[frm_idx] = value;
+                }
+            });
+
+            this->graph->connect(source_obj.node, this->route->node, 0, idx, src_format);
+            routes.insert(audio::route{idx, 0, 0, idx});
+        }
+
+        this->route->set_routes(std::move(routes));
+
+        this->graph->connect(this->route->node, this->output_obj.node, 0, 0, dst_format);
+    }
+};
+}  // namespace yas::audio::test_utils::route
+
 @interface graph_route_tests : XCTestCase
 
 @end
@@ -274,4 +312,143 @@ using namespace yas;
     }
 }
 
+- (void)test_render_many_routes {
+    uint32_t const src_count = 128;
+    audio::test_utils::route::context context{src_count};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+    auto const *const output_node = rendering_graph.output_node();
+
+    audio::format const format{{.sample_rate = 48000.0, .channel_count = src_count}};
+
+    // 最初に用意した長さを超えるスライスも描画できる
+    for (uint32_t const frame_length : {512, 8192, 256}) {
+        audio::pcm_buffer buffer{format, frame_length};
+
+        XCTAssertTrue(output_node->render(&buffer, audio::time{0}));
+
+        for (uint32_t ch_idx = 0; ch_idx < src_count; ++ch_idx) {
+            auto const *const data = buffer.data_ptr_at_index<float>(ch_idx);
+            XCTAssertEqual(data[0], static_cast<float>(ch_idx + 1));
+            XCTAssertEqual(data[frame_length - 1], static_cast<float>(ch_idx + 1));
+        }
+    }
+}
+
+- (void)test_render_above_default_frames_without_allocation {
+    uint32_t const src_count = 2;
+    uint32_t const maximum_frames = audio::rendering_graph::default_maximum_frames * 2;
+    audio::test_utils::route::context context{src_count};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node, maximum_frames};
+    auto const *const output_node = rendering_graph.output_node();
+    audio::pcm_buffer buffer{audio::format{{.sample_rate = 48000.0, .channel_count = src_count}}, maximum_frames};
+
+    // 最初の描画から描画スレッドで確保しない
+    bool result = false;
+    auto const allocation = test::count_allocations(
+        [&result, &output_node, &buffer] { result = output_node->render(&buffer, audio::time{0}); });
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(allocation.count, 0);
+
+    for (uint32_t ch_idx = 0; ch_idx < src_count; ++ch_idx) {
+        auto const *const data = buffer.data_ptr_at_index<float>(ch_idx);
+        XCTAssertEqual(data[0], static_cast<float>(ch_idx + 1));
+        XCTAssertEqual(data[maximum_frames - 1], static_cast<float>(ch_idx + 1));
+    }
+}
+
+- (void)test_render_slice_longer_than_maximum_frames {
+    uint32_t const maximum_frames = 256;
+    audio::test_utils::route::context context{1};
+
+    std::vector<std::pair<uint32_t, int64_t>> called;
+    called.reserve(4);
+
+    context.source_objs.at(0).node->set_render_handler([&called](audio::node_render_args const &args) {
+        called.emplace_back(args.buffer->frame_length(), args.time.sample_time());
+
+        auto *const data = args.buffer->data_ptr_at_index<float>(0);
+        for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+            data[frm_idx] = static_cast<float>(args.time.sample_time() + frm_idx);
+        }
+    });
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node, maximum_frames};
+    audio::pcm_buffer buffer{audio::format{{.sample_rate = 48000.0, .channel_count = 1}}, 600};
+
+    bool result = false;
+    auto const allocation = test::count_allocations([&result, &rendering_graph, &buffer] {
+        result = rendering_graph.output_node()->render(&buffer, audio::time{100, 48000.0});
+    });
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(allocation.count, 0);
+
+    // 確保し直さずに、maximum_framesずつ時間をずらして描画する
+    XCTAssertEqual(called.size(), 3);
+    XCTAssertEqual(called.at(0).first, 256);
+    XCTAssertEqual(called.at(0).second, 100);
+    XCTAssertEqual(called.at(1).first, 256);
+    XCTAssertEqual(called.at(1).second, 356);
+    XCTAssertEqual(called.at(2).first, 88);
+    XCTAssertEqual(called.at(2).second, 612);
+
+    auto const *const data = buffer.data_ptr_at_index<float>(0);
+    for (uint32_t frm_idx = 0; frm_idx < 600; ++frm_idx) {
+        XCTAssertEqual(data[frm_idx], static_cast<float>(100 + frm_idx));
+    }
+}
+
+- (void)test_render_unmapped_source_channel {
+    auto graph = audio::graph::make_shared();
+    auto route = audio::graph_route::make_shared();
+    test::node_object source_obj{0, 1};
+    test::node_object output_obj{1, 0};
+    test::node_object input_obj{0, 1};
+
+    audio::format const src_format{{.sample_rate = 48000.0, .channel_count = 2}};
+    audio::format const dst_format{{.sample_rate = 48000.0, .channel_count = 1}};
+
+    source_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        for (uint32_t ch_idx = 0; ch_idx < 2; ++ch_idx) {
+            auto *const data = args.buffer->data_ptr_at_index<float>(ch_idx);
+            for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                data[frm_idx] = static_cast<float>(ch_idx + 1);
+            }
+        }
+    });
+
+    graph->connect(source_obj.node, route->node, 0, 0, src_format);
+    graph->connect(route->node, output_obj.node, 0, 0, dst_format);
+
+    route->add_route({0, 1, 0, 0});
+
+    audio::rendering_graph rendering_graph{output_obj.node, input_obj.node};
+    audio::pcm_buffer buffer{dst_format, 512};
+
+    XCTAssertTrue(rendering_graph.output_node()->render(&buffer, audio::time{0}));
+
+    auto const *const data = buffer.data_ptr_at_index<float>(0);
+    XCTAssertEqual(data[0], 2.0f);
+    XCTAssertEqual(data[511], 2.0f);
+}
+
+- (void)test_render_256_routes_performance {
+    uint32_t const src_count = 256;
+    audio::test_utils::route::context context{src_count};
+
+    audio::rendering_graph rendering_graph{context.output_obj.node, context.input_obj.node};
+    auto const *const output_node = rendering_graph.output_node();
+    auto const buffer =
+        std::make_shared<audio::pcm_buffer>(audio::format{{.sample_rate = 48000.0, .channel_count = src_count}}, 512);
+
+    [self measureBlock:^{
+        for (uint32_t idx = 0; idx < 1000; ++idx) {
+            output_node->render(buffer.get(), audio::time{idx * 512});
+        }
+    }];
+}
+
 @end
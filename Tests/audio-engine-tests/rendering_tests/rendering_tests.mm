@@ -3,6 +3,8 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <cmath>
+#import <cstring>
 #import "../test_utils.h"
 
 using namespace yas;
@@ -145,6 +147,293 @@ using namespace yas;
     }
 }
 
+- (void)test_rendering_graph_diamond {
+    audio::format format{{.sample_rate = 48000.0, .channel_count = 1}};
+
+    test::node_object source_obj(0, 1);
+    test::node_object splitter_obj(1, 2);
+    test::node_object left_obj(1, 1);
+    test::node_object right_obj(1, 1);
+    test::node_object mixer_obj(2, 1);
+    test::node_object output_obj(1, 0);
+    test::node_object input_obj(0, 1);
+
+    std::size_t source_called = 0;
+
+    source_obj.node->set_render_handler([&source_called](audio::node_render_args const &args) {
+        ++source_called;
+
+        auto *const data = args.buffer->data_ptr_at_index<float>(0);
+        for (uint32_t idx = 0; idx < args.buffer->frame_length(); ++idx) {
+            data[idx] = 1.0f;
+        }
+    });
+
+    auto const pull_handler = [](audio::node_render_args const &args) {
+        args.source_connections.at(0).render(args.buffer, args.time);
+    };
+
+    splitter_obj.node->set_render_handler(pull_handler);
+    left_obj.node->set_render_handler(pull_handler);
+    right_obj.node->set_render_handler(pull_handler);
+
+    mixer_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        audio::pcm_buffer right_buffer{args.buffer->format(), args.buffer->frame_length()};
+
+        args.source_connections.at(0).render(args.buffer, args.time);
+        args.source_connections.at(1).render(&right_buffer, args.time);
+
+        auto *const data = args.buffer->data_ptr_at_index<float>(0);
+        auto const *const right_data = right_buffer.data_ptr_at_index<float>(0);
+        for (uint32_t idx = 0; idx < args.buffer->frame_length(); ++idx) {
+            data[idx] += right_data[idx];
+        }
+    });
+
+    auto graph = audio::graph::make_shared();
+    graph->connect(source_obj.node, splitter_obj.node, 0, 0, format);
+    graph->connect(splitter_obj.node, left_obj.node, 0, 0, format);
+    graph->connect(splitter_obj.node, right_obj.node, 1, 0, format);
+    graph->connect(left_obj.node, mixer_obj.node, 0, 0, format);
+    graph->connect(right_obj.node, mixer_obj.node, 0, 1, format);
+    graph->connect(mixer_obj.node, output_obj.node, 0, 0, format);
+
+    audio::rendering_graph rendering_graph{output_obj.node, input_obj.node, 16};
+
+    auto const *const output_node = rendering_graph.output_node();
+    XCTAssertTrue(output_node != nullptr);
+
+    auto const &source_nodes = output_node->source_nodes;
+
+    XCTAssertEqual(source_nodes.size(), 5);
+
+    auto const &mixer_node = source_nodes.at(0);
+    auto const &left_node = source_nodes.at(1);
+    auto const &right_node = source_nodes.at(2);
+    auto const &splitter_node = source_nodes.at(3);
+    auto const &source_node = source_nodes.at(4);
+
+    XCTAssertEqual(mixer_node->source_connections.at(0).source_node, left_node.get());
+    XCTAssertEqual(mixer_node->source_connections.at(1).source_node, right_node.get());
+    XCTAssertEqual(left_node->source_connections.at(0).source_node, splitter_node.get());
+    XCTAssertEqual(right_node->source_connections.at(0).source_node, splitter_node.get());
+    XCTAssertEqual(splitter_node->source_connections.at(0).source_node, source_node.get());
+
+    XCTAssertFalse(splitter_node->is_output_shared(0));
+    XCTAssertFalse(splitter_node->is_output_shared(1));
+    XCTAssertTrue(source_node->is_output_shared(0));
+
+    audio::pcm_buffer buffer{format, 16};
+    buffer.set_frame_length(8);
+
+    for (uint32_t cycle = 0; cycle < 2; ++cycle) {
+        XCTAssertTrue(output_node->render(&buffer, audio::time{cycle * 8}));
+
+        XCTAssertEqual(source_called, cycle + 1);
+
+        auto const *const data = buffer.data_ptr_at_index<float>(0);
+        for (uint32_t idx = 0; idx < buffer.frame_length(); ++idx) {
+            XCTAssertEqual(data[idx], 2.0f);
+        }
+    }
+
+    // 共有バッファより長い場合はそのまま描画する
+    audio::pcm_buffer long_buffer{format, 32};
+
+    XCTAssertTrue(output_node->render(&long_buffer, audio::time{16}));
+
+    XCTAssertEqual(source_called, 4);
+    XCTAssertEqual(long_buffer.data_ptr_at_index<float>(0)[31], 2.0f);
+}
+
+- (void)test_rendering_graph_shared_output_at_different_time {
+    audio::format format{{.sample_rate = 48000.0, .channel_count = 1}};
+
+    test::node_object source_obj(0, 1);
+    test::node_object splitter_obj(1, 2);
+    test::node_object left_obj(1, 1);
+    test::node_object right_obj(1, 1);
+    test::node_object mixer_obj(2, 1);
+    test::node_object output_obj(1, 0);
+    test::node_object input_obj(0, 1);
+
+    std::size_t source_called = 0;
+
+    source_obj.node->set_render_handler([&source_called](audio::node_render_args const &args) {
+        ++source_called;
+
+        auto *const data = args.buffer->data_ptr_at_index<float>(0);
+        for (uint32_t idx = 0; idx < args.buffer->frame_length(); ++idx) {
+            data[idx] = static_cast<float>(args.time.sample_time() + idx);
+        }
+    });
+
+    auto const pull_handler = [](audio::node_render_args const &args) {
+        args.source_connections.at(0).render(args.buffer, args.time);
+    };
+
+    splitter_obj.node->set_render_handler(pull_handler);
+    left_obj.node->set_render_handler(pull_handler);
+
+    // 同じ周期の中で、共有している出力の先の位置を描画する
+    right_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        audio::time const next_time{args.time.sample_time() + args.buffer->frame_length(), args.time.sample_rate()};
+        args.source_connections.at(0).render(args.buffer, next_time);
+    });
+
+    mixer_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        audio::pcm_buffer right_buffer{args.buffer->format(), args.buffer->frame_length()};
+
+        args.source_connections.at(0).render(args.buffer, args.time);
+        args.source_connections.at(1).render(&right_buffer, args.time);
+
+        auto *const data = args.buffer->data_ptr_at_index<float>(0);
+        auto const *const right_data = right_buffer.data_ptr_at_index<float>(0);
+        for (uint32_t idx = 0; idx < args.buffer->frame_length(); ++idx) {
+            data[idx] += right_data[idx];
+        }
+    });
+
+    auto graph = audio::graph::make_shared();
+    graph->connect(source_obj.node, splitter_obj.node, 0, 0, format);
+    graph->connect(splitter_obj.node, left_obj.node, 0, 0, format);
+    graph->connect(splitter_obj.node, right_obj.node, 1, 0, format);
+    graph->connect(left_obj.node, mixer_obj.node, 0, 0, format);
+    graph->connect(right_obj.node, mixer_obj.node, 0, 1, format);
+    graph->connect(mixer_obj.node, output_obj.node, 0, 0, format);
+
+    audio::rendering_graph rendering_graph{output_obj.node, input_obj.node, 16};
+
+    auto const *const output_node = rendering_graph.output_node();
+    XCTAssertTrue(output_node != nullptr);
+    XCTAssertTrue(output_node->source_nodes.at(4)->is_output_shared(0));
+
+    audio::pcm_buffer buffer{format, 16};
+    buffer.set_frame_length(8);
+
+    XCTAssertTrue(output_node->render(&buffer, audio::time{int64_t(8), 48000.0}));
+
+    XCTAssertEqual(source_called, 2);
+
+    auto const *const data = buffer.data_ptr_at_index<float>(0);
+    for (uint32_t idx = 0; idx < buffer.frame_length(); ++idx) {
+        XCTAssertEqual(data[idx], static_cast<float>((8 + idx) + (16 + idx)));
+    }
+}
+
+- (void)test_rendering_graph_parallel_sources {
+    audio::format format{{.sample_rate = 48000.0, .channel_count = 1}};
+    uint32_t const branch_count = 4;
+
+    test::node_object mixer_obj(branch_count, 1);
+    test::node_object output_obj(1, 0);
+    test::node_object input_obj(0, 1);
+    std::vector<test::node_object> source_objs;
+    std::vector<test::node_object> gain_objs;
+
+    auto graph = audio::graph::make_shared();
+
+    for (uint32_t idx = 0; idx < branch_count; ++idx) {
+        auto const &source_obj = source_objs.emplace_back(0, 1);
+        auto const &gain_obj = gain_objs.emplace_back(1, 1);
+
+        source_obj.node->set_render_handler([idx](audio::node_render_args const &args) {
+            auto const frame = args.time.sample_time();
+            auto *const data = args.buffer->data_ptr_at_index<float>(0);
+            for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                data[frm_idx] = std::sin(static_cast<float>(frame + frm_idx) * 0.01f * static_cast<float>(idx + 1));
+            }
+        });
+
+        gain_obj.node->set_render_handler([idx](audio::node_render_args const &args) {
+            args.source_connections.at(0).render(args.buffer, args.time);
+            auto *const data = args.buffer->data_ptr_at_index<float>(0);
+            for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                data[frm_idx] *= 0.1f * static_cast<float>(idx + 1);
+            }
+        });
+
+        graph->connect(source_obj.node, gain_obj.node, 0, 0, format);
+        graph->connect(gain_obj.node, mixer_obj.node, 0, idx, format);
+    }
+
+    mixer_obj.node->set_render_handler([](audio::node_render_args const &args) {
+        audio::pcm_buffer branch_buffer{args.buffer->format(), args.buffer->frame_length()};
+        args.buffer->clear();
+
+        for (auto const &pair : args.source_connections) {
+            pair.second.render(&branch_buffer, args.time);
+
+            auto *const data = args.buffer->data_ptr_at_index<float>(0);
+            auto const *const branch_data = branch_buffer.data_ptr_at_index<float>(0);
+            for (uint32_t frm_idx = 0; frm_idx < args.buffer->frame_length(); ++frm_idx) {
+                data[frm_idx] += branch_data[frm_idx];
+            }
+        }
+    });
+
+    graph->connect(mixer_obj.node, output_obj.node, 0, 0, format);
+
+    audio::rendering_graph serial_graph{output_obj.node, input_obj.node, 64};
+    audio::rendering_graph parallel_graph{output_obj.node, input_obj.node, 64,
+                                          audio::rendering_worker_pool::make_shared(3)};
+
+    XCTAssertEqual(serial_graph.output_node()->source_nodes.at(0)->parallel_sources().size(), 0);
+
+    auto const &parallel_nodes = parallel_graph.output_node()->source_nodes;
+    auto const &parallel_sources = parallel_nodes.at(0)->parallel_sources();
+    XCTAssertEqual(parallel_sources.size(), branch_count);
+    for (auto const *const connection : parallel_sources) {
+        XCTAssertTrue(connection->source_node->is_output_shared(connection->source_bus_idx));
+    }
+
+    audio::pcm_buffer serial_buffer{format, 64};
+    audio::pcm_buffer parallel_buffer{format, 64};
+
+    for (int64_t frame = 0; frame < 64 * 8; frame += 64) {
+        audio::time const time{frame, format.sample_rate()};
+
+        XCTAssertTrue(serial_graph.output_node()->render(&serial_buffer, time));
+        XCTAssertTrue(parallel_graph.output_node()->render(&parallel_buffer, time));
+
+        auto const *const serial_data = serial_buffer.data_ptr_at_index<float>(0);
+        auto const *const parallel_data = parallel_buffer.data_ptr_at_index<float>(0);
+        XCTAssertEqual(std::memcmp(serial_data, parallel_data, sizeof(float) * 64), 0);
+    }
+}
+
+- (void)test_rendering_graph_parallel_sources_not_independent {
+    audio::format format{{.sample_rate = 48000.0, .channel_count = 1}};
+
+    test::node_object source_obj(0, 1);
+    test::node_object splitter_obj(1, 2);
+    test::node_object mixer_obj(2, 1);
+    test::node_object output_obj(1, 0);
+    test::node_object input_obj(0, 1);
+
+    auto const handler = [](audio::node_render_args const &args) {
+        for (auto const &pair : args.source_connections) {
+            pair.second.render(args.buffer, args.time);
+        }
+    };
+
+    source_obj.node->set_render_handler([](audio::node_render_args const &) {});
+    splitter_obj.node->set_render_handler(handler);
+    mixer_obj.node->set_render_handler(handler);
+
+    auto graph = audio::graph::make_shared();
+    graph->connect(source_obj.node, splitter_obj.node, 0, 0, format);
+    graph->connect(splitter_obj.node, mixer_obj.node, 0, 0, format);
+    graph->connect(splitter_obj.node, mixer_obj.node, 1, 1, format);
+    graph->connect(mixer_obj.node, output_obj.node, 0, 0, format);
+
+    audio::rendering_graph rendering_graph{output_obj.node, input_obj.node, 64,
+                                           audio::rendering_worker_pool::make_shared(2)};
+
+    // 接続元が同じノードを含むので並列にしない
+    XCTAssertEqual(rendering_graph.output_node()->source_nodes.at(0)->parallel_sources().size(), 0);
+}
+
 - (void)test_rendering_graph_empty {
     test::node_object output_obj{1, 0};
     test::node_object input_obj{0, 1};
@@ -33,6 +33,8 @@ struct element : buffering_element_for_buffering_channel {
     std::function<void(path::channel const &, fragment_index_t const)> force_write_handler;
     std::function<bool(frame_index_t const)> contains_frame_handler;
     std::function<bool(audio::pcm_buffer *, frame_index_t const)> read_into_buffer_handler;
+    std::function<bool(audio::pcm_buffer *, uint32_t const, uint32_t const, frame_index_t const, uint32_t const)>
+        read_into_channel_handler;
     std::function<void(fragment_index_t const)> advance_handler;
     std::function<void(void)> overwrite_handler;
 
@@ -60,6 +62,12 @@ struct element : buffering_element_for_buffering_channel {
         return this->read_into_buffer_handler(buffer, frame);
     }
 
+    bool read_into_channel_on_render(audio::pcm_buffer *buffer, uint32_t const out_ch_idx,
+                                     uint32_t const out_begin_frame, frame_index_t const frame,
+                                     uint32_t const length) {
+        return this->read_into_channel_handler(buffer, out_ch_idx, out_begin_frame, frame, length);
+    }
+
     void advance_on_render(fragment_index_t const frag_idx) {
         this->advance_handler(frag_idx);
     }
@@ -73,6 +81,47 @@ struct element : buffering_element_for_buffering_channel {
     }
 };
 
+/// force_writeなどで実際のエレメントのようにステートが変わる
+static std::shared_ptr<element> make_stateful_element(std::vector<fragment_index_t> &written) {
+    using state_t = audio_buffering_element_state;
+
+    struct element_values {
+        state_t state = state_t::initial;
+        fragment_index_t frag_idx = 0;
+    };
+
+    auto const values = std::make_shared<element_values>();
+    auto const stateful = element::make_shared();
+
+    stateful->state_handler = [values] { return values->state; };
+    stateful->fragment_index_handler = [values] { return values->frag_idx; };
+    stateful->force_write_handler = [values, &written](path::channel const &, fragment_index_t const frag_idx) {
+        values->state = state_t::readable;
+        values->frag_idx = frag_idx;
+        written.emplace_back(frag_idx);
+    };
+    stateful->advance_handler = [values](fragment_index_t const frag_idx) {
+        values->state = state_t::writable;
+        values->frag_idx = frag_idx;
+    };
+    stateful->overwrite_handler = [values] {
+        if (values->state == state_t::readable) {
+            values->state = state_t::writable;
+        }
+    };
+
+    return stateful;
+}
+
+static std::vector<fragment_index_t> fragment_indices(
+    std::vector<std::shared_ptr<buffering_element_for_buffering_channel>> const &elements) {
+    std::vector<fragment_index_t> indices;
+    for (auto const &element : elements) {
+        indices.emplace_back(element->fragment_index_on_render());
+    }
+    return indices;
+}
+
 static std::shared_ptr<element> cast_to_test_element(
     std::shared_ptr<buffering_element_for_buffering_channel> const &protocol) {
     return std::dynamic_pointer_cast<element>(protocol);
@@ -345,6 +394,205 @@ static buffering_element_ptr cast_to_buffering_element(
     XCTAssertEqual(data[1], 456);
 }
 
+- (void)test_read_into_channel {
+    auto const element0 = buffering_channel_test::element::make_shared();
+    element0->contains_frame_handler = [](frame_index_t const frame) { return false; };
+    element0->read_into_channel_handler = [](audio::pcm_buffer *, uint32_t const, uint32_t const, frame_index_t const,
+                                             uint32_t const) { return false; };
+
+    std::vector<std::tuple<uint32_t, uint32_t, frame_index_t, uint32_t>> called_read1;
+    auto const element1 = buffering_channel_test::element::make_shared();
+    element1->contains_frame_handler = [](frame_index_t const frame) { return frame == 300; };
+    element1->read_into_channel_handler = [&called_read1](audio::pcm_buffer *buffer, uint32_t const out_ch_idx,
+                                                          uint32_t const out_begin_frame, frame_index_t const frame,
+                                                          uint32_t const length) {
+        called_read1.emplace_back(out_ch_idx, out_begin_frame, frame, length);
+        buffer->data_ptr_at_index<int16_t>(out_ch_idx)[out_begin_frame] = 123;
+        return true;
+    };
+
+    auto const channel = buffering_channel::make_shared({element0, element1});
+
+    audio::pcm_buffer buffer{buffering_channel_test::format, buffering_channel_test::sample_rate};
+    int16_t const *const data = buffer.data_ptr_at_index<int16_t>(0);
+
+    XCTAssertFalse(channel->read_into_channel_on_render(&buffer, 0, 1, 200, 1));
+    XCTAssertEqual(called_read1.size(), 0);
+
+    XCTAssertTrue(channel->read_into_channel_on_render(&buffer, 0, 1, 300, 1));
+    XCTAssertEqual(called_read1.size(), 1);
+    XCTAssertEqual(called_read1.at(0), std::make_tuple(0, 1, 300, 1));
+
+    XCTAssertEqual(data[0], 0);
+    XCTAssertEqual(data[1], 123);
+}
+
+- (void)test_write_all_elements_reusing_readable {
+    std::vector<fragment_index_t> written;
+    auto const channel = buffering_channel::make_shared({buffering_channel_test::make_stateful_element(written),
+                                                         buffering_channel_test::make_stateful_element(written),
+                                                         buffering_channel_test::make_stateful_element(written)});
+    auto const ch_path = buffering_channel_test::channel_path();
+
+    XCTAssertEqual(channel->write_all_elements_on_task(ch_path, 0), 0);
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{0, 1, 2}));
+
+    written.clear();
+
+    // 読み込み済みの1と2は読み直さない
+    XCTAssertEqual(channel->write_all_elements_on_task(ch_path, 1), 2);
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{3}));
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->elements_for_test()),
+                   (std::vector<fragment_index_t>{1, 2, 3}));
+
+    written.clear();
+
+    // 前に戻っても読み込み済みのものは使う
+    XCTAssertEqual(channel->write_all_elements_on_task(ch_path, 0), 2);
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{0}));
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->elements_for_test()),
+                   (std::vector<fragment_index_t>{0, 1, 2}));
+
+    written.clear();
+
+    // ファイルが違えば全て読み直す
+    XCTAssertEqual(channel->write_all_elements_on_task(buffering_channel_test::channel_path(3), 0), 0);
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{0, 1, 2}));
+}
+
+- (void)test_set_element_count {
+    std::vector<fragment_index_t> written;
+    std::size_t called_make = 0;
+    auto const channel = buffering_channel::make_shared(
+        {buffering_channel_test::make_stateful_element(written),
+         buffering_channel_test::make_stateful_element(written)},
+        [&written, &called_make] {
+            ++called_make;
+            return buffering_channel_test::make_stateful_element(written);
+        });
+    auto const ch_path = buffering_channel_test::channel_path();
+
+    channel->write_all_elements_on_task(ch_path, 0);
+
+    channel->set_element_count_on_task(1);
+
+    XCTAssertEqual(channel->elements_for_test().size(), 1);
+    XCTAssertEqual(channel->warm_elements_for_test().size(), 1, @"減らしたエレメントは先読み用に回す");
+    XCTAssertEqual(called_make, 0);
+
+    channel->set_element_count_on_task(3);
+
+    XCTAssertEqual(channel->elements_for_test().size(), 3);
+    XCTAssertEqual(channel->warm_elements_for_test().size(), 0);
+    XCTAssertEqual(called_make, 1, @"先読み用のものを使ってから足りない分を作る");
+
+    written.clear();
+
+    XCTAssertEqual(channel->write_all_elements_on_task(ch_path, 0), 2);
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{2}));
+}
+
+- (void)test_add_element {
+    std::vector<fragment_index_t> written;
+    auto const channel = buffering_channel::make_shared(
+        {buffering_channel_test::make_stateful_element(written),
+         buffering_channel_test::make_stateful_element(written)},
+        [&written] { return buffering_channel_test::make_stateful_element(written); });
+    auto const ch_path = buffering_channel_test::channel_path();
+
+    XCTAssertFalse(channel->add_element_on_task(), @"書き込む前は増やさない");
+
+    channel->write_all_elements_on_task(ch_path, 0);
+
+    written.clear();
+
+    XCTAssertTrue(channel->add_element_on_task());
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{3}), @"次に進んだ時の最後のフラグメントを書き込む");
+    XCTAssertEqual(channel->elements_for_test().size(), 2, @"renderで進むまでは並びに入れない");
+
+    XCTAssertFalse(channel->add_element_on_task(), @"並びに入るまでは次を増やさない");
+
+    channel->advance_on_render(0);
+
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->elements_for_test()),
+                   (std::vector<fragment_index_t>{2, 1, 3}));
+
+    written.clear();
+
+    XCTAssertTrue(channel->add_element_on_task());
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{5}));
+
+    channel->advance_on_render(1);
+
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->elements_for_test()),
+                   (std::vector<fragment_index_t>{2, 4, 3, 5}));
+
+    XCTAssertTrue(channel->add_element_on_task());
+
+    channel->set_element_count_on_task(2);
+
+    XCTAssertEqual(channel->elements_for_test().size(), 2, @"加えかけたものも含めて減らす");
+    XCTAssertTrue(channel->add_element_on_task());
+}
+
+- (void)test_write_warm_elements {
+    std::vector<fragment_index_t> written;
+    std::size_t called_make = 0;
+    auto const channel = buffering_channel::make_shared({buffering_channel_test::make_stateful_element(written)},
+                                                        [&written, &called_make] {
+                                                            ++called_make;
+                                                            return buffering_channel_test::make_stateful_element(
+                                                                written);
+                                                        });
+    auto const ch_path = buffering_channel_test::channel_path();
+
+    XCTAssertFalse(channel->write_warm_elements_if_needed_on_task({5}), @"全体を書き込む前は何もしない");
+
+    channel->write_all_elements_on_task(ch_path, 0);
+
+    written.clear();
+
+    XCTAssertTrue(channel->write_warm_elements_if_needed_on_task({5, 6}));
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{5}), @"1回でひとつだけ書き込む");
+    XCTAssertTrue(channel->write_warm_elements_if_needed_on_task({5, 6}));
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{5, 6}));
+    XCTAssertFalse(channel->write_warm_elements_if_needed_on_task({5, 6}));
+    XCTAssertEqual(called_make, 2);
+
+    XCTAssertFalse(channel->write_warm_elements_if_needed_on_task({6}));
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->warm_elements_for_test()),
+                   (std::vector<fragment_index_t>{6}), @"対象から外れたものは捨てる");
+
+    written.clear();
+
+    XCTAssertEqual(channel->write_all_elements_on_task(ch_path, 6), 1);
+    XCTAssertEqual(written.size(), 0, @"先読みしたものを使う");
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->elements_for_test()),
+                   (std::vector<fragment_index_t>{6}));
+    XCTAssertEqual(buffering_channel_test::fragment_indices(channel->warm_elements_for_test()),
+                   (std::vector<fragment_index_t>{0}), @"入れ替えたものは先読み用に回す");
+}
+
+- (void)test_overwrite_invalidates_warm_elements {
+    std::vector<fragment_index_t> written;
+    auto const channel = buffering_channel::make_shared(
+        {buffering_channel_test::make_stateful_element(written)},
+        [&written] { return buffering_channel_test::make_stateful_element(written); });
+    auto const ch_path = buffering_channel_test::channel_path();
+
+    channel->write_all_elements_on_task(ch_path, 0);
+    XCTAssertTrue(channel->write_warm_elements_if_needed_on_task({5}));
+    XCTAssertFalse(channel->write_warm_elements_if_needed_on_task({5}));
+
+    written.clear();
+
+    channel->overwrite_element_on_render({.index = 10, .length = 1});
+
+    XCTAssertTrue(channel->write_warm_elements_if_needed_on_task({5}), @"上書きされたら読み直す");
+    XCTAssertEqual(written, (std::vector<fragment_index_t>{5}));
+    XCTAssertFalse(channel->write_warm_elements_if_needed_on_task({5}));
+}
+
 - (void)test_make_channel {
     audio::format const format{
         {.sample_rate = 4, .channel_count = 2, .pcm_format = audio::pcm_format::int16, .interleaved = false}};
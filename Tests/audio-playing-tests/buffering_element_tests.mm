@@ -51,6 +51,88 @@ static bool write_signal_to_file(proc::signal_event_ptr const &write_event, frag
 
     return true;
 }
+
+static bool write_packed_signal_to_file(proc::signal_event_ptr const &write_event, fragment_index_t const frag_idx) {
+    auto const frame = frag_idx * buffering_element_test::sample_rate;
+    auto const ch_path = buffering_element_test::channel_path();
+
+    if (!file_manager::create_directory_if_not_exists(ch_path.value())) {
+        return false;
+    }
+
+    proc::channel channel;
+    channel.insert_event(proc::make_range_time(frame, write_event->size()), write_event);
+
+    return static_cast<bool>(packed_fragment_file::write(path::packed_fragment{ch_path, frag_idx}.value(), channel));
+}
+
+namespace benchmark {
+    static sample_rate_t const sample_rate = 48000;
+    static fragment_index_t const fragment_count = 16;
+    static std::size_t const event_count = 8;
+
+    // フラグメントごとにevent_count個の信号イベントを書き出す
+    static bool write_fragments(exporter_fragment_format const fragment_format) {
+        auto const ch_path = buffering_element_test::channel_path(sample_rate);
+        length_t const event_length = sample_rate / event_count;
+
+        for (fragment_index_t frag_idx = 0; frag_idx < fragment_count; ++frag_idx) {
+            proc::channel channel;
+
+            for (std::size_t event_idx = 0; event_idx < event_count; ++event_idx) {
+                auto const event = proc::signal_event::make_shared<float>(event_length);
+                std::fill_n(event->data<float>(), event_length, static_cast<float>(event_idx));
+                frame_index_t const frame = frag_idx * sample_rate + event_idx * event_length;
+                channel.insert_event(proc::make_range_time(frame, event_length), event);
+            }
+
+            switch (fragment_format) {
+                case exporter_fragment_format::directory: {
+                    path::fragment const frag_path{.channel_path = ch_path, .fragment_index = frag_idx};
+
+                    if (!file_manager::create_directory_if_not_exists(frag_path.value())) {
+                        return false;
+                    }
+
+                    for (auto const &event_pair : channel.filtered_events<proc::signal_event>()) {
+                        path::signal_event const signal_path{.fragment_path = frag_path,
+                                                             .range = event_pair.first,
+                                                             .sample_type = event_pair.second->sample_type()};
+
+                        if (!signal_file::write(signal_path.value(), *event_pair.second)) {
+                            return false;
+                        }
+                    }
+                } break;
+                case exporter_fragment_format::packed: {
+                    if (!file_manager::create_directory_if_not_exists(ch_path.value())) {
+                        return false;
+                    }
+
+                    if (!packed_fragment_file::write(path::packed_fragment{ch_path, frag_idx}.value(), channel)) {
+                        return false;
+                    }
+                } break;
+            }
+        }
+
+        return true;
+    }
+
+    static void refill_all(buffering_element_ptr const &element) {
+        auto const ch_path = buffering_element_test::channel_path(sample_rate);
+
+        for (fragment_index_t frag_idx = 0; frag_idx < fragment_count; ++frag_idx) {
+            element->force_write_on_task(ch_path, frag_idx);
+        }
+    }
+
+    static buffering_element_ptr make_element() {
+        audio::format const format{
+            {.sample_rate = sample_rate, .pcm_format = audio::pcm_format::float32, .channel_count = 1}};
+        return buffering_element::make_shared(format, sample_rate);
+    }
+}  // namespace benchmark
 }  // namespace yas::playing::buffering_element_test
 
 @interface buffering_element_tests : XCTestCase
@@ -211,6 +293,49 @@ static bool write_signal_to_file(proc::signal_event_ptr const &write_event, frag
     }
 }
 
+- (void)test_read_into_channel {
+    auto const ch_path = buffering_element_test::channel_path();
+    auto const element = buffering_element_test::make_element();
+
+    path::fragment const frag_path{.channel_path = ch_path, .fragment_index = 1000};
+    XCTAssertTrue(file_manager::create_directory_if_not_exists(frag_path.value()));
+
+    auto const signal_event = proc::signal_event::make_shared<float>(2);
+    float *data = signal_event->data<float>();
+    data[0] = 1.0f;
+    data[1] = 0.5f;
+
+    proc::time::range const range{2000, 2};
+    auto const signal_path_value = path::signal_event{frag_path, range, signal_event->sample_type()}.value();
+    XCTAssertTrue(signal_file::write(signal_path_value, *signal_event));
+
+    element->force_write_on_task(ch_path, 1000);
+
+    XCTAssertEqual(element->state(), buffering_element::state_t::readable);
+
+    audio::format const format{{.sample_rate = buffering_element_test::sample_rate, .channel_count = 2}};
+    audio::pcm_buffer buffer{format, 4};
+
+    XCTAssertFalse(element->read_into_channel_on_render(&buffer, 1, 0, 1999, 2));
+    XCTAssertFalse(element->read_into_channel_on_render(&buffer, 1, 0, 2001, 2));
+    XCTAssertFalse(element->read_into_channel_on_render(&buffer, 1, 3, 2000, 2), @"出力のバッファに収まらない");
+    XCTAssertFalse(element->read_into_channel_on_render(&buffer, 2, 0, 2000, 2), @"出力のチャンネルが範囲外");
+
+    XCTAssertTrue(element->read_into_channel_on_render(&buffer, 1, 1, 2000, 2));
+
+    float const *const data0 = buffer.data_ptr_at_channel<float>(0);
+    float const *const data1 = buffer.data_ptr_at_channel<float>(1);
+    XCTAssertEqual(data0[1], 0.0f);
+    XCTAssertEqual(data0[2], 0.0f);
+    XCTAssertEqual(data1[0], 0.0f);
+    XCTAssertEqual(data1[1], 1.0f);
+    XCTAssertEqual(data1[2], 0.5f);
+    XCTAssertEqual(data1[3], 0.0f);
+
+    XCTAssertTrue(element->read_into_channel_on_render(&buffer, 0, 3, 2001, 1));
+    XCTAssertEqual(data0[3], 0.5f);
+}
+
 - (void)test_advance {
     auto const ch_path = buffering_element_test::channel_path();
     auto const element = buffering_element_test::make_element();
@@ -385,6 +510,60 @@ static bool write_signal_to_file(proc::signal_event_ptr const &write_event, frag
     }}.join();
 }
 
+- (void)test_write_packed {
+    auto const ch_path = buffering_element_test::channel_path();
+    auto const element = buffering_element_test::make_element();
+
+    if (auto const signal = proc::signal_event::make_shared<float>(buffering_element_test::sample_rate)) {
+        float *data = signal->data<float>();
+
+        data[0] = 1.0f;
+        data[1] = 2.0f;
+
+        XCTAssertTrue(buffering_element_test::write_packed_signal_to_file(signal, 0));
+
+        // 両方の形式があればまとめたファイルを読む
+        data[0] = 3.0f;
+        data[1] = 4.0f;
+
+        XCTAssertTrue(buffering_element_test::write_signal_to_file(signal, 0));
+    }
+
+    element->force_write_on_task(ch_path, 0);
+
+    XCTAssertEqual(element->state(), buffering_element::state_t::readable);
+
+    std::thread{[&element] {
+        audio::pcm_buffer buffer{buffering_element_test::format, buffering_element_test::sample_rate};
+
+        XCTAssertTrue(element->read_into_buffer_on_render(&buffer, 0));
+
+        float const *const data = buffer.data_ptr_at_index<float>(0);
+        XCTAssertEqual(data[0], 1.0f);
+        XCTAssertEqual(data[1], 2.0f);
+    }}.join();
+}
+
+- (void)test_write_directory_performance {
+    XCTAssertTrue(buffering_element_test::benchmark::write_fragments(exporter_fragment_format::directory));
+
+    auto const element = buffering_element_test::benchmark::make_element();
+
+    [self measureBlock:^{
+        buffering_element_test::benchmark::refill_all(element);
+    }];
+}
+
+- (void)test_write_packed_performance {
+    XCTAssertTrue(buffering_element_test::benchmark::write_fragments(exporter_fragment_format::packed));
+
+    auto const element = buffering_element_test::benchmark::make_element();
+
+    [self measureBlock:^{
+        buffering_element_test::benchmark::refill_all(element);
+    }];
+}
+
 - (void)test_state_to_string {
     XCTAssertEqual(to_string(audio_buffering_element_state::initial), "initial");
     XCTAssertEqual(to_string(audio_buffering_element_state::writable), "writable");
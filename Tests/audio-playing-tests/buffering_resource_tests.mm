@@ -40,16 +40,35 @@ struct channel : buffering_channel_for_buffering_resource {
 
     std::function<bool()> write_elements_handler;
     std::function<void(path::channel const &, fragment_index_t const)> write_all_elements_handler;
+    std::function<void(std::size_t const)> set_element_count_handler;
+    std::function<bool()> add_element_handler;
+    std::function<bool(std::vector<fragment_index_t> const &)> write_warm_elements_handler;
+    std::size_t reused_count = 0;
     std::function<void(fragment_index_t const)> advance_handler;
     std::function<void(fragment_range const)> overwrite_element_handler;
     std::function<bool(audio::pcm_buffer *, frame_index_t const)> read_into_buffer_handler;
+    std::function<bool(audio::pcm_buffer *, uint32_t const, uint32_t const, frame_index_t const, uint32_t const)>
+        read_into_channel_handler;
 
     bool write_elements_if_needed_on_task() {
         return this->write_elements_handler();
     }
 
-    void write_all_elements_on_task(path::channel const &ch_path, fragment_index_t const top_frag_idx) {
+    std::size_t write_all_elements_on_task(path::channel const &ch_path, fragment_index_t const top_frag_idx) {
         this->write_all_elements_handler(ch_path, top_frag_idx);
+        return this->reused_count;
+    }
+
+    void set_element_count_on_task(std::size_t const count) {
+        this->set_element_count_handler(count);
+    }
+
+    bool add_element_on_task() {
+        return this->add_element_handler();
+    }
+
+    bool write_warm_elements_if_needed_on_task(std::vector<fragment_index_t> const &frag_indices) {
+        return this->write_warm_elements_handler(frag_indices);
     }
 
     void advance_on_render(fragment_index_t const frag_idx) {
@@ -63,6 +82,12 @@ struct channel : buffering_channel_for_buffering_resource {
     bool read_into_buffer_on_render(audio::pcm_buffer *out_buffer, frame_index_t const frame) {
         return this->read_into_buffer_handler(out_buffer, frame);
     }
+
+    bool read_into_channel_on_render(audio::pcm_buffer *out_buffer, uint32_t const out_ch_idx,
+                                     uint32_t const out_begin_frame, frame_index_t const frame,
+                                     uint32_t const length) {
+        return this->read_into_channel_handler(out_buffer, out_ch_idx, out_begin_frame, frame, length);
+    }
 };
 
 struct cpp {
@@ -94,10 +119,16 @@ struct cpp {
     }
 
     void setup_advancing() {
+        this->setup_advancing({.min_element_count = buffering_test::element_count,
+                               .max_element_count = buffering_test::element_count,
+                               .warming_fragment_count = 0});
+    }
+
+    void setup_advancing(buffering_prefetch_args const &args) {
         std::vector<std::shared_ptr<buffering_test::channel>> channels;
 
         auto const buffering = buffering_resource::make_shared(
-            buffering_test::element_count, test_utils::root_path(),
+            args, test_utils::root_path(),
             [&channels](std::size_t const element_count, audio::format const &format, sample_rate_t const frag_length) {
                 auto channel = std::make_shared<buffering_test::channel>(element_count, format, frag_length);
                 channels.emplace_back(channel);
@@ -541,6 +572,65 @@ struct cpp {
     XCTAssertFalse(buffering->read_into_buffer_on_render(&buffer, 1, 301));
 }
 
+- (void)test_read_into_channel {
+    self->_cpp.setup_advancing();
+
+    auto const &buffering = self->_cpp.buffering;
+    auto &channels = self->_cpp.channels;
+
+    struct called_args {
+        audio::pcm_buffer *buffer;
+        uint32_t out_ch_idx;
+        uint32_t out_begin_frame;
+        frame_index_t frame;
+        uint32_t length;
+    };
+
+    bool result1 = true;
+    std::vector<called_args> called0;
+    std::vector<called_args> called1;
+
+    channels.at(0)->read_into_channel_handler = [&called0](audio::pcm_buffer *buffer, uint32_t const out_ch_idx,
+                                                           uint32_t const out_begin_frame, frame_index_t const frame,
+                                                           uint32_t const length) {
+        called0.emplace_back(called_args{buffer, out_ch_idx, out_begin_frame, frame, length});
+        return false;
+    };
+
+    channels.at(1)->read_into_channel_handler = [&called1, &result1](
+                                                    audio::pcm_buffer *buffer, uint32_t const out_ch_idx,
+                                                    uint32_t const out_begin_frame, frame_index_t const frame,
+                                                    uint32_t const length) {
+        called1.emplace_back(called_args{buffer, out_ch_idx, out_begin_frame, frame, length});
+        return result1;
+    };
+
+    audio::pcm_buffer buffer{buffering_test::format, buffering_test::sample_rate};
+
+    XCTAssertFalse(buffering->read_into_channel_on_render(&buffer, 0, 1, 100, 2));
+
+    XCTAssertEqual(called0.size(), 1);
+    XCTAssertEqual(called0.at(0).buffer, &buffer);
+    XCTAssertEqual(called0.at(0).out_ch_idx, 0);
+    XCTAssertEqual(called0.at(0).out_begin_frame, 1);
+    XCTAssertEqual(called0.at(0).frame, 100);
+    XCTAssertEqual(called0.at(0).length, 2);
+    XCTAssertEqual(called1.size(), 0);
+
+    XCTAssertTrue(buffering->read_into_channel_on_render(&buffer, 1, 0, 101, 3));
+
+    XCTAssertEqual(called1.size(), 1);
+    XCTAssertEqual(called1.at(0).out_ch_idx, 1, @"出力のチャンネルはbufferingのチャンネルと同じ");
+    XCTAssertEqual(called1.at(0).frame, 101);
+    XCTAssertEqual(called1.at(0).length, 3);
+
+    XCTAssertFalse(buffering->read_into_channel_on_render(&buffer, 2, 0, 102, 1));
+
+    // ch_idxが範囲外で呼ばれない
+    XCTAssertEqual(called0.size(), 1);
+    XCTAssertEqual(called1.size(), 1);
+}
+
 - (void)test_needs_all_writing_on_render {
     self->_cpp.setup_advancing();
 
@@ -607,6 +697,198 @@ struct cpp {
     XCTAssertEqual(buffering->element_count(), buffering_test::element_count);
 }
 
+- (void)test_make_with_invalid_element_count {
+    auto const make_channel = [](std::size_t const element_count, audio::format const &format,
+                                 sample_rate_t const frag_length) {
+        return std::make_shared<buffering_test::channel>(element_count, format, frag_length);
+    };
+
+    XCTAssertThrows(buffering_resource::make_shared(0, test_utils::root_path(), make_channel));
+    XCTAssertThrows(buffering_resource::make_shared({.min_element_count = 3, .max_element_count = 2},
+                                                    test_utils::root_path(), make_channel));
+}
+
+- (void)test_statistics {
+    self->_cpp.setup_advancing();
+
+    auto const &buffering = self->_cpp.buffering;
+    auto &channels = self->_cpp.channels;
+
+    bool read_result = true;
+
+    for (auto const &channel : channels) {
+        channel->read_into_channel_handler = [&read_result](audio::pcm_buffer *, uint32_t const, uint32_t const,
+                                                            frame_index_t const,
+                                                            uint32_t const) { return read_result; };
+        channel->write_elements_handler = [] { return true; };
+        channel->reused_count = 1;
+    }
+
+    audio::pcm_buffer buffer{buffering_test::format, 4};
+
+    XCTAssertTrue(buffering->read_into_channel_on_render(&buffer, 0, 0, 0, 1));
+
+    read_result = false;
+
+    XCTAssertFalse(buffering->read_into_channel_on_render(&buffer, 1, 0, 0, 1));
+
+    XCTAssertTrue(buffering->write_elements_if_needed_on_task());
+
+    buffering->set_all_writing_on_render(0);
+    buffering->write_all_elements_on_task();
+
+    auto const statistics = buffering->statistics();
+
+    XCTAssertEqual(statistics.element_count, 3);
+    XCTAssertEqual(statistics.read_count, 2);
+    XCTAssertEqual(statistics.underrun_count, 1);
+    XCTAssertEqual(statistics.read_hit_rate(), 0.5);
+    XCTAssertEqual(statistics.refill_count, 1);
+    XCTAssertEqual(statistics.last_refill_seconds, statistics.total_refill_seconds);
+    XCTAssertEqual(statistics.max_refill_seconds, statistics.total_refill_seconds);
+    XCTAssertEqual(statistics.warm_hit_count, 2);
+    XCTAssertEqual(statistics.warm_miss_count, 10, @"setup時の6と、今回の2ch*3-2");
+}
+
+- (void)test_adapt_element_count {
+    self->_cpp.setup_advancing({.min_element_count = 2, .max_element_count = 4, .warming_fragment_count = 0});
+
+    auto const &buffering = self->_cpp.buffering;
+    auto &channels = self->_cpp.channels;
+
+    XCTAssertEqual(buffering->element_count(), 2);
+    XCTAssertEqual(channels.at(0)->element_count, 2);
+
+    std::vector<std::size_t> called;
+
+    for (auto const &channel : channels) {
+        channel->read_into_channel_handler = [](audio::pcm_buffer *, uint32_t const, uint32_t const,
+                                                frame_index_t const, uint32_t const) { return false; };
+        channel->write_elements_handler = [] { return true; };
+        channel->set_element_count_handler = [&called](std::size_t const count) { called.emplace_back(count); };
+    }
+
+    audio::pcm_buffer buffer{buffering_test::format, 4};
+
+    XCTAssertFalse(buffering->read_into_channel_on_render(&buffer, 0, 0, 0, 1));
+
+    buffering->set_all_writing_on_render(0);
+    buffering->write_all_elements_on_task();
+
+    XCTAssertEqual(called, (std::vector<std::size_t>{3, 3}), @"読めなかったらひとつ増やす");
+    XCTAssertEqual(buffering->element_count(), 3);
+
+    buffering->set_all_writing_on_render(0);
+    buffering->write_all_elements_on_task();
+
+    XCTAssertEqual(called.size(), 2);
+
+    // 書き込みが速ければ減らしていく
+    for (std::size_t idx = 0; idx < 20; ++idx) {
+        XCTAssertTrue(buffering->write_elements_if_needed_on_task());
+    }
+
+    buffering->set_all_writing_on_render(0);
+    buffering->write_all_elements_on_task();
+
+    XCTAssertEqual(called, (std::vector<std::size_t>{3, 3, 2, 2}));
+    XCTAssertEqual(buffering->element_count(), 2);
+}
+
+- (void)test_add_element_on_underrun_while_advancing {
+    self->_cpp.setup_advancing({.min_element_count = 2, .max_element_count = 4, .warming_fragment_count = 0});
+
+    auto const &buffering = self->_cpp.buffering;
+    auto &channels = self->_cpp.channels;
+
+    std::size_t called_add = 0;
+    std::vector<std::size_t> called_set;
+
+    for (auto const &channel : channels) {
+        channel->read_into_channel_handler = [](audio::pcm_buffer *, uint32_t const, uint32_t const,
+                                                frame_index_t const, uint32_t const) { return false; };
+        channel->write_elements_handler = [] { return false; };
+        channel->add_element_handler = [&called_add] {
+            ++called_add;
+            return true;
+        };
+        channel->set_element_count_handler = [&called_set](std::size_t const count) {
+            called_set.emplace_back(count);
+        };
+    }
+
+    XCTAssertFalse(buffering->write_elements_if_needed_on_task());
+    XCTAssertEqual(called_add, 0);
+
+    audio::pcm_buffer buffer{buffering_test::format, 4};
+
+    XCTAssertFalse(buffering->read_into_channel_on_render(&buffer, 0, 0, 0, 1));
+
+    XCTAssertTrue(buffering->write_elements_if_needed_on_task(), @"シークを待たずに増やす");
+    XCTAssertEqual(called_add, 2);
+    XCTAssertEqual(buffering->element_count(), 3);
+    XCTAssertEqual(called_set.size(), 0);
+
+    XCTAssertFalse(buffering->write_elements_if_needed_on_task());
+    XCTAssertEqual(called_add, 2, @"読めなかった回数が増えなければ増やさない");
+
+    XCTAssertFalse(buffering->read_into_channel_on_render(&buffer, 0, 0, 0, 1));
+
+    channels.at(1)->add_element_handler = [] { return false; };
+
+    XCTAssertTrue(buffering->write_elements_if_needed_on_task());
+    XCTAssertEqual(called_add, 3);
+    XCTAssertEqual(buffering->element_count(), 4);
+
+    buffering->set_all_writing_on_render(0);
+    buffering->write_all_elements_on_task();
+
+    XCTAssertEqual(called_set, (std::vector<std::size_t>{4, 4}), @"増やせなかったチャンネルを全体の書き込みでそろえる");
+}
+
+- (void)test_warming_fragment_indices {
+    self->_cpp.setup_advancing({.min_element_count = 3, .max_element_count = 3, .warming_fragment_count = 2});
+
+    auto const &buffering = self->_cpp.buffering;
+    auto &channels = self->_cpp.channels;
+
+    XCTAssertEqual(buffering->warming_fragment_indices_for_test(), (std::vector<fragment_index_t>{0, 1}),
+                   @"シーク先から先読みする");
+
+    std::vector<std::vector<fragment_index_t>> called0;
+    std::vector<std::vector<fragment_index_t>> called1;
+
+    channels.at(0)->write_elements_handler = [] { return false; };
+    channels.at(1)->write_elements_handler = [] { return false; };
+    channels.at(0)->write_warm_elements_handler = [&called0](std::vector<fragment_index_t> const &frag_indices) {
+        called0.emplace_back(frag_indices);
+        return true;
+    };
+    channels.at(1)->write_warm_elements_handler = [&called1](std::vector<fragment_index_t> const &frag_indices) {
+        called1.emplace_back(frag_indices);
+        return false;
+    };
+
+    buffering->set_warming_frames_request_on_main({8});
+
+    XCTAssertTrue(buffering->write_elements_if_needed_on_task());
+
+    XCTAssertEqual(called0.size(), 1);
+    XCTAssertEqual(called0.at(0), (std::vector<fragment_index_t>{2, 3, 0, 1}), @"8(frame) / 4(frag_length) = 2");
+    XCTAssertEqual(called1.size(), 1);
+    XCTAssertEqual(called1.at(0), (std::vector<fragment_index_t>{2, 3, 0, 1}));
+
+    buffering->set_all_writing_on_render(20);
+    buffering->write_all_elements_on_task();
+
+    XCTAssertEqual(buffering->warming_fragment_indices_for_test(), (std::vector<fragment_index_t>{2, 3, 5, 6, 0, 1}),
+                   @"新しいシーク先が前に来る");
+
+    channels.at(0)->write_warm_elements_handler = [](std::vector<fragment_index_t> const &) { return false; };
+
+    XCTAssertFalse(buffering->write_elements_if_needed_on_task(), @"先読みするものがなければfalse");
+}
+
 - (void)test_setup_state_to_string {
     XCTAssertEqual(to_string(audio_buffering_setup_state::initial), "initial");
     XCTAssertEqual(to_string(audio_buffering_setup_state::creating), "creating");
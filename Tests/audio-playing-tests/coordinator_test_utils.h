@@ -62,11 +62,13 @@ struct player : player_for_coordinator {
     std::function<void(bool)> set_playing_handler;
     std::function<void(frame_index_t)> seek_handler;
     std::function<void(std::optional<channel_index_t>, fragment_range)> overwrite_handler;
+    std::function<void(std::vector<frame_index_t>)> set_warming_frames_handler;
     std::function<std::string const &(void)> identifier_handler;
     std::function<playing::channel_mapping(void)> ch_mapping_handler;
     std::function<bool(void)> is_playing_handler;
     std::function<bool(void)> is_seeking_handler;
     std::function<frame_index_t(void)> current_frame_handler;
+    std::function<playing::buffering_statistics(void)> buffering_statistics_handler;
     std::function<observing::syncable(std::function<void(bool const &)> &&)> observe_is_playing_handler;
 
     void set_identifier(std::string const &identifier) override {
@@ -89,6 +91,10 @@ struct player : player_for_coordinator {
         this->overwrite_handler(file_ch_idx, frag_range);
     }
 
+    void set_warming_frames(std::vector<frame_index_t> const &frames) override {
+        this->set_warming_frames_handler(frames);
+    }
+
     std::string const &identifier() const override {
         return this->identifier_handler();
     }
@@ -109,6 +115,10 @@ struct player : player_for_coordinator {
         return this->current_frame_handler();
     }
 
+    playing::buffering_statistics buffering_statistics() const override {
+        return this->buffering_statistics_handler();
+    }
+
     observing::syncable observe_is_playing(std::function<void(bool const &)> &&handler) override {
         return this->observe_is_playing_handler(std::move(handler));
     }
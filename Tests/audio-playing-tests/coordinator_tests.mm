@@ -294,6 +294,34 @@ using namespace yas::playing;
     XCTAssertEqual(coordinator->current_frame(), 2);
 }
 
+- (void)test_set_warming_frames {
+    auto const coordinator = self->_cpp.setup_coordinator();
+
+    std::vector<std::vector<frame_index_t>> called;
+
+    self->_cpp.player->set_warming_frames_handler = [&called](std::vector<frame_index_t> frames) {
+        called.emplace_back(std::move(frames));
+    };
+
+    coordinator->set_warming_frames({10, 20});
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0), (std::vector<frame_index_t>{10, 20}));
+}
+
+- (void)test_buffering_statistics {
+    auto const coordinator = self->_cpp.setup_coordinator();
+
+    self->_cpp.player->buffering_statistics_handler = [] {
+        return buffering_statistics{.element_count = 4, .underrun_count = 2};
+    };
+
+    auto const statistics = coordinator->buffering_statistics();
+
+    XCTAssertEqual(statistics.element_count, 4);
+    XCTAssertEqual(statistics.underrun_count, 2);
+}
+
 - (void)test_format {
     auto const coordinator = self->_cpp.setup_coordinator();
 
@@ -3,6 +3,7 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <audio-engine/utils/worker_pool.h>
 #import <audio-playing/umbrella.hpp>
 #import <audio-processing/umbrella.hpp>
 #import <cpp-utils/umbrella.hpp>
@@ -18,6 +19,47 @@ struct cpp {
     std::shared_ptr<exporter_task_queue> const queue = exporter_task_queue::make_shared(2);
     exporter::task_priority_t const priority{.timeline = 0, .fragment = 1};
 };
+
+static std::map<std::filesystem::path, std::string> read_contents(std::filesystem::path const &root_path) {
+    std::map<std::filesystem::path, std::string> contents;
+
+    for (auto const &entry : std::filesystem::recursive_directory_iterator(root_path)) {
+        if (entry.is_regular_file()) {
+            std::ifstream stream{entry.path(), std::ios::binary};
+            contents.emplace(std::filesystem::relative(entry.path(), root_path),
+                             std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}});
+        }
+    }
+
+    return contents;
+}
+
+// チャンネルごとに独立したトラックで定数とsinを生成する
+static proc::timeline_ptr make_synthetic_timeline(std::size_t const ch_count, proc::length_t const length) {
+    auto const timeline = proc::timeline::make_shared();
+
+    auto each = make_fast_each(ch_count);
+    while (yas_each_next(each)) {
+        auto const &idx = yas_each_index(each);
+        auto const src_ch_idx = static_cast<channel_index_t>(idx * 2 + 100);
+        auto const dst_ch_idx = static_cast<channel_index_t>(idx);
+
+        auto const track = proc::track::make_shared();
+
+        auto constant_module = proc::make_signal_module<float>(static_cast<float>(idx) * 0.1f);
+        constant_module->connect_output(proc::to_connector_index(proc::constant::output::value), src_ch_idx);
+        track->push_back_module(constant_module, {0, length});
+
+        auto sin_module = proc::make_signal_module<float>(proc::math1::kind::sin);
+        sin_module->connect_input(proc::to_connector_index(proc::math1::input::parameter), src_ch_idx);
+        sin_module->connect_output(proc::to_connector_index(proc::math1::output::result), dst_ch_idx);
+        track->push_back_module(sin_module, {0, length});
+
+        timeline->insert_track(static_cast<track_index_t>(idx), track);
+    }
+
+    return timeline;
+}
 }  // namespace yas::playing::exporter_test
 
 @interface exporter_tests : XCTestCase
@@ -151,6 +193,74 @@ struct cpp {
     }
 }
 
+- (void)test_set_timeline_packed {
+    std::string const &root_path = self->_cpp.root_path;
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 2;
+    std::string const identifier = "0";
+    path::timeline const tl_path{root_path, identifier, sample_rate};
+
+    auto exporter = exporter::make_shared(root_path, queue, priority, nullptr, exporter::fragment_format_t::packed);
+
+    auto module0 = proc::make_signal_module<double>(10.0);
+    module0->connect_output(proc::to_connector_index(proc::constant::output::value), 0);
+    auto module1 = proc::make_number_module<int64_t>(11);
+    module1->connect_output(proc::to_connector_index(proc::constant::output::value), 1);
+
+    auto track0 = proc::track::make_shared();
+    track0->push_back_module(module0, {-2, 5});
+    auto track1 = proc::track::make_shared();
+    track1->push_back_module(module1, {10, 1});
+
+    auto timeline = proc::timeline::make_shared({{0, track0}, {1, track1}});
+
+    exporter->set_timeline_container(timeline_container::make_shared(identifier, sample_rate, timeline));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    auto const ch0_path = path::channel{tl_path, 0};
+
+    XCTAssertFalse(file_manager::content_exists(path::fragment{ch0_path, 0}.value()));
+
+    XCTAssertFalse(file_manager::content_exists(path::packed_fragment{ch0_path, -2}.value()));
+    XCTAssertTrue(file_manager::content_exists(path::packed_fragment{ch0_path, -1}.value()));
+    XCTAssertTrue(file_manager::content_exists(path::packed_fragment{ch0_path, 0}.value()));
+    XCTAssertTrue(file_manager::content_exists(path::packed_fragment{ch0_path, 1}.value()));
+    XCTAssertFalse(file_manager::content_exists(path::packed_fragment{ch0_path, 2}.value()));
+
+    auto const ch1_path = path::channel{tl_path, 1};
+
+    XCTAssertFalse(file_manager::content_exists(path::packed_fragment{ch1_path, 4}.value()));
+    XCTAssertTrue(file_manager::content_exists(path::packed_fragment{ch1_path, 5}.value()));
+    XCTAssertFalse(file_manager::content_exists(path::packed_fragment{ch1_path, 6}.value()));
+
+    {
+        auto const signal_path_value = path::packed_fragment{ch0_path, 1}.value();
+        std::ifstream stream{signal_path_value, std::ios::binary};
+        std::string const data{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+        audio::format const format{{.sample_rate = static_cast<double>(sample_rate),
+                                    .pcm_format = audio::pcm_format::float64,
+                                    .channel_count = 1}};
+        audio::pcm_buffer buffer{format, static_cast<uint32_t>(sample_rate)};
+
+        XCTAssertTrue(packed_fragment_file::read_signals(data.data(), data.size(), buffer, 2));
+        XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[0], 10.0);
+        XCTAssertEqual(buffer.data_ptr_at_index<double>(0)[1], 0.0);
+    }
+
+    {
+        auto result = packed_fragment_file::read_numbers(path::packed_fragment{ch1_path, 5}.value());
+        XCTAssertTrue(result);
+        auto const &event_pairs = result.value();
+        XCTAssertEqual(event_pairs.size(), 1);
+        auto const &event_pair = *event_pairs.begin();
+        XCTAssertEqual(event_pair.first, 10);
+        XCTAssertEqual(event_pair.second->get<int64_t>(), 11);
+    }
+}
+
 - (void)test_set_sample_rate {
     std::string const &root_path = self->_cpp.root_path;
     auto const &queue = self->_cpp.queue;
@@ -360,6 +470,255 @@ struct cpp {
     XCTAssertFalse(file_manager::content_exists(path::fragment{ch1_path, 1}.value()));
 }
 
+- (void)test_skip_unchanged_fragments {
+    std::string const &root_path = self->_cpp.root_path;
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 2;
+    std::string const identifier = "0";
+    path::timeline const tl_path{root_path, identifier, sample_rate};
+
+    auto exporter = exporter::make_shared(root_path, queue, priority);
+
+    auto module0 = proc::make_signal_module<int64_t>(10);
+    module0->connect_output(proc::to_connector_index(proc::constant::output::value), 0);
+
+    auto track0 = proc::track::make_shared();
+    track0->push_back_module(module0, {0, 2});
+
+    auto timeline = proc::timeline::make_shared({{0, track0}});
+
+    exporter->set_timeline_container(timeline_container::make_shared(identifier, sample_rate, timeline));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    path::channel const ch0_path{tl_path, 0};
+    path::channel const ch1_path{tl_path, 1};
+    auto const signal_path_value = path::signal_event{path::fragment{ch0_path, 0}, {0, 2}, typeid(int64_t)}.value();
+
+    // 書き換えられていないことが分かるように、書き出されたファイルの中身を変えておく
+    auto const marker = proc::signal_event::make_shared<int64_t>(2);
+    marker->data<int64_t>()[0] = 99;
+    marker->data<int64_t>()[1] = 99;
+    XCTAssertTrue(signal_file::write(signal_path_value, *marker));
+
+    auto module1 = proc::make_signal_module<int64_t>(20);
+    module1->connect_output(proc::to_connector_index(proc::constant::output::value), 1);
+
+    auto track1 = proc::track::make_shared();
+    track1->push_back_module(module1, {0, 2});
+
+    timeline->insert_track(1, track1);
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertTrue(file_manager::content_exists(path::fragment{ch1_path, 0}.value()));
+
+    int64_t values[2] = {0, 0};
+
+    XCTAssertTrue(signal_file::read(signal_path_value, &values, sizeof(values)));
+    XCTAssertEqual(values[0], 99);
+    XCTAssertEqual(values[1], 99);
+
+    timeline->erase_track(1);
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertFalse(file_manager::content_exists(path::fragment{ch1_path, 0}.value()));
+
+    XCTAssertTrue(signal_file::read(signal_path_value, &values, sizeof(values)));
+    XCTAssertEqual(values[0], 99);
+
+    // 内容が変わったら書き直される
+    timeline->erase_track(0);
+
+    auto module2 = proc::make_signal_module<int64_t>(30);
+    module2->connect_output(proc::to_connector_index(proc::constant::output::value), 0);
+
+    auto track2 = proc::track::make_shared();
+    track2->push_back_module(module2, {0, 2});
+
+    timeline->insert_track(0, track2);
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertTrue(signal_file::read(signal_path_value, &values, sizeof(values)));
+    XCTAssertEqual(values[0], 30);
+    XCTAssertEqual(values[1], 30);
+}
+
+- (void)test_remove_fragments_of_replaced_timeline {
+    std::string const &root_path = self->_cpp.root_path;
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 2;
+
+    auto exporter = exporter::make_shared(root_path, queue, priority);
+
+    auto const make_timeline = [](channel_index_t const ch_idx) {
+        auto module = proc::make_signal_module<int64_t>(10);
+        module->connect_output(proc::to_connector_index(proc::constant::output::value), ch_idx);
+
+        auto track = proc::track::make_shared();
+        track->push_back_module(module, {0, 2});
+
+        return proc::timeline::make_shared({{0, track}});
+    };
+
+    exporter->set_timeline_container(timeline_container::make_shared("0", sample_rate, make_timeline(1)));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    path::fragment const old_frag_path{path::channel{path::timeline{root_path, "0", sample_rate}, 1}, 0};
+    XCTAssertTrue(file_manager::content_exists(old_frag_path.value()));
+
+    // 索引に無いフラグメントが残らないように、置き換える前のタイムラインのファイルは消される
+    exporter->set_timeline_container(timeline_container::make_shared("1", sample_rate, make_timeline(0)));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    XCTAssertFalse(file_manager::content_exists(old_frag_path.value()));
+    XCTAssertTrue(file_manager::content_exists(
+        path::fragment{path::channel{path::timeline{root_path, "1", sample_rate}, 0}, 0}.value()));
+}
+
+- (void)test_set_timeline_in_parallel {
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 2;
+    std::string const identifier = "0";
+    auto const serial_root_path = self->_cpp.root_path / "serial";
+    auto const parallel_root_path = self->_cpp.root_path / "parallel";
+
+    auto const serial_exporter = exporter::make_shared(serial_root_path, queue, priority);
+    auto const parallel_exporter =
+        exporter::make_shared(parallel_root_path, queue, priority, audio::worker_pool::make_shared(3));
+
+    serial_exporter->set_timeline_container(
+        timeline_container::make_shared(identifier, sample_rate, test_utils::test_timeline(0, 2)));
+    parallel_exporter->set_timeline_container(
+        timeline_container::make_shared(identifier, sample_rate, test_utils::test_timeline(0, 2)));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    auto const serial_contents = exporter_test::read_contents(serial_root_path);
+    auto const parallel_contents = exporter_test::read_contents(parallel_root_path);
+
+    XCTAssertGreaterThan(serial_contents.size(), 0);
+    XCTAssertTrue(serial_contents == parallel_contents);
+}
+
+- (void)test_set_timeline_in_parallel_with_many_fragments {
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 4;
+    std::string const identifier = "0";
+    auto const worker_pool = audio::worker_pool::make_shared(3);
+
+    // ワーカーの数とバッチの大きさに揃わない数のフラグメントを書き出す
+    for (auto const &format : {exporter::fragment_format_t::directory, exporter::fragment_format_t::packed}) {
+        auto const serial_root_path = self->_cpp.root_path / "serial";
+        auto const parallel_root_path = self->_cpp.root_path / "parallel";
+        file_manager::remove_content(self->_cpp.root_path);
+
+        auto const serial_exporter = exporter::make_shared(serial_root_path, queue, priority, nullptr, format);
+        auto const parallel_exporter = exporter::make_shared(parallel_root_path, queue, priority, worker_pool, format);
+
+        serial_exporter->set_timeline_container(timeline_container::make_shared(
+            identifier, sample_rate, exporter_test::make_synthetic_timeline(3, sample_rate * 19 + 1)));
+        parallel_exporter->set_timeline_container(timeline_container::make_shared(
+            identifier, sample_rate, exporter_test::make_synthetic_timeline(3, sample_rate * 19 + 1)));
+
+        queue->wait_until_all_tasks_are_finished();
+
+        auto const serial_contents = exporter_test::read_contents(serial_root_path);
+        auto const parallel_contents = exporter_test::read_contents(parallel_root_path);
+
+        XCTAssertGreaterThan(serial_contents.size(), 0);
+        XCTAssertTrue(serial_contents == parallel_contents);
+    }
+}
+
+- (void)test_set_timeline_in_parallel_with_stateful_module {
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 2;
+    std::string const identifier = "0";
+    auto const serial_root_path = self->_cpp.root_path / "serial";
+    auto const parallel_root_path = self->_cpp.root_path / "parallel";
+
+    // 前のスライスの値を持ち越すので、範囲を分けずにレンダリングされないと後半のフラグメントが変わる
+    auto const make_timeline = [] {
+        auto const timeline = proc::timeline::make_shared();
+        auto const track = proc::track::make_shared();
+
+        auto const number_module = proc::make_number_module<int16_t>(int16_t(5));
+        number_module->connect_output(proc::to_connector_index(proc::constant::output::value), 1);
+        track->push_back_module(number_module, {0, 1});
+
+        auto const signal_module = proc::make_number_to_signal_module<int16_t>();
+        signal_module->connect_input(proc::to_connector_index(proc::number_to_signal::input::number), 1);
+        signal_module->connect_output(proc::to_connector_index(proc::number_to_signal::output::signal), 0);
+        track->push_back_module(signal_module, {0, 16});
+
+        timeline->insert_track(0, track);
+        return timeline;
+    };
+
+    auto const serial_exporter = exporter::make_shared(serial_root_path, queue, priority);
+    auto const parallel_exporter =
+        exporter::make_shared(parallel_root_path, queue, priority, audio::worker_pool::make_shared(3));
+
+    serial_exporter->set_timeline_container(timeline_container::make_shared(identifier, sample_rate, make_timeline()));
+    parallel_exporter->set_timeline_container(
+        timeline_container::make_shared(identifier, sample_rate, make_timeline()));
+
+    queue->wait_until_all_tasks_are_finished();
+
+    auto const serial_contents = exporter_test::read_contents(serial_root_path);
+    auto const parallel_contents = exporter_test::read_contents(parallel_root_path);
+
+    XCTAssertGreaterThan(serial_contents.size(), 0);
+    XCTAssertTrue(serial_contents == parallel_contents);
+}
+
+- (void)test_export_performance {
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 48000;
+    auto const root_path = self->_cpp.root_path;
+    auto const worker_pool = audio::worker_pool::make_shared();
+
+    [self measureBlock:^{
+        file_manager::remove_content(root_path);
+
+        auto const exporter = exporter::make_shared(root_path, queue, priority, worker_pool);
+        exporter->set_timeline_container(timeline_container::make_shared(
+            test_utils::identifier, sample_rate, exporter_test::make_synthetic_timeline(8, sample_rate * 16)));
+
+        queue->wait_until_all_tasks_are_finished();
+    }];
+}
+
+- (void)test_export_packed_performance {
+    auto const &queue = self->_cpp.queue;
+    exporter::task_priority_t const &priority = self->_cpp.priority;
+    sample_rate_t const sample_rate = 48000;
+    auto const root_path = self->_cpp.root_path;
+    auto const worker_pool = audio::worker_pool::make_shared();
+
+    [self measureBlock:^{
+        file_manager::remove_content(root_path);
+
+        auto const exporter =
+            exporter::make_shared(root_path, queue, priority, worker_pool, exporter::fragment_format_t::packed);
+        exporter->set_timeline_container(timeline_container::make_shared(
+            test_utils::identifier, sample_rate, exporter_test::make_synthetic_timeline(8, sample_rate * 16)));
+
+        queue->wait_until_all_tasks_are_finished();
+    }];
+}
+
 - (void)test_method_to_string {
     XCTAssertEqual(to_string(exporter::method_t::reset), "reset");
     XCTAssertEqual(to_string(exporter::method_t::export_began), "export_began");
@@ -372,6 +731,7 @@ struct cpp {
     XCTAssertEqual(to_string(exporter::error_t::write_signal_failed), "write_signal_failed");
     XCTAssertEqual(to_string(exporter::error_t::write_numbers_failed), "write_numbers_failed");
     XCTAssertEqual(to_string(exporter::error_t::get_content_paths_failed), "get_content_paths_failed");
+    XCTAssertEqual(to_string(exporter::error_t::write_packed_fragment_failed), "write_packed_fragment_failed");
 }
 
 @end
@@ -8,6 +8,9 @@
 #import <cpp-utils/file_path.h>
 #import <cpp-utils/system_path_utils.h>
 #import <audio-playing/umbrella.hpp>
+#import <cstring>
+#import <filesystem>
+#import <fstream>
 #import "test_utils.h"
 
 using namespace yas;
@@ -17,6 +20,47 @@ namespace yas::playing::numbers_file_test {
 struct cpp {
     std::string const root_path = test_utils::root_path();
 };
+
+/// ヘッダのない旧形式で書き込む
+struct legacy_writer {
+    std::ofstream stream;
+
+    explicit legacy_writer(std::string const &path) : stream(path, std::ios_base::out | std::ios_base::binary) {
+    }
+
+    template <typename T>
+    void write(frame_index_t const frame, sample_store_type const store_type, T const value) {
+        this->stream.write(reinterpret_cast<char const *>(&frame), sizeof(frame_index_t));
+        this->stream.write(reinterpret_cast<char const *>(&store_type), sizeof(sample_store_type));
+        this->stream.write(reinterpret_cast<char const *>(&value), sizeof(T));
+    }
+};
+
+static std::size_t constexpr bench_count = 100000;
+
+/// 同じイベントを新形式と旧形式で書き込み、それぞれのパスを返す
+static std::pair<std::string, std::string> write_bench_files(std::string const &root_path) {
+    file_manager::create_directory_if_not_exists(root_path);
+
+    auto const path = file_path{root_path}.appending("numbers").string();
+    auto const legacy_path = file_path{root_path}.appending("numbers_legacy").string();
+
+    numbers_file::event_map_t events;
+
+    {
+        legacy_writer writer{legacy_path};
+
+        for (frame_index_t frame = 0; frame < static_cast<frame_index_t>(bench_count); ++frame) {
+            auto const value = static_cast<double>(frame) * 0.001;
+            events.emplace_hint(events.end(), frame, proc::number_event::make_shared(value));
+            writer.write(frame, sample_store_type::float64, value);
+        }
+    }
+
+    numbers_file::write(path, events);
+
+    return {path, legacy_path};
+}
 }  // namespace yas::playing::numbers_file_test
 
 @interface numbers_file_tests : XCTestCase
@@ -75,6 +119,199 @@ struct cpp {
     XCTAssertTrue(read_events.find(10)->second->is_equal(proc::number_event::make_shared(boolean(true))));
 }
 
+- (void)test_read_columns {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    numbers_file::event_map_t const write_events{{-1, proc::number_event::make_shared(double(0.5))},
+                                                 {2, proc::number_event::make_shared(int16_t(-2))},
+                                                 {2, proc::number_event::make_shared(boolean(true))}};
+
+    XCTAssertTrue(numbers_file::write(path, write_events));
+
+    auto const result = numbers_file::read_columns(path);
+
+    XCTAssertTrue(result);
+
+    auto const &columns = result.value();
+
+    XCTAssertEqual(columns.size(), 3);
+
+    XCTAssertEqual(columns.frame_at(0), -1);
+    XCTAssertEqual(columns.frame_at(1), 2);
+    XCTAssertEqual(columns.frame_at(2), 2);
+
+    XCTAssertEqual(columns.store_type_at(0), sample_store_type::float64);
+    XCTAssertEqual(columns.store_type_at(1), sample_store_type::int16);
+    XCTAssertEqual(columns.store_type_at(2), sample_store_type::boolean);
+
+    XCTAssertTrue(columns.event_at(0)->is_equal(proc::number_event::make_shared(double(0.5))));
+    XCTAssertTrue(columns.event_at(1)->is_equal(proc::number_event::make_shared(int16_t(-2))));
+    XCTAssertTrue(columns.event_at(2)->is_equal(proc::number_event::make_shared(boolean(true))));
+
+    XCTAssertThrows(columns.frame_at(3));
+    XCTAssertThrows(columns.event_at(3));
+
+    XCTAssertEqual(columns.events().size(), 3);
+}
+
+- (void)test_write_same_store_type {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    numbers_file::event_map_t write_events;
+    for (frame_index_t frame = 0; frame < 10; ++frame) {
+        write_events.emplace(frame, proc::number_event::make_shared(float(frame)));
+    }
+
+    XCTAssertTrue(numbers_file::write(path, write_events));
+
+    // 型がすべて同じなら、イベントごとの型を持たずに値を詰めて並べる
+    XCTAssertEqual(std::filesystem::file_size(path), 32 + sizeof(frame_index_t) * 10 + sizeof(float) * 10);
+
+    auto const result = numbers_file::read_columns(path);
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(result.value().size(), 10);
+    XCTAssertEqual(result.value().store_type_at(9), sample_store_type::float32);
+    XCTAssertTrue(result.value().event_at(9)->is_equal(proc::number_event::make_shared(float(9))));
+}
+
+- (void)test_read_columns_from_data {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    XCTAssertTrue(numbers_file::write(path, {{4, proc::number_event::make_shared(uint32_t(4))}}));
+
+    std::ifstream stream{path, std::ios_base::in | std::ios_base::binary};
+    std::vector<char> data{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+    auto const result = numbers_file::read_columns(data.data(), data.size());
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(result.value().size(), 1);
+    XCTAssertEqual(result.value().frame_at(0), 4);
+    XCTAssertTrue(result.value().event_at(0)->is_equal(proc::number_event::make_shared(uint32_t(4))));
+
+    // コピーせずに参照している
+    frame_index_t const frame = 5;
+    std::memcpy(&data.at(32), &frame, sizeof(frame_index_t));
+
+    XCTAssertEqual(result.value().frame_at(0), 5);
+}
+
+- (void)test_write_empty {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    XCTAssertTrue(numbers_file::write(path, {}));
+
+    auto const result = numbers_file::read(path);
+
+    XCTAssertTrue(result);
+    XCTAssertEqual(result.value().size(), 0);
+}
+
+- (void)test_read_legacy {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    {
+        numbers_file_test::legacy_writer writer{path};
+        writer.write(0, sample_store_type::float64, double(1.5));
+        writer.write(1, sample_store_type::int32, int32_t(-3));
+        writer.write(1, sample_store_type::boolean, true);
+    }
+
+    auto const read_result = numbers_file::read(path);
+
+    XCTAssertTrue(read_result);
+
+    auto const &read_events = read_result.value();
+
+    XCTAssertEqual(read_events.size(), 3);
+
+    auto iterator = read_events.begin();
+    XCTAssertEqual(iterator->first, 0);
+    XCTAssertTrue(iterator->second->is_equal(proc::number_event::make_shared(double(1.5))));
+    ++iterator;
+    XCTAssertEqual(iterator->first, 1);
+    XCTAssertTrue(iterator->second->is_equal(proc::number_event::make_shared(int32_t(-3))));
+    ++iterator;
+    XCTAssertEqual(iterator->first, 1);
+    XCTAssertTrue(iterator->second->is_equal(proc::number_event::make_shared(boolean(true))));
+
+    auto const columns_result = numbers_file::read_columns(path);
+
+    XCTAssertTrue(columns_result);
+    XCTAssertEqual(columns_result.value().size(), 3);
+    XCTAssertEqual(columns_result.value().store_type_at(1), sample_store_type::int32);
+}
+
+- (void)test_read_legacy_error {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    {
+        numbers_file_test::legacy_writer writer{path};
+        writer.write(0, sample_store_type::unknown, double(1.0));
+    }
+
+    auto const result = numbers_file::read(path);
+
+    XCTAssertFalse(result);
+    XCTAssertEqual(result.error(), numbers_file::read_error::sample_store_type_not_found);
+}
+
+- (void)test_read_invalid_header {
+    file_manager::create_directory_if_not_exists(self->_cpp.root_path);
+
+    auto const path = file_path{self->_cpp.root_path}.appending("numbers").string();
+
+    XCTAssertTrue(numbers_file::write(path, {{0, proc::number_event::make_shared(double(1.0))}}));
+
+    // 値の途中で切れたファイルは読み込まない
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    auto const result = numbers_file::read(path);
+
+    XCTAssertFalse(result);
+    XCTAssertEqual(result.error(), numbers_file::read_error::invalid_header);
+}
+
+- (void)test_read_legacy_performance {
+    auto const legacy_path = numbers_file_test::write_bench_files(self->_cpp.root_path).second;
+
+    [self measureBlock:^{
+        auto const result = numbers_file::read(legacy_path);
+        XCTAssertEqual(result.value().size(), numbers_file_test::bench_count);
+    }];
+}
+
+- (void)test_read_events_performance {
+    auto const path = numbers_file_test::write_bench_files(self->_cpp.root_path).first;
+
+    [self measureBlock:^{
+        auto const result = numbers_file::read(path);
+        XCTAssertEqual(result.value().size(), numbers_file_test::bench_count);
+    }];
+}
+
+- (void)test_read_columns_performance {
+    auto const path = numbers_file_test::write_bench_files(self->_cpp.root_path).first;
+
+    [self measureBlock:^{
+        auto const result = numbers_file::read_columns(path);
+        XCTAssertEqual(result.value().size(), numbers_file_test::bench_count);
+    }];
+}
+
 - (void)test_write_error_to_string {
     XCTAssertEqual(to_string(numbers_file::write_error::open_stream_failed), "open_stream_failed");
     XCTAssertEqual(to_string(numbers_file::write_error::write_to_stream_failed), "write_to_stream_failed");
@@ -87,6 +324,8 @@ struct cpp {
     XCTAssertEqual(to_string(numbers_file::read_error::read_sample_store_type_failed), "read_sample_store_type_failed");
     XCTAssertEqual(to_string(numbers_file::read_error::read_value_failed), "read_value_failed");
     XCTAssertEqual(to_string(numbers_file::read_error::sample_store_type_not_found), "sample_store_type_not_found");
+    XCTAssertEqual(to_string(numbers_file::read_error::read_from_stream_failed), "read_from_stream_failed");
+    XCTAssertEqual(to_string(numbers_file::read_error::invalid_header), "invalid_header");
 }
 
 @end
@@ -0,0 +1,202 @@
+//
+//  packed_fragment_file_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/format/format.h>
+#import <audio-engine/pcm_buffer/pcm_buffer.h>
+#import <cpp-utils/file_manager.h>
+#import <cpp-utils/file_path.h>
+#import <audio-playing/umbrella.hpp>
+#import <audio-processing/umbrella.hpp>
+#import <cstring>
+#import <fstream>
+#import "test_utils.h"
+
+using namespace yas;
+using namespace yas::playing;
+
+namespace yas::playing::packed_fragment_file_test {
+static audio::format const format{
+    {.sample_rate = 4.0, .channel_count = 1, .pcm_format = audio::pcm_format::float32, .interleaved = false}};
+
+static std::string file_path_value() {
+    return file_path{test_utils::root_path()}.appending("packed").string();
+}
+
+static std::string read_file(std::string const &path) {
+    std::ifstream stream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+template <typename T>
+static proc::signal_event_ptr make_signal(std::vector<T> const &values) {
+    auto event = proc::signal_event::make_shared<T>(values.size());
+    std::copy(values.begin(), values.end(), event->template data<T>());
+    return event;
+}
+}  // namespace yas::playing::packed_fragment_file_test
+
+@interface packed_fragment_file_tests : XCTestCase
+
+@end
+
+@implementation packed_fragment_file_tests
+
+- (void)setUp {
+    file_manager::remove_content(test_utils::root_path());
+    file_manager::create_directory_if_not_exists(test_utils::root_path());
+}
+
+- (void)tearDown {
+    file_manager::remove_content(test_utils::root_path());
+}
+
+- (void)test_write_and_read_signals {
+    using namespace packed_fragment_file_test;
+
+    proc::channel channel;
+    channel.insert_event(proc::make_range_time(0, 1), make_signal<float>({1.0f}));
+    channel.insert_event(proc::make_range_time(2, 2), make_signal<float>({3.0f, 4.0f}));
+    channel.insert_event(proc::make_range_time(1, 1), make_signal<double>({100.0}));
+
+    auto const path = file_path_value();
+
+    XCTAssertTrue(packed_fragment_file::write(path, channel));
+    XCTAssertFalse(file_manager::content_exists(path + ".tmp"));
+
+    auto const data = read_file(path);
+    audio::pcm_buffer buffer{format, 4};
+
+    XCTAssertTrue(packed_fragment_file::read_signals(data.data(), data.size(), buffer, 0));
+
+    // サンプルの型が違う信号は読み込まない
+    float const *const values = buffer.data_ptr_at_index<float>(0);
+    XCTAssertEqual(values[0], 1.0f);
+    XCTAssertEqual(values[1], 0.0f);
+    XCTAssertEqual(values[2], 3.0f);
+    XCTAssertEqual(values[3], 4.0f);
+}
+
+- (void)test_write_and_read_numbers {
+    using namespace packed_fragment_file_test;
+
+    proc::channel channel;
+    channel.insert_event(proc::make_range_time(0, 2), make_signal<float>({1.0f, 2.0f}));
+    channel.insert_event(proc::make_frame_time(1), proc::number_event::make_shared(int64_t(10)));
+    channel.insert_event(proc::make_frame_time(3), proc::number_event::make_shared(1.5));
+
+    auto const path = file_path_value();
+
+    XCTAssertTrue(packed_fragment_file::write(path, channel));
+
+    auto const result = packed_fragment_file::read_numbers(path);
+    XCTAssertTrue(result);
+
+    auto const &events = result.value();
+    XCTAssertEqual(events.size(), 2);
+
+    auto iterator = events.begin();
+    XCTAssertEqual(iterator->first, 1);
+    XCTAssertEqual(iterator->second->get<int64_t>(), 10);
+
+    ++iterator;
+    XCTAssertEqual(iterator->first, 3);
+    XCTAssertEqual(iterator->second->get<double>(), 1.5);
+}
+
+- (void)test_read_empty_numbers {
+    using namespace packed_fragment_file_test;
+
+    proc::channel channel;
+    channel.insert_event(proc::make_range_time(0, 1), make_signal<float>({1.0f}));
+
+    auto const path = file_path_value();
+
+    XCTAssertTrue(packed_fragment_file::write(path, channel));
+
+    auto const result = packed_fragment_file::read_numbers(path);
+    XCTAssertTrue(result);
+    XCTAssertEqual(result.value().size(), 0);
+}
+
+- (void)test_read_error {
+    using namespace packed_fragment_file_test;
+
+    audio::pcm_buffer buffer{format, 4};
+
+    std::string const invalid_data(64, 'a');
+    XCTAssertEqual(packed_fragment_file::read_signals(invalid_data.data(), invalid_data.size(), buffer, 0).error(),
+                   packed_fragment_file::read_error::invalid_header);
+    XCTAssertEqual(packed_fragment_file::read_signals(invalid_data.data(), 8, buffer, 0).error(),
+                   packed_fragment_file::read_error::invalid_header);
+
+    proc::channel channel;
+    channel.insert_event(proc::make_range_time(2, 2), make_signal<float>({1.0f, 2.0f}));
+
+    auto const path = file_path_value();
+    XCTAssertTrue(packed_fragment_file::write(path, channel));
+
+    auto const data = read_file(path);
+
+    XCTAssertEqual(packed_fragment_file::read_signals(data.data(), data.size(), buffer, 4).error(),
+                   packed_fragment_file::read_error::out_of_range);
+    XCTAssertEqual(packed_fragment_file::read_signals(data.data(), data.size() - 1, buffer, 0).error(),
+                   packed_fragment_file::read_error::invalid_signal_index);
+
+    // 長さにサンプルのバイト数を掛けると溢れる値
+    auto overflowed_data = data;
+    uint64_t const overflowed_length = (uint64_t(1) << 62) + 2;
+    std::memcpy(&overflowed_data[32 + 8], &overflowed_length, sizeof(uint64_t));
+
+    XCTAssertEqual(
+        packed_fragment_file::read_signals(overflowed_data.data(), overflowed_data.size(), buffer, 0).error(),
+        packed_fragment_file::read_error::invalid_signal_index);
+
+    XCTAssertEqual(packed_fragment_file::read_numbers(path + "_none").error(),
+                   packed_fragment_file::read_error::open_stream_failed);
+}
+
+- (void)test_write_error_to_string {
+    XCTAssertEqual(to_string(packed_fragment_file::write_error::open_stream_failed), "open_stream_failed");
+    XCTAssertEqual(to_string(packed_fragment_file::write_error::write_to_stream_failed), "write_to_stream_failed");
+    XCTAssertEqual(to_string(packed_fragment_file::write_error::close_stream_failed), "close_stream_failed");
+    XCTAssertEqual(to_string(packed_fragment_file::write_error::rename_failed), "rename_failed");
+}
+
+- (void)test_read_error_to_string {
+    XCTAssertEqual(to_string(packed_fragment_file::read_error::open_stream_failed), "open_stream_failed");
+    XCTAssertEqual(to_string(packed_fragment_file::read_error::read_from_stream_failed), "read_from_stream_failed");
+    XCTAssertEqual(to_string(packed_fragment_file::read_error::invalid_header), "invalid_header");
+    XCTAssertEqual(to_string(packed_fragment_file::read_error::invalid_signal_index), "invalid_signal_index");
+    XCTAssertEqual(to_string(packed_fragment_file::read_error::out_of_range), "out_of_range");
+    XCTAssertEqual(to_string(packed_fragment_file::read_error::read_numbers_failed), "read_numbers_failed");
+}
+
+- (void)test_error_ostream {
+    auto const write_errors = {packed_fragment_file::write_error::open_stream_failed,
+                               packed_fragment_file::write_error::write_to_stream_failed,
+                               packed_fragment_file::write_error::close_stream_failed,
+                               packed_fragment_file::write_error::rename_failed};
+
+    for (auto const &error : write_errors) {
+        std::ostringstream stream;
+        stream << error;
+        XCTAssertEqual(stream.str(), to_string(error));
+    }
+
+    auto const read_errors = {packed_fragment_file::read_error::open_stream_failed,
+                              packed_fragment_file::read_error::read_from_stream_failed,
+                              packed_fragment_file::read_error::invalid_header,
+                              packed_fragment_file::read_error::invalid_signal_index,
+                              packed_fragment_file::read_error::out_of_range,
+                              packed_fragment_file::read_error::read_numbers_failed};
+
+    for (auto const &error : read_errors) {
+        std::ostringstream stream;
+        stream << error;
+        XCTAssertEqual(stream.str(), to_string(error));
+    }
+}
+
+@end
@@ -83,6 +83,26 @@ using namespace yas::playing;
                   (path::fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 4}));
 }
 
+- (void)test_packed_fragment {
+    path::timeline tl_path{"/root", "0", 48000};
+    path::packed_fragment frag_path{path::channel{tl_path, 1}, 2};
+
+    XCTAssertEqual(frag_path.fragment_index, 2);
+    XCTAssertEqual(frag_path.value().string(), "/root/0_48000/1/2.packed");
+}
+
+- (void)test_packed_fragment_equal {
+    XCTAssertTrue((path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 2}) ==
+                  (path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 2}));
+    XCTAssertFalse((path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 2}) ==
+                   (path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 3}, 2}));
+    XCTAssertFalse((path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 2}) ==
+                   (path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 4}));
+
+    XCTAssertTrue((path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 2}) !=
+                  (path::packed_fragment{path::channel{path::timeline{"/root", "0", 48000}, 1}, 4}));
+}
+
 - (void)test_signal_event {
     path::timeline tl_path{"/root", "0", 48000};
     path::channel ch_path{tl_path, 1};
@@ -24,7 +24,7 @@ using namespace yas::playing;
 - (void)test_setup_state_initial {
     audio::pcm_buffer buffer = player_test::cpp::make_out_buffer();
 
-    self->_cpp.skip_reading();
+    self->_cpp.setup_initial();
 
     auto const &buffering = self->_cpp.buffering;
 
@@ -47,7 +47,7 @@ using namespace yas::playing;
 - (void)test_setup_state_creating {
     audio::pcm_buffer buffer = player_test::cpp::make_out_buffer();
 
-    self->_cpp.skip_reading();
+    self->_cpp.setup_initial();
 
     auto const &buffering = self->_cpp.buffering;
 
@@ -67,7 +67,7 @@ using namespace yas::playing;
 - (void)test_setup_state_rendering {
     audio::pcm_buffer buffer = player_test::cpp::make_out_buffer();
 
-    self->_cpp.skip_reading();
+    self->_cpp.setup_initial();
 
     auto const &buffering = self->_cpp.buffering;
 
@@ -218,9 +218,15 @@ using namespace yas::playing;
 
     std::size_t called_pull_seek = 0;
     std::size_t called_needs_all_writing = 0;
+    std::size_t called_reset_overwrite = 0;
+    std::size_t called_perform_overwrite = 0;
 
     buffering->rendering_state_handler = [] { return audio_buffering_rendering_state::advancing; };
-    resource->reset_overwrite_requests_handler = [] {};
+    resource->reset_overwrite_requests_handler = [&called_reset_overwrite] { ++called_reset_overwrite; };
+    resource->perform_overwrite_requests_handler =
+        [&called_perform_overwrite](player_test::resource::overwrite_requests_f const &) {
+            ++called_perform_overwrite;
+        };
     resource->pull_seek_frame_handler = [&called_pull_seek] {
         ++called_pull_seek;
         return 0;
@@ -236,6 +242,8 @@ using namespace yas::playing;
 
     XCTAssertEqual(called_pull_seek, 1);
     XCTAssertEqual(called_needs_all_writing, 1);
+    XCTAssertEqual(called_reset_overwrite, 0);
+    XCTAssertEqual(called_perform_overwrite, 1, @"読み込み済みのエレメントを使い回すので上書きを反映してから全体を書き込む");
 }
 
 @end
@@ -3,12 +3,49 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <cpp-utils/file_manager.h>
 #import <audio-playing/umbrella.hpp>
+#import <audio-processing/umbrella.hpp>
 #import "player_test_utils.h"
 
 using namespace yas;
 using namespace yas::playing;
 
+namespace yas::playing::player_rendering_test::benchmark {
+static sample_rate_t const sample_rate = 48000;
+static uint32_t const ch_count = 2;
+static uint32_t const out_length = 512;
+static fragment_index_t const fragment_count = 16;
+
+// チャンネルごとにフラグメントをまとめたファイルを書き出す
+static bool write_fragments(std::string const &identifier) {
+    path::timeline const tl_path{
+        .root_path = test_utils::root_path(), .identifier = identifier, .sample_rate = sample_rate};
+
+    for (channel_index_t ch_idx = 0; ch_idx < ch_count; ++ch_idx) {
+        path::channel const ch_path{.timeline_path = tl_path, .channel_index = ch_idx};
+
+        if (!file_manager::create_directory_if_not_exists(ch_path.value())) {
+            return false;
+        }
+
+        for (fragment_index_t frag_idx = 0; frag_idx < fragment_count; ++frag_idx) {
+            auto const event = proc::signal_event::make_shared<float>(sample_rate);
+            std::fill_n(event->data<float>(), sample_rate, static_cast<float>(ch_idx));
+
+            proc::channel channel;
+            channel.insert_event(proc::make_range_time(frag_idx * sample_rate, sample_rate), event);
+
+            if (!packed_fragment_file::write(path::packed_fragment{ch_path, frag_idx}.value(), channel)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+}  // namespace yas::playing::player_rendering_test::benchmark
+
 @interface player_rendering_tests : XCTestCase
 
 @end
@@ -110,11 +147,11 @@ using namespace yas::playing;
     self->_cpp.skip_pull();
 
     auto const &resource = self->_cpp.resource;
-    auto const &reading = self->_cpp.reading;
+    auto const &buffering = self->_cpp.buffering;
 
     bool is_playing = false;
     std::size_t called_is_playing = 0;
-    std::size_t called_buffer = 0;
+    std::size_t called_fragment_length = 0;
 
     resource->perform_overwrite_requests_handler = [](player_test::resource::overwrite_requests_f const &) {};
 
@@ -123,22 +160,25 @@ using namespace yas::playing;
         return is_playing;
     };
 
-    reading->buffer_handler = [&called_buffer] {
-        ++called_buffer;
-        return nullptr;
+    resource->current_frame_handler = [] { return 0; };
+    resource->set_current_frame_handler = [](frame_index_t) {};
+    buffering->channel_count_handler = [] { return 0; };
+    buffering->fragment_length_handler = [&called_fragment_length] {
+        ++called_fragment_length;
+        return 4;
     };
 
     self->_cpp.rendering_handler(&buffer);
 
     XCTAssertEqual(called_is_playing, 1);
-    XCTAssertEqual(called_buffer, 0);
+    XCTAssertEqual(called_fragment_length, 0);
 
     is_playing = true;
 
     self->_cpp.rendering_handler(&buffer);
 
     XCTAssertEqual(called_is_playing, 2);
-    XCTAssertEqual(called_buffer, 1);
+    XCTAssertEqual(called_fragment_length, 1);
 }
 
 - (void)test_rendering {
@@ -157,9 +197,10 @@ using namespace yas::playing;
     resource->current_frame_handler = [&current_frame] { return current_frame; };
     buffering->fragment_length_handler = [] { return 4; };
     buffering->channel_count_handler = [] { return 3; };
-    buffering->read_into_buffer_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
-                                                              frame_index_t frame_idx) {
-        player_test::cpp::fill_buffer(buffer, ch_idx, frame_idx);
+    buffering->read_into_channel_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
+                                                               uint32_t out_begin_frame, frame_index_t frame_idx,
+                                                               uint32_t length) {
+        player_test::cpp::fill_channel(buffer, ch_idx, out_begin_frame, frame_idx, length);
         called_read_into.emplace_back(ch_idx, frame_idx);
         return true;
     };
@@ -210,9 +251,10 @@ using namespace yas::playing;
     resource->current_frame_handler = [&current_frame] { return current_frame; };
     buffering->fragment_length_handler = [] { return 1; };
     buffering->channel_count_handler = [] { return 3; };
-    buffering->read_into_buffer_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
-                                                              frame_index_t frame_idx) {
-        player_test::cpp::fill_buffer(buffer, ch_idx, frame_idx);
+    buffering->read_into_channel_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
+                                                               uint32_t out_begin_frame, frame_index_t frame_idx,
+                                                               uint32_t length) {
+        player_test::cpp::fill_channel(buffer, ch_idx, out_begin_frame, frame_idx, length);
         called_read_into.emplace_back(ch_idx, frame_idx);
         return true;
     };
@@ -273,9 +315,10 @@ using namespace yas::playing;
     resource->current_frame_handler = [&current_frame] { return current_frame; };
     buffering->fragment_length_handler = [] { return 4; };
     buffering->channel_count_handler = [] { return 1; };
-    buffering->read_into_buffer_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
-                                                              frame_index_t frame_idx) {
-        player_test::cpp::fill_buffer(buffer, ch_idx, frame_idx);
+    buffering->read_into_channel_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
+                                                               uint32_t out_begin_frame, frame_index_t frame_idx,
+                                                               uint32_t length) {
+        player_test::cpp::fill_channel(buffer, ch_idx, out_begin_frame, frame_idx, length);
         called_read_into.emplace_back(ch_idx, frame_idx);
         return true;
     };
@@ -322,15 +365,16 @@ using namespace yas::playing;
     resource->current_frame_handler = [&current_frame] { return current_frame; };
     buffering->fragment_length_handler = [] { return 1; };
     buffering->channel_count_handler = [] { return 3; };
-    buffering->read_into_buffer_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
-                                                              frame_index_t frame_idx) {
+    buffering->read_into_channel_handler = [&called_read_into](audio::pcm_buffer *buffer, channel_index_t ch_idx,
+                                                               uint32_t out_begin_frame, frame_index_t frame_idx,
+                                                               uint32_t length) {
         called_read_into.emplace_back(ch_idx, frame_idx);
 
         if (frame_idx != 30) {
             return false;
         }
 
-        player_test::cpp::fill_buffer(buffer, ch_idx, frame_idx);
+        player_test::cpp::fill_channel(buffer, ch_idx, out_begin_frame, frame_idx, length);
         return true;
     };
     buffering->advance_handler = [&called_advance](fragment_index_t frag_idx) {
@@ -367,4 +411,50 @@ using namespace yas::playing;
     XCTAssertEqual(data2[1], 0);
 }
 
+- (void)test_rendering_performance {
+    using namespace player_rendering_test::benchmark;
+
+    file_manager::remove_content(test_utils::root_path());
+    XCTAssertTrue(write_fragments("0"));
+
+    auto const worker = worker_stub::make_shared();
+    auto const renderer = std::make_shared<player_test::renderer>();
+    auto const resource = player_resource::make_shared(
+        buffering_resource::make_shared(3, test_utils::root_path(), playing::make_buffering_channel));
+
+    renderer_rendering_f rendering_handler = nullptr;
+    renderer->set_rendering_handler_handler = [&rendering_handler](renderer_rendering_f &&handler) {
+        rendering_handler = std::move(handler);
+    };
+
+    auto const player =
+        player::make_shared(test_utils::root_path(), renderer, worker, {.setup = 100, .rendering = 101}, resource);
+    player->set_identifier("0");
+    player->set_channel_mapping({.indices = {0, 1}});
+    player->set_playing(true);
+
+    worker->start();
+
+    audio::format const format{{.sample_rate = static_cast<double>(sample_rate), .channel_count = ch_count}};
+    auto const buffer = std::make_shared<audio::pcm_buffer>(format, out_length);
+
+    // バッファを作って先頭から書き込み終わるまで進めておく
+    while (resource->buffering()->rendering_state() != audio_buffering_rendering_state::advancing) {
+        rendering_handler(buffer.get());
+        worker->process();
+    }
+
+    [self measureBlock:^{
+        for (uint32_t idx = 0; idx < 1000; ++idx) {
+            rendering_handler(buffer.get());
+            // taskでの書き込みは描画の合間に進める
+            worker->process();
+        }
+    }];
+
+    XCTAssertGreaterThan(player->current_frame(), 0);
+
+    file_manager::remove_content(test_utils::root_path());
+}
+
 @end
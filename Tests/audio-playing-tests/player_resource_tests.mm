@@ -4,33 +4,14 @@
 
 #import <XCTest/XCTest.h>
 #import <audio-playing/umbrella.hpp>
+#import <atomic>
+#import <set>
+#import <thread>
 
 using namespace yas;
 using namespace yas::playing;
 
 namespace yas::playing::player_resource_test {
-struct reading_resource : reading_resource_for_player_resource {
-    state_t state() const override {
-        return state_t::initial;
-    }
-
-    audio::pcm_buffer *buffer_on_render() override {
-        return nullptr;
-    }
-
-    bool needs_create_on_render(sample_rate_t const sample_rate, audio::pcm_format const pcm_format,
-                                uint32_t const length) const override {
-        return false;
-    }
-
-    void set_creating_on_render(sample_rate_t const sample_rate, audio::pcm_format const pcm_format,
-                                uint32_t const length) override {
-    }
-
-    void create_buffer_on_task() override {
-    }
-};
-
 struct buffering_resource : buffering_resource_for_player_resource {
     setup_state_t setup_state() const override {
         return setup_state_t::initial;
@@ -75,6 +56,11 @@ struct buffering_resource : buffering_resource_for_player_resource {
         return false;
     }
 
+    bool read_into_channel_on_render(audio::pcm_buffer *, channel_index_t const, uint32_t const, frame_index_t const,
+                                     uint32_t const) override {
+        return false;
+    }
+
     bool needs_all_writing_on_render() const override {
         return false;
     }
@@ -82,14 +68,22 @@ struct buffering_resource : buffering_resource_for_player_resource {
     }
     void set_identifier_request_on_main(std::string const &) override {
     }
+    void set_warming_frames_request_on_main(std::vector<frame_index_t> const &) override {
+    }
+    buffering_statistics statistics() const override {
+        return {};
+    }
 };
 
 struct cpp {
-    std::shared_ptr<reading_resource> const reading = std::make_shared<player_resource_test::reading_resource>();
     std::shared_ptr<buffering_resource> const buffering = std::make_shared<player_resource_test::buffering_resource>();
 
     player_resource_ptr make_resource() {
-        return player_resource::make_shared(this->reading, this->buffering);
+        return player_resource::make_shared(this->buffering);
+    }
+
+    player_resource_ptr make_resource(std::size_t const overwrite_capacity) {
+        return player_resource::make_shared(this->buffering, overwrite_capacity);
     }
 };
 }  // namespace yas::playing::player_resource_test
@@ -105,7 +99,6 @@ struct cpp {
 - (void)test_constructor {
     auto const resource = self->_cpp.make_resource();
 
-    XCTAssertEqual(resource->reading(), self->_cpp.reading);
     XCTAssertEqual(resource->buffering(), self->_cpp.buffering);
 }
 
@@ -235,4 +228,135 @@ struct cpp {
                            }];
 }
 
+- (void)test_coalesce_overwrite_requests {
+    auto const resource = self->_cpp.make_resource();
+
+    std::vector<player_resource_for_player::overwrite_requests_t> called;
+
+    auto requests = [&called](player_resource_for_player::overwrite_requests_t const &requests) {
+        called.emplace_back(requests);
+    };
+
+    resource->reset_overwrite_requests_on_render();
+
+    resource->add_overwrite_request_on_main({.file_channel_index = 1, .fragment_range = {.index = 2, .length = 1}});
+    resource->add_overwrite_request_on_main({.file_channel_index = 1, .fragment_range = {.index = 2, .length = 1}});
+    resource->add_overwrite_request_on_main(
+        {.file_channel_index = std::nullopt, .fragment_range = {.index = 4, .length = 4}});
+    resource->add_overwrite_request_on_main({.file_channel_index = 3, .fragment_range = {.index = 5, .length = 2}});
+
+    resource->perform_overwrite_requests_on_render(requests);
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0).size(), 2);
+    XCTAssertTrue(called.at(0).at(0) ==
+                  (element_address{.file_channel_index = 1, .fragment_range = {.index = 2, .length = 1}}));
+    XCTAssertTrue(called.at(0).at(1) ==
+                  (element_address{.file_channel_index = std::nullopt, .fragment_range = {.index = 4, .length = 4}}));
+}
+
+- (void)test_overflow_overwrite_requests {
+    auto const resource = self->_cpp.make_resource(2);
+
+    std::vector<player_resource_for_player::overwrite_requests_t> called;
+
+    auto requests = [&called](player_resource_for_player::overwrite_requests_t const &requests) {
+        called.emplace_back(requests);
+    };
+
+    resource->reset_overwrite_requests_on_render();
+
+    for (fragment_index_t idx = 0; idx < 3; ++idx) {
+        resource->add_overwrite_request_on_main(
+            {.file_channel_index = 0, .fragment_range = {.index = idx * 10, .length = 1}});
+    }
+
+    resource->perform_overwrite_requests_on_render(requests);
+
+    // 溢れた場合はすべてを上書きするリクエストにまとめる
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0).size(), 1);
+    XCTAssertFalse(called.at(0).at(0).file_channel_index.has_value());
+    XCTAssertTrue(called.at(0).at(0).fragment_range.contains(0));
+    XCTAssertTrue(called.at(0).at(0).fragment_range.contains(20));
+    XCTAssertTrue(called.at(0).at(0).fragment_range.contains(-1000000));
+    XCTAssertTrue(called.at(0).at(0).fragment_range.contains(1000000));
+
+    called.clear();
+
+    resource->add_overwrite_request_on_main({.file_channel_index = 0, .fragment_range = {.index = 30, .length = 1}});
+
+    resource->perform_overwrite_requests_on_render(requests);
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0).size(), 1);
+    XCTAssertEqual(called.at(0).at(0).fragment_range.index, 30);
+}
+
+- (void)test_seek_and_overwrite_while_rendering {
+    auto const resource = self->_cpp.make_resource(16);
+
+    fragment_index_t const request_count = 20000;
+    frame_index_t const last_seek_frame = request_count - 1;
+
+    std::atomic<bool> is_finished{false};
+    std::set<fragment_index_t> overwritten;
+    bool is_all_overwritten = false;
+    std::optional<frame_index_t> pulled_seek_frame = std::nullopt;
+
+    // レンダリングのスレッドと同じ順番でresourceを呼び続ける
+    std::thread render_thread{[&resource, &is_finished, &overwritten, &is_all_overwritten, &pulled_seek_frame] {
+        auto const handler = [&overwritten, &is_all_overwritten](
+                                 player_resource_for_player::overwrite_requests_t const &requests) {
+            for (auto const &request : requests) {
+                if (request.fragment_range.length > 1) {
+                    is_all_overwritten = true;
+                } else {
+                    overwritten.insert(request.fragment_range.index);
+                }
+            }
+        };
+
+        auto const render = [&resource, &handler, &pulled_seek_frame] {
+            if (auto const seek_frame = resource->pull_seek_frame_on_render()) {
+                pulled_seek_frame = seek_frame;
+                resource->set_current_frame_on_render(seek_frame.value());
+            }
+
+            resource->perform_overwrite_requests_on_render(handler);
+        };
+
+        while (!is_finished) {
+            render();
+            std::this_thread::yield();
+        }
+
+        // mainで最後に追加されたものも受け取る
+        render();
+    }};
+
+    for (fragment_index_t idx = 0; idx < request_count; ++idx) {
+        resource->seek_on_main(idx);
+        resource->add_overwrite_request_on_main(
+            {.file_channel_index = 0, .fragment_range = {.index = idx, .length = 1}});
+
+        if (idx % 64 == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    is_finished = true;
+    render_thread.join();
+
+    XCTAssertEqual(pulled_seek_frame, last_seek_frame);
+    XCTAssertEqual(resource->current_frame(), last_seek_frame);
+    XCTAssertFalse(resource->is_seeking_on_main());
+
+    // 溢れて全体の上書きになったものを除いて、すべてのリクエストが届いている
+    if (!is_all_overwritten) {
+        XCTAssertEqual(overwritten.size(), request_count);
+    }
+    XCTAssertTrue(overwritten.count(last_seek_frame) > 0 || is_all_overwritten);
+}
+
 @end
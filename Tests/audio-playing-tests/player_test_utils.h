@@ -31,16 +31,10 @@ struct resource : player_resource_for_player {
     std::function<void(overwrite_requests_f const &)> perform_overwrite_requests_handler;
     std::function<void(void)> reset_overwrite_requests_handler;
 
-    std::shared_ptr<reading_resource_for_player_resource> const _reading;
     std::shared_ptr<buffering_resource_for_player_resource> const _buffering;
 
-    resource(std::shared_ptr<reading_resource_for_player_resource> const &reading,
-             std::shared_ptr<buffering_resource_for_player_resource> const &buffering)
-        : _reading(reading), _buffering(buffering) {
-    }
-
-    std::shared_ptr<reading_resource_for_player_resource> const &reading() const override {
-        return this->_reading;
+    explicit resource(std::shared_ptr<buffering_resource_for_player_resource> const &buffering)
+        : _buffering(buffering) {
     }
 
     std::shared_ptr<buffering_resource_for_player_resource> const &buffering() const override {
@@ -88,36 +82,6 @@ struct resource : player_resource_for_player {
     }
 };
 
-struct reading : reading_resource_for_player_resource {
-    std::function<state_t(void)> state_handler;
-    std::function<audio::pcm_buffer *(void)> buffer_handler;
-    std::function<bool(sample_rate_t, audio::pcm_format, uint32_t)> needs_create_handler;
-    std::function<void(sample_rate_t, audio::pcm_format, uint32_t)> set_creating_handler;
-    std::function<void(void)> create_buffer_handler;
-
-    state_t state() const override {
-        return this->state_handler();
-    }
-
-    audio::pcm_buffer *buffer_on_render() override {
-        return this->buffer_handler();
-    }
-
-    bool needs_create_on_render(sample_rate_t const sample_rate, audio::pcm_format const pcm_format,
-                                uint32_t const length) const override {
-        return this->needs_create_handler(sample_rate, pcm_format, length);
-    }
-
-    void set_creating_on_render(sample_rate_t const sample_rate, audio::pcm_format const pcm_format,
-                                uint32_t const length) override {
-        this->set_creating_handler(sample_rate, pcm_format, length);
-    }
-
-    void create_buffer_on_task() override {
-        this->create_buffer_handler();
-    }
-};
-
 struct buffering : buffering_resource_for_player_resource {
     std::function<setup_state_t(void)> setup_state_handler;
     std::function<rendering_state_t(void)> rendering_state_handler;
@@ -133,9 +97,13 @@ struct buffering : buffering_resource_for_player_resource {
     std::function<bool(void)> write_elements_if_needed_handler;
     std::function<void(element_address const &)> overwrite_element_handler;
     std::function<bool(audio::pcm_buffer *, channel_index_t, frame_index_t)> read_into_buffer_handler;
+    std::function<bool(audio::pcm_buffer *, channel_index_t, uint32_t, frame_index_t, uint32_t)>
+        read_into_channel_handler;
     std::function<bool(void)> needs_all_writing_handler;
     std::function<void(channel_mapping)> set_ch_mapping_request_handler;
     std::function<void(std::string)> set_identifier_request_handler;
+    std::function<void(std::vector<frame_index_t>)> set_warming_frames_request_handler;
+    std::function<buffering_statistics(void)> statistics_handler;
 
     setup_state_t setup_state() const override {
         return this->setup_state_handler();
@@ -203,10 +171,24 @@ struct buffering : buffering_resource_for_player_resource {
         this->set_identifier_request_handler(identifier);
     }
 
+    void set_warming_frames_request_on_main(std::vector<frame_index_t> const &frames) override {
+        this->set_warming_frames_request_handler(frames);
+    }
+
+    buffering_statistics statistics() const override {
+        return this->statistics_handler();
+    }
+
     bool read_into_buffer_on_render(audio::pcm_buffer *buffer, channel_index_t const ch_idx,
                                     frame_index_t const frame_idx) override {
         return this->read_into_buffer_handler(buffer, ch_idx, frame_idx);
     }
+
+    bool read_into_channel_on_render(audio::pcm_buffer *buffer, channel_index_t const ch_idx,
+                                     uint32_t const out_begin_frame, frame_index_t const frame_idx,
+                                     uint32_t const length) override {
+        return this->read_into_channel_handler(buffer, ch_idx, out_begin_frame, frame_idx, length);
+    }
 };
 
 struct cpp {
@@ -217,13 +199,11 @@ struct cpp {
 
     worker_stub_ptr const worker = worker_stub::make_shared();
     std::shared_ptr<player_test::renderer> const renderer = std::make_shared<player_test::renderer>();
-    std::shared_ptr<player_test::reading> const reading = std::make_shared<player_test::reading>();
     std::shared_ptr<player_test::buffering> const buffering = std::make_shared<player_test::buffering>();
-    std::shared_ptr<player_test::resource> const resource = std::make_shared<player_test::resource>(reading, buffering);
+    std::shared_ptr<player_test::resource> const resource = std::make_shared<player_test::resource>(buffering);
 
     player_ptr player = nullptr;
     renderer_rendering_f rendering_handler = nullptr;
-    audio::pcm_buffer_ptr reading_buffer = nullptr;
 
     static audio::format make_format() {
         return audio::format{{.sample_rate = sample_rate, .pcm_format = pcm_format, .channel_count = ch_count}};
@@ -233,13 +213,14 @@ struct cpp {
         return audio::pcm_buffer{make_format(), length};
     }
 
-    static void fill_buffer(audio::pcm_buffer *buffer, channel_index_t const ch_idx, frame_index_t const begin_frame) {
-        auto *data = buffer->data_ptr_at_index<int16_t>(0);
+    static void fill_channel(audio::pcm_buffer *buffer, channel_index_t const ch_idx, uint32_t const out_begin_frame,
+                             frame_index_t const begin_frame, uint32_t const length) {
+        auto *data = buffer->data_ptr_at_index<int16_t>(static_cast<uint32_t>(ch_idx));
 
-        auto each = make_fast_each(buffer->frame_length());
+        auto each = make_fast_each(length);
         while (yas_each_next(each)) {
             auto const &idx = yas_each_index(each);
-            data[idx] = ch_idx * 1000 + begin_frame + idx;
+            data[out_begin_frame + idx] = ch_idx * 1000 + begin_frame + idx;
         }
     }
 
@@ -257,18 +238,8 @@ struct cpp {
             player::make_shared(test_utils::root_path(), this->renderer, this->worker, priority, this->resource);
     }
 
-    void skip_reading() {
-        this->setup_initial();
-
-        auto const &reading = this->reading;
-
-        reading->state_handler = [] { return playing::reading_resource_state::rendering; };
-        reading->set_creating_handler = [](double, audio::pcm_format, uint32_t) {};
-        reading->needs_create_handler = [](double, audio::pcm_format, uint32_t) { return false; };
-    }
-
     void skip_buffering_setup() {
-        this->skip_reading();
+        this->setup_initial();
 
         auto const &buffering = this->buffering;
 
@@ -293,17 +264,13 @@ struct cpp {
     void skip_playing() {
         this->skip_pull();
 
-        this->reading_buffer = std::make_shared<audio::pcm_buffer>(this->make_format(), cpp::length);
-
         this->resource->perform_overwrite_requests_handler = [](player_test::resource::overwrite_requests_f const &) {};
         this->resource->is_playing_handler = [] { return true; };
-        this->reading->buffer_handler = [this] { return this->reading_buffer.get(); };
     }
 
     void reset() {
         this->player = nullptr;
         this->rendering_handler = nullptr;
-        this->reading_buffer = nullptr;
     }
 };
 }  // namespace yas::playing::player_test
@@ -25,9 +25,8 @@ using namespace yas::playing;
     player_task_priority const priority{.setup = 100, .rendering = 101};
     auto const worker = worker::make_shared();
     auto const renderer = std::make_shared<player_test::renderer>();
-    auto const reading = std::make_shared<player_test::reading>();
     auto const buffering = std::make_shared<player_test::buffering>();
-    auto const resource = std::make_shared<player_test::resource>(reading, buffering);
+    auto const resource = std::make_shared<player_test::resource>(buffering);
 
     std::vector<std::string> called_set_identifier;
     std::vector<channel_mapping> called_set_ch_mapping;
@@ -190,6 +189,33 @@ using namespace yas::playing;
     XCTAssertEqual(player->current_frame(), 1);
 }
 
+- (void)test_set_warming_frames {
+    self->_cpp.setup_initial();
+
+    auto const &player = self->_cpp.player;
+
+    std::vector<std::vector<frame_index_t>> called;
+
+    self->_cpp.buffering->set_warming_frames_request_handler = [&called](std::vector<frame_index_t> frames) {
+        called.emplace_back(std::move(frames));
+    };
+
+    player->set_warming_frames({100, 200});
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0), (std::vector<frame_index_t>{100, 200}));
+}
+
+- (void)test_buffering_statistics {
+    self->_cpp.setup_initial();
+
+    auto const &player = self->_cpp.player;
+
+    self->_cpp.buffering->statistics_handler = [] { return buffering_statistics{.read_count = 10}; };
+
+    XCTAssertEqual(player->buffering_statistics().read_count, 10);
+}
+
 - (void)test_identifier {
     self->_cpp.setup_initial();
 
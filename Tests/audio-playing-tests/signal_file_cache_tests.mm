@@ -0,0 +1,176 @@
+//
+//  signal_file_cache_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/format/format.h>
+#import <audio-engine/pcm_buffer/pcm_buffer.h>
+#import <cpp-utils/file_manager.h>
+#import <cpp-utils/file_path.h>
+#import <audio-playing/umbrella.hpp>
+#import <audio-processing/umbrella.hpp>
+#import "test_utils.h"
+
+using namespace yas;
+using namespace yas::playing;
+
+namespace yas::playing::signal_file_cache_test {
+static audio::format const format{
+    {.sample_rate = 4.0, .channel_count = 1, .pcm_format = audio::pcm_format::float32, .interleaved = false}};
+
+static std::string signal_path(std::string const &name) {
+    return file_path{test_utils::root_path()}.appending(name).string();
+}
+
+static bool write_signal(std::string const &path, std::vector<float> const &values) {
+    auto const event = proc::signal_event::make_shared<float>(values.size());
+    std::copy(values.begin(), values.end(), event->data<float>());
+    return static_cast<bool>(signal_file::write(path, *event));
+}
+}  // namespace yas::playing::signal_file_cache_test
+
+@interface signal_file_cache_tests : XCTestCase
+
+@end
+
+@implementation signal_file_cache_tests
+
+- (void)setUp {
+    file_manager::remove_content(test_utils::root_path());
+    file_manager::create_directory_if_not_exists(test_utils::root_path());
+}
+
+- (void)tearDown {
+    file_manager::remove_content(test_utils::root_path());
+}
+
+- (void)test_read {
+    using namespace signal_file_cache_test;
+
+    auto const path = signal_path("signal");
+    XCTAssertTrue(write_signal(path, {1.0f, 2.0f}));
+
+    auto const cache = signal_file_cache::make_shared(2);
+    audio::pcm_buffer buffer{format, 4};
+
+    XCTAssertTrue(cache->read(signal_file_info{path, proc::time::range{1, 2}, typeid(float)}, buffer, 0));
+
+    float const *const data = buffer.data_ptr_at_index<float>(0);
+    XCTAssertEqual(data[0], 0.0f);
+    XCTAssertEqual(data[1], 1.0f);
+    XCTAssertEqual(data[2], 2.0f);
+    XCTAssertEqual(data[3], 0.0f);
+
+    XCTAssertEqual(cache->mapped_count(), 1);
+
+    // 2回目はマップからコピーされる
+    buffer.clear();
+    XCTAssertTrue(cache->read(signal_file_info{path, proc::time::range{5, 2}, typeid(float)}, buffer, 4));
+
+    XCTAssertEqual(data[0], 0.0f);
+    XCTAssertEqual(data[1], 1.0f);
+    XCTAssertEqual(data[2], 2.0f);
+    XCTAssertEqual(data[3], 0.0f);
+
+    XCTAssertEqual(cache->mapped_count(), 1);
+}
+
+- (void)test_read_replaced_file {
+    using namespace signal_file_cache_test;
+
+    auto const path = signal_path("signal");
+    signal_file_info const info{path, proc::time::range{0, 2}, typeid(float)};
+
+    XCTAssertTrue(write_signal(path, {1.0f, 2.0f}));
+
+    auto const cache = signal_file_cache::make_shared(2);
+    audio::pcm_buffer buffer{format, 4};
+
+    XCTAssertTrue(cache->read(info, buffer, 0));
+    XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[0], 1.0f);
+
+    // 書き出し時と同じく消してから作り直す
+    XCTAssertTrue(std::filesystem::remove(path));
+    XCTAssertTrue(write_signal(path, {3.0f, 4.0f}));
+
+    XCTAssertTrue(cache->read(info, buffer, 0));
+    XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[0], 3.0f);
+    XCTAssertEqual(buffer.data_ptr_at_index<float>(0)[1], 4.0f);
+
+    XCTAssertEqual(cache->mapped_count(), 1);
+}
+
+- (void)test_capacity {
+    using namespace signal_file_cache_test;
+
+    auto const cache = signal_file_cache::make_shared(2);
+    audio::pcm_buffer buffer{format, 4};
+
+    XCTAssertEqual(cache->capacity(), 2);
+
+    for (auto const &name : {"a", "b", "c"}) {
+        auto const path = signal_path(name);
+        XCTAssertTrue(write_signal(path, {1.0f}));
+        XCTAssertTrue(cache->read(signal_file_info{path, proc::time::range{0, 1}, typeid(float)}, buffer, 0));
+    }
+
+    XCTAssertEqual(cache->mapped_count(), 2);
+
+    cache->clear();
+
+    XCTAssertEqual(cache->mapped_count(), 0);
+}
+
+- (void)test_read_error {
+    using namespace signal_file_cache_test;
+
+    auto const path = signal_path("signal");
+    XCTAssertTrue(write_signal(path, {1.0f, 2.0f}));
+
+    auto const cache = signal_file_cache::make_shared(2);
+    audio::pcm_buffer buffer{format, 4};
+
+    auto const type_result = cache->read(signal_file_info{path, proc::time::range{0, 2}, typeid(double)}, buffer, 0);
+    XCTAssertEqual(type_result.error(), signal_file::read_error::invalid_sample_type);
+
+    auto const range_result = cache->read(signal_file_info{path, proc::time::range{3, 2}, typeid(float)}, buffer, 0);
+    XCTAssertEqual(range_result.error(), signal_file::read_error::out_of_range);
+
+    auto const count_result = cache->read(signal_file_info{path, proc::time::range{0, 3}, typeid(float)}, buffer, 0);
+    XCTAssertEqual(count_result.error(), signal_file::read_error::read_count_not_match);
+
+    auto const open_result =
+        cache->read(signal_file_info{signal_path("none"), proc::time::range{0, 2}, typeid(float)}, buffer, 0);
+    XCTAssertEqual(open_result.error(), signal_file::read_error::open_stream_failed);
+}
+
+- (void)test_read_performance {
+    using namespace signal_file_cache_test;
+
+    std::size_t const file_count = 16;
+    std::size_t const length = 48000;
+    audio::format const perf_format{{.sample_rate = static_cast<double>(length),
+                                     .channel_count = 1,
+                                     .pcm_format = audio::pcm_format::float32,
+                                     .interleaved = false}};
+    audio::pcm_buffer buffer{perf_format, static_cast<uint32_t>(length)};
+
+    std::vector<signal_file_info> infos;
+    for (std::size_t idx = 0; idx < file_count; ++idx) {
+        auto const path = signal_path("signal_" + std::to_string(idx));
+        XCTAssertTrue(write_signal(path, std::vector<float>(length, static_cast<float>(idx))));
+        infos.emplace_back(path, proc::time::range{0, length}, typeid(float));
+    }
+
+    auto const cache = signal_file_cache::make_shared(file_count);
+
+    [self measureBlock:^{
+        for (std::size_t count = 0; count < 10; ++count) {
+            for (auto const &info : infos) {
+                XCTAssertTrue(cache->read(info, buffer, 0));
+            }
+        }
+    }];
+}
+
+@end
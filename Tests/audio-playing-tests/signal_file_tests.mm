@@ -95,6 +95,7 @@ using namespace yas::playing;
     XCTAssertEqual(to_string(signal_file::read_error::read_from_stream_failed), "read_from_stream_failed");
     XCTAssertEqual(to_string(signal_file::read_error::read_count_not_match), "read_count_not_match");
     XCTAssertEqual(to_string(signal_file::read_error::close_stream_failed), "close_stream_failed");
+    XCTAssertEqual(to_string(signal_file::read_error::map_file_failed), "map_file_failed");
 }
 
 - (void)test_write_error_ostream {
@@ -112,7 +113,8 @@ using namespace yas::playing;
     auto const values = {
         signal_file::read_error::invalid_sample_type,  signal_file::read_error::out_of_range,
         signal_file::read_error::open_stream_failed,   signal_file::read_error::read_from_stream_failed,
-        signal_file::read_error::read_count_not_match, signal_file::read_error::close_stream_failed};
+        signal_file::read_error::read_count_not_match, signal_file::read_error::close_stream_failed,
+        signal_file::read_error::map_file_failed};
 
     for (auto const &value : values) {
         std::ostringstream stream;
@@ -0,0 +1,76 @@
+//
+//  spsc_queue_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-playing/umbrella.hpp>
+#import <thread>
+
+using namespace yas;
+using namespace yas::playing;
+
+@interface spsc_queue_tests : XCTestCase
+
+@end
+
+@implementation spsc_queue_tests
+
+- (void)test_push_and_pop {
+    spsc_queue<int> queue{3};
+
+    XCTAssertEqual(queue.capacity(), 3);
+
+    int value = 0;
+    XCTAssertFalse(queue.pop(value));
+
+    XCTAssertTrue(queue.push(1));
+    XCTAssertTrue(queue.push(2));
+    XCTAssertTrue(queue.push(3));
+    XCTAssertFalse(queue.push(4));
+
+    XCTAssertTrue(queue.pop(value));
+    XCTAssertEqual(value, 1);
+
+    XCTAssertTrue(queue.push(5));
+
+    XCTAssertTrue(queue.pop(value));
+    XCTAssertEqual(value, 2);
+    XCTAssertTrue(queue.pop(value));
+    XCTAssertEqual(value, 3);
+    XCTAssertTrue(queue.pop(value));
+    XCTAssertEqual(value, 5);
+    XCTAssertFalse(queue.pop(value));
+}
+
+- (void)test_push_and_pop_on_threads {
+    std::size_t const count = 100000;
+    spsc_queue<std::size_t> queue{16};
+
+    std::thread thread{[&queue, count] {
+        for (std::size_t idx = 0; idx < count;) {
+            if (queue.push(idx)) {
+                ++idx;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    std::size_t expected = 0;
+    std::size_t value = 0;
+
+    while (expected < count) {
+        if (queue.pop(value)) {
+            XCTAssertEqual(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    thread.join();
+
+    XCTAssertFalse(queue.pop(value));
+}
+
+@end
@@ -33,4 +33,19 @@ using namespace yas::playing;
     XCTAssertFalse(matcher->is_cancel({2, 2}));
 }
 
+- (void)test_coalesce_by_range {
+    auto matcher = timeline_canceller::make_shared(proc::time::range{2, 2});
+
+    XCTAssertTrue(matcher->is_coalesce({2, 2}));
+    XCTAssertTrue(matcher->is_coalesce({0, 3}));
+    XCTAssertTrue(matcher->is_coalesce({3, 4}));
+    XCTAssertTrue(matcher->is_coalesce({0, 2}));
+    XCTAssertTrue(matcher->is_coalesce({4, 2}));
+
+    XCTAssertFalse(matcher->is_coalesce({0, 1}));
+    XCTAssertFalse(matcher->is_coalesce({5, 2}));
+
+    XCTAssertFalse(timeline_canceller::make_shared(std::nullopt)->is_coalesce({0, 10}));
+}
+
 @end
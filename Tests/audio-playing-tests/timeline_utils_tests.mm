@@ -212,4 +212,24 @@ using namespace yas::playing;
     XCTAssertTrue(timeline_utils::to_sample_type(sample_store_type::boolean) == typeid(boolean));
 }
 
+- (void)test_content_hash {
+    auto make_channel = [](float const value, proc::frame_index_t const frame) {
+        auto signal = proc::signal_event::make_shared<float>(2);
+        signal->data<float>()[0] = value;
+        signal->data<float>()[1] = value;
+
+        proc::channel channel;
+        channel.insert_event(proc::make_range_time(frame, 2), signal);
+        channel.insert_event(proc::make_frame_time(frame), proc::number_event::make_shared(int64_t(1)));
+        return channel;
+    };
+
+    auto const hash = timeline_utils::content_hash(make_channel(1.0f, 0));
+
+    XCTAssertEqual(timeline_utils::content_hash(make_channel(1.0f, 0)), hash);
+    XCTAssertNotEqual(timeline_utils::content_hash(make_channel(2.0f, 0)), hash);
+    XCTAssertNotEqual(timeline_utils::content_hash(make_channel(1.0f, 1)), hash);
+    XCTAssertNotEqual(timeline_utils::content_hash(proc::channel{}), hash);
+}
+
 @end
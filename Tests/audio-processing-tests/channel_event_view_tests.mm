@@ -0,0 +1,160 @@
+//
+//  channel_event_view_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-processing/umbrella.hpp>
+#import <cpp-utils/fast_each.h>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::test_utils::channel_event_view {
+static void setup_channel(proc::channel &channel) {
+    // insert_eventでは弾かれる時間の型のイベントも、viewで除かれることを確かめるために直接入れる
+    channel.events().emplace(make_any_time(), number_event::make_shared(int8_t(0)));
+    channel.insert_event(make_frame_time(0), number_event::make_shared(int8_t(1)));
+    channel.insert_event(make_frame_time(5), number_event::make_shared(float(2.0f)));
+    channel.insert_event(make_frame_time(10), number_event::make_shared(int8_t(3)));
+    channel.insert_event(make_range_time(0, 2), signal_event::make_shared<int8_t>(2));
+    channel.insert_event(make_range_time(4, 2), signal_event::make_shared<float>(2));
+    channel.insert_event(make_range_time(10, 2), signal_event::make_shared<int8_t>(2));
+}
+}  // namespace yas::proc::test_utils::channel_event_view
+
+@interface channel_event_view_tests : XCTestCase
+
+@end
+
+@implementation channel_event_view_tests
+
+- (void)test_filtered_view {
+    proc::channel channel;
+    test_utils::channel_event_view::setup_channel(channel);
+
+    auto const numbers = channel.filtered_view<number_event>();
+    XCTAssertEqual(numbers.size(), 3);
+
+    std::vector<frame_index_t> frames;
+    for (auto const &pair : numbers) {
+        frames.emplace_back(pair.first);
+    }
+    XCTAssertEqual(frames, (std::vector<frame_index_t>{0, 5, 10}));
+
+    auto const signals = channel.filtered_view<signal_event>();
+    XCTAssertEqual(signals.size(), 3);
+    XCTAssertEqual((*signals.begin()).first, (time::range{0, 2}));
+}
+
+- (void)test_filtered_view_with_sample_type {
+    proc::channel channel;
+    test_utils::channel_event_view::setup_channel(channel);
+
+    auto const int8_numbers = channel.filtered_view<int8_t, number_event>();
+    XCTAssertEqual(int8_numbers.size(), 2);
+
+    auto const float_numbers = channel.filtered_view<float, number_event>();
+    XCTAssertEqual(float_numbers.size(), 1);
+    XCTAssertEqual((*float_numbers.begin()).first, 5);
+    XCTAssertEqual((*float_numbers.begin()).second->get<float>(), 2.0f);
+
+    auto const int8_signals = channel.filtered_view<int8_t, signal_event>();
+    XCTAssertEqual(int8_signals.size(), 2);
+
+    XCTAssertTrue((channel.filtered_view<double, signal_event>().empty()));
+}
+
+- (void)test_filtered_view_with_range {
+    proc::channel channel;
+    test_utils::channel_event_view::setup_channel(channel);
+
+    // numberは範囲内のみ
+    {
+        auto const numbers = channel.filtered_view<int8_t, number_event>(time::range{0, 10});
+        XCTAssertEqual(numbers.size(), 1);
+        XCTAssertEqual((*numbers.begin()).first, 0);
+
+        XCTAssertEqual((channel.filtered_view<int8_t, number_event>(time::range{1, 9}).size()), 0);
+        XCTAssertEqual((channel.filtered_view<int8_t, number_event>(time::range{1, 10}).size()), 1);
+    }
+
+    // signalは範囲の終端に隣接するものまで
+    {
+        XCTAssertEqual((channel.filtered_view<int8_t, signal_event>(time::range{0, 9}).size()), 1);
+        XCTAssertEqual((channel.filtered_view<int8_t, signal_event>(time::range{0, 10}).size()), 2);
+        XCTAssertEqual((channel.filtered_view<int8_t, signal_event>(time::range{20, 1}).size()), 2);
+    }
+}
+
+- (void)test_erase_event_with_range {
+    proc::channel channel;
+    test_utils::channel_event_view::setup_channel(channel);
+
+    channel.erase_event<int8_t, signal_event>(time::range{2, 8}, [](auto const &pair) {
+        return pair.first.can_combine(time::range{2, 8});
+    });
+
+    XCTAssertEqual((channel.filtered_view<int8_t, signal_event>().size()), 0);
+    XCTAssertEqual((channel.filtered_view<float, signal_event>().size()), 1);
+    XCTAssertEqual((channel.filtered_view<number_event>().size()), 3);
+    XCTAssertEqual(channel.events().size(), 5);
+}
+
+- (void)test_erase_events_keeps_outside {
+    proc::channel channel;
+    test_utils::channel_event_view::setup_channel(channel);
+
+    channel.erase_events(time::range{5, 6});
+
+    // anyは常に消える
+    XCTAssertFalse(channel.events().cbegin()->first.is_any_type());
+
+    auto const numbers = channel.filtered_view<number_event>();
+    XCTAssertEqual(numbers.size(), 1);
+    XCTAssertEqual((*numbers.begin()).first, 0);
+
+    std::vector<time::range> ranges;
+    for (auto const &pair : channel.filtered_view<signal_event>()) {
+        ranges.emplace_back(pair.first);
+    }
+    XCTAssertEqual(ranges, (std::vector<time::range>{{0, 2}, {4, 1}, {11, 1}}));
+}
+
+- (void)test_receive_signal_performance_with_many_numbers {
+    length_t const slice_length = 1024;
+    std::size_t const number_count = 10000;
+
+    stream stream{sync_source{48000, slice_length}};
+    auto &channel = stream.add_channel(0);
+
+    auto each = make_fast_each(number_count);
+    while (yas_each_next(each)) {
+        auto const &idx = yas_each_index(each);
+        channel.insert_event(make_frame_time(static_cast<frame_index_t>(idx)),
+                             number_event::make_shared(static_cast<float>(idx)));
+    }
+
+    auto const module = module::make_shared([] {
+        auto receive_processor = make_receive_signal_processor<float>(
+            [](time::range const &, sync_source const &, channel_index_t const, connector_index_t const,
+               float const *const) {});
+        auto send_processor = make_send_signal_processor<float>(
+            [](time::range const &, sync_source const &, channel_index_t const, connector_index_t const,
+               float *const) {});
+        return module::processors_t{std::move(receive_processor), std::move(send_processor)};
+    });
+    module->connect_input(0, 0);
+    module->connect_output(0, 0);
+
+    auto *const stream_ptr = &stream;
+
+    [self measureBlock:^{
+        auto each = make_fast_each(number_count / slice_length);
+        while (yas_each_next(each)) {
+            auto const frame = static_cast<frame_index_t>(yas_each_index(each) * slice_length);
+            module->process(time::range{frame, slice_length}, *stream_ptr);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,223 @@
+//
+//  file_reader_cache_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-processing/module/maker/file_module.h>
+#import <audio-processing/module/maker/file_reader_cache.h>
+#import <audio-engine/umbrella.hpp>
+#import "utils/test_utils.h"
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::test_utils::file_reader_cache {
+static double constexpr sample_rate = 48000;
+static uint32_t constexpr ch_count = 1;
+static uint32_t constexpr bit_depth = 16;
+static audio::pcm_format constexpr pcm_format = audio::pcm_format::int16;
+
+static void setup_file(std::filesystem::path const &path, int16_t const offset) {
+    auto const file_result =
+        audio::file::make_created({.file_path = path,
+                                   .pcm_format = pcm_format,
+                                   .settings = audio::wave_file_settings(sample_rate, ch_count, bit_depth)});
+    XCTAssertTrue(file_result.is_success());
+    auto const &file = file_result.value();
+
+    auto buffer = audio::pcm_buffer(file->processing_format(), 8);
+    auto *data = buffer.data_ptr_at_index<int16_t>(0);
+    for (int16_t idx = 0; idx < 8; ++idx) {
+        data[idx] = offset + idx;
+    }
+
+    file->write_from_buffer(buffer);
+
+    file->close();
+}
+}  // namespace yas::proc::test_utils::file_reader_cache
+
+@interface file_reader_cache_tests : XCTestCase
+
+@end
+
+@implementation file_reader_cache_tests
+
+- (void)setUp {
+    [super setUp];
+    test_utils::remove_contents_in_test_directory();
+    test_utils::create_test_directory();
+}
+
+- (void)tearDown {
+    test_utils::remove_contents_in_test_directory();
+    [super tearDown];
+}
+
+- (void)test_reader_read {
+    auto const path = test_utils::test_path().append("test.wav");
+    test_utils::file_reader_cache::setup_file(path, 0);
+
+    auto const reader = file::reader::make_opened(path, audio::pcm_format::int16);
+    XCTAssertTrue(reader);
+    XCTAssertEqual(reader->file_length(), 8);
+    XCTAssertEqual(reader->pcm_format(), audio::pcm_format::int16);
+    XCTAssertFalse(reader->is_modified());
+
+    {
+        auto const *buffer = reader->read(0, 2);
+        XCTAssertTrue(buffer);
+        XCTAssertEqual(buffer->frame_length(), 2);
+        auto const *data = buffer->data_ptr_at_index<int16_t>(0);
+        XCTAssertEqual(data[0], 0);
+        XCTAssertEqual(data[1], 1);
+    }
+
+    {
+        auto const *buffer = reader->read(2, 2);
+        XCTAssertTrue(buffer);
+        auto const *data = buffer->data_ptr_at_index<int16_t>(0);
+        XCTAssertEqual(data[0], 2);
+        XCTAssertEqual(data[1], 3);
+    }
+
+    {
+        auto const *buffer = reader->read(1, 4);
+        XCTAssertTrue(buffer);
+        XCTAssertEqual(buffer->frame_length(), 4);
+        auto const *data = buffer->data_ptr_at_index<int16_t>(0);
+        XCTAssertEqual(data[0], 1);
+        XCTAssertEqual(data[3], 4);
+    }
+
+    XCTAssertFalse(reader->read(-1, 2));
+    XCTAssertFalse(reader->read(0, 0));
+}
+
+- (void)test_make_opened_failed {
+    auto const path = test_utils::test_path().append("not_exists.wav");
+
+    XCTAssertFalse(file::reader::make_opened(path, audio::pcm_format::int16));
+}
+
+- (void)test_acquire_and_release {
+    auto const path = test_utils::test_path().append("test.wav");
+    test_utils::file_reader_cache::setup_file(path, 0);
+
+    auto const cache = file::reader_cache::make_shared(2);
+
+    XCTAssertEqual(cache->capacity(), 2);
+    XCTAssertEqual(cache->size(), 0);
+
+    auto reader = cache->acquire(path, audio::pcm_format::int16);
+    XCTAssertTrue(reader);
+    XCTAssertEqual(cache->hit_count(), 0);
+    XCTAssertEqual(cache->miss_count(), 1);
+    XCTAssertEqual(cache->size(), 0);
+
+    auto *const raw_reader = reader.get();
+
+    cache->release(std::move(reader));
+    XCTAssertEqual(cache->size(), 1);
+
+    auto reused = cache->acquire(path, audio::pcm_format::int16);
+    XCTAssertEqual(reused.get(), raw_reader);
+    XCTAssertEqual(cache->hit_count(), 1);
+    XCTAssertEqual(cache->miss_count(), 1);
+    XCTAssertEqual(cache->size(), 0);
+
+    auto other_format = cache->acquire(path, audio::pcm_format::float32);
+    XCTAssertTrue(other_format);
+    XCTAssertNotEqual(other_format.get(), raw_reader);
+    XCTAssertEqual(cache->hit_count(), 1);
+    XCTAssertEqual(cache->miss_count(), 2);
+
+    cache->release(std::move(reused));
+    cache->release(std::move(other_format));
+    XCTAssertEqual(cache->size(), 2);
+
+    cache->clear();
+    XCTAssertEqual(cache->size(), 0);
+    XCTAssertEqual(cache->hit_count(), 0);
+    XCTAssertEqual(cache->miss_count(), 0);
+}
+
+- (void)test_lru_eviction {
+    auto const path0 = test_utils::test_path().append("test0.wav");
+    auto const path1 = test_utils::test_path().append("test1.wav");
+    auto const path2 = test_utils::test_path().append("test2.wav");
+    test_utils::file_reader_cache::setup_file(path0, 0);
+    test_utils::file_reader_cache::setup_file(path1, 10);
+    test_utils::file_reader_cache::setup_file(path2, 20);
+
+    auto const cache = file::reader_cache::make_shared(2);
+
+    cache->release(cache->acquire(path0, audio::pcm_format::int16));
+    cache->release(cache->acquire(path1, audio::pcm_format::int16));
+    // path0を最近使ったものにする
+    cache->release(cache->acquire(path0, audio::pcm_format::int16));
+    cache->release(cache->acquire(path2, audio::pcm_format::int16));
+
+    XCTAssertEqual(cache->size(), 2);
+    XCTAssertEqual(cache->hit_count(), 1);
+    XCTAssertEqual(cache->miss_count(), 3);
+
+    cache->release(cache->acquire(path0, audio::pcm_format::int16));
+    cache->release(cache->acquire(path2, audio::pcm_format::int16));
+    XCTAssertEqual(cache->hit_count(), 3);
+
+    // path1は追い出されている
+    cache->release(cache->acquire(path1, audio::pcm_format::int16));
+    XCTAssertEqual(cache->hit_count(), 3);
+    XCTAssertEqual(cache->miss_count(), 4);
+}
+
+- (void)test_acquire_modified_file {
+    auto const path = test_utils::test_path().append("test.wav");
+    test_utils::file_reader_cache::setup_file(path, 0);
+
+    auto const cache = file::reader_cache::make_shared(2);
+
+    cache->release(cache->acquire(path, audio::pcm_format::int16));
+
+    std::filesystem::remove(path);
+    test_utils::file_reader_cache::setup_file(path, 100);
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+
+    auto reader = cache->acquire(path, audio::pcm_format::int16);
+    XCTAssertEqual(cache->hit_count(), 0);
+    XCTAssertEqual(cache->miss_count(), 2);
+
+    auto const *buffer = reader->read(0, 1);
+    XCTAssertEqual(buffer->data_ptr_at_index<int16_t>(0)[0], 100);
+}
+
+- (void)test_context_reuses_reader {
+    auto const path = test_utils::test_path().append("test.wav");
+    test_utils::file_reader_cache::setup_file(path, 0);
+
+    auto const cache = file::reader_cache::make_shared(2);
+
+    file::context<int16_t> const context{path, 0, 0, cache};
+    sync_source const sync_src{(sample_rate_t)test_utils::file_reader_cache::sample_rate, 2};
+
+    std::vector<int16_t> data(2);
+
+    context.read_from_file(time::range{0, 2}, sync_src, 0, data.data());
+    XCTAssertEqual(data[0], 0);
+    XCTAssertEqual(data[1], 1);
+
+    context.read_from_file(time::range{2, 2}, sync_src, 0, data.data());
+    XCTAssertEqual(data[0], 2);
+    XCTAssertEqual(data[1], 3);
+
+    context.read_from_file(time::range{7, 2}, sync_src, 0, data.data());
+    XCTAssertEqual(data[0], 7);
+    XCTAssertEqual(data[1], 0);
+
+    XCTAssertEqual(cache->miss_count(), 1);
+    XCTAssertEqual(cache->hit_count(), 2);
+    XCTAssertEqual(cache->size(), 1);
+}
+
+@end
@@ -0,0 +1,134 @@
+//
+//  math_kernels_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-processing/umbrella.hpp>
+#import <cstring>
+#import <vector>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::test_utils::math_kernels {
+static std::size_t constexpr bench_length = 1024;
+static std::size_t constexpr bench_count = 1000;
+
+template <typename T>
+static bool is_equal_bits(T const lhs, T const rhs) {
+    return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+template <typename T>
+static T value_at(std::vector<T> const &vec, frame_index_t const offset, length_t const length,
+                  frame_index_t const idx) {
+    auto const input_idx = idx + offset;
+    return (input_idx >= 0 && input_idx < static_cast<frame_index_t>(length)) ? vec.at(input_idx) : 0;
+}
+}  // namespace yas::proc::test_utils::math_kernels
+
+@interface math_kernels_tests : XCTestCase
+
+@end
+
+@implementation math_kernels_tests
+
+- (void)test_math1_kernel_matches_scalar {
+    std::vector<double> const input{0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+    length_t const out_length = 8;
+
+    for (std::size_t kind_idx = 0; kind_idx <= static_cast<std::size_t>(math1::kind::round); ++kind_idx) {
+        auto const kind = static_cast<math1::kind>(kind_idx);
+        auto const kernel = math1::signal_kernel<double>(kind);
+
+        for (frame_index_t offset = -10; offset <= 10; ++offset) {
+            for (length_t const in_length : {0, 4, 8}) {
+                std::vector<double> out(out_length);
+                math1::process_signal(kernel, input.data(), offset, in_length, out.data(), out_length);
+
+                for (frame_index_t idx = 0; idx < static_cast<frame_index_t>(out_length); ++idx) {
+                    auto const expected =
+                        math1::calc(kind, test_utils::math_kernels::value_at(input, offset, in_length, idx));
+                    XCTAssertTrue(test_utils::math_kernels::is_equal_bits(out.at(idx), expected));
+                }
+            }
+        }
+    }
+}
+
+- (void)test_math2_kernel_matches_scalar {
+    std::vector<int16_t> const left{1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int16_t> const right{8, 7, 6, 5, 4, 3, 2, 1};
+    length_t const out_length = 8;
+
+    for (std::size_t kind_idx = 0; kind_idx <= static_cast<std::size_t>(math2::kind::hypot); ++kind_idx) {
+        auto const kind = static_cast<math2::kind>(kind_idx);
+        auto const kernel = math2::signal_kernel<int16_t>(kind);
+
+        for (frame_index_t left_offset = -10; left_offset <= 10; ++left_offset) {
+            for (frame_index_t right_offset = -10; right_offset <= 10; ++right_offset) {
+                for (length_t const in_length : {0, 3, 8}) {
+                    std::vector<int16_t> out(out_length);
+                    math2::process_signal(kernel, left.data(), left_offset, in_length, right.data(), right_offset,
+                                          length_t{8}, out.data(), out_length);
+
+                    for (frame_index_t idx = 0; idx < static_cast<frame_index_t>(out_length); ++idx) {
+                        auto const left_value =
+                            test_utils::math_kernels::value_at(left, left_offset, in_length, idx);
+                        auto const right_value = test_utils::math_kernels::value_at(right, right_offset, 8, idx);
+                        XCTAssertEqual(out.at(idx), math2::calc(kind, left_value, right_value));
+                    }
+                }
+            }
+        }
+    }
+}
+
+- (void)test_math1_performance {
+    using namespace test_utils::math_kernels;
+
+    std::vector<float> const input(bench_length, 0.5f);
+    std::vector<float> output(bench_length);
+    float const *const in_ptr = input.data();
+    float *const out_ptr = output.data();
+
+    std::vector<math1::signal_kernel_f<float>> kernels;
+    for (std::size_t kind_idx = 0; kind_idx <= static_cast<std::size_t>(math1::kind::round); ++kind_idx) {
+        kernels.emplace_back(math1::signal_kernel<float>(static_cast<math1::kind>(kind_idx)));
+    }
+
+    [self measureBlock:^{
+        for (auto const &kernel : kernels) {
+            for (std::size_t idx = 0; idx < bench_count; ++idx) {
+                math1::process_signal(kernel, in_ptr, 0, bench_length, out_ptr, bench_length);
+            }
+        }
+    }];
+}
+
+- (void)test_math2_performance {
+    using namespace test_utils::math_kernels;
+
+    std::vector<float> const left(bench_length, 0.5f);
+    std::vector<float> const right(bench_length, 2.0f);
+    std::vector<float> output(bench_length);
+    float const *const left_ptr = left.data();
+    float const *const right_ptr = right.data();
+    float *const out_ptr = output.data();
+
+    std::vector<math2::signal_kernel_f<float>> kernels;
+    for (std::size_t kind_idx = 0; kind_idx <= static_cast<std::size_t>(math2::kind::hypot); ++kind_idx) {
+        kernels.emplace_back(math2::signal_kernel<float>(static_cast<math2::kind>(kind_idx)));
+    }
+
+    [self measureBlock:^{
+        for (auto const &kernel : kernels) {
+            for (std::size_t idx = 0; idx < bench_count; ++idx) {
+                math2::process_signal(kernel, left_ptr, 0, bench_length, right_ptr, 0, bench_length, out_ptr,
+                                      bench_length);
+            }
+        }
+    }];
+}
+
+@end
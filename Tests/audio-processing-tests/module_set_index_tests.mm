@@ -0,0 +1,195 @@
+//
+//  module_set_index_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-processing/umbrella.hpp>
+#import <random>
+
+using namespace yas;
+using namespace yas::proc;
+
+@interface module_set_index_tests : XCTestCase
+
+@end
+
+@implementation module_set_index_tests
+
+- (void)test_empty {
+    module_set_index index;
+    index.rebuild({});
+
+    XCTAssertEqual(index.size(), 0);
+    XCTAssertFalse(index.total_range());
+
+    bool called = false;
+    index.for_each_overlapped({0, 100}, [&called](auto const &...) { called = true; });
+    XCTAssertFalse(called);
+}
+
+- (void)test_for_each_overlapped {
+    auto const set1 = module_set::make_shared({});
+    auto const set2 = module_set::make_shared({});
+    auto const set3 = module_set::make_shared({});
+    auto const set4 = module_set::make_shared({});
+
+    module_set_index index;
+    index.rebuild({{time::range{0, 10}, set1},
+                   {time::range{0, 100}, set2},
+                   {time::range{20, 5}, set3},
+                   {time::range{50, 10}, set4}});
+
+    XCTAssertEqual(index.size(), 4);
+    XCTAssertEqual(index.total_range(), (time::range{0, 100}));
+
+    std::vector<std::pair<module_set_ptr, time::range>> called;
+    auto handler = [&called](time::range const &, time::range const &intersected, module_set_plan const &plan) {
+        called.emplace_back(plan.module_set(), intersected);
+    };
+
+    index.for_each_overlapped({5, 20}, handler);
+
+    XCTAssertEqual(called.size(), 3);
+    XCTAssertEqual(called.at(0).first, set1);
+    XCTAssertEqual(called.at(0).second, (time::range{5, 5}));
+    XCTAssertEqual(called.at(1).first, set2);
+    XCTAssertEqual(called.at(1).second, (time::range{5, 20}));
+    XCTAssertEqual(called.at(2).first, set3);
+    XCTAssertEqual(called.at(2).second, (time::range{20, 5}));
+
+    called.clear();
+
+    index.for_each_overlapped({60, 100}, handler);
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0).first, set2);
+    XCTAssertEqual(called.at(0).second, (time::range{60, 40}));
+
+    called.clear();
+
+    index.for_each_overlapped({100, 10}, handler);
+    index.for_each_overlapped({-10, 10}, handler);
+
+    XCTAssertEqual(called.size(), 0);
+}
+
+- (void)test_matches_linear_scan {
+    std::mt19937 engine(0);
+    std::uniform_int_distribution<frame_index_t> frame_dist(-50, 150);
+    std::uniform_int_distribution<length_t> length_dist(1, 40);
+
+    for (std::size_t count = 0; count < 100; ++count) {
+        track_module_set_map_t module_sets;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            module_sets.emplace(time::range{frame_dist(engine), length_dist(engine)}, module_set::make_shared({}));
+        }
+
+        module_set_index index;
+        index.rebuild(module_sets);
+
+        std::optional<time::range> total_range;
+        for (auto const &pair : module_sets) {
+            total_range = total_range ? total_range->merged(pair.first) : pair.first;
+        }
+        XCTAssertEqual(index.total_range(), total_range);
+
+        for (std::size_t query_idx = 0; query_idx < 20; ++query_idx) {
+            time::range const range{frame_dist(engine), length_dist(engine)};
+
+            std::vector<std::pair<time::range, time::range>> expected;
+            for (auto const &pair : module_sets) {
+                if (auto const intersected = pair.first.intersected(range)) {
+                    expected.emplace_back(pair.first, *intersected);
+                }
+            }
+
+            std::vector<std::pair<time::range, time::range>> actual;
+            index.for_each_overlapped(range, [&actual](time::range const &set_range, time::range const &intersected,
+                                                       module_set_plan const &) {
+                actual.emplace_back(set_range, intersected);
+            });
+
+            XCTAssertTrue(actual == expected);
+        }
+    }
+}
+
+- (void)test_insert_and_erase_matches_rebuild {
+    std::mt19937 engine(0);
+    std::uniform_int_distribution<frame_index_t> frame_dist(-50, 150);
+    std::uniform_int_distribution<length_t> length_dist(1, 40);
+
+    track_module_set_map_t module_sets;
+    module_set_index index;
+    index.rebuild(module_sets);
+
+    auto collect = [](module_set_index const &index, time::range const &range) {
+        std::vector<std::pair<time::range, module_set_ptr>> result;
+        index.for_each_overlapped(range, [&result](time::range const &set_range, time::range const &,
+                                                   module_set_plan const &plan) {
+            result.emplace_back(set_range, plan.module_set());
+        });
+        return result;
+    };
+
+    for (std::size_t count = 0; count < 200; ++count) {
+        time::range const range{frame_dist(engine), length_dist(engine)};
+
+        // 同じ範囲があれば入れ替えか削除、なければ追加する
+        if (module_sets.count(range) > 0 && count % 2 == 0) {
+            module_sets.erase(range);
+            index.erase(range);
+        } else {
+            auto const module_set = module_set::make_shared({});
+            module_sets.insert_or_assign(range, module_set);
+            index.insert_or_replace(range, module_set);
+        }
+
+        module_set_index rebuilt_index;
+        rebuilt_index.rebuild(module_sets);
+
+        XCTAssertEqual(index.size(), rebuilt_index.size());
+        XCTAssertEqual(index.total_range(), rebuilt_index.total_range());
+
+        time::range const query_range{frame_dist(engine), length_dist(engine)};
+        XCTAssertTrue(collect(index, query_range) == collect(rebuilt_index, query_range));
+    }
+}
+
+- (void)test_update_plan {
+    auto const module_set = module_set::make_shared({});
+    auto const other_module_set = module_set::make_shared({});
+
+    module_set_index index;
+    index.rebuild({{time::range{0, 10}, module_set}, {time::range{20, 10}, other_module_set}});
+
+    module_set->push_back(make_signal_module<float>(1.0f));
+    other_module_set->push_back(make_signal_module<float>(2.0f));
+
+    index.update_plan({0, 10});
+
+    std::vector<bool> outdated;
+    auto handler = [&outdated](time::range const &, time::range const &, module_set_plan const &plan) {
+        outdated.emplace_back(plan.is_outdated());
+    };
+
+    index.for_each_overlapped({0, 30}, handler);
+
+    XCTAssertTrue(outdated == (std::vector<bool>{false, true}));
+
+    // 重なっていない範囲のplanは作り直さない
+    index.update_outdated_plans({0, 10});
+    outdated.clear();
+    index.for_each_overlapped({0, 30}, handler);
+
+    XCTAssertTrue(outdated == (std::vector<bool>{false, true}));
+
+    index.update_outdated_plans({0, 30});
+    outdated.clear();
+    index.for_each_overlapped({0, 30}, handler);
+
+    XCTAssertTrue(outdated == (std::vector<bool>{false, false}));
+    XCTAssertEqual(index.size(), 2);
+}
+
+@end
@@ -0,0 +1,237 @@
+//
+//  module_set_plan_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-processing/umbrella.hpp>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::test_utils::module_set_plan {
+static module_vector_t make_modules() {
+    auto const constant1 = make_signal_module<float>(1.0f);
+    constant1->connect_output(to_connector_index(constant::output::value), 0);
+
+    auto const constant2 = make_signal_module<float>(2.0f);
+    constant2->connect_output(to_connector_index(constant::output::value), 1);
+
+    auto const plus = make_signal_module<float>(math2::kind::plus);
+    connect(plus, math2::input::left, 0);
+    connect(plus, math2::input::right, 1);
+    connect(plus, math2::output::result, 2);
+
+    auto const multiply = make_signal_module<float>(math2::kind::multiply);
+    connect(multiply, math2::input::left, 2);
+    connect(multiply, math2::input::right, 1);
+    connect(multiply, math2::output::result, 3);
+
+    return {constant1, constant2, plus, multiply};
+}
+
+static std::vector<float> signal_values(stream const &stream, channel_index_t const ch_idx) {
+    std::vector<float> values;
+    for (auto const &pair : stream.channel(ch_idx).filtered_events<float, signal_event>()) {
+        auto const &vec = pair.second->vector<float>();
+        values.insert(values.end(), vec.begin(), vec.end());
+    }
+    return values;
+}
+}  // namespace yas::proc::test_utils::module_set_plan
+
+@interface module_set_plan_tests : XCTestCase
+
+@end
+
+@implementation module_set_plan_tests
+
+- (void)test_steps {
+    auto const processor = [](time::range const &, connector_map_t const &, connector_map_t const &, stream &) {};
+
+    auto const module1 = module::make_shared([processor] { return module::processors_t{processor, nullptr}; });
+    auto const module2 = module::make_shared([processor] { return module::processors_t{processor, processor}; });
+
+    auto const module_set = module_set::make_shared({module1, module2});
+
+    proc::module_set_plan const plan{module_set};
+
+    XCTAssertEqual(plan.module_set(), module_set);
+
+    auto const &steps = plan.steps();
+
+    XCTAssertEqual(steps.size(), 3);
+    XCTAssertEqual(steps.at(0).processor, &module1->processors().at(0));
+    XCTAssertEqual(steps.at(0).inputs, &module1->input_connectors());
+    XCTAssertEqual(steps.at(0).outputs, &module1->output_connectors());
+    XCTAssertFalse(steps.at(0).input_channels.has_value());
+    XCTAssertEqual(steps.at(1).processor, &module2->processors().at(0));
+    XCTAssertEqual(steps.at(2).processor, &module2->processors().at(1));
+    XCTAssertEqual(steps.at(2).inputs, &module2->input_connectors());
+}
+
+- (void)test_process_matches_modules {
+    using namespace test_utils::module_set_plan;
+
+    auto const module_set = module_set::make_shared(make_modules());
+    proc::module_set_plan const plan{module_set};
+
+    proc::stream expected_stream{sync_source{1, 8}};
+    proc::stream plan_stream{sync_source{1, 8}};
+
+    for (frame_index_t frame = 0; frame < 16; frame += 4) {
+        for (auto const &module : module_set->modules()) {
+            module->process({frame, 4}, expected_stream);
+        }
+        plan.process({frame, 4}, plan_stream);
+    }
+
+    XCTAssertEqual(plan_stream.channel_count(), expected_stream.channel_count());
+
+    for (channel_index_t ch_idx = 0; ch_idx < 4; ++ch_idx) {
+        XCTAssertTrue(plan_stream.has_channel(ch_idx));
+        XCTAssertEqual(signal_values(plan_stream, ch_idx), signal_values(expected_stream, ch_idx));
+    }
+
+    XCTAssertEqual(signal_values(plan_stream, 3), std::vector<float>(16, 6.0f));
+}
+
+- (void)test_resolve_input_channels {
+    std::size_t called = 0;
+    auto const counting_processor = [&called](time::range const &, connector_map_t const &, connector_map_t const &,
+                                              stream &) { ++called; };
+
+    auto const module = module::make_shared([counting_processor] {
+        return module::processors_t{input_processor{.handler = counting_processor},
+                                    input_processor{.handler = counting_processor, .connector_indices = {{1}}},
+                                    input_processor{.handler = counting_processor, .connector_indices = {{2}}}};
+    });
+    module->connect_input(0, 10);
+    module->connect_input(1, 11);
+    module->connect_input(3, 10);
+
+    proc::module_set_plan const plan{module_set::make_shared({module})};
+
+    // 読むコネクタが繋がっていないinput_processorは並べない
+    auto const &steps = plan.steps();
+    XCTAssertEqual(steps.size(), 2);
+    XCTAssertEqual(steps.at(0).input_channels, (std::vector<channel_index_t>{10, 11}));
+    XCTAssertEqual(steps.at(1).input_channels, (std::vector<channel_index_t>{11}));
+
+    proc::stream stream{sync_source{1, 4}};
+
+    // 読むチャンネルにイベントが無ければ呼び出さない
+    plan.process({0, 4}, stream);
+    XCTAssertEqual(called, 0);
+
+    stream.add_channel(11);
+    plan.process({0, 4}, stream);
+    XCTAssertEqual(called, 0);
+
+    stream.add_channel(10).insert_event(make_frame_time(0), number_event::make_shared(int8_t(1)));
+    plan.process({0, 4}, stream);
+    XCTAssertEqual(called, 1);
+
+    stream.channel(11).insert_event(make_frame_time(0), number_event::make_shared(int8_t(1)));
+    plan.process({0, 4}, stream);
+    XCTAssertEqual(called, 3);
+}
+
+- (void)test_skip_matches_modules {
+    // 入力が無いスライスと有るスライスが混ざっても結果が変わらない
+    auto const make_modules = [] {
+        auto const constant = make_signal_module<float>(3.0f);
+        constant->connect_output(to_connector_index(constant::output::value), 0);
+
+        auto const plus = make_signal_module<float>(math2::kind::plus);
+        plus->connect_input(to_connector_index(math2::input::left), 0);
+        plus->connect_input(to_connector_index(math2::input::right), 1);
+        plus->connect_output(to_connector_index(math2::output::result), 2);
+
+        return module_vector_t{constant, plus};
+    };
+
+    auto const module_set = module_set::make_shared(make_modules());
+    auto const expected_modules = make_modules();
+    proc::module_set_plan const plan{module_set};
+
+    proc::stream expected_stream{sync_source{1, 4}};
+    proc::stream plan_stream{sync_source{1, 4}};
+
+    for (frame_index_t frame = 0; frame < 8; frame += 4) {
+        for (auto const &module : expected_modules) {
+            module->process({frame, 4}, expected_stream);
+        }
+        plan.process({frame, 4}, plan_stream);
+    }
+
+    using namespace test_utils::module_set_plan;
+
+    XCTAssertEqual(signal_values(plan_stream, 2), signal_values(expected_stream, 2));
+    XCTAssertEqual(signal_values(plan_stream, 2), std::vector<float>(8, 3.0f));
+}
+
+- (void)test_is_outdated {
+    using namespace test_utils::module_set_plan;
+
+    auto const module_set = module_set::make_shared(make_modules());
+    proc::module_set_plan const plan{module_set};
+
+    XCTAssertFalse(plan.is_outdated());
+
+    module_set->erase(3);
+
+    XCTAssertTrue(plan.is_outdated());
+
+    proc::module_set_plan const rebuilt_plan{module_set};
+
+    XCTAssertFalse(rebuilt_plan.is_outdated());
+
+    module_set->push_back(make_signal_module<float>(1.0f));
+
+    XCTAssertTrue(rebuilt_plan.is_outdated());
+}
+
+- (void)test_is_outdated_by_connector_change {
+    using namespace test_utils::module_set_plan;
+
+    auto const modules = make_modules();
+    auto const module_set = module_set::make_shared(module_vector_t{modules});
+    proc::module_set_plan const plan{module_set};
+
+    XCTAssertFalse(plan.is_outdated());
+
+    modules.at(3)->disconnect_output(to_connector_index(math2::output::result));
+    modules.at(3)->connect_output(to_connector_index(math2::output::result), 4);
+
+    XCTAssertTrue(plan.is_outdated());
+
+    proc::module_set_plan const rebuilt_plan{module_set};
+
+    XCTAssertFalse(rebuilt_plan.is_outdated());
+
+    proc::stream stream{sync_source{1, 4}};
+    rebuilt_plan.process({0, 4}, stream);
+
+    XCTAssertFalse(stream.has_channel(3));
+    XCTAssertEqual(signal_values(stream, 4), std::vector<float>(4, 6.0f));
+
+    modules.at(2)->disconnect_input(to_connector_index(math2::input::left));
+
+    XCTAssertTrue(rebuilt_plan.is_outdated());
+}
+
+- (void)test_is_not_outdated_by_other_module_connector_change {
+    using namespace test_utils::module_set_plan;
+
+    auto const module_set = module_set::make_shared(make_modules());
+    proc::module_set_plan const plan{module_set};
+
+    // 含まれていないmoduleのconnectorが変わっても作り直さない
+    auto const other_module = make_signal_module<float>(1.0f);
+    other_module->connect_output(to_connector_index(constant::output::value), 0);
+    other_module->disconnect_output(to_connector_index(constant::output::value));
+
+    XCTAssertFalse(plan.is_outdated());
+}
+
+@end
@@ -131,4 +131,16 @@ using namespace yas::proc;
     XCTAssertEqual(called.at(1), 1);
 }
 
+- (void)test_state {
+    auto const stateful_module = proc::module::make_shared([] { return module::processors_t{}; });
+    auto const stateless_module =
+        proc::module::make_shared([] { return module::processors_t{}; }, module_state::stateless);
+
+    XCTAssertEqual(stateful_module->state(), module_state::stateful);
+    XCTAssertEqual(stateless_module->state(), module_state::stateless);
+
+    XCTAssertEqual(stateful_module->copy()->state(), module_state::stateful);
+    XCTAssertEqual(stateless_module->copy()->state(), module_state::stateless);
+}
+
 @end
@@ -0,0 +1,104 @@
+//
+//  oscillator_module_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-engine/umbrella.hpp>
+#import <audio-processing/umbrella.hpp>
+#import <cmath>
+#import <sstream>
+
+using namespace yas;
+using namespace yas::proc;
+
+namespace yas::proc::test_utils::oscillator_module {
+static std::vector<double> process(std::vector<audio::oscillator_voice> voices, std::vector<double> table,
+                                   frame_index_t const frame_offset, time::range const &range) {
+    channel_index_t const ch_idx = 0;
+
+    stream stream{sync_source{8, range.length}};
+
+    auto module = oscillator::make_signal_module(std::move(voices), std::move(table), frame_offset);
+    connect(module, oscillator::output::value, ch_idx);
+
+    module->process(range, stream);
+
+    auto const &signal = stream.channel(ch_idx).events().cbegin()->second.get<signal_event>();
+    auto const *const data = signal->data<double>();
+
+    return std::vector<double>(data, data + range.length);
+}
+}  // namespace yas::proc::test_utils::oscillator_module
+
+@interface oscillator_module_tests : XCTestCase
+
+@end
+
+@implementation oscillator_module_tests
+
+- (void)test_make_signal_module {
+    XCTAssertTrue(oscillator::make_signal_module<float>({}, {}, 0));
+    XCTAssertTrue(oscillator::make_signal_module<double>({{.frequency = 1.0}}, {}, 0));
+}
+
+- (void)test_process {
+    auto const data = proc::test_utils::oscillator_module::process(
+        {{.frequency = 1.0},
+         {.waveform = audio::oscillator_waveform::table, .frequency = 2.0, .phase = 0.25, .gain = 0.5}},
+        {0.0, 1.0}, 0, time::range{0, 8});
+
+    XCTAssertEqual(data.size(), 8);
+
+    std::vector<double> const table_values{0.25, 0.5, 0.25, 0.0};
+
+    for (uint32_t idx = 0; idx < 8; ++idx) {
+        double const sine = std::sin(audio::math::two_pi * static_cast<double>(idx) / 8.0);
+        XCTAssertEqualWithAccuracy(data.at(idx), sine + table_values.at(idx % 4), 1.0e-9);
+    }
+}
+
+- (void)test_process_continues_from_any_frame {
+    std::vector<audio::oscillator_voice> const voices{{.frequency = 1.0},
+                                                      {.waveform = audio::oscillator_waveform::saw, .frequency = 0.5}};
+
+    auto const whole = proc::test_utils::oscillator_module::process(voices, {}, 0, time::range{0, 16});
+    auto const part = proc::test_utils::oscillator_module::process(voices, {}, 0, time::range{5, 7});
+
+    // 途中の範囲だけを処理しても、続けて処理したときと同じ値になる
+    for (uint32_t idx = 0; idx < 7; ++idx) {
+        XCTAssertEqualWithAccuracy(part.at(idx), whole.at(idx + 5), 1.0e-9);
+    }
+
+    auto const offset = proc::test_utils::oscillator_module::process(voices, {}, 3, time::range{2, 4});
+
+    for (uint32_t idx = 0; idx < 4; ++idx) {
+        XCTAssertEqualWithAccuracy(offset.at(idx), whole.at(idx + 5), 1.0e-9);
+    }
+}
+
+- (void)test_connect_output {
+    auto module = oscillator::make_signal_module<float>({}, {}, 0);
+    connect(module, oscillator::output::value, 7);
+
+    auto const &connectors = module->output_connectors();
+
+    XCTAssertEqual(connectors.size(), 1);
+    XCTAssertEqual(connectors.cbegin()->first, to_connector_index(oscillator::output::value));
+    XCTAssertEqual(connectors.cbegin()->second.channel_index, 7);
+}
+
+- (void)test_output_to_string {
+    XCTAssertEqual(to_string(oscillator::output::value), "value");
+}
+
+- (void)test_output_ostream {
+    auto const values = {oscillator::output::value};
+
+    for (auto const &value : values) {
+        std::ostringstream stream;
+        stream << value;
+        XCTAssertEqual(stream.str(), to_string(value));
+    }
+}
+
+@end
@@ -0,0 +1,211 @@
+//
+//  signal_event_pool_tests.mm
+//
+
+#import <XCTest/XCTest.h>
+#import <audio-processing/umbrella.hpp>
+#import <cpp-utils/boolean.h>
+#import "utils/allocation_counter.h"
+
+using namespace yas;
+using namespace yas::proc;
+
+@interface signal_event_pool_tests : XCTestCase
+
+@end
+
+@implementation signal_event_pool_tests
+
+- (void)test_make_shared {
+    auto const pool = signal_event_pool::make_shared();
+
+    XCTAssertEqual(pool->max_vector_count(), signal_event_pool::default_max_vector_count);
+    XCTAssertEqual(pool->vector_count(), 0);
+    XCTAssertEqual(pool->allocation_count(), 0);
+    XCTAssertEqual(pool->reuse_count(), 0);
+}
+
+- (void)test_take_and_put {
+    auto const pool = signal_event_pool::make_shared();
+
+    auto vec = pool->take<float>(4);
+    XCTAssertEqual(vec.size(), 4);
+    XCTAssertEqual(pool->allocation_count(), 1);
+    XCTAssertEqual(pool->reuse_count(), 0);
+
+    vec[0] = 1.0f;
+    auto const *const data = vec.data();
+
+    pool->put(std::move(vec));
+    XCTAssertEqual(pool->vector_count(), 1);
+
+    auto reused = pool->take<float>(2);
+    XCTAssertEqual(reused.size(), 2);
+    XCTAssertEqual(reused.data(), data);
+    XCTAssertEqual(reused[0], 0.0f);
+    XCTAssertEqual(pool->allocation_count(), 1);
+    XCTAssertEqual(pool->reuse_count(), 1);
+    XCTAssertEqual(pool->vector_count(), 0);
+
+    pool->put(std::move(reused));
+
+    // 容量が足りなければ新たに確保する
+    auto larger = pool->take<float>(8);
+    XCTAssertEqual(larger.size(), 8);
+    XCTAssertEqual(pool->allocation_count(), 2);
+    XCTAssertEqual(pool->vector_count(), 1);
+
+    // 型が違えば再利用しない
+    auto other = pool->take<double>(1);
+    XCTAssertEqual(pool->allocation_count(), 3);
+    XCTAssertEqual(pool->vector_count(), 1);
+
+    pool->clear();
+    XCTAssertEqual(pool->vector_count(), 0);
+    XCTAssertEqual(pool->allocation_count(), 0);
+    XCTAssertEqual(pool->reuse_count(), 0);
+}
+
+- (void)test_max_vector_count {
+    auto const pool = signal_event_pool::make_shared(2);
+
+    pool->put(std::vector<int16_t>(1));
+    pool->put(std::vector<int16_t>(1));
+    pool->put(std::vector<int16_t>(1));
+
+    XCTAssertEqual(pool->vector_count(), 2);
+
+    pool->put(std::vector<int16_t>());
+
+    XCTAssertEqual(pool->vector_count(), 2);
+}
+
+- (void)test_signal_event_returns_vector_to_pool {
+    auto const pool = signal_event_pool::make_shared();
+
+    {
+        auto const signal = signal_event::make_shared<boolean>(3, pool);
+        XCTAssertEqual(signal->size(), 3);
+        XCTAssertTrue(signal->sample_type() == typeid(boolean));
+        XCTAssertEqual(pool->vector_count(), 0);
+    }
+
+    XCTAssertEqual(pool->vector_count(), 1);
+
+    {
+        auto const signal = signal_event::make_shared<boolean>(3, pool);
+        XCTAssertEqual(pool->reuse_count(), 1);
+    }
+
+    auto const signal = signal_event::make_shared<boolean>(3, nullptr);
+    XCTAssertEqual(signal->size(), 3);
+}
+
+- (void)test_stream_pool {
+    auto const pool = signal_event_pool::make_shared();
+
+    stream const stream{sync_source{1, 1}, pool};
+    XCTAssertEqual(stream.signal_event_pool(), pool);
+
+    proc::stream const copied{stream};
+    XCTAssertEqual(copied.signal_event_pool(), pool);
+
+    proc::stream const no_pool{sync_source{1, 1}};
+    XCTAssertFalse(no_pool.signal_event_pool());
+}
+
+- (void)test_timeline_process_reuses_vectors_across_slices {
+    auto const timeline = timeline::make_shared();
+
+    auto const track = track::make_shared();
+    auto module1 = make_signal_module<float>(1.0f);
+    module1->connect_output(to_connector_index(constant::output::value), 0);
+    track->push_back_module(std::move(module1), {0, 1000});
+    auto module2 = make_signal_module<float>(2.0f);
+    module2->connect_output(to_connector_index(constant::output::value), 0);
+    track->push_back_module(std::move(module2), {1000, 1000});
+    timeline->insert_track(0, track);
+
+    std::vector<std::size_t> allocation_counts;
+    std::vector<std::size_t> reuse_counts;
+
+    // moduleの境目がスライスの途中に来るようにして、signalを結合する処理も通す
+    timeline->process(time::range{0, 2000}, sync_source{100, 150}, [&](time::range const &, stream const &stream) {
+        auto const &pool = stream.signal_event_pool();
+        XCTAssertTrue(pool);
+        allocation_counts.emplace_back(pool->allocation_count());
+        reuse_counts.emplace_back(pool->reuse_count());
+        return continuation::keep;
+    });
+
+    XCTAssertEqual(allocation_counts.size(), 14);
+
+    // 最初のスライスで確保したメモリを次のスライスから使い回す
+    XCTAssertEqual(allocation_counts.at(0), 1);
+    XCTAssertEqual(reuse_counts.at(0), 0);
+    XCTAssertEqual(allocation_counts.at(5), 1);
+    XCTAssertEqual(reuse_counts.at(5), 5);
+
+    // {900, 150}のスライスで結合用に1つ確保され、以降は確保されない
+    XCTAssertEqual(allocation_counts.at(6), 2);
+    XCTAssertEqual(allocation_counts.back(), 2);
+    XCTAssertEqual(reuse_counts.back(), 13);
+}
+
+- (void)test_timeline_process_without_allocating_signals_after_warming_up {
+    uint32_t const slice_length = 1024;
+    uint32_t const slice_count = 8;
+
+    auto const timeline = timeline::make_shared();
+
+    auto const track = track::make_shared();
+    auto module = make_signal_module<float>(1.0f);
+    module->connect_output(to_connector_index(constant::output::value), 0);
+    track->push_back_module(std::move(module), {0, slice_length * slice_count});
+    timeline->insert_track(0, track);
+
+    std::vector<test::allocation_count> allocations;
+    allocations.reserve(slice_count);
+
+    // スライスごとに、前のスライスを受け取ってから次のスライスを受け取るまでに確保された回数を数える
+    test::begin_counting_allocations();
+
+    timeline->process(time::range{0, slice_length * slice_count}, sync_source{48000, slice_length},
+                      [&allocations](time::range const &, stream const &) {
+                          allocations.emplace_back(test::end_counting_allocations());
+                          test::begin_counting_allocations();
+                          return continuation::keep;
+                      });
+
+    auto const last_allocation = test::end_counting_allocations();
+
+    XCTAssertEqual(allocations.size(), slice_count);
+    XCTAssertGreaterThanOrEqual(allocations.at(0).max_byte_size, slice_length * sizeof(float));
+
+    // 最初のスライスの信号がプールへ戻った後は、信号の大きさのメモリを確保せず、確保する回数も変わらない
+    for (uint32_t idx = 2; idx < slice_count; ++idx) {
+        XCTAssertLessThan(allocations.at(idx).max_byte_size, slice_length * sizeof(float));
+        XCTAssertEqual(allocations.at(idx).count, allocations.at(2).count);
+    }
+
+    XCTAssertLessThan(last_allocation.max_byte_size, slice_length * sizeof(float));
+}
+
+- (void)test_signal_event_with_unpoolable_type {
+    struct element {
+        std::string key;
+    };
+
+    auto const pool = signal_event_pool::make_shared();
+
+    {
+        auto const signal = signal_event::make_shared<element>(2, pool);
+        XCTAssertEqual(signal->size(), 2);
+    }
+
+    // プールで扱えない型はプールを使わずに確保と解放をする
+    XCTAssertEqual(pool->allocation_count(), 0);
+    XCTAssertEqual(pool->vector_count(), 0);
+}
+
+@end
@@ -4,6 +4,9 @@
 
 #import <XCTest/XCTest.h>
 #include <audio-processing/time/time.h>
+#include <cpp-utils/fast_each.h>
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 using namespace yas;
@@ -330,4 +333,91 @@ using namespace yas::proc;
     }
 }
 
+- (void)test_null_time {
+    proc::time const null_time{nullptr};
+
+    XCTAssertFalse(null_time);
+    XCTAssertFalse(null_time.is_range_type());
+    XCTAssertFalse(null_time.is_frame_type());
+    XCTAssertFalse(null_time.is_any_type());
+    XCTAssertTrue(null_time == proc::time{nullptr});
+    XCTAssertFalse(null_time == make_any_time());
+
+    XCTAssertTrue(make_any_time());
+}
+
+- (void)test_copy {
+    proc::time const src_time = make_range_time(1, 2);
+    proc::time copied_time = src_time;
+
+    copied_time = time::range{3, 4};
+
+    XCTAssertEqual(src_time.get<time::range>(), (time::range{1, 2}));
+    XCTAssertEqual(copied_time.get<time::range>(), (time::range{3, 4}));
+}
+
+- (void)test_insert_performance {
+    std::size_t const count = 100000;
+
+    [self measureBlock:^{
+        std::multimap<proc::time, int> map;
+
+        auto each = make_fast_each(count);
+        while (yas_each_next(each)) {
+            auto const &idx = yas_each_index(each);
+            auto const frame = static_cast<frame_index_t>((idx * 7919) % count);
+            if (idx % 2 == 0) {
+                map.emplace(make_frame_time(frame), 0);
+            } else {
+                map.emplace(make_range_time(frame, 16), 0);
+            }
+        }
+    }];
+}
+
+- (void)test_sort_performance {
+    std::size_t const count = 100000;
+
+    std::vector<proc::time> src_times;
+    src_times.reserve(count);
+
+    auto each = make_fast_each(count);
+    while (yas_each_next(each)) {
+        auto const &idx = yas_each_index(each);
+        auto const frame = static_cast<frame_index_t>((idx * 7919) % count);
+        if (idx % 2 == 0) {
+            src_times.emplace_back(make_frame_time(frame));
+        } else {
+            src_times.emplace_back(make_range_time(frame, 16));
+        }
+    }
+
+    auto const *const src_times_ptr = &src_times;
+
+    [self measureBlock:^{
+        auto times = *src_times_ptr;
+        std::sort(times.begin(), times.end());
+    }];
+}
+
+- (void)test_compare_performance {
+    std::size_t const count = 1000000;
+
+    proc::time const lhs = make_range_time(0, 16);
+    proc::time const rhs = make_range_time(0, 32);
+
+    [self measureBlock:^{
+        std::size_t less_count = 0;
+
+        auto each = make_fast_each(count);
+        while (yas_each_next(each)) {
+            if (lhs < rhs && lhs != rhs) {
+                ++less_count;
+            }
+        }
+
+        XCTAssertEqual(less_count, count);
+    }];
+}
+
 @end
@@ -3,12 +3,90 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <audio-engine/utils/worker_pool.h>
 #import <audio-processing/timeline/timeline.h>
+#import <audio-processing/timeline/timeline_utils.h>
+#import <audio-processing/umbrella.hpp>
 #import <cpp-utils/each_index.h>
 
 using namespace yas;
 using namespace yas::proc;
 
+namespace yas::proc::test_utils::parallel_timeline {
+using snapshot_t = std::vector<std::tuple<channel_index_t, proc::time, std::vector<float>>>;
+using called_t = std::vector<std::tuple<time::range, std::optional<track_index_t>, snapshot_t>>;
+
+static snapshot_t make_snapshot(stream const &stream) {
+    snapshot_t snapshot;
+
+    for (auto const &channel_pair : stream.channels()) {
+        for (auto const &event_pair : channel_pair.second.events()) {
+            std::vector<float> values;
+            if (auto const signal = event_pair.second.get<signal_event>()) {
+                values = signal->vector<float>();
+            }
+            snapshot.emplace_back(channel_pair.first, event_pair.first, std::move(values));
+        }
+    }
+
+    return snapshot;
+}
+
+// トラックごとに別のチャンネルで定数を生成してsinを求める
+static timeline_ptr make_independent_timeline(std::size_t const track_count, length_t const length) {
+    auto const timeline = timeline::make_shared();
+
+    auto trk_each = make_fast_each(track_count);
+    while (yas_each_next(trk_each)) {
+        auto const &trk_idx = yas_each_index(trk_each);
+        auto const src_ch_idx = static_cast<channel_index_t>(trk_idx * 2);
+        auto const dst_ch_idx = src_ch_idx + 1;
+
+        auto const track = track::make_shared();
+
+        auto module_each = make_fast_each<frame_index_t>(4);
+        while (yas_each_next(module_each)) {
+            auto const &module_idx = yas_each_index(module_each);
+            time::range const range{module_idx * static_cast<frame_index_t>(length / 4), length / 4};
+
+            auto constant_module = make_signal_module<float>(static_cast<float>(trk_idx) + module_idx * 0.1f);
+            constant_module->connect_output(to_connector_index(constant::output::value), src_ch_idx);
+            track->push_back_module(std::move(constant_module), range);
+
+            auto sin_module = make_signal_module<float>(math1::kind::sin);
+            sin_module->connect_input(to_connector_index(math1::input::parameter), src_ch_idx);
+            sin_module->connect_output(to_connector_index(math1::output::result), dst_ch_idx);
+            track->push_back_module(std::move(sin_module), range);
+        }
+
+        timeline->insert_track(static_cast<track_index_t>(trk_idx), track);
+    }
+
+    return timeline;
+}
+
+static called_t process(timeline_ptr const &timeline, time::range const &range, sync_source const &sync_src,
+                        audio::worker_pool_ptr const &worker_pool,
+                        std::optional<std::size_t> const abort_count = std::nullopt) {
+    called_t called;
+
+    timeline->process(
+        range, sync_src,
+        [&called, &abort_count](time::range const &time_range, stream const &stream,
+                                std::optional<track_index_t> const &trk_idx) {
+            called.emplace_back(time_range, trk_idx, make_snapshot(stream));
+
+            if (abort_count.has_value() && called.size() == *abort_count) {
+                return continuation::abort;
+            }
+            return continuation::keep;
+        },
+        worker_pool);
+
+    return called;
+}
+}  // namespace yas::proc::test_utils::parallel_timeline
+
 @interface timeline_tests : XCTestCase
 
 @end
@@ -376,6 +454,94 @@ using namespace yas::proc;
     XCTAssertEqual(last_frame, 5);
 }
 
+- (void)test_process_in_parallel {
+    using namespace test_utils::parallel_timeline;
+
+    length_t const process_length = 64;
+    auto const timeline = make_independent_timeline(8, process_length);
+    auto const worker_pool = audio::worker_pool::make_shared(3);
+
+    XCTAssertTrue(is_tracks_independent(timeline->tracks()));
+
+    auto const serial_called = process(timeline, time::range{0, process_length}, sync_source{1, 10}, nullptr);
+    auto const parallel_called =
+        process(timeline, time::range{0, process_length}, sync_source{1, 10}, worker_pool);
+
+    // 7スライス * (8トラック + 全体)
+    XCTAssertEqual(serial_called.size(), 63);
+    XCTAssertTrue(serial_called == parallel_called);
+}
+
+- (void)test_process_in_parallel_with_dependent_tracks {
+    using namespace test_utils::parallel_timeline;
+
+    length_t const process_length = 16;
+    auto const timeline = make_independent_timeline(2, process_length);
+
+    // トラック1がトラック0の出力を読む
+    auto const dependent_track = track::make_shared();
+    auto plus_module = make_signal_module<float>(math2::kind::plus);
+    plus_module->connect_input(to_connector_index(math2::input::left), 1);
+    plus_module->connect_input(to_connector_index(math2::input::right), 3);
+    plus_module->connect_output(to_connector_index(math2::output::result), 10);
+    dependent_track->push_back_module(std::move(plus_module), time::range{0, process_length});
+    timeline->insert_track(2, dependent_track);
+
+    XCTAssertFalse(is_tracks_independent(timeline->tracks()));
+
+    auto const worker_pool = audio::worker_pool::make_shared(3);
+
+    auto const serial_called = process(timeline, time::range{0, process_length}, sync_source{1, 5}, nullptr);
+    auto const parallel_called = process(timeline, time::range{0, process_length}, sync_source{1, 5}, worker_pool);
+
+    XCTAssertTrue(serial_called == parallel_called);
+}
+
+- (void)test_abort_process_in_parallel {
+    using namespace test_utils::parallel_timeline;
+
+    length_t const process_length = 64;
+    auto const timeline = make_independent_timeline(4, process_length);
+    auto const worker_pool = audio::worker_pool::make_shared(3);
+
+    auto const serial_called =
+        process(timeline, time::range{0, process_length}, sync_source{1, 10}, nullptr, std::size_t(7));
+    auto const parallel_called =
+        process(timeline, time::range{0, process_length}, sync_source{1, 10}, worker_pool, std::size_t(7));
+
+    XCTAssertEqual(parallel_called.size(), 7);
+    XCTAssertEqual(std::get<1>(parallel_called.back()), 1);
+    XCTAssertTrue(serial_called == parallel_called);
+}
+
+- (void)test_is_tracks_independent_with_shared_module {
+    // 書き込むチャンネルがなくてもモジュールを共有していれば独立していない
+    auto const module = make_signal_module<float>(math1::kind::sin);
+    module->connect_input(to_connector_index(math1::input::parameter), 0);
+
+    auto const track0 = track::make_shared();
+    track0->push_back_module(module, time::range{0, 1});
+    auto const track1 = track::make_shared();
+    track1->push_back_module(module, time::range{1, 1});
+
+    XCTAssertTrue(is_tracks_independent({{0, track0}}));
+    XCTAssertFalse(is_tracks_independent({{0, track0}, {1, track1}}));
+}
+
+- (void)test_is_tracks_stateless {
+    auto const track0 = track::make_shared();
+    track0->push_back_module(make_signal_module<float>(1.0f), time::range{0, 1});
+    track0->push_back_module(make_signal_module<float>(math1::kind::sin), time::range{0, 1});
+
+    XCTAssertTrue(is_tracks_stateless({{0, track0}}));
+
+    // 前のスライスの値を持ち越すモジュールがあればstatelessではない
+    auto const track1 = track::make_shared();
+    track1->push_back_module(make_number_to_signal_module<float>(), time::range{0, 1});
+
+    XCTAssertFalse(is_tracks_stateless({{0, track0}, {1, track1}}));
+}
+
 - (void)test_total_range {
     auto const timeline = timeline::make_shared();
 
@@ -4,6 +4,8 @@
 
 #import <XCTest/XCTest.h>
 #import <audio-processing/track/track.h>
+#import <audio-processing/umbrella.hpp>
+#import <thread>
 
 using namespace yas;
 using namespace yas::proc;
@@ -210,6 +212,29 @@ using namespace yas::proc;
     XCTAssertEqual(track->total_range(), (time::range{-10, 110}));
 }
 
+- (void)test_total_range_from_multiple_threads {
+    auto track = track::make_shared();
+    track->push_back_module(module::make_shared([] { return module::processors_t{}; }), {0, 1});
+    track->push_back_module(module::make_shared([] { return module::processors_t{}; }), {99, 1});
+
+    // 変更した時点で作り直しているので、constの関数は同時に呼んでも書き込まない
+    proc::track const &const_track = *track;
+    std::vector<std::optional<time::range>> results(4);
+    std::vector<std::thread> threads;
+
+    for (std::size_t idx = 0; idx < results.size(); ++idx) {
+        threads.emplace_back([&const_track, &result = results.at(idx)] { result = const_track.total_range(); });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (auto const &result : results) {
+        XCTAssertEqual(result, (time::range{0, 100}));
+    }
+}
+
 - (void)test_copy {
     std::vector<int> called;
 
@@ -242,4 +267,153 @@ using namespace yas::proc;
     XCTAssertEqual(called.at(1), 1);
 }
 
+- (void)test_process_after_modifying {
+    std::vector<time::range> called;
+
+    auto make_module = [&called] {
+        return module::make_shared([&called] {
+            auto processor = [&called](time::range const &range, connector_map_t const &, connector_map_t const &,
+                                       stream &) { called.push_back(range); };
+            return module::processors_t{std::move(processor)};
+        });
+    };
+
+    auto track = track::make_shared();
+    track->push_back_module(make_module(), {0, 10});
+
+    proc::stream stream{sync_source{1, 100}};
+
+    track->process({5, 10}, stream);
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0), (time::range{5, 5}));
+
+    called.clear();
+
+    track->push_back_module(make_module(), {10, 10});
+
+    track->process({5, 10}, stream);
+
+    XCTAssertEqual(called.size(), 2);
+    XCTAssertEqual(called.at(0), (time::range{5, 5}));
+    XCTAssertEqual(called.at(1), (time::range{10, 5}));
+
+    called.clear();
+
+    track->erase_modules_for_range({0, 10});
+
+    track->process({5, 10}, stream);
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0), (time::range{10, 5}));
+}
+
+- (void)test_process_with_plan {
+    std::vector<std::pair<int, time::range>> called;
+
+    auto make_module = [&called](int const id) {
+        return module::make_shared([&called, id] {
+            auto processor = [&called, id](time::range const &range, connector_map_t const &,
+                                           connector_map_t const &, stream &) { called.emplace_back(id, range); };
+            return module::processors_t{std::move(processor)};
+        });
+    };
+
+    auto const module_set = module_set::make_shared({make_module(1)});
+    auto track = track::make_shared({{time::range{0, 10}, module_set}});
+
+    XCTAssertFalse(track->is_plan_enabled());
+
+    track->set_plan_enabled(true);
+
+    XCTAssertTrue(track->is_plan_enabled());
+    XCTAssertTrue(track->copy()->is_plan_enabled());
+
+    proc::stream stream{sync_source{1, 100}};
+
+    track->process({5, 10}, stream);
+
+    XCTAssertEqual(called.size(), 1);
+    XCTAssertEqual(called.at(0).first, 1);
+    XCTAssertEqual(called.at(0).second, (time::range{5, 5}));
+
+    called.clear();
+
+    // 監視されていないmodule_setを直接変更しても反映される
+    module_set->push_back(make_module(2));
+
+    track->process({0, 10}, stream);
+    track->process({0, 10}, stream);
+
+    XCTAssertEqual(called.size(), 4);
+    XCTAssertEqual(called.at(0).first, 1);
+    XCTAssertEqual(called.at(1).first, 2);
+    XCTAssertEqual(called.at(2).first, 1);
+    XCTAssertEqual(called.at(3).first, 2);
+
+    called.clear();
+
+    track->push_back_module(make_module(3), {10, 10});
+
+    track->process({5, 10}, stream);
+
+    XCTAssertEqual(called.size(), 3);
+    XCTAssertEqual(called.at(2).first, 3);
+    XCTAssertEqual(called.at(2).second, (time::range{10, 5}));
+}
+
+- (void)test_process_with_plan_after_connector_change {
+    auto const module = make_signal_module<int8_t>(int8_t(1));
+    module->connect_output(to_connector_index(constant::output::value), 0);
+
+    auto track = track::make_shared();
+    track->push_back_module(module, {0, 10});
+    track->set_plan_enabled(true);
+
+    proc::stream stream{sync_source{1, 10}};
+
+    track->process({0, 5}, stream);
+
+    XCTAssertTrue(stream.has_channel(0));
+    XCTAssertFalse(stream.has_channel(1));
+
+    // connectorの変更はmodule_setから通知されないが、planが古くなったことで反映される
+    module->disconnect_output(to_connector_index(constant::output::value));
+    module->connect_output(to_connector_index(constant::output::value), 1);
+
+    track->process({5, 5}, stream);
+    track->process({0, 5}, stream);
+
+    XCTAssertTrue(stream.has_channel(1));
+    XCTAssertEqual(stream.channel(1).events().size(), 1);
+}
+
+- (void)test_process_many_module_sets_performance {
+    std::size_t called = 0;
+
+    auto const module = module::make_shared([&called] {
+        auto processor = [&called](time::range const &, connector_map_t const &, connector_map_t const &,
+                                   stream &) { ++called; };
+        return module::processors_t{std::move(processor)};
+    });
+
+    track_module_set_map_t module_sets;
+    for (frame_index_t idx = 0; idx < 100000; ++idx) {
+        module_sets.emplace(time::range{idx * 100, 200}, module_set::make_shared({module}));
+    }
+
+    auto const track = track::make_shared(std::move(module_sets));
+    track->set_plan_enabled(true);
+
+    auto const stream = std::make_shared<proc::stream>(sync_source{44100, 512});
+
+    [self measureBlock:^{
+        for (frame_index_t frame = 0; frame < 1000000; frame += 512) {
+            track->process({frame, 512}, *stream);
+        }
+    }];
+
+    XCTAssertGreaterThan(called, 0);
+}
+
 @end